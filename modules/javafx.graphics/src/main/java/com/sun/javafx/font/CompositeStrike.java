@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -174,6 +174,30 @@ public class CompositeStrike implements FontStrike {
         return getStrikeSlot(slot).getGlyph(slotglyphCode);
     }
 
+    /* The codes are sorted, so the codes of each slot are contiguous and
+     * each run is handed to its slot strike with the slot bits removed.
+     */
+    @Override
+    public void prepareGlyphs(int[] glyphCodes, int count) {
+        int start = 0;
+        while (start < count) {
+            int slot = (glyphCodes[start] >>> 24);
+            int end = start + 1;
+            while (end < count && (glyphCodes[end] >>> 24) == slot) {
+                end++;
+            }
+            FontStrike slotStrike = getStrikeSlot(slot);
+            if (slotStrike != null && end - start > 1) {
+                int[] slotCodes = new int[end - start];
+                for (int i = start; i < end; i++) {
+                    slotCodes[i - start] = glyphCodes[i] & CompositeGlyphMapper.GLYPHMASK;
+                }
+                slotStrike.prepareGlyphs(slotCodes, slotCodes.length);
+            }
+            start = end;
+        }
+    }
+
      /**
      * Access to individual character advances are frequently needed for layout
      * understand that advance may vary for single glyph if ligatures or kerning
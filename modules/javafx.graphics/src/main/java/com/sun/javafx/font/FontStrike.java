@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -50,6 +50,15 @@ public interface FontStrike {
     public void clearDesc(); // for cache management.
     public int getAAMode();
 
+    /**
+     * Called before the glyphs with the given codes are requested for
+     * rendering, so that strikes able to rasterize several glyphs in a
+     * single call can do so. The codes are in ascending order, each code
+     * at most once. The default implementation does nothing.
+     */
+    public default void prepareGlyphs(int[] glyphCodes, int count) {
+    }
+
     /* These are all user space values */
     public float getCharAdvance(char ch);
     public Shape getOutline(GlyphList gl,
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2013, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -54,4 +54,10 @@ public interface Glyph {
     public int getHeight();
     public int getOriginX();
     public int getOriginY();
+
+    /* Index of the first byte of the mask in the array returned by
+     * getPixelData(), for glyphs that share one array. */
+    public default int getPixelDataOffset() {
+        return 0;
+    }
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013, 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2013, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,6 +25,8 @@
 
 package com.sun.javafx.font.freetype;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import com.sun.javafx.font.Disposer;
 import com.sun.javafx.font.FontResource;
 import com.sun.javafx.font.FontStrikeDesc;
@@ -117,19 +119,11 @@ class FTFontFile extends PrismFontFile {
         return OSFreetype.FT_Outline_Decompose(face);
     }
 
-    synchronized void initGlyph(FTGlyph glyph, FTFontStrike strike) {
-        float size = strike.getSize();
-        if (size == 0) {
-            glyph.buffer = new byte[0];
-            glyph.bitmap = new FT_Bitmap();
-            return;
-        }
-        int size26dot6 = (int)(size * 64);
+    /* Sets up the face for rendering glyphs of the strike, returns the load flags */
+    private int setupStrike(FTFontStrike strike, boolean lcd) {
+        int size26dot6 = (int)(strike.getSize() * 64);
         OSFreetype.FT_Set_Char_Size(face, 0, size26dot6, 72, 72);
 
-        boolean lcd = strike.getAAMode() == FontResource.AA_LCD &&
-                      FTFactory.LCD_SUPPORT;
-
         int flags = OSFreetype.FT_LOAD_RENDER | OSFreetype.FT_LOAD_NO_HINTING | OSFreetype.FT_LOAD_NO_BITMAP;
         FT_Matrix matrix = strike.matrix;
         if (matrix != null) {
@@ -142,6 +136,19 @@ class FTFontFile extends PrismFontFile {
         } else {
             flags |= OSFreetype.FT_LOAD_TARGET_NORMAL;
         }
+        return flags;
+    }
+
+    synchronized void initGlyph(FTGlyph glyph, FTFontStrike strike) {
+        float size = strike.getSize();
+        if (size == 0) {
+            glyph.buffer = new byte[0];
+            glyph.bitmap = new FT_Bitmap();
+            return;
+        }
+        boolean lcd = strike.getAAMode() == FontResource.AA_LCD &&
+                      FTFactory.LCD_SUPPORT;
+        int flags = setupStrike(strike, lcd);
 
         int glyphCode = glyph.getGlyphCode();
         int error = OSFreetype.FT_Load_Glyph(face, glyphCode, flags);
@@ -149,7 +156,7 @@ class FTFontFile extends PrismFontFile {
             if (PrismFontFactory.debugFonts) {
                 System.err.println("FT_Load_Glyph failed " + error +
                                    " glyph code " + glyphCode +
-                                   " load falgs " + flags);
+                                   " load flags " + flags);
             }
             return;
         }
@@ -172,7 +179,7 @@ class FTFontFile extends PrismFontFile {
             if (PrismFontFactory.debugFonts) {
                 System.err.println("Unexpected pixel mode: " + pixelMode +
                                    " glyph code " + glyphCode +
-                                   " load falgs " + flags);
+                                   " load flags " + flags);
             }
             return;
         }
@@ -206,4 +213,121 @@ class FTFontFile extends PrismFontFile {
         glyph.userAdvance = glyphRec.linearHoriAdvance / 65536.0f; /* Fixed 16.16 */
         glyph.lcd = lcd;
     }
+
+    /*
+     * Glyph records written by OSFreetype.rasterizeGlyphs, reused across
+     * calls. Guarded by the lock on this object like the face itself.
+     */
+    private static final int GLYPH_BUFFER_SIZE = 64 * 1024;
+    private static final byte[] EMPTY_BITMAP = new byte[0];
+    private ByteBuffer glyphBuffer;
+
+    /**
+     * Initializes several glyphs of the strike with a single native call per
+     * buffer full of glyphs, instead of one FT_Load_Glyph, getGlyphSlot and
+     * getBitmapData round trip per glyph.
+     */
+    synchronized void initGlyphs(FTGlyph[] glyphs, int count, FTFontStrike strike) {
+        if (strike.getSize() == 0) {
+            for (int i = 0; i < count; i++) {
+                initGlyph(glyphs[i], strike);
+            }
+            return;
+        }
+        boolean lcd = strike.getAAMode() == FontResource.AA_LCD &&
+                      FTFactory.LCD_SUPPORT;
+        int flags = setupStrike(strike, lcd);
+
+        int[] glyphCodes = new int[count];
+        for (int i = 0; i < count; i++) {
+            glyphCodes[i] = glyphs[i].getGlyphCode();
+        }
+        if (glyphBuffer == null) {
+            glyphBuffer = ByteBuffer.allocateDirect(GLYPH_BUFFER_SIZE).order(ByteOrder.nativeOrder());
+        }
+        int offset = 0;
+        while (offset < count) {
+            int done = OSFreetype.rasterizeGlyphs(face, glyphCodes, offset, count - offset, flags, glyphBuffer);
+            if (done == 0) {
+                /* The glyph does not fit in the buffer, load it on its own */
+                initGlyph(glyphs[offset++], strike);
+                continue;
+            }
+            glyphBuffer.clear();
+            /* The bitmaps of the batch are copied into a single array */
+            byte[] pixels = new byte[getBitmapDataSize(done)];
+            int pixelOffset = 0;
+            for (int i = 0; i < done; i++) {
+                pixelOffset = readGlyphRecord(glyphs[offset + i], flags, lcd, pixels, pixelOffset);
+            }
+            offset += done;
+        }
+    }
+
+    private int getBitmapDataSize(int count) {
+        int size = 0;
+        int header = 0;
+        for (int i = 0; i < count; i++) {
+            int dataSize = glyphBuffer.getInt(header + OSFreetype.GLYPH_RECORD_DATA_SIZE * 4);
+            size += dataSize;
+            header += OSFreetype.GLYPH_RECORD_HEADER * 4 + ((dataSize + 3) & ~3);
+        }
+        return size;
+    }
+
+    /* Returns the offset in pixels after the bitmap of the glyph */
+    private int readGlyphRecord(FTGlyph glyph, int flags, boolean lcd, byte[] pixels, int pixelOffset) {
+        ByteBuffer buffer = glyphBuffer;
+        int header = buffer.position();
+        int dataSize = buffer.getInt(header + OSFreetype.GLYPH_RECORD_DATA_SIZE * 4);
+        buffer.position(header + OSFreetype.GLYPH_RECORD_HEADER * 4 + ((dataSize + 3) & ~3));
+
+        int error = buffer.getInt(header + OSFreetype.GLYPH_RECORD_ERROR * 4);
+        if (error != 0) {
+            if (PrismFontFactory.debugFonts) {
+                System.err.println("FT_Load_Glyph failed " + error +
+                                   " glyph code " + glyph.getGlyphCode() +
+                                   " load flags " + flags);
+            }
+            return pixelOffset;
+        }
+        int pixelMode = buffer.getInt(header + OSFreetype.GLYPH_RECORD_PIXEL_MODE * 4);
+        if (pixelMode != OSFreetype.FT_PIXEL_MODE_GRAY && pixelMode != OSFreetype.FT_PIXEL_MODE_LCD) {
+            /* See initGlyph() */
+            if (PrismFontFactory.debugFonts) {
+                System.err.println("Unexpected pixel mode: " + pixelMode +
+                                   " glyph code " + glyph.getGlyphCode() +
+                                   " load flags " + flags);
+            }
+            return pixelOffset;
+        }
+        FT_Bitmap bitmap = new FT_Bitmap();
+        bitmap.pixel_mode = (byte)pixelMode;
+        bitmap.width = buffer.getInt(header + OSFreetype.GLYPH_RECORD_WIDTH * 4);
+        bitmap.rows = buffer.getInt(header + OSFreetype.GLYPH_RECORD_ROWS * 4);
+        bitmap.pitch = bitmap.width;
+
+        if (dataSize > 0) {
+            buffer.get(header + OSFreetype.GLYPH_RECORD_HEADER * 4, pixels, pixelOffset, dataSize);
+            glyph.buffer = pixels;
+            glyph.bufferOffset = pixelOffset;
+            pixelOffset += dataSize;
+        } else if (bitmap.width != 0 && bitmap.rows != 0) {
+            /* Bitmap that getBitmapData() would not have returned either */
+            glyph.buffer = null;
+        } else {
+            /* white space */
+            glyph.buffer = EMPTY_BITMAP;
+        }
+
+        glyph.bitmap_left = buffer.getInt(header + OSFreetype.GLYPH_RECORD_BITMAP_LEFT * 4);
+        glyph.bitmap_top = buffer.getInt(header + OSFreetype.GLYPH_RECORD_BITMAP_TOP * 4);
+        glyph.advanceX = buffer.getInt(header + OSFreetype.GLYPH_RECORD_ADVANCE_X * 4) / 64f;    /* Fixed 26.6*/
+        glyph.advanceY = buffer.getInt(header + OSFreetype.GLYPH_RECORD_ADVANCE_Y * 4) / 64f;
+        glyph.userAdvance = buffer.getInt(header + OSFreetype.GLYPH_RECORD_LINEAR_HORI_ADVANCE * 4) / 65536.0f; /* Fixed 16.16 */
+        glyph.lcd = lcd;
+        /* Set last, FTGlyph uses it to tell whether the glyph is initialized */
+        glyph.bitmap = bitmap;
+        return pixelOffset;
+    }
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2013, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -83,4 +83,24 @@ class FTFontStrike extends PrismFontStrike<FTFontFile> {
         fontResource.initGlyph(glyph, this);
     }
 
+    @Override
+    public void prepareGlyphs(int[] glyphCodes, int count) {
+        FTGlyph[] glyphs = new FTGlyph[count];
+        int pending = 0;
+        for (int i = 0; i < count; i++) {
+            /* The codes are sorted, a repeated code is the same glyph */
+            if (i > 0 && glyphCodes[i] == glyphCodes[i - 1]) {
+                continue;
+            }
+            FTGlyph glyph = (FTGlyph)getGlyph(glyphCodes[i]);
+            if (glyph.bitmap == null) {
+                glyphs[pending++] = glyph;
+            }
+        }
+        if (pending > 1) {
+            FTFontFile fontResource = getFontResource();
+            fontResource.initGlyphs(glyphs, pending, this);
+        }
+    }
+
 }
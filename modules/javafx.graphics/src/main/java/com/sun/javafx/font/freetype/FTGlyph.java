@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2013, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -33,6 +33,7 @@ class FTGlyph implements Glyph {
     FTFontStrike strike;
     int glyphCode;
     byte[] buffer;
+    int bufferOffset; /* glyphs rasterized together share one buffer */
     FT_Bitmap bitmap;
     int bitmap_left;
     int bitmap_top;
@@ -87,6 +88,12 @@ class FTGlyph implements Glyph {
         return buffer;
     }
 
+    @Override
+    public int getPixelDataOffset() {
+        init();
+        return bufferOffset;
+    }
+
     @Override
     public float getPixelXAdvance() {
         init();
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013, 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2013, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,6 +25,7 @@
 
 package com.sun.javafx.font.freetype;
 
+import java.nio.ByteBuffer;
 import java.security.AccessController;
 import java.security.PrivilegedAction;
 import com.sun.glass.utils.NativeLibLoader;
@@ -111,6 +112,20 @@ class OSFreetype {
     static final native void FT_Set_Transform(long face, FT_Matrix matrix, long delta_x, long delta_y);
     static final native FT_GlyphSlotRec getGlyphSlot(long face);
     static final native byte[] getBitmapData(long face);
+
+    /* Layout of the glyph records written by rasterizeGlyphs, in ints */
+    static final int GLYPH_RECORD_ERROR = 0;
+    static final int GLYPH_RECORD_PIXEL_MODE = 1;
+    static final int GLYPH_RECORD_WIDTH = 2;
+    static final int GLYPH_RECORD_ROWS = 3;
+    static final int GLYPH_RECORD_BITMAP_LEFT = 4;
+    static final int GLYPH_RECORD_BITMAP_TOP = 5;
+    static final int GLYPH_RECORD_ADVANCE_X = 6;
+    static final int GLYPH_RECORD_ADVANCE_Y = 7;
+    static final int GLYPH_RECORD_LINEAR_HORI_ADVANCE = 8;
+    static final int GLYPH_RECORD_DATA_SIZE = 9;
+    static final int GLYPH_RECORD_HEADER = 10;
+    static final native int rasterizeGlyphs(long face, int[] glyphCodes, int offset, int count, int load_flags, ByteBuffer buffer);
     static final native boolean isPangoEnabled();
     static final native boolean isHarfbuzzEnabled();
 }
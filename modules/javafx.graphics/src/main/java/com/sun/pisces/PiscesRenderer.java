@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2020, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -380,6 +380,36 @@ public final class PiscesRenderer {
 
     private native void setLCDGammaCorrectionImpl(float gamma);
 
+    /**
+     * Sets how many threads, including the calling one, may rasterize the
+     * rows of one large fill in parallel, and the minimum number of pixels
+     * each of them must get. With one thread (the default) every fill is
+     * rendered on the calling thread. Applies to all renderers.
+     *
+     * @param maxThreads maximum number of threads per fill
+     * @param minBandSize minimum number of pixels per thread
+     */
+    public static void setThreading(int maxThreads, int minBandSize) {
+        setThreadingImpl(maxThreads, minBandSize);
+    }
+
+    private static native void setThreadingImpl(int maxThreads, int minBandSize);
+
+    /**
+     * Restricts the blend loops of all renderers to the given SIMD level
+     * (0 for scalar, 1 for SSE2, 2 for AVX2, 3 for NEON). Meant for tests
+     * comparing the variants, which all produce the same pixels.
+     *
+     * @param level the SIMD level
+     * @return the level selected, the given one if the CPU supports it and
+     * 0 otherwise
+     */
+    public static int setSIMDLevel(int level) {
+        return setSIMDLevelImpl(level);
+    }
+
+    private static native int setSIMDLevelImpl(int level);
+
     public void fillLCDAlphaMask(byte[] mask, int x, int y, int width, int height, int offset, int stride)
     {
         if (mask == null) {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2009, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -244,7 +244,8 @@ public interface Graphics {
       PixelFormat format = PixelFormat.BYTE_BGRA_PRE;
       Texture tex = getResourceFactory().createTexture(
             format, Texture.Usage.STATIC, WrapMode.CLAMP_NOT_NEEDED, width, height);
-      ByteBuffer bb = ByteBuffer.wrap(glyphImage);
+      int offset = glyph.getPixelDataOffset();
+      ByteBuffer bb = ByteBuffer.wrap(glyphImage, offset, glyphImage.length - offset).slice();
       int scan = width * tex.getPixelFormat().getBytesPerPixelUnit();
       // format arg is the Buffer pixel format. Texture may not be created with the
       // same as requested (ie the software pipeline).
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2009, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -41,6 +41,7 @@ import com.sun.prism.impl.shape.MaskData;
 import com.sun.prism.paint.Color;
 
 import java.nio.ByteBuffer;
+import java.util.Arrays;
 import java.util.HashMap;
 import java.util.WeakHashMap;
 
@@ -133,6 +134,7 @@ public class GlyphCache {
         int len = gl.getGlyphCount();
         Color currentColor = null;
         Point2D pt = new Point2D();
+        boolean prepared = false;
 
         for (int gi = 0; gi < len; gi++) {
             int gc = gl.getGlyphCode(gi);
@@ -146,7 +148,14 @@ public class GlyphCache {
             pt.setLocation(x + gl.getPosX(gi), y + gl.getPosY(gi));
             xform.transform(pt, pt);
             int subPixel = strike.getQuantizedPosition(pt);
-            GlyphData data = getCachedGlyph(gc, subPixel);
+            GlyphData data = lookupGlyph(gc, subPixel);
+            if (data == null) {
+                if (!prepared) {
+                    prepareGlyphs(gl, gi, len);
+                    prepared = true;
+                }
+                data = getCachedGlyph(gc, subPixel);
+            }
             if (data != null) {
                 if (clip != null) {
                     // Always check clipping using user space.
@@ -238,6 +247,47 @@ public class GlyphCache {
         packer.clear();
     }
 
+    private GlyphData lookupGlyph(int glyphCode, int subPixel) {
+        int segIndex = glyphCode >>> SEGSHIFT;
+        int subIndex = glyphCode & SEGMASK;
+        segIndex |= (subPixel << SUBPIXEL_SHIFT);
+        GlyphData[] segment = glyphDataMap.get(segIndex);
+        return segment != null ? segment[subIndex] : null;
+    }
+
+    /* On the first cache miss of a glyph list, hand the remaining glyphs
+     * which are not cached yet to the strike, so it can rasterize them
+     * together instead of one at a time. Only the first sub pixel position
+     * is checked, glyphs cached at other positions are merely prepared again.
+     * Text repeats glyphs, so the codes are sorted and each is passed once.
+     */
+    private void prepareGlyphs(GlyphList gl, int start, int len) {
+        int[] glyphCodes = new int[len - start];
+        int count = 0;
+        for (int gi = start; gi < len; gi++) {
+            int gc = gl.getGlyphCode(gi);
+            if ((gc & CompositeGlyphMapper.GLYPHMASK) == CharToGlyphMapper.INVISIBLE_GLYPH_ID) {
+                continue;
+            }
+            if (lookupGlyph(gc, 0) == null) {
+                glyphCodes[count++] = gc;
+            }
+        }
+        if (count < 2) {
+            return;
+        }
+        Arrays.sort(glyphCodes, 0, count);
+        int unique = 1;
+        for (int i = 1; i < count; i++) {
+            if (glyphCodes[i] != glyphCodes[unique - 1]) {
+                glyphCodes[unique++] = glyphCodes[i];
+            }
+        }
+        if (unique > 1) {
+            strike.prepareGlyphs(glyphCodes, unique);
+        }
+    }
+
     private GlyphData getCachedGlyph(int glyphCode, int subPixel) {
         int segIndex = glyphCode >>> SEGSHIFT;
         int subIndex = glyphCode & SEGMASK;
@@ -268,6 +318,7 @@ public class GlyphCache {
                 // in the glyph, even as an opaque type, it should save
                 // repeated work next time the glyph is used.
                 MaskData maskData = MaskData.create(glyphImage,
+                                                    glyph.getPixelDataOffset(),
                                                     glyph.getOriginX(),
                                                     glyph.getOriginY(),
                                                     glyph.getWidth(),
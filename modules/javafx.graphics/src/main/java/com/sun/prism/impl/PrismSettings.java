@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -85,6 +85,8 @@ public final class PrismSettings {
     public static final boolean forceUploadingPainter;
     public static final boolean forceAlphaTestShader;
     public static final boolean forceNonAntialiasedShape;
+    public static final int swThreads;
+    public static final int swMinBandSize;
 
     public static enum RasterizerType {
         DoubleMarlin("Double Precision Marlin Rasterizer");
@@ -355,6 +357,16 @@ public final class PrismSettings {
         // Force non anti-aliasing (not smooth) shape rendering
         forceNonAntialiasedShape = getBoolean(systemProperties, "prism.forceNonAntialiasedShape", false);
 
+        /*
+         * Number of threads the software pipeline may use to rasterize the
+         * rows of a large fill in parallel ("true" uses all processors), and
+         * the minimum number of pixels per thread.
+         */
+        swThreads = getInt(systemProperties, "prism.sw.threads", 1,
+                Runtime.getRuntime().availableProcessors(),
+                "Try -Dprism.sw.threads=[true|<number>]");
+        swMinBandSize = getInt(systemProperties, "prism.sw.minBandSize", 128 * 128,
+                "Try -Dprism.sw.minBandSize=<number>");
     }
 
     private static int parseInt(String s, int dflt, int trueDflt,
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2009, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -81,9 +81,17 @@ public class MaskData {
     public static MaskData create(byte[] pixels,
                                   int originX, int originY,
                                   int width, int height)
+    {
+        return create(pixels, 0, originX, originY, width, height);
+    }
+
+    public static MaskData create(byte[] pixels, int offset,
+                                  int originX, int originY,
+                                  int width, int height)
     {
         MaskData maskData = new MaskData();
-        maskData.update(ByteBuffer.wrap(pixels), originX, originY, width, height);
+        ByteBuffer maskBuffer = ByteBuffer.wrap(pixels, offset, pixels.length - offset).slice();
+        maskData.update(maskBuffer, originX, originY, width, height);
         return maskData;
     }
 }
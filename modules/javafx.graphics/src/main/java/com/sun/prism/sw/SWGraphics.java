@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -708,11 +708,11 @@ final class SWGraphics implements ReadbackGraphics {
                 if (g.isLCDGlyph()) {
                     this.pr.fillLCDAlphaMask(pixelData, intPosX, intPosY,
                             g.getWidth(), g.getHeight(),
-                            0, g.getWidth());
+                            g.getPixelDataOffset(), g.getWidth());
                 } else {
                     this.pr.fillAlphaMask(pixelData, intPosX, intPosY,
                             g.getWidth(), g.getHeight(),
-                            0, g.getWidth());
+                            g.getPixelDataOffset(), g.getWidth());
                 }
             }
         } else {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -27,8 +27,10 @@ package com.sun.prism.sw;
 
 import com.sun.glass.ui.Screen;
 import com.sun.glass.utils.NativeLibLoader;
+import com.sun.pisces.PiscesRenderer;
 import com.sun.prism.GraphicsPipeline;
 import com.sun.prism.ResourceFactory;
+import com.sun.prism.impl.PrismSettings;
 
 import java.security.AccessController;
 import java.security.PrivilegedAction;
@@ -43,6 +45,7 @@ public final class SWPipeline extends GraphicsPipeline {
             NativeLibLoader.loadLibrary("prism_sw");
             return null;
         });
+        PiscesRenderer.setThreading(PrismSettings.swThreads, PrismSettings.swMinBandSize);
     }
 
     @Override public boolean init() {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2008, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2008, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -34,14 +34,41 @@ import com.sun.scenario.effect.impl.sw.RendererDelegate;
 
 public class SSERendererDelegate implements RendererDelegate {
 
+    /**
+     * The maximum number of threads, including the calling thread, that
+     * work on one pass of an effect. Defaults to 1, which keeps all effects
+     * on the calling thread, until a speedup has been measured on the
+     * supported platforms; set decora.sse.threads to enable threading.
+     */
+    private static final int MAX_THREADS;
+
+    /**
+     * The minimum number of destination pixels handed to one thread.
+     * Passes smaller than two bands of this size run on the calling
+     * thread.
+     */
+    private static final int MIN_BAND_SIZE;
+
     public static native boolean isSupported();
 
+    private static native void initThreading(int maxThreads, int minBandSize);
+
     static {
         @SuppressWarnings("removal")
         var dummy = AccessController.doPrivileged((PrivilegedAction) () -> {
             NativeLibLoader.loadLibrary("decora_sse");
             return null;
         });
+
+        @SuppressWarnings("removal")
+        int threads = AccessController.doPrivileged(
+                (PrivilegedAction<Integer>) () -> Integer.getInteger("decora.sse.threads", 1));
+        @SuppressWarnings("removal")
+        int bandSize = AccessController.doPrivileged(
+                (PrivilegedAction<Integer>) () -> Integer.getInteger("decora.sse.minBandSize", 128 * 128));
+        MAX_THREADS = Math.max(1, threads);
+        MIN_BAND_SIZE = Math.max(1, bandSize);
+        initThreading(MAX_THREADS, MIN_BAND_SIZE);
     }
 
     public SSERendererDelegate() {
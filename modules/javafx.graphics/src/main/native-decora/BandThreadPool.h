@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef BAND_THREAD_POOL_H
+#define BAND_THREAD_POOL_H
+
+/*
+ * The native worker pool of the Decora SSE peers, included from
+ * SSEThreadPool.cc only. It is a copy of native-prism-sw/BandThreadPool.h,
+ * the pool of the Pisces software renderer, which is built from its own
+ * source directory; change both together.
+ *
+ * The workers run contiguous bands of rows of one operation and never
+ * call into the JVM, so they may run while the caller holds critical
+ * arrays.
+ */
+
+#include <jni.h>
+
+#ifdef WIN32
+#include <windows.h>
+#include <process.h>
+#else
+#include <pthread.h>
+#endif
+
+#define BAND_POOL_MAX_THREADS 64
+#define BAND_POOL_DEFAULT_MIN_BAND_SIZE (128 * 128)
+
+#ifdef WIN32
+typedef CRITICAL_SECTION BandPoolMutex;
+typedef CONDITION_VARIABLE BandPoolCond;
+#define bandPoolMutexInit(m)      InitializeCriticalSection(m)
+#define bandPoolMutexLock(m)      EnterCriticalSection(m)
+#define bandPoolMutexUnlock(m)    LeaveCriticalSection(m)
+#define bandPoolCondInit(c)       InitializeConditionVariable(c)
+#define bandPoolCondWait(c, m)    SleepConditionVariableCS(c, m, INFINITE)
+#define bandPoolCondSignal(c)     WakeConditionVariable(c)
+#define bandPoolCondBroadcast(c)  WakeAllConditionVariable(c)
+#else
+typedef pthread_mutex_t BandPoolMutex;
+typedef pthread_cond_t BandPoolCond;
+#define bandPoolMutexInit(m)      pthread_mutex_init(m, NULL)
+#define bandPoolMutexLock(m)      pthread_mutex_lock(m)
+#define bandPoolMutexUnlock(m)    pthread_mutex_unlock(m)
+#define bandPoolCondInit(c)       pthread_cond_init(c, NULL)
+#define bandPoolCondWait(c, m)    pthread_cond_wait(c, m)
+#define bandPoolCondSignal(c)     pthread_cond_signal(c)
+#define bandPoolCondBroadcast(c)  pthread_cond_broadcast(c)
+#endif
+
+typedef void (*BandPoolFunc)(void *data, jint start, jint end);
+
+/*
+ * The operation currently being run. All fields are guarded by lock; the
+ * workers wait on workCond for generation to change and the caller
+ * waits on doneCond for doneBands to reach bands.
+ */
+static struct {
+    BandPoolMutex lock;
+    BandPoolCond workCond;
+    BandPoolCond doneCond;
+    int initialized;
+    int busy;
+    jint workers;
+    unsigned int generation;
+    BandPoolFunc func;
+    void *data;
+    jint lines;
+    jint bands;
+    jint nextBand;
+    jint doneBands;
+} bandPool;
+
+static jint bandPoolMaxThreads = 1;
+static jint bandPoolMinBandSize = BAND_POOL_DEFAULT_MIN_BAND_SIZE;
+
+/*
+ * Runs the bands of the current operation that nobody has claimed yet.
+ * Called and returns with the lock held.
+ */
+static void
+bandPoolRunPending(void) {
+    while (bandPool.nextBand < bandPool.bands) {
+        jint band = bandPool.nextBand++;
+        BandPoolFunc func = bandPool.func;
+        void *data = bandPool.data;
+        jint start = (jint)(((jlong)bandPool.lines * band) / bandPool.bands);
+        jint end = (jint)(((jlong)bandPool.lines * (band + 1)) / bandPool.bands);
+        bandPoolMutexUnlock(&bandPool.lock);
+        func(data, start, end);
+        bandPoolMutexLock(&bandPool.lock);
+        if (++bandPool.doneBands == bandPool.bands) {
+            bandPoolCondSignal(&bandPool.doneCond);
+        }
+    }
+}
+
+static void
+bandPoolWorkerLoop(void) {
+    unsigned int seen;
+    bandPoolMutexLock(&bandPool.lock);
+    seen = bandPool.generation;
+    for (;;) {
+        while (bandPool.generation == seen) {
+            bandPoolCondWait(&bandPool.workCond, &bandPool.lock);
+        }
+        seen = bandPool.generation;
+        bandPoolRunPending();
+    }
+}
+
+#ifdef WIN32
+static unsigned __stdcall
+bandPoolWorkerMain(void *arg) {
+    (void)arg;
+    bandPoolWorkerLoop();
+    return 0;
+}
+
+static int
+bandPoolStartWorker(void) {
+    HANDLE thread = (HANDLE)_beginthreadex(NULL, 0, bandPoolWorkerMain, NULL, 0, NULL);
+    if (thread == 0) {
+        return 0;
+    }
+    CloseHandle(thread);
+    return 1;
+}
+#else
+static void *
+bandPoolWorkerMain(void *arg) {
+    (void)arg;
+    bandPoolWorkerLoop();
+    return NULL;
+}
+
+static int
+bandPoolStartWorker(void) {
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, bandPoolWorkerMain, NULL) != 0) {
+        return 0;
+    }
+    pthread_detach(thread);
+    return 1;
+}
+#endif
+
+/*
+ * Sets the maximum number of threads working on one operation (including
+ * the calling thread) and the minimum number of pixels per band.
+ */
+static void
+bandPoolSetThreading(jint threads, jint bandSize) {
+    if (!bandPool.initialized) {
+        bandPoolMutexInit(&bandPool.lock);
+        bandPoolCondInit(&bandPool.workCond);
+        bandPoolCondInit(&bandPool.doneCond);
+        bandPool.initialized = 1;
+    }
+    bandPoolMaxThreads = (threads < 1) ? 1
+            : ((threads > BAND_POOL_MAX_THREADS) ? BAND_POOL_MAX_THREADS : threads);
+    bandPoolMinBandSize = (bandSize < 1) ? 1 : bandSize;
+}
+
+/*
+ * Splits [0, lines) into contiguous bands of at least the minimum band
+ * size, given lineSize pixels per line, and calls func once per band.
+ * Returns after all bands have completed. If the pool is already busy
+ * with an operation from another thread, all bands run on the calling
+ * thread.
+ */
+static void
+bandPoolRun(jint lines, jint lineSize, BandPoolFunc func, void *data) {
+    jlong bands = ((jlong)lines * lineSize) / bandPoolMinBandSize;
+    if (bands > bandPoolMaxThreads) {
+        bands = bandPoolMaxThreads;
+    }
+    if (bands > lines) {
+        bands = lines;
+    }
+    if (bands <= 1 || !bandPool.initialized) {
+        func(data, 0, lines);
+        return;
+    }
+
+    bandPoolMutexLock(&bandPool.lock);
+    // Operations from a second rendering thread do not queue behind this one.
+    if (bandPool.busy) {
+        bandPoolMutexUnlock(&bandPool.lock);
+        func(data, 0, lines);
+        return;
+    }
+    while (bandPool.workers < bands - 1 && bandPoolStartWorker()) {
+        bandPool.workers++;
+    }
+    if (bands > bandPool.workers + 1) {
+        bands = bandPool.workers + 1;
+    }
+    bandPool.busy = 1;
+    bandPool.func = func;
+    bandPool.data = data;
+    bandPool.lines = lines;
+    bandPool.bands = (jint)bands;
+    bandPool.nextBand = 0;
+    bandPool.doneBands = 0;
+    bandPool.generation++;
+    bandPoolCondBroadcast(&bandPool.workCond);
+
+    bandPoolRunPending();
+    while (bandPool.doneBands < bandPool.bands) {
+        bandPoolCondWait(&bandPool.doneCond, &bandPool.lock);
+    }
+    bandPool.busy = 0;
+    bandPoolMutexUnlock(&bandPool.lock);
+}
+
+#endif
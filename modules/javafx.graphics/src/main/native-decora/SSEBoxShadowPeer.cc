@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2009, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -30,6 +30,7 @@
 
 #include <jni.h>
 #include "SSEUtils.h"
+#include "SSEKernels.h"
 #include "com_sun_scenario_effect_impl_sw_sse_SSEBoxShadowPeer.h"
 
 JNIEXPORT void JNICALL
@@ -54,33 +55,8 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSEBoxShadowPeer_filterHorizontalBlack
         return;
     }
 
-    jint hsize = dstw - srcw + 1;
-    // amax goes from hsize*255 to 255 as spread goes from 0 to 1
-    jint amax = hsize * 255;
-    amax += (jint) ((255 - amax) * spread);
-    jint kscale = 0x7fffffff / amax;
-    jint amin = (amax / 255);
-    jint srcoff = 0;
-    jint dstoff = 0;
-    for (jint y = 0; y < dsth; y++) {
-        jint suma = 0;
-        for (jint x = 0; x < dstw; x++) {
-            jint rgb;
-            // Un-accumulate the data for col-hsize location into the sums.
-            rgb = (x >= hsize) ? srcPixels[srcoff + x - hsize] : 0;
-            suma -= (rgb >> 24) & 0xff;
-            // Accumulate the data for this col location into the sums.
-            rgb = (x < srcw) ? srcPixels[srcoff + x] : 0;
-            suma += (rgb >> 24) & 0xff;
-            // Clamp, scale and convert the sum into a color.
-            dstPixels[dstoff + x] =
-                ((suma < amin) ? 0
-                 : ((suma >= amax) ? 0xff000000
-                    : (((suma * kscale) >> 23) << 24)));
-        }
-        srcoff += srcscan;
-        dstoff += dstscan;
-    }
+    boxShadowHorizontalBlack(dstPixels, dstw, dsth, dstscan,
+                             srcPixels, srcw, srch, srcscan, spread);
 
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
@@ -108,34 +84,8 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSEBoxShadowPeer_filterVerticalBlack
         return;
     }
 
-    jint vsize = dsth - srch + 1;
-    // amax goes from hsize*255 to 255 as spread goes from 0 to 1
-    jint amax = vsize * 255;
-    amax += (jint) ((255 - amax) * spread);
-    jint kscale = 0x7fffffff / amax;
-    jint amin = (amax / 255);
-    jint voff = vsize * srcscan;
-    for (jint x = 0; x < dstw; x++) {
-        jint suma = 0;
-        jint srcoff = x;
-        jint dstoff = x;
-        for (jint y = 0; y < dsth; y++) {
-            jint rgb;
-            // Un-accumulate the data for row-vsize location into the sums.
-            rgb = (srcoff >= voff) ? srcPixels[srcoff - voff] : 0;
-            suma -= (rgb >> 24) & 0xff;
-            // Accumulate the data for this row location into the sums.
-            rgb = (y < srch) ? srcPixels[srcoff] : 0;
-            suma += (rgb >> 24) & 0xff;
-            // Clamp, scale and convert the sum into a color.
-            dstPixels[dstoff] =
-                ((suma < amin) ? 0
-                 : ((suma >= amax) ? 0xff000000
-                    : (((suma * kscale) >> 23) << 24)));
-            srcoff += srcscan;
-            dstoff += dstscan;
-        }
-    }
+    boxShadowVerticalBlack(dstPixels, dstw, dsth, dstscan,
+                           srcPixels, srcw, srch, srcscan, spread);
 
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
@@ -166,46 +116,8 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSEBoxShadowPeer_filterVertical
         return;
     }
 
-    jint vsize = dsth - srch + 1;
-    // amax goes from hsize*255 to 255 as spread goes from 0 to 1
-    jint amax = vsize * 255;
-    amax += (jint) ((255 - amax) * spread);
-    jint kscalea = 0x7fffffff / amax;
-    jint kscaler = (jint) (kscalea * shadowColor[0]);
-    jint kscaleg = (jint) (kscalea * shadowColor[1]);
-    jint kscaleb = (jint) (kscalea * shadowColor[2]);
-    kscalea = (jint) (kscalea * shadowColor[3]);
-    jint amin = (amax / 255);
-    jint voff = vsize * srcscan;
-    jint shadowRGB =
-        (((jint) (shadowColor[0] * 255)) << 16) |
-        (((jint) (shadowColor[1] * 255)) <<  8) |
-        (((jint) (shadowColor[2] * 255))      ) |
-        (((jint) (shadowColor[3] * 255)) << 24);
-    for (jint x = 0; x < dstw; x++) {
-        jint suma = 0;
-        jint srcoff = x;
-        jint dstoff = x;
-        for (jint y = 0; y < dsth; y++) {
-            jint rgb;
-            // Un-accumulate the data for row-vsize location into the sums.
-            rgb = (srcoff >= voff) ? srcPixels[srcoff - voff] : 0;
-            suma -= (rgb >> 24) & 0xff;
-            // Accumulate the data for this row location into the sums.
-            rgb = (y < srch) ? srcPixels[srcoff] : 0;
-            suma += (rgb >> 24) & 0xff;
-            // Clamp, scale and convert the sum into a color.
-            dstPixels[dstoff] =
-                ((suma < amin) ? 0
-                 : ((suma >= amax) ? shadowRGB
-                    : ((((suma * kscalea) >> 23) << 24) |
-                       (((suma * kscaler) >> 23) << 16) |
-                       (((suma * kscaleg) >> 23) <<  8) |
-                       (((suma * kscaleb) >> 23)      ))));
-            srcoff += srcscan;
-            dstoff += dstscan;
-        }
-    }
+    boxShadowVertical(dstPixels, dstw, dsth, dstscan,
+                      srcPixels, srcw, srch, srcscan, spread, shadowColor);
 
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
@@ -0,0 +1,1355 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <stddef.h>
+#include "SSEKernels.h"
+#include "SSEThreadPool.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define DECORA_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#ifdef DECORA_X86
+#if defined(__GNUC__) || defined(__clang__)
+#define DECORA_TARGET_SSE2 __attribute__((target("sse2")))
+#define DECORA_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DECORA_TARGET_SSE2
+#define DECORA_TARGET_AVX2
+#endif
+#endif /* DECORA_X86 */
+
+/*
+ * Number of columns processed together by the vertical box passes, so
+ * that the running sums of a block stay in registers or in L1 while the
+ * block is walked from top to bottom.
+ */
+#define COLUMN_BLOCK 64
+
+#define cmin 1.0f
+#define cmax (255.0f - 1.0f/32.0f)
+
+static int detectSIMDLevel()
+{
+#ifdef DECORA_X86
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    if ((info[3] & (1 << 26)) == 0) {
+        return DECORA_SIMD_NONE;
+    }
+    // AVX2 also needs the OS to save the YMM registers (OSXSAVE + XCR0).
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        if ((info[1] & (1 << 5)) != 0) {
+            return DECORA_SIMD_AVX2;
+        }
+    }
+    return DECORA_SIMD_SSE2;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return DECORA_SIMD_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return DECORA_SIMD_SSE2;
+    }
+    return DECORA_SIMD_NONE;
+#endif
+#else
+    return DECORA_SIMD_NONE;
+#endif /* DECORA_X86 */
+}
+
+// Benign race: every thread computes the same value.
+static int simdLevel = -1;
+
+int getDecoraSIMDLevel()
+{
+    if (simdLevel < 0) {
+        simdLevel = detectSIMDLevel();
+    }
+    return simdLevel;
+}
+
+int setDecoraSIMDLevel(int level)
+{
+    int supported = detectSIMDLevel();
+    simdLevel = (level < supported) ? level : supported;
+    return simdLevel;
+}
+
+/*
+ * Parameters shared by the box shadow passes.
+ */
+struct ShadowParams {
+    jint amin;
+    jint amax;
+    jint kscalea;
+    jint kscaler;
+    jint kscaleg;
+    jint kscaleb;
+    jint shadowRGB;
+};
+
+static void initShadowParams(ShadowParams *p, jint ksize, jfloat spread,
+                             const jfloat *shadowColor)
+{
+    // amax goes from ksize*255 to 255 as spread goes from 0 to 1
+    jint amax = ksize * 255;
+    amax += (jint) ((255 - amax) * spread);
+    jint kscale = 0x7fffffff / amax;
+    p->amax = amax;
+    p->amin = (amax / 255);
+    if (shadowColor == NULL) {
+        p->kscalea = kscale;
+        p->kscaler = p->kscaleg = p->kscaleb = 0;
+        p->shadowRGB = 0xff000000;
+    } else {
+        p->kscaler = (jint) (kscale * shadowColor[0]);
+        p->kscaleg = (jint) (kscale * shadowColor[1]);
+        p->kscaleb = (jint) (kscale * shadowColor[2]);
+        p->kscalea = (jint) (kscale * shadowColor[3]);
+        p->shadowRGB =
+            (((jint) (shadowColor[0] * 255)) << 16) |
+            (((jint) (shadowColor[1] * 255)) <<  8) |
+            (((jint) (shadowColor[2] * 255))      ) |
+            (((jint) (shadowColor[3] * 255)) << 24);
+    }
+}
+
+static inline jint shadowBlack(jint suma, const ShadowParams *p)
+{
+    return ((suma < p->amin) ? 0
+            : ((suma >= p->amax) ? 0xff000000
+               : (((suma * p->kscalea) >> 23) << 24)));
+}
+
+static inline jint shadowColored(jint suma, const ShadowParams *p)
+{
+    return ((suma < p->amin) ? 0
+            : ((suma >= p->amax) ? p->shadowRGB
+               : ((((suma * p->kscalea) >> 23) << 24) |
+                  (((suma * p->kscaler) >> 23) << 16) |
+                  (((suma * p->kscaleg) >> 23) <<  8) |
+                  (((suma * p->kscaleb) >> 23)      ))));
+}
+
+static inline jint convolveShadowPixel(jfloat sum, const jint *shadowRGBs)
+{
+    return ((sum < 0.0f) ? 0
+            : ((sum >= 254.0f) ? shadowRGBs[255]
+               : shadowRGBs[((jint) sum) + 1]));
+}
+
+/*
+ * Scalar variants, the reference for the SIMD ones.
+ */
+
+static void boxBlurHorizontalScalar(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                    const jint *srcPixels, jint srcw, jint srcscan)
+{
+    jint hsize = dstw - srcw + 1;
+    jint kscale = 0x7fffffff / (hsize * 255);
+    jint srcoff = 0;
+    jint dstoff = 0;
+    for (jint y = 0; y < dsth; y++) {
+        jint suma = 0;
+        jint sumr = 0;
+        jint sumg = 0;
+        jint sumb = 0;
+        for (jint x = 0; x < dstw; x++) {
+            jint rgb;
+            // Un-accumulate the data for col-hsize location into the sums.
+            rgb = (x >= hsize) ? srcPixels[srcoff + x - hsize] : 0;
+            suma -= (rgb >> 24) & 0xff;
+            sumr -= (rgb >> 16) & 0xff;
+            sumg -= (rgb >>  8) & 0xff;
+            sumb -= (rgb      ) & 0xff;
+            // Accumulate the data for this col location into the sums.
+            rgb = (x < srcw) ? srcPixels[srcoff + x] : 0;
+            suma += (rgb >> 24) & 0xff;
+            sumr += (rgb >> 16) & 0xff;
+            sumg += (rgb >>  8) & 0xff;
+            sumb += (rgb      ) & 0xff;
+            dstPixels[dstoff + x] =
+                (((suma * kscale) >> 23) << 24) +
+                (((sumr * kscale) >> 23) << 16) +
+                (((sumg * kscale) >> 23) <<  8) +
+                (((sumb * kscale) >> 23)      );
+        }
+        srcoff += srcscan;
+        dstoff += dstscan;
+    }
+}
+
+static void boxBlurVerticalScalar(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                  const jint *srcPixels, jint srch, jint srcscan)
+{
+    jint vsize = dsth - srch + 1;
+    jint kscale = 0x7fffffff / (vsize * 255);
+    jint voff = vsize * srcscan;
+    for (jint x = 0; x < dstw; x++) {
+        jint suma = 0;
+        jint sumr = 0;
+        jint sumg = 0;
+        jint sumb = 0;
+        jint srcoff = x;
+        jint dstoff = x;
+        for (jint y = 0; y < dsth; y++) {
+            jint rgb;
+            // Un-accumulate the data for row-vsize location into the sums.
+            rgb = (srcoff >= voff) ? srcPixels[srcoff - voff] : 0;
+            suma -= (rgb >> 24) & 0xff;
+            sumr -= (rgb >> 16) & 0xff;
+            sumg -= (rgb >>  8) & 0xff;
+            sumb -= (rgb      ) & 0xff;
+            // Accumulate the data for this col location into the sums.
+            rgb = (y < srch) ? srcPixels[srcoff] : 0;
+            suma += (rgb >> 24) & 0xff;
+            sumr += (rgb >> 16) & 0xff;
+            sumg += (rgb >>  8) & 0xff;
+            sumb += (rgb      ) & 0xff;
+            dstPixels[dstoff] =
+                (((suma * kscale) >> 23) << 24) +
+                (((sumr * kscale) >> 23) << 16) +
+                (((sumg * kscale) >> 23) <<  8) +
+                (((sumb * kscale) >> 23)      );
+            srcoff += srcscan;
+            dstoff += dstscan;
+        }
+    }
+}
+
+static void boxShadowHorizontalScalar(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                      const jint *srcPixels, jint srcw, jint srcscan,
+                                      const ShadowParams *p)
+{
+    jint hsize = dstw - srcw + 1;
+    jint srcoff = 0;
+    jint dstoff = 0;
+    for (jint y = 0; y < dsth; y++) {
+        jint suma = 0;
+        for (jint x = 0; x < dstw; x++) {
+            jint rgb;
+            // Un-accumulate the data for col-hsize location into the sums.
+            rgb = (x >= hsize) ? srcPixels[srcoff + x - hsize] : 0;
+            suma -= (rgb >> 24) & 0xff;
+            // Accumulate the data for this col location into the sums.
+            rgb = (x < srcw) ? srcPixels[srcoff + x] : 0;
+            suma += (rgb >> 24) & 0xff;
+            // Clamp, scale and convert the sum into a color.
+            dstPixels[dstoff + x] = shadowBlack(suma, p);
+        }
+        srcoff += srcscan;
+        dstoff += dstscan;
+    }
+}
+
+static void boxShadowVerticalScalar(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                    const jint *srcPixels, jint srch, jint srcscan,
+                                    const ShadowParams *p, bool colored)
+{
+    jint vsize = dsth - srch + 1;
+    jint voff = vsize * srcscan;
+    for (jint x = 0; x < dstw; x++) {
+        jint suma = 0;
+        jint srcoff = x;
+        jint dstoff = x;
+        for (jint y = 0; y < dsth; y++) {
+            jint rgb;
+            // Un-accumulate the data for row-vsize location into the sums.
+            rgb = (srcoff >= voff) ? srcPixels[srcoff - voff] : 0;
+            suma -= (rgb >> 24) & 0xff;
+            // Accumulate the data for this row location into the sums.
+            rgb = (y < srch) ? srcPixels[srcoff] : 0;
+            suma += (rgb >> 24) & 0xff;
+            // Clamp, scale and convert the sum into a color.
+            dstPixels[dstoff] = colored ? shadowColored(suma, p) : shadowBlack(suma, p);
+            srcoff += srcscan;
+            dstoff += dstscan;
+        }
+    }
+}
+
+static void linearConvolveHVScalar(jint *dstPixels, jint dstcols, jint dstrows,
+                                   jint dcolinc, jint drowinc,
+                                   const jint *srcPixels, jint srccols,
+                                   jint scolinc, jint srowinc,
+                                   const jfloat *kvals, jint kernelSize)
+{
+    // cvals stores the component values from the surrounding K pixels
+    // from x-r to x+r
+    jfloat cvals[128*4];
+    jint dstrow = 0;
+    jint srcrow = 0;
+    for (jint r = 0; r < dstrows; r++) {
+        jint dstoff = dstrow;
+        jint srcoff = srcrow;
+        // Must clear out the array at the start of every line
+        for (jint i = 0; i < kernelSize*4; i++) {
+            cvals[i] = 0.0f;
+        }
+        jint koff = kernelSize;
+        for (jint c = 0; c < dstcols; c++) {
+            // Load the data for this x location into the array.
+            jint i = (kernelSize - koff) * 4;
+            jint rgb = (c < srccols) ? srcPixels[srcoff] : 0;
+            cvals[i+0] = (jfloat) ((rgb >> 24) & 0xff);
+            cvals[i+1] = (jfloat) ((rgb >> 16) & 0xff);
+            cvals[i+2] = (jfloat) ((rgb >>  8) & 0xff);
+            cvals[i+3] = (jfloat) ((rgb      ) & 0xff);
+            // Bump the koff to the next spot to align the coefficients.
+            if (--koff <= 0) {
+                koff += kernelSize;
+            }
+            jfloat suma = 0.0f;
+            jfloat sumr = 0.0f;
+            jfloat sumg = 0.0f;
+            jfloat sumb = 0.0f;
+            for (i = 0; i < kernelSize*4; i += 4) {
+                jfloat factor = kvals[koff + (i>>2)];
+                suma += cvals[i+0] * factor;
+                sumr += cvals[i+1] * factor;
+                sumg += cvals[i+2] * factor;
+                sumb += cvals[i+3] * factor;
+            }
+            dstPixels[dstoff] =
+                (((suma < cmin) ? 0 : ((suma > cmax) ? 255 : ((jint) suma))) << 24) +
+                (((sumr < cmin) ? 0 : ((sumr > cmax) ? 255 : ((jint) sumr))) << 16) +
+                (((sumg < cmin) ? 0 : ((sumg > cmax) ? 255 : ((jint) sumg))) <<  8) +
+                (((sumb < cmin) ? 0 : ((sumb > cmax) ? 255 : ((jint) sumb)))      );
+            dstoff += dcolinc;
+            srcoff += scolinc;
+        }
+        dstrow += drowinc;
+        srcrow += srowinc;
+    }
+}
+
+static void linearConvolveShadowHVScalar(jint *dstPixels, jint dstcols, jint dstrows,
+                                         jint dcolinc, jint drowinc,
+                                         const jint *srcPixels, jint srccols,
+                                         jint scolinc, jint srowinc,
+                                         const jfloat *kvals, jint kernelSize,
+                                         const jint *shadowRGBs)
+{
+    // avals stores the alpha values from the surrounding K pixels
+    // from x-r to x+r
+    jfloat avals[128];
+    jint dstrow = 0;
+    jint srcrow = 0;
+    for (jint r = 0; r < dstrows; r++) {
+        jint dstoff = dstrow;
+        jint srcoff = srcrow;
+        // Must clear out the array at the start of every line
+        for (jint i = 0; i < kernelSize; i++) {
+            avals[i] = 0.0f;
+        }
+        jint koff = kernelSize;
+        for (jint c = 0; c < dstcols; c++) {
+            // Load the data for this x location into the array.
+            jint rgb = (c < srccols) ? srcPixels[srcoff] : 0;
+            avals[kernelSize - koff] = (jfloat) ((rgb >> 24) & 0xff);
+            // Bump the koff to the next spot to align the coefficients.
+            if (--koff <= 0) {
+                koff += kernelSize;
+            }
+            jfloat sum = -0.5f;
+            for (jint i = 0; i < kernelSize; i++) {
+                sum += avals[i] * kvals[koff + i];
+            }
+            dstPixels[dstoff] = convolveShadowPixel(sum, shadowRGBs);
+            dstoff += dcolinc;
+            srcoff += scolinc;
+        }
+        dstrow += drowinc;
+        srcrow += srowinc;
+    }
+}
+
+#ifdef DECORA_X86
+
+/*
+ * SSE2 variants. A pixel is held as four 32-bit lanes in memory byte
+ * order (b, g, r, a); the channels never interact so the lane order does
+ * not matter as long as the pixel is packed back the same way.
+ */
+
+DECORA_TARGET_SSE2 static inline __m128i loadPixel(jint rgb)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i v = _mm_unpacklo_epi8(_mm_cvtsi32_si128(rgb), zero);
+    return _mm_unpacklo_epi16(v, zero);
+}
+
+DECORA_TARGET_SSE2 static inline jint storePixel(__m128i v)
+{
+    v = _mm_packs_epi32(v, v);
+    return _mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+}
+
+// _mm_mullo_epi32 needs SSE4.1, build it from two 32x32->64 multiplies.
+DECORA_TARGET_SSE2 static inline __m128i mullo(__m128i a, __m128i b)
+{
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// ((sum * kscale) >> 23) for sums that cannot overflow the product.
+DECORA_TARGET_SSE2 static inline __m128i scaleSum(__m128i sum, __m128i kscale)
+{
+    return _mm_srli_epi32(mullo(sum, kscale), 23);
+}
+
+/*
+ * Per-lane shadowBlack()/shadowColored(). Lanes with suma >= amax may
+ * overflow the products, but they are replaced by the saturated color.
+ */
+DECORA_TARGET_SSE2 static inline __m128i clampShadow(__m128i suma, __m128i v,
+                                                     const ShadowParams *p)
+{
+    __m128i lt = _mm_cmplt_epi32(suma, _mm_set1_epi32(p->amin));
+    __m128i ge = _mm_cmpgt_epi32(suma, _mm_set1_epi32(p->amax - 1));
+    v = _mm_andnot_si128(_mm_or_si128(lt, ge), v);
+    return _mm_or_si128(v, _mm_and_si128(ge, _mm_set1_epi32(p->shadowRGB)));
+}
+
+DECORA_TARGET_SSE2 static inline __m128i shadowBlackSSE2(__m128i suma, const ShadowParams *p)
+{
+    __m128i v = _mm_slli_epi32(scaleSum(suma, _mm_set1_epi32(p->kscalea)), 24);
+    return clampShadow(suma, v, p);
+}
+
+DECORA_TARGET_SSE2 static inline __m128i shadowColoredSSE2(__m128i suma, const ShadowParams *p)
+{
+    __m128i v = _mm_slli_epi32(scaleSum(suma, _mm_set1_epi32(p->kscalea)), 24);
+    v = _mm_or_si128(v, _mm_slli_epi32(scaleSum(suma, _mm_set1_epi32(p->kscaler)), 16));
+    v = _mm_or_si128(v, _mm_slli_epi32(scaleSum(suma, _mm_set1_epi32(p->kscaleg)), 8));
+    v = _mm_or_si128(v, scaleSum(suma, _mm_set1_epi32(p->kscaleb)));
+    return clampShadow(suma, v, p);
+}
+
+// The alpha bytes of four pixels as 32-bit lanes.
+DECORA_TARGET_SSE2 static inline __m128i loadAlphas(const jint *pixels)
+{
+    return _mm_srli_epi32(_mm_loadu_si128((const __m128i *) pixels), 24);
+}
+
+// Per-lane fvaltobyte() of the convolve peer.
+DECORA_TARGET_SSE2 static inline __m128i clampComponents(__m128 sum)
+{
+    __m128i v = _mm_cvttps_epi32(sum);
+    __m128 lt = _mm_cmplt_ps(sum, _mm_set1_ps(cmin));
+    __m128i gt = _mm_castps_si128(_mm_cmpgt_ps(sum, _mm_set1_ps(cmax)));
+    v = _mm_andnot_si128(_mm_or_si128(_mm_castps_si128(lt), gt), v);
+    return _mm_or_si128(v, _mm_and_si128(gt, _mm_set1_epi32(255)));
+}
+
+DECORA_TARGET_SSE2 static void boxBlurRowSSE2(jint *dst, const jint *src,
+                                              jint dstw, jint srcw, jint hsize,
+                                              __m128i kscale)
+{
+    __m128i sum = _mm_setzero_si128();
+    for (jint x = 0; x < dstw; x++) {
+        if (x >= hsize) {
+            sum = _mm_sub_epi32(sum, loadPixel(src[x - hsize]));
+        }
+        if (x < srcw) {
+            sum = _mm_add_epi32(sum, loadPixel(src[x]));
+        }
+        dst[x] = storePixel(scaleSum(sum, kscale));
+    }
+}
+
+DECORA_TARGET_SSE2 static void boxBlurHorizontalSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                                     const jint *srcPixels, jint srcw, jint srcscan)
+{
+    jint hsize = dstw - srcw + 1;
+    __m128i kscale = _mm_set1_epi32(0x7fffffff / (hsize * 255));
+    for (jint y = 0; y < dsth; y++) {
+        boxBlurRowSSE2(dstPixels + (ptrdiff_t) y * dstscan,
+                       srcPixels + (ptrdiff_t) y * srcscan,
+                       dstw, srcw, hsize, kscale);
+    }
+}
+
+/*
+ * The vertical passes walk the image row by row over blocks of
+ * COLUMN_BLOCK columns instead of column by column, which keeps the
+ * source reads sequential. Since x < srcscan, the scalar test
+ * srcoff >= voff is the same as y >= vsize.
+ */
+DECORA_TARGET_SSE2 static void boxBlurVerticalSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                                   const jint *srcPixels, jint srch, jint srcscan)
+{
+    jint vsize = dsth - srch + 1;
+    __m128i kscale = _mm_set1_epi32(0x7fffffff / (vsize * 255));
+    __m128i sums[COLUMN_BLOCK];
+    for (jint x0 = 0; x0 < dstw; x0 += COLUMN_BLOCK) {
+        jint bw = (dstw - x0 < COLUMN_BLOCK) ? dstw - x0 : COLUMN_BLOCK;
+        for (jint i = 0; i < bw; i++) {
+            sums[i] = _mm_setzero_si128();
+        }
+        for (jint y = 0; y < dsth; y++) {
+            const jint *out = (y >= vsize) ? srcPixels + (ptrdiff_t) (y - vsize) * srcscan + x0 : NULL;
+            const jint *in = (y < srch) ? srcPixels + (ptrdiff_t) y * srcscan + x0 : NULL;
+            jint *dst = dstPixels + (ptrdiff_t) y * dstscan + x0;
+            for (jint i = 0; i < bw; i++) {
+                __m128i sum = sums[i];
+                if (out != NULL) {
+                    sum = _mm_sub_epi32(sum, loadPixel(out[i]));
+                }
+                if (in != NULL) {
+                    sum = _mm_add_epi32(sum, loadPixel(in[i]));
+                }
+                sums[i] = sum;
+                dst[i] = storePixel(scaleSum(sum, kscale));
+            }
+        }
+    }
+}
+
+/*
+ * The horizontal shadow pass only carries one sum per row, so four rows
+ * are run side by side with one row per lane.
+ */
+DECORA_TARGET_SSE2 static void boxShadowHorizontalSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                                       const jint *srcPixels, jint srcw, jint srcscan,
+                                                       const ShadowParams *p)
+{
+    jint hsize = dstw - srcw + 1;
+    jint y = 0;
+    for (; y + 4 <= dsth; y += 4) {
+        const jint *s0 = srcPixels + (ptrdiff_t) y * srcscan;
+        const jint *s1 = s0 + srcscan;
+        const jint *s2 = s1 + srcscan;
+        const jint *s3 = s2 + srcscan;
+        jint *d0 = dstPixels + (ptrdiff_t) y * dstscan;
+        __m128i suma = _mm_setzero_si128();
+        for (jint x = 0; x < dstw; x++) {
+            if (x >= hsize) {
+                jint xo = x - hsize;
+                __m128i a = _mm_setr_epi32(s0[xo], s1[xo], s2[xo], s3[xo]);
+                suma = _mm_sub_epi32(suma, _mm_srli_epi32(a, 24));
+            }
+            if (x < srcw) {
+                __m128i a = _mm_setr_epi32(s0[x], s1[x], s2[x], s3[x]);
+                suma = _mm_add_epi32(suma, _mm_srli_epi32(a, 24));
+            }
+            jint out[4];
+            _mm_storeu_si128((__m128i *) out, shadowBlackSSE2(suma, p));
+            jint *d = d0 + x;
+            d[0] = out[0];
+            d += dstscan;
+            d[0] = out[1];
+            d += dstscan;
+            d[0] = out[2];
+            d += dstscan;
+            d[0] = out[3];
+        }
+    }
+    if (y < dsth) {
+        boxShadowHorizontalScalar(dstPixels + (ptrdiff_t) y * dstscan, dstw, dsth - y, dstscan,
+                                  srcPixels + (ptrdiff_t) y * srcscan, srcw, srcscan, p);
+    }
+}
+
+/*
+ * Four columns per lane group; the columns left over at the right edge
+ * of a block are handled with the scalar formula.
+ */
+DECORA_TARGET_SSE2 static void boxShadowVerticalSSE2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                                     const jint *srcPixels, jint srch, jint srcscan,
+                                                     const ShadowParams *p, bool colored)
+{
+    jint vsize = dsth - srch + 1;
+    __m128i sums[COLUMN_BLOCK / 4];
+    jint tailSums[3];
+    for (jint x0 = 0; x0 < dstw; x0 += COLUMN_BLOCK) {
+        jint bw = (dstw - x0 < COLUMN_BLOCK) ? dstw - x0 : COLUMN_BLOCK;
+        jint groups = bw / 4;
+        jint tail = bw - groups * 4;
+        for (jint i = 0; i < groups; i++) {
+            sums[i] = _mm_setzero_si128();
+        }
+        for (jint i = 0; i < tail; i++) {
+            tailSums[i] = 0;
+        }
+        for (jint y = 0; y < dsth; y++) {
+            const jint *out = (y >= vsize) ? srcPixels + (ptrdiff_t) (y - vsize) * srcscan + x0 : NULL;
+            const jint *in = (y < srch) ? srcPixels + (ptrdiff_t) y * srcscan + x0 : NULL;
+            jint *dst = dstPixels + (ptrdiff_t) y * dstscan + x0;
+            for (jint i = 0; i < groups; i++) {
+                __m128i suma = sums[i];
+                if (out != NULL) {
+                    suma = _mm_sub_epi32(suma, loadAlphas(out + i * 4));
+                }
+                if (in != NULL) {
+                    suma = _mm_add_epi32(suma, loadAlphas(in + i * 4));
+                }
+                sums[i] = suma;
+                __m128i v = colored ? shadowColoredSSE2(suma, p) : shadowBlackSSE2(suma, p);
+                _mm_storeu_si128((__m128i *) (dst + i * 4), v);
+            }
+            for (jint i = 0; i < tail; i++) {
+                jint x = groups * 4 + i;
+                jint suma = tailSums[i];
+                if (out != NULL) {
+                    suma -= (out[x] >> 24) & 0xff;
+                }
+                if (in != NULL) {
+                    suma += (in[x] >> 24) & 0xff;
+                }
+                tailSums[i] = suma;
+                dst[x] = colored ? shadowColored(suma, p) : shadowBlack(suma, p);
+            }
+        }
+    }
+}
+
+/*
+ * The four components of a pixel are convolved in the four lanes of a
+ * register. Each lane sees the same multiplies and adds, in the same
+ * order, as the scalar loop, so the results are bit-identical.
+ */
+DECORA_TARGET_SSE2 static void linearConvolveHVSSE2(jint *dstPixels, jint dstcols, jint dstrows,
+                                                    jint dcolinc, jint drowinc,
+                                                    const jint *srcPixels, jint srccols,
+                                                    jint scolinc, jint srowinc,
+                                                    const jfloat *kvals, jint kernelSize)
+{
+    __m128 cvals[128];
+    for (jint r = 0; r < dstrows; r++) {
+        jint *dst = dstPixels + (ptrdiff_t) r * drowinc;
+        const jint *src = srcPixels + (ptrdiff_t) r * srowinc;
+        for (jint i = 0; i < kernelSize; i++) {
+            cvals[i] = _mm_setzero_ps();
+        }
+        jint koff = kernelSize;
+        for (jint c = 0; c < dstcols; c++) {
+            jint rgb = (c < srccols) ? *src : 0;
+            cvals[kernelSize - koff] = _mm_cvtepi32_ps(loadPixel(rgb));
+            if (--koff <= 0) {
+                koff += kernelSize;
+            }
+            const jfloat *k = kvals + koff;
+            __m128 sum = _mm_setzero_ps();
+            for (jint i = 0; i < kernelSize; i++) {
+                sum = _mm_add_ps(sum, _mm_mul_ps(cvals[i], _mm_set1_ps(k[i])));
+            }
+            *dst = storePixel(clampComponents(sum));
+            dst += dcolinc;
+            src += scolinc;
+        }
+    }
+}
+
+/*
+ * Only alpha is convolved for shadows, so four rows are run side by
+ * side with one row per lane.
+ */
+DECORA_TARGET_SSE2 static void linearConvolveShadowHVSSE2(jint *dstPixels, jint dstcols, jint dstrows,
+                                                          jint dcolinc, jint drowinc,
+                                                          const jint *srcPixels, jint srccols,
+                                                          jint scolinc, jint srowinc,
+                                                          const jfloat *kvals, jint kernelSize,
+                                                          const jint *shadowRGBs)
+{
+    __m128 avals[128];
+    jint r = 0;
+    for (; r + 4 <= dstrows; r += 4) {
+        jint *dst = dstPixels + (ptrdiff_t) r * drowinc;
+        const jint *src = srcPixels + (ptrdiff_t) r * srowinc;
+        for (jint i = 0; i < kernelSize; i++) {
+            avals[i] = _mm_setzero_ps();
+        }
+        jint koff = kernelSize;
+        for (jint c = 0; c < dstcols; c++) {
+            __m128i rgb = _mm_setzero_si128();
+            if (c < srccols) {
+                rgb = _mm_setr_epi32(src[0], src[srowinc], src[2 * srowinc], src[3 * srowinc]);
+            }
+            avals[kernelSize - koff] = _mm_cvtepi32_ps(_mm_srli_epi32(rgb, 24));
+            if (--koff <= 0) {
+                koff += kernelSize;
+            }
+            const jfloat *k = kvals + koff;
+            __m128 sum = _mm_set1_ps(-0.5f);
+            for (jint i = 0; i < kernelSize; i++) {
+                sum = _mm_add_ps(sum, _mm_mul_ps(avals[i], _mm_set1_ps(k[i])));
+            }
+            jfloat sums[4];
+            _mm_storeu_ps(sums, sum);
+            dst[0] = convolveShadowPixel(sums[0], shadowRGBs);
+            dst[drowinc] = convolveShadowPixel(sums[1], shadowRGBs);
+            dst[2 * drowinc] = convolveShadowPixel(sums[2], shadowRGBs);
+            dst[3 * drowinc] = convolveShadowPixel(sums[3], shadowRGBs);
+            dst += dcolinc;
+            src += scolinc;
+        }
+    }
+    if (r < dstrows) {
+        linearConvolveShadowHVScalar(dstPixels + (ptrdiff_t) r * drowinc, dstcols, dstrows - r,
+                                     dcolinc, drowinc,
+                                     srcPixels + (ptrdiff_t) r * srowinc, srccols,
+                                     scolinc, srowinc, kvals, kernelSize, shadowRGBs);
+    }
+}
+
+/*
+ * AVX2 variants. They follow the SSE2 ones but carry two pixels (or
+ * eight rows or columns of alpha) per register.
+ */
+
+// Two pixels as eight 32-bit lanes, the first pixel in the low half.
+DECORA_TARGET_AVX2 static inline __m256i loadPixels2(jint rgb0, jint rgb1)
+{
+    return _mm256_cvtepu8_epi32(_mm_unpacklo_epi32(_mm_cvtsi32_si128(rgb0),
+                                                   _mm_cvtsi32_si128(rgb1)));
+}
+
+// Packs the lanes of loadPixels2() back into the low two ints.
+DECORA_TARGET_AVX2 static inline __m128i storePixels2(__m256i v)
+{
+    __m128i p = _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return _mm_packus_epi16(p, p);
+}
+
+DECORA_TARGET_AVX2 static inline __m256i scaleSum8(__m256i sum, __m256i kscale)
+{
+    return _mm256_srli_epi32(_mm256_mullo_epi32(sum, kscale), 23);
+}
+
+DECORA_TARGET_AVX2 static inline __m256i clampShadow8(__m256i suma, __m256i v,
+                                                      const ShadowParams *p)
+{
+    __m256i lt = _mm256_cmpgt_epi32(_mm256_set1_epi32(p->amin), suma);
+    __m256i ge = _mm256_cmpgt_epi32(suma, _mm256_set1_epi32(p->amax - 1));
+    v = _mm256_andnot_si256(_mm256_or_si256(lt, ge), v);
+    return _mm256_or_si256(v, _mm256_and_si256(ge, _mm256_set1_epi32(p->shadowRGB)));
+}
+
+DECORA_TARGET_AVX2 static inline __m256i shadowBlackAVX2(__m256i suma, const ShadowParams *p)
+{
+    __m256i v = _mm256_slli_epi32(scaleSum8(suma, _mm256_set1_epi32(p->kscalea)), 24);
+    return clampShadow8(suma, v, p);
+}
+
+DECORA_TARGET_AVX2 static inline __m256i shadowColoredAVX2(__m256i suma, const ShadowParams *p)
+{
+    __m256i v = _mm256_slli_epi32(scaleSum8(suma, _mm256_set1_epi32(p->kscalea)), 24);
+    v = _mm256_or_si256(v, _mm256_slli_epi32(scaleSum8(suma, _mm256_set1_epi32(p->kscaler)), 16));
+    v = _mm256_or_si256(v, _mm256_slli_epi32(scaleSum8(suma, _mm256_set1_epi32(p->kscaleg)), 8));
+    v = _mm256_or_si256(v, scaleSum8(suma, _mm256_set1_epi32(p->kscaleb)));
+    return clampShadow8(suma, v, p);
+}
+
+DECORA_TARGET_AVX2 static inline __m256i loadAlphas8(const jint *pixels)
+{
+    return _mm256_srli_epi32(_mm256_loadu_si256((const __m256i *) pixels), 24);
+}
+
+DECORA_TARGET_AVX2 static inline __m256i clampComponents8(__m256 sum)
+{
+    __m256i v = _mm256_cvttps_epi32(sum);
+    __m256 lt = _mm256_cmp_ps(sum, _mm256_set1_ps(cmin), _CMP_LT_OQ);
+    __m256i gt = _mm256_castps_si256(_mm256_cmp_ps(sum, _mm256_set1_ps(cmax), _CMP_GT_OQ));
+    v = _mm256_andnot_si256(_mm256_or_si256(_mm256_castps_si256(lt), gt), v);
+    return _mm256_or_si256(v, _mm256_and_si256(gt, _mm256_set1_epi32(255)));
+}
+
+// Two rows side by side, one per register half.
+DECORA_TARGET_AVX2 static void boxBlurHorizontalAVX2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                                     const jint *srcPixels, jint srcw, jint srcscan)
+{
+    jint hsize = dstw - srcw + 1;
+    jint k = 0x7fffffff / (hsize * 255);
+    __m256i kscale = _mm256_set1_epi32(k);
+    jint y = 0;
+    for (; y + 2 <= dsth; y += 2) {
+        const jint *s0 = srcPixels + (ptrdiff_t) y * srcscan;
+        const jint *s1 = s0 + srcscan;
+        jint *d0 = dstPixels + (ptrdiff_t) y * dstscan;
+        jint *d1 = d0 + dstscan;
+        __m256i sum = _mm256_setzero_si256();
+        for (jint x = 0; x < dstw; x++) {
+            if (x >= hsize) {
+                sum = _mm256_sub_epi32(sum, loadPixels2(s0[x - hsize], s1[x - hsize]));
+            }
+            if (x < srcw) {
+                sum = _mm256_add_epi32(sum, loadPixels2(s0[x], s1[x]));
+            }
+            __m128i v = storePixels2(scaleSum8(sum, kscale));
+            d0[x] = _mm_cvtsi128_si32(v);
+            d1[x] = _mm_extract_epi32(v, 1);
+        }
+    }
+    if (y < dsth) {
+        boxBlurRowSSE2(dstPixels + (ptrdiff_t) y * dstscan,
+                       srcPixels + (ptrdiff_t) y * srcscan,
+                       dstw, srcw, hsize, _mm_set1_epi32(k));
+    }
+}
+
+// Pairs of adjacent columns, read and written with one 64-bit access.
+DECORA_TARGET_AVX2 static void boxBlurVerticalAVX2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                                   const jint *srcPixels, jint srch, jint srcscan)
+{
+    jint vsize = dsth - srch + 1;
+    jint k = 0x7fffffff / (vsize * 255);
+    __m256i kscale = _mm256_set1_epi32(k);
+    __m256i sums[COLUMN_BLOCK / 2];
+    for (jint x0 = 0; x0 < dstw; x0 += COLUMN_BLOCK) {
+        jint bw = (dstw - x0 < COLUMN_BLOCK) ? dstw - x0 : COLUMN_BLOCK;
+        jint pairs = bw / 2;
+        bool odd = (bw & 1) != 0;
+        __m128i tailSum = _mm_setzero_si128();
+        for (jint i = 0; i < pairs; i++) {
+            sums[i] = _mm256_setzero_si256();
+        }
+        for (jint y = 0; y < dsth; y++) {
+            const jint *out = (y >= vsize) ? srcPixels + (ptrdiff_t) (y - vsize) * srcscan + x0 : NULL;
+            const jint *in = (y < srch) ? srcPixels + (ptrdiff_t) y * srcscan + x0 : NULL;
+            jint *dst = dstPixels + (ptrdiff_t) y * dstscan + x0;
+            for (jint i = 0; i < pairs; i++) {
+                __m256i sum = sums[i];
+                if (out != NULL) {
+                    __m128i o = _mm_loadl_epi64((const __m128i *) (out + i * 2));
+                    sum = _mm256_sub_epi32(sum, _mm256_cvtepu8_epi32(o));
+                }
+                if (in != NULL) {
+                    __m128i n = _mm_loadl_epi64((const __m128i *) (in + i * 2));
+                    sum = _mm256_add_epi32(sum, _mm256_cvtepu8_epi32(n));
+                }
+                sums[i] = sum;
+                _mm_storel_epi64((__m128i *) (dst + i * 2), storePixels2(scaleSum8(sum, kscale)));
+            }
+            if (odd) {
+                jint x = pairs * 2;
+                if (out != NULL) {
+                    tailSum = _mm_sub_epi32(tailSum, loadPixel(out[x]));
+                }
+                if (in != NULL) {
+                    tailSum = _mm_add_epi32(tailSum, loadPixel(in[x]));
+                }
+                dst[x] = storePixel(scaleSum(tailSum, _mm_set1_epi32(k)));
+            }
+        }
+    }
+}
+
+// Eight rows side by side, one per lane.
+DECORA_TARGET_AVX2 static void boxShadowHorizontalAVX2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                                       const jint *srcPixels, jint srcw, jint srcscan,
+                                                       const ShadowParams *p)
+{
+    jint hsize = dstw - srcw + 1;
+    __m256i rows = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                      _mm256_set1_epi32(srcscan));
+    jint y = 0;
+    for (; y + 8 <= dsth; y += 8) {
+        const jint *s = srcPixels + (ptrdiff_t) y * srcscan;
+        jint *d0 = dstPixels + (ptrdiff_t) y * dstscan;
+        __m256i suma = _mm256_setzero_si256();
+        for (jint x = 0; x < dstw; x++) {
+            if (x >= hsize) {
+                __m256i a = _mm256_i32gather_epi32((const int *) (s + x - hsize), rows, 4);
+                suma = _mm256_sub_epi32(suma, _mm256_srli_epi32(a, 24));
+            }
+            if (x < srcw) {
+                __m256i a = _mm256_i32gather_epi32((const int *) (s + x), rows, 4);
+                suma = _mm256_add_epi32(suma, _mm256_srli_epi32(a, 24));
+            }
+            jint out[8];
+            _mm256_storeu_si256((__m256i *) out, shadowBlackAVX2(suma, p));
+            jint *d = d0 + x;
+            for (jint i = 0; i < 8; i++) {
+                *d = out[i];
+                d += dstscan;
+            }
+        }
+    }
+    if (y < dsth) {
+        boxShadowHorizontalSSE2(dstPixels + (ptrdiff_t) y * dstscan, dstw, dsth - y, dstscan,
+                                srcPixels + (ptrdiff_t) y * srcscan, srcw, srcscan, p);
+    }
+}
+
+DECORA_TARGET_AVX2 static void boxShadowVerticalAVX2(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                                     const jint *srcPixels, jint srch, jint srcscan,
+                                                     const ShadowParams *p, bool colored)
+{
+    jint vsize = dsth - srch + 1;
+    __m256i sums[COLUMN_BLOCK / 8];
+    jint tailSums[7];
+    for (jint x0 = 0; x0 < dstw; x0 += COLUMN_BLOCK) {
+        jint bw = (dstw - x0 < COLUMN_BLOCK) ? dstw - x0 : COLUMN_BLOCK;
+        jint groups = bw / 8;
+        jint tail = bw - groups * 8;
+        for (jint i = 0; i < groups; i++) {
+            sums[i] = _mm256_setzero_si256();
+        }
+        for (jint i = 0; i < tail; i++) {
+            tailSums[i] = 0;
+        }
+        for (jint y = 0; y < dsth; y++) {
+            const jint *out = (y >= vsize) ? srcPixels + (ptrdiff_t) (y - vsize) * srcscan + x0 : NULL;
+            const jint *in = (y < srch) ? srcPixels + (ptrdiff_t) y * srcscan + x0 : NULL;
+            jint *dst = dstPixels + (ptrdiff_t) y * dstscan + x0;
+            for (jint i = 0; i < groups; i++) {
+                __m256i suma = sums[i];
+                if (out != NULL) {
+                    suma = _mm256_sub_epi32(suma, loadAlphas8(out + i * 8));
+                }
+                if (in != NULL) {
+                    suma = _mm256_add_epi32(suma, loadAlphas8(in + i * 8));
+                }
+                sums[i] = suma;
+                __m256i v = colored ? shadowColoredAVX2(suma, p) : shadowBlackAVX2(suma, p);
+                _mm256_storeu_si256((__m256i *) (dst + i * 8), v);
+            }
+            for (jint i = 0; i < tail; i++) {
+                jint x = groups * 8 + i;
+                jint suma = tailSums[i];
+                if (out != NULL) {
+                    suma -= (out[x] >> 24) & 0xff;
+                }
+                if (in != NULL) {
+                    suma += (in[x] >> 24) & 0xff;
+                }
+                tailSums[i] = suma;
+                dst[x] = colored ? shadowColored(suma, p) : shadowBlack(suma, p);
+            }
+        }
+    }
+}
+
+// Two rows side by side, one per register half, each with its own ring.
+DECORA_TARGET_AVX2 static void linearConvolveHVAVX2(jint *dstPixels, jint dstcols, jint dstrows,
+                                                    jint dcolinc, jint drowinc,
+                                                    const jint *srcPixels, jint srccols,
+                                                    jint scolinc, jint srowinc,
+                                                    const jfloat *kvals, jint kernelSize)
+{
+    __m256 cvals[128];
+    jint r = 0;
+    for (; r + 2 <= dstrows; r += 2) {
+        jint *dst = dstPixels + (ptrdiff_t) r * drowinc;
+        const jint *src = srcPixels + (ptrdiff_t) r * srowinc;
+        for (jint i = 0; i < kernelSize; i++) {
+            cvals[i] = _mm256_setzero_ps();
+        }
+        jint koff = kernelSize;
+        for (jint c = 0; c < dstcols; c++) {
+            __m256i rgb = _mm256_setzero_si256();
+            if (c < srccols) {
+                rgb = loadPixels2(src[0], src[srowinc]);
+            }
+            cvals[kernelSize - koff] = _mm256_cvtepi32_ps(rgb);
+            if (--koff <= 0) {
+                koff += kernelSize;
+            }
+            const jfloat *k = kvals + koff;
+            __m256 sum = _mm256_setzero_ps();
+            for (jint i = 0; i < kernelSize; i++) {
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(cvals[i], _mm256_set1_ps(k[i])));
+            }
+            __m128i v = storePixels2(clampComponents8(sum));
+            dst[0] = _mm_cvtsi128_si32(v);
+            dst[drowinc] = _mm_extract_epi32(v, 1);
+            dst += dcolinc;
+            src += scolinc;
+        }
+    }
+    if (r < dstrows) {
+        linearConvolveHVSSE2(dstPixels + (ptrdiff_t) r * drowinc, dstcols, dstrows - r,
+                             dcolinc, drowinc,
+                             srcPixels + (ptrdiff_t) r * srowinc, srccols,
+                             scolinc, srowinc, kvals, kernelSize);
+    }
+}
+
+// Eight rows side by side, one per lane.
+DECORA_TARGET_AVX2 static void linearConvolveShadowHVAVX2(jint *dstPixels, jint dstcols, jint dstrows,
+                                                          jint dcolinc, jint drowinc,
+                                                          const jint *srcPixels, jint srccols,
+                                                          jint scolinc, jint srowinc,
+                                                          const jfloat *kvals, jint kernelSize,
+                                                          const jint *shadowRGBs)
+{
+    __m256 avals[128];
+    __m256i rows = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                      _mm256_set1_epi32(srowinc));
+    jint r = 0;
+    for (; r + 8 <= dstrows; r += 8) {
+        jint *dst = dstPixels + (ptrdiff_t) r * drowinc;
+        const jint *src = srcPixels + (ptrdiff_t) r * srowinc;
+        for (jint i = 0; i < kernelSize; i++) {
+            avals[i] = _mm256_setzero_ps();
+        }
+        jint koff = kernelSize;
+        for (jint c = 0; c < dstcols; c++) {
+            __m256i rgb = _mm256_setzero_si256();
+            if (c < srccols) {
+                rgb = _mm256_i32gather_epi32((const int *) src, rows, 4);
+            }
+            avals[kernelSize - koff] = _mm256_cvtepi32_ps(_mm256_srli_epi32(rgb, 24));
+            if (--koff <= 0) {
+                koff += kernelSize;
+            }
+            const jfloat *k = kvals + koff;
+            __m256 sum = _mm256_set1_ps(-0.5f);
+            for (jint i = 0; i < kernelSize; i++) {
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(avals[i], _mm256_set1_ps(k[i])));
+            }
+            jfloat sums[8];
+            _mm256_storeu_ps(sums, sum);
+            jint *d = dst;
+            for (jint i = 0; i < 8; i++) {
+                *d = convolveShadowPixel(sums[i], shadowRGBs);
+                d += drowinc;
+            }
+            dst += dcolinc;
+            src += scolinc;
+        }
+    }
+    if (r < dstrows) {
+        linearConvolveShadowHVSSE2(dstPixels + (ptrdiff_t) r * drowinc, dstcols, dstrows - r,
+                                   dcolinc, drowinc,
+                                   srcPixels + (ptrdiff_t) r * srowinc, srccols,
+                                   scolinc, srowinc, kvals, kernelSize, shadowRGBs);
+    }
+}
+
+#endif /* DECORA_X86 */
+
+/*
+ * Select the variant for one band of a pass.
+ */
+
+static void boxBlurHorizontalSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                  const jint *srcPixels, jint srcw, jint srcscan)
+{
+    switch (getDecoraSIMDLevel()) {
+#ifdef DECORA_X86
+    case DECORA_SIMD_AVX2:
+        boxBlurHorizontalAVX2(dstPixels, dstw, dsth, dstscan, srcPixels, srcw, srcscan);
+        return;
+    case DECORA_SIMD_SSE2:
+        boxBlurHorizontalSSE2(dstPixels, dstw, dsth, dstscan, srcPixels, srcw, srcscan);
+        return;
+#endif
+    default:
+        boxBlurHorizontalScalar(dstPixels, dstw, dsth, dstscan, srcPixels, srcw, srcscan);
+    }
+}
+
+static void boxBlurVerticalSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                const jint *srcPixels, jint srch, jint srcscan)
+{
+    switch (getDecoraSIMDLevel()) {
+#ifdef DECORA_X86
+    case DECORA_SIMD_AVX2:
+        boxBlurVerticalAVX2(dstPixels, dstw, dsth, dstscan, srcPixels, srch, srcscan);
+        return;
+    case DECORA_SIMD_SSE2:
+        boxBlurVerticalSSE2(dstPixels, dstw, dsth, dstscan, srcPixels, srch, srcscan);
+        return;
+#endif
+    default:
+        boxBlurVerticalScalar(dstPixels, dstw, dsth, dstscan, srcPixels, srch, srcscan);
+    }
+}
+
+static void boxShadowHorizontalSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                    const jint *srcPixels, jint srcw, jint srcscan,
+                                    const ShadowParams *p)
+{
+    switch (getDecoraSIMDLevel()) {
+#ifdef DECORA_X86
+    case DECORA_SIMD_AVX2:
+        boxShadowHorizontalAVX2(dstPixels, dstw, dsth, dstscan, srcPixels, srcw, srcscan, p);
+        return;
+    case DECORA_SIMD_SSE2:
+        boxShadowHorizontalSSE2(dstPixels, dstw, dsth, dstscan, srcPixels, srcw, srcscan, p);
+        return;
+#endif
+    default:
+        boxShadowHorizontalScalar(dstPixels, dstw, dsth, dstscan, srcPixels, srcw, srcscan, p);
+    }
+}
+
+static void boxShadowVerticalSIMD(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                                  const jint *srcPixels, jint srch, jint srcscan,
+                                  const ShadowParams *p, bool colored)
+{
+    switch (getDecoraSIMDLevel()) {
+#ifdef DECORA_X86
+    case DECORA_SIMD_AVX2:
+        boxShadowVerticalAVX2(dstPixels, dstw, dsth, dstscan, srcPixels, srch, srcscan, p, colored);
+        return;
+    case DECORA_SIMD_SSE2:
+        boxShadowVerticalSSE2(dstPixels, dstw, dsth, dstscan, srcPixels, srch, srcscan, p, colored);
+        return;
+#endif
+    default:
+        boxShadowVerticalScalar(dstPixels, dstw, dsth, dstscan, srcPixels, srch, srcscan, p, colored);
+    }
+}
+
+static void linearConvolveHVSIMD(jint *dstPixels, jint dstcols, jint dstrows,
+                                 jint dcolinc, jint drowinc,
+                                 const jint *srcPixels, jint srccols,
+                                 jint scolinc, jint srowinc,
+                                 const jfloat *kvals, jint kernelSize)
+{
+    switch (getDecoraSIMDLevel()) {
+#ifdef DECORA_X86
+    case DECORA_SIMD_AVX2:
+        linearConvolveHVAVX2(dstPixels, dstcols, dstrows, dcolinc, drowinc,
+                             srcPixels, srccols, scolinc, srowinc, kvals, kernelSize);
+        return;
+    case DECORA_SIMD_SSE2:
+        linearConvolveHVSSE2(dstPixels, dstcols, dstrows, dcolinc, drowinc,
+                             srcPixels, srccols, scolinc, srowinc, kvals, kernelSize);
+        return;
+#endif
+    default:
+        linearConvolveHVScalar(dstPixels, dstcols, dstrows, dcolinc, drowinc,
+                               srcPixels, srccols, scolinc, srowinc, kvals, kernelSize);
+    }
+}
+
+static void linearConvolveShadowHVSIMD(jint *dstPixels, jint dstcols, jint dstrows,
+                                       jint dcolinc, jint drowinc,
+                                       const jint *srcPixels, jint srccols,
+                                       jint scolinc, jint srowinc,
+                                       const jfloat *kvals, jint kernelSize,
+                                       const jint *shadowRGBs)
+{
+    switch (getDecoraSIMDLevel()) {
+#ifdef DECORA_X86
+    case DECORA_SIMD_AVX2:
+        linearConvolveShadowHVAVX2(dstPixels, dstcols, dstrows, dcolinc, drowinc,
+                                   srcPixels, srccols, scolinc, srowinc,
+                                   kvals, kernelSize, shadowRGBs);
+        return;
+    case DECORA_SIMD_SSE2:
+        linearConvolveShadowHVSSE2(dstPixels, dstcols, dstrows, dcolinc, drowinc,
+                                   srcPixels, srccols, scolinc, srowinc,
+                                   kvals, kernelSize, shadowRGBs);
+        return;
+#endif
+    default:
+        linearConvolveShadowHVScalar(dstPixels, dstcols, dstrows, dcolinc, drowinc,
+                                     srcPixels, srccols, scolinc, srowinc,
+                                     kvals, kernelSize, shadowRGBs);
+    }
+}
+
+/*
+ * Banded execution. Horizontal box passes and the HV convolutions are
+ * split into bands of rows, vertical box passes into strips of columns.
+ * Bands share no state, so the output does not depend on the banding.
+ */
+
+struct BoxPass {
+    jint *dstPixels;
+    jint dstw, dsth, dstscan;
+    const jint *srcPixels;
+    jint srcw, srch, srcscan;
+    ShadowParams shadow;
+    bool colored;
+};
+
+struct ConvolvePass {
+    jint *dstPixels;
+    jint dstcols, dcolinc, drowinc;
+    const jint *srcPixels;
+    jint srccols, scolinc, srowinc;
+    const jfloat *kvals;
+    jint kernelSize;
+    const jint *shadowRGBs;
+};
+
+static void boxBlurHorizontalBand(void *data, jint start, jint end)
+{
+    BoxPass *p = (BoxPass *) data;
+    boxBlurHorizontalSIMD(p->dstPixels + (ptrdiff_t) start * p->dstscan, p->dstw, end - start, p->dstscan,
+                          p->srcPixels + (ptrdiff_t) start * p->srcscan, p->srcw, p->srcscan);
+}
+
+static void boxBlurVerticalBand(void *data, jint start, jint end)
+{
+    BoxPass *p = (BoxPass *) data;
+    boxBlurVerticalSIMD(p->dstPixels + start, end - start, p->dsth, p->dstscan,
+                        p->srcPixels + start, p->srch, p->srcscan);
+}
+
+static void boxShadowHorizontalBand(void *data, jint start, jint end)
+{
+    BoxPass *p = (BoxPass *) data;
+    boxShadowHorizontalSIMD(p->dstPixels + (ptrdiff_t) start * p->dstscan, p->dstw, end - start, p->dstscan,
+                            p->srcPixels + (ptrdiff_t) start * p->srcscan, p->srcw, p->srcscan,
+                            &p->shadow);
+}
+
+static void boxShadowVerticalBand(void *data, jint start, jint end)
+{
+    BoxPass *p = (BoxPass *) data;
+    boxShadowVerticalSIMD(p->dstPixels + start, end - start, p->dsth, p->dstscan,
+                          p->srcPixels + start, p->srch, p->srcscan,
+                          &p->shadow, p->colored);
+}
+
+static void linearConvolveHVBand(void *data, jint start, jint end)
+{
+    ConvolvePass *p = (ConvolvePass *) data;
+    linearConvolveHVSIMD(p->dstPixels + (ptrdiff_t) start * p->drowinc, p->dstcols, end - start,
+                         p->dcolinc, p->drowinc,
+                         p->srcPixels + (ptrdiff_t) start * p->srowinc, p->srccols,
+                         p->scolinc, p->srowinc, p->kvals, p->kernelSize);
+}
+
+static void linearConvolveShadowHVBand(void *data, jint start, jint end)
+{
+    ConvolvePass *p = (ConvolvePass *) data;
+    linearConvolveShadowHVSIMD(p->dstPixels + (ptrdiff_t) start * p->drowinc, p->dstcols, end - start,
+                               p->dcolinc, p->drowinc,
+                               p->srcPixels + (ptrdiff_t) start * p->srowinc, p->srccols,
+                               p->scolinc, p->srowinc, p->kvals, p->kernelSize,
+                               p->shadowRGBs);
+}
+
+static void initBoxPass(BoxPass *p,
+                        jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                        const jint *srcPixels, jint srcw, jint srch, jint srcscan)
+{
+    p->dstPixels = dstPixels;
+    p->dstw = dstw;
+    p->dsth = dsth;
+    p->dstscan = dstscan;
+    p->srcPixels = srcPixels;
+    p->srcw = srcw;
+    p->srch = srch;
+    p->srcscan = srcscan;
+    p->colored = false;
+}
+
+static void initConvolvePass(ConvolvePass *p,
+                             jint *dstPixels, jint dstcols, jint dcolinc, jint drowinc,
+                             const jint *srcPixels, jint srccols, jint scolinc, jint srowinc,
+                             const jfloat *kvals, jint kernelSize, const jint *shadowRGBs)
+{
+    p->dstPixels = dstPixels;
+    p->dstcols = dstcols;
+    p->dcolinc = dcolinc;
+    p->drowinc = drowinc;
+    p->srcPixels = srcPixels;
+    p->srccols = srccols;
+    p->scolinc = scolinc;
+    p->srowinc = srowinc;
+    p->kvals = kvals;
+    p->kernelSize = kernelSize;
+    p->shadowRGBs = shadowRGBs;
+}
+
+void boxBlurHorizontal(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                       const jint *srcPixels, jint srcw, jint srch, jint srcscan)
+{
+    BoxPass p;
+    initBoxPass(&p, dstPixels, dstw, dsth, dstscan, srcPixels, srcw, srch, srcscan);
+    runDecoraBands(dsth, dstw, boxBlurHorizontalBand, &p);
+}
+
+void boxBlurVertical(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                     const jint *srcPixels, jint srcw, jint srch, jint srcscan)
+{
+    BoxPass p;
+    initBoxPass(&p, dstPixels, dstw, dsth, dstscan, srcPixels, srcw, srch, srcscan);
+    runDecoraBands(dstw, dsth, boxBlurVerticalBand, &p);
+}
+
+void boxShadowHorizontalBlack(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                              const jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                              jfloat spread)
+{
+    BoxPass p;
+    initBoxPass(&p, dstPixels, dstw, dsth, dstscan, srcPixels, srcw, srch, srcscan);
+    initShadowParams(&p.shadow, dstw - srcw + 1, spread, NULL);
+    runDecoraBands(dsth, dstw, boxShadowHorizontalBand, &p);
+}
+
+void boxShadowVerticalBlack(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                            const jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                            jfloat spread)
+{
+    BoxPass p;
+    initBoxPass(&p, dstPixels, dstw, dsth, dstscan, srcPixels, srcw, srch, srcscan);
+    initShadowParams(&p.shadow, dsth - srch + 1, spread, NULL);
+    runDecoraBands(dstw, dsth, boxShadowVerticalBand, &p);
+}
+
+void boxShadowVertical(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                       const jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                       jfloat spread, const jfloat *shadowColor)
+{
+    BoxPass p;
+    initBoxPass(&p, dstPixels, dstw, dsth, dstscan, srcPixels, srcw, srch, srcscan);
+    initShadowParams(&p.shadow, dsth - srch + 1, spread, shadowColor);
+    p.colored = true;
+    runDecoraBands(dstw, dsth, boxShadowVerticalBand, &p);
+}
+
+void linearConvolveHV(jint *dstPixels, jint dstcols, jint dstrows, jint dcolinc, jint drowinc,
+                      const jint *srcPixels, jint srccols, jint scolinc, jint srowinc,
+                      const jfloat *kvals, jint kernelSize)
+{
+    ConvolvePass p;
+    initConvolvePass(&p, dstPixels, dstcols, dcolinc, drowinc,
+                     srcPixels, srccols, scolinc, srowinc, kvals, kernelSize, NULL);
+    runDecoraBands(dstrows, dstcols, linearConvolveHVBand, &p);
+}
+
+void linearConvolveShadowHV(jint *dstPixels, jint dstcols, jint dstrows, jint dcolinc, jint drowinc,
+                            const jint *srcPixels, jint srccols, jint scolinc, jint srowinc,
+                            const jfloat *kvals, jint kernelSize, const jint *shadowRGBs)
+{
+    ConvolvePass p;
+    initConvolvePass(&p, dstPixels, dstcols, dcolinc, drowinc,
+                     srcPixels, srccols, scolinc, srowinc, kvals, kernelSize, shadowRGBs);
+    runDecoraBands(dstrows, dstcols, linearConvolveShadowHVBand, &p);
+}
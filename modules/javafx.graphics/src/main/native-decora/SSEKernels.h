@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef _Included_SSEKernels
+#define _Included_SSEKernels
+
+#include <jni.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+ * The inner loops of the SSE peers. Each kernel has a scalar, an SSE2
+ * and an AVX2 variant that produce identical pixels; the best variant
+ * supported by the CPU is chosen at runtime. Passes that are large
+ * enough are split into bands run on the SSEThreadPool workers. The
+ * arguments mirror the JNI entry points of the peers, with the arrays
+ * already pinned and the ranges already checked.
+ */
+
+#define DECORA_SIMD_NONE 0
+#define DECORA_SIMD_SSE2 1
+#define DECORA_SIMD_AVX2 2
+
+/*
+ * Returns the SIMD level used by the kernels.
+ */
+int getDecoraSIMDLevel();
+
+/*
+ * Restricts the kernels to the given SIMD level (capped at what the
+ * CPU supports) and returns the level actually selected. Meant for
+ * benchmarks and tests comparing the variants.
+ */
+int setDecoraSIMDLevel(int level);
+
+void boxBlurHorizontal(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                       const jint *srcPixels, jint srcw, jint srch, jint srcscan);
+
+void boxBlurVertical(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                     const jint *srcPixels, jint srcw, jint srch, jint srcscan);
+
+void boxShadowHorizontalBlack(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                              const jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                              jfloat spread);
+
+void boxShadowVerticalBlack(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                            const jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                            jfloat spread);
+
+void boxShadowVertical(jint *dstPixels, jint dstw, jint dsth, jint dstscan,
+                       const jint *srcPixels, jint srcw, jint srch, jint srcscan,
+                       jfloat spread, const jfloat *shadowColor);
+
+void linearConvolveHV(jint *dstPixels, jint dstcols, jint dstrows, jint dcolinc, jint drowinc,
+                      const jint *srcPixels, jint srccols, jint scolinc, jint srowinc,
+                      const jfloat *kvals, jint kernelSize);
+
+void linearConvolveShadowHV(jint *dstPixels, jint dstcols, jint dstrows, jint dcolinc, jint drowinc,
+                            const jint *srcPixels, jint srccols, jint scolinc, jint srowinc,
+                            const jfloat *kvals, jint kernelSize, const jint *shadowRGBs);
+
+#ifdef __cplusplus
+};
+#endif /* __cplusplus */
+
+#endif /* _Included_SSEKernels */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2009, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -31,6 +31,7 @@
 #include <jni.h>
 #include <math.h>
 #include "SSEUtils.h"
+#include "SSEKernels.h"
 #include "com_sun_scenario_effect_impl_sw_sse_SSELinearConvolvePeer.h"
 
 #define cmin 1.0f
@@ -130,55 +131,8 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolvePeer_filterHV
         return;
     }
 
-    // cvals stores the component values from the surrounding K pixels
-    // from x-r to x+r
-    jfloat cvals[128*4];
-    jint dstrow = 0;
-    jint srcrow = 0;
-    for (jint r = 0; r < dstrows; r++) {
-        jint dstoff = dstrow;
-        jint srcoff = srcrow;
-        // Must clear out the array at the start of every line
-        // Might be able to rely on the fact that the previous line must
-        // have run out of data towards the end of the scan line, though.
-        for (jint i = 0; i < kernelSize*4; i++) {
-            cvals[i] = 0.0f;
-        }
-        jint koff = kernelSize;
-        for (jint c = 0; c < dstcols; c++) {
-            // Load the data for this x location into the array.
-            jint i = (kernelSize - koff) * 4;
-            jint rgb = (c < srccols) ? srcPixels[srcoff] : 0;
-            cvals[i+0] = (jfloat) ((rgb >> 24) & 0xff);
-            cvals[i+1] = (jfloat) ((rgb >> 16) & 0xff);
-            cvals[i+2] = (jfloat) ((rgb >>  8) & 0xff);
-            cvals[i+3] = (jfloat) ((rgb      ) & 0xff);
-            // Bump the koff to the next spot to align the coefficients.
-            if (--koff <= 0) {
-                koff += kernelSize;
-            }
-            jfloat suma = 0.0f;
-            jfloat sumr = 0.0f;
-            jfloat sumg = 0.0f;
-            jfloat sumb = 0.0f;
-            for (i = 0; i < kernelSize*4; i += 4) {
-                jfloat factor = kvals[koff + (i>>2)];
-                suma += cvals[i+0] * factor;
-                sumr += cvals[i+1] * factor;
-                sumg += cvals[i+2] * factor;
-                sumb += cvals[i+3] * factor;
-            }
-            dstPixels[dstoff] =
-                (((suma < cmin) ? 0 : ((suma > cmax) ? 255 : ((jint) suma))) << 24) +
-                (((sumr < cmin) ? 0 : ((sumr > cmax) ? 255 : ((jint) sumr))) << 16) +
-                (((sumg < cmin) ? 0 : ((sumg > cmax) ? 255 : ((jint) sumg))) <<  8) +
-                (((sumb < cmin) ? 0 : ((sumb > cmax) ? 255 : ((jint) sumb)))      );
-            dstoff += dcolinc;
-            srcoff += scolinc;
-        }
-        dstrow += drowinc;
-        srcrow += srowinc;
-    }
+    linearConvolveHV(dstPixels, dstcols, dstrows, dcolinc, drowinc,
+                     srcPixels, srccols, scolinc, srowinc, kvals, kernelSize);
 
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2009, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -31,6 +31,7 @@
 #include <jni.h>
 #include <math.h>
 #include "SSEUtils.h"
+#include "SSEKernels.h"
 #include "com_sun_scenario_effect_impl_sw_sse_SSELinearConvolveShadowPeer.h"
 
 #define cmin 1.0f
@@ -147,43 +148,9 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolveShadowPeer_filterHV
         return;
     }
 
-    // avals stores the alpha values from the surrounding K pixels
-    // from x-r to x+r
-    jfloat avals[128];
-    jint dstrow = 0;
-    jint srcrow = 0;
-    for (jint r = 0; r < dstrows; r++) {
-        jint dstoff = dstrow;
-        jint srcoff = srcrow;
-        // Must clear out the array at the start of every line
-        // Might be able to rely on the fact that the previous line must
-        // have run out of data towards the end of the scan line, though.
-        for (jint i = 0; i < kernelSize; i++) {
-            avals[i] = 0.0f;
-        }
-        jint koff = kernelSize;
-        for (jint c = 0; c < dstcols; c++) {
-            // Load the data for this x location into the array.
-            jint rgb = (c < srccols) ? srcPixels[srcoff] : 0;
-            avals[kernelSize - koff] = (jfloat) ((rgb >> 24) & 0xff);
-            // Bump the koff to the next spot to align the coefficients.
-            if (--koff <= 0) {
-                koff += kernelSize;
-            }
-            jfloat sum = -0.5f;
-            for (jint i = 0; i < kernelSize; i++) {
-                sum += avals[i] * kvals[koff + i];
-            }
-            dstPixels[dstoff] =
-                ((sum < 0.0f) ? 0
-                 : ((sum >= 254.0f) ? shadowRGBs[255]
-                    : shadowRGBs[((jint) sum) + 1]));
-            dstoff += dcolinc;
-            srcoff += scolinc;
-        }
-        dstrow += drowinc;
-        srcrow += srowinc;
-    }
+    linearConvolveShadowHV(dstPixels, dstcols, dstrows, dcolinc, drowinc,
+                           srcPixels, srccols, scolinc, srowinc,
+                           kvals, kernelSize, shadowRGBs);
 
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -23,27 +23,21 @@
  * questions.
  */
 
-package com.sun.javafx.webkit;
+#include "SSEThreadPool.h"
 
-import com.sun.webkit.security.WCMessageDigest;
-import java.nio.ByteBuffer;
-import java.security.MessageDigest;
-import java.security.NoSuchAlgorithmException;
+#include "BandThreadPool.h"
 
-public class WCMessageDigestImpl extends WCMessageDigest {
-    private final MessageDigest digest;
-
-    public WCMessageDigestImpl(String algorithm) throws NoSuchAlgorithmException {
-        digest = MessageDigest.getInstance(algorithm);
-    }
+void setDecoraThreading(jint maxThreads, jint minBandSize)
+{
+    bandPoolSetThreading(maxThreads, minBandSize);
+}
 
-    @Override
-    public void addBytes(ByteBuffer input) {
-        digest.update(input);
-    }
+jint getDecoraThreadCount()
+{
+    return bandPoolMaxThreads;
+}
 
-    @Override
-    public byte[] computeHash() {
-        return digest.digest();
-    }
+void runDecoraBands(jint lines, jint lineSize, DecoraBandFunc func, void *data)
+{
+    bandPoolRun(lines, lineSize, func, data);
 }
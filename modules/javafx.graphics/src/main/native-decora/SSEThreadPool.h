@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef _Included_SSEThreadPool
+#define _Included_SSEThreadPool
+
+#include <jni.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+ * A fixed pool of native worker threads that the peers use to run the
+ * rows (or column strips) of a pass in parallel, see BandThreadPool.h. The
+ * workers never call into the JVM, so they may run while the caller holds
+ * critical arrays.
+ */
+
+typedef void (*DecoraBandFunc)(void *data, jint start, jint end);
+
+/*
+ * Sets the maximum number of threads working on one pass (including the
+ * calling thread) and the minimum number of destination pixels per band.
+ * A pass smaller than two bands runs entirely on the calling thread.
+ */
+void setDecoraThreading(jint maxThreads, jint minBandSize);
+
+/*
+ * Returns the maximum number of threads working on one pass.
+ */
+jint getDecoraThreadCount();
+
+/*
+ * Splits [0, lines) into contiguous bands of at least minBandSize pixels,
+ * given lineSize pixels per line, and calls func once per band. Returns
+ * after all bands have completed. If the pool is already busy with a pass
+ * from another thread, all bands run on the calling thread.
+ */
+void runDecoraBands(jint lines, jint lineSize, DecoraBandFunc func, void *data);
+
+#ifdef __cplusplus
+};
+#endif /* __cplusplus */
+
+#endif /* _Included_SSEThreadPool */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2008, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2008, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -24,6 +24,7 @@
  */
 
 #include "SSEUtils.h"
+#include "SSEThreadPool.h"
 #include "com_sun_scenario_effect_impl_sw_sse_SSERendererDelegate.h"
 
 #ifdef WIN32 /* WIN32 */
@@ -43,6 +44,13 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSERendererDelegate_isSupported
 #endif
 }
 
+JNIEXPORT void JNICALL
+Java_com_sun_scenario_effect_impl_sw_sse_SSERendererDelegate_initThreading
+    (JNIEnv *env, jclass klass, jint maxThreads, jint minBandSize)
+{
+    setDecoraThreading(maxThreads, minBandSize);
+}
+
 static void laccum(jint pixel, jfloat mul, jfloat *fvals) {
     mul /= 255.f;
     fvals[FVAL_R] += ((pixel >> 16) & 0xff) * mul;
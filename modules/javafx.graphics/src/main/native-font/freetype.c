@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2013, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -397,6 +397,81 @@ JNIEXPORT jbyteArray JNICALL OS_NATIVE(getBitmapData)(JNIEnv *env, jclass that,
     return result;
 }
 
+/*
+ * Loads and renders the glyphs codes[offset..offset+count) using the current
+ * size and transform of the face, and writes one record per glyph to the
+ * direct buffer: a header of GLYPH_RECORD_HEADER ints (see OSFreetype.java)
+ * followed by the bitmap rows packed without padding, so they can be
+ * uploaded to the glyph cache as they are. Each record is padded to a
+ * multiple of 4 bytes. Returns the number of glyphs written, which is less
+ * than count when the buffer is full.
+ */
+#define GLYPH_RECORD_HEADER 10
+
+JNIEXPORT jint JNICALL OS_NATIVE(rasterizeGlyphs)
+    (JNIEnv *env, jclass that, jlong facePtr, jintArray glyphCodes,
+     jint offset, jint count, jint loadFlags, jobject buffer)
+{
+    if (!facePtr || !glyphCodes || !buffer) return 0;
+    FT_Face face = (FT_Face)facePtr;
+    unsigned char* dst = (*env)->GetDirectBufferAddress(env, buffer);
+    jlong capacity = (*env)->GetDirectBufferCapacity(env, buffer);
+    if (!dst || capacity <= 0) return 0;
+    jint length = (*env)->GetArrayLength(env, glyphCodes);
+    if (offset < 0 || count < 0 || offset > length - count) return 0;
+    jint* codes = (*env)->GetIntArrayElements(env, glyphCodes, NULL);
+    if (!codes) return 0;
+
+    const size_t headerSize = GLYPH_RECORD_HEADER * sizeof(jint);
+    size_t pos = 0;
+    jint done = 0;
+    for (; done < count; done++) {
+        if ((size_t)capacity - pos < headerSize) break;
+        FT_Error error = FT_Load_Glyph(face, (FT_UInt)codes[offset + done], (FT_Int32)loadFlags);
+        FT_GlyphSlot slot = face->glyph;
+        if (!error && !slot) error = FT_Err_Invalid_Slot_Handle;
+
+        FT_Bitmap* bitmap = NULL;
+        size_t size = 0;
+        if (!error) {
+            bitmap = &slot->bitmap;
+            if ((bitmap->pixel_mode == FT_PIXEL_MODE_GRAY || bitmap->pixel_mode == FT_PIXEL_MODE_LCD) &&
+                bitmap->buffer && bitmap->pitch > 0 && bitmap->width <= (unsigned int)bitmap->pitch &&
+                bitmap->rows <= INT_MAX / bitmap->pitch) {
+                size = (size_t)bitmap->width * bitmap->rows;
+            }
+        }
+        size_t padded = (size + 3) & ~(size_t)3;
+        if ((size_t)capacity - pos - headerSize < padded) break;
+
+        jint* header = (jint*)(dst + pos);
+        memset(header, 0, headerSize);
+        header[0] = (jint)error;
+        if (!error) {
+            header[1] = (jint)bitmap->pixel_mode;
+            header[2] = (jint)bitmap->width;
+            header[3] = (jint)bitmap->rows;
+            header[4] = (jint)slot->bitmap_left;
+            header[5] = (jint)slot->bitmap_top;
+            header[6] = (jint)slot->advance.x;
+            header[7] = (jint)slot->advance.y;
+            header[8] = (jint)slot->linearHoriAdvance;
+            header[9] = (jint)size;
+        }
+        unsigned char* data = dst + pos + headerSize;
+        unsigned int y;
+        for (y = 0; size && y < bitmap->rows; y++) {
+            memcpy(data + (size_t)y * bitmap->width,
+                   bitmap->buffer + (size_t)y * bitmap->pitch,
+                   bitmap->width);
+        }
+        pos += headerSize + padded;
+    }
+
+    (*env)->ReleaseIntArrayElements(env, glyphCodes, codes, JNI_ABORT);
+    return done;
+}
+
 JNIEXPORT void JNICALL OS_NATIVE(FT_1Set_1Transform)
     (JNIEnv *env, jclass that, jlong arg0, jobject arg1, jlong arg2, jlong arg3)
 {
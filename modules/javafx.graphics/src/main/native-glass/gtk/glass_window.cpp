@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -235,6 +235,15 @@ void WindowContextBase::process_delete() {
 }
 
 void WindowContextBase::process_expose(GdkEventExpose* event) {
+    // The repainted frame may be identical to the cached one, so make sure
+    // the next paint() still covers the exposed area
+    if (!paint_damage) {
+        paint_damage = cairo_region_create();
+    }
+    cairo_rectangle_int_t area = {event->area.x, event->area.y,
+            event->area.width, event->area.height};
+    cairo_region_union_rectangle(paint_damage, &area);
+
     if (jview) {
         mainEnv->CallVoidMethod(jview, jViewNotifyRepaint, event->area.x, event->area.y, event->area.width, event->area.height);
         CHECK_JNI_EXCEPTION(mainEnv)
@@ -514,33 +523,119 @@ void WindowContextBase::process_key(GdkEventKey* event) {
     }
 }
 
+// Number of rows merged into one damage rectangle when diffing frames
+#define PAINT_DAMAGE_BAND 32
+
+/*
+ * Compares a new frame with the cached copy of the previous one, copies the
+ * changed pixels into the cache and adds the changed areas to the damage
+ * region. Changes are tracked per row and merged in bands of
+ * PAINT_DAMAGE_BAND rows to keep the region small.
+ */
+static void update_paint_surface(cairo_surface_t* surface, cairo_region_t* damage,
+        const guint32* data, jint width, jint height) {
+    guint32* cache = (guint32*) cairo_image_surface_get_data(surface);
+    int stride = cairo_image_surface_get_stride(surface) / 4;
+
+    for (jint band = 0; band < height; band += PAINT_DAMAGE_BAND) {
+        jint band_end = MIN(band + PAINT_DAMAGE_BAND, height);
+        jint x0 = width, x1 = 0;
+        for (jint y = band; y < band_end; y++) {
+            const guint32* src = data + (size_t) y * width;
+            guint32* dst = cache + (size_t) y * stride;
+            if (memcmp(src, dst, (size_t) width * 4) == 0) {
+                continue;
+            }
+            jint left = 0;
+            while (src[left] == dst[left]) {
+                left++;
+            }
+            jint right = width;
+            while (src[right - 1] == dst[right - 1]) {
+                right--;
+            }
+            memcpy(dst + left, src + left, (size_t) (right - left) * 4);
+            x0 = MIN(x0, left);
+            x1 = MAX(x1, right);
+        }
+        if (x0 < x1) {
+            cairo_rectangle_int_t rect = {x0, band, x1 - x0, band_end - band};
+            cairo_region_union_rectangle(damage, &rect);
+        }
+    }
+}
+
 void WindowContextBase::paint(void* data, jint width, jint height) {
+    cairo_rectangle_int_t bounds = {0, 0, width, height};
+    cairo_region_t* damage = paint_damage ? paint_damage : cairo_region_create();
+    paint_damage = NULL;
+
+    if (paint_surface
+            && cairo_image_surface_get_width(paint_surface) == width
+            && cairo_image_surface_get_height(paint_surface) == height) {
+        cairo_surface_flush(paint_surface);
+        update_paint_surface(paint_surface, damage, (const guint32*) data, width, height);
+        cairo_surface_mark_dirty(paint_surface);
+    } else {
+        // No previous frame to compare with: cache this one and repaint everything
+        if (paint_surface) {
+            cairo_surface_destroy(paint_surface);
+        }
+        paint_surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+        if (cairo_surface_status(paint_surface) == CAIRO_STATUS_SUCCESS) {
+            unsigned char* dst = cairo_image_surface_get_data(paint_surface);
+            int stride = cairo_image_surface_get_stride(paint_surface);
+            for (jint y = 0; y < height; y++) {
+                memcpy(dst + (size_t) y * stride, (unsigned char*) data + (size_t) y * width * 4,
+                        (size_t) width * 4);
+            }
+            cairo_surface_mark_dirty(paint_surface);
+        } else {
+            cairo_surface_destroy(paint_surface);
+            paint_surface = NULL;
+        }
+        cairo_region_union_rectangle(damage, &bounds);
+    }
+
+    cairo_region_intersect_rectangle(damage, &bounds);
+    if (cairo_region_is_empty(damage)) {
+        cairo_region_destroy(damage);
+        return;
+    }
+
+    cairo_surface_t* cairo_surface = paint_surface
+            ? cairo_surface_reference(paint_surface)
+            : cairo_image_surface_create_for_data(
+                    (unsigned char*)data,
+                    CAIRO_FORMAT_ARGB32,
+                    width, height, width * 4);
+
 #ifdef GLASS_GTK3
-    cairo_rectangle_int_t rect = {0, 0, width, height};
-    cairo_region_t *region = cairo_region_create_rectangle(&rect);
-    gdk_window_begin_paint_region(gdk_window, region);
+    gdk_window_begin_paint_region(gdk_window, damage);
 #endif
     cairo_t* context = gdk_cairo_create(gdk_window);
 
-    cairo_surface_t* cairo_surface =
-        cairo_image_surface_create_for_data(
-            (unsigned char*)data,
-            CAIRO_FORMAT_ARGB32,
-            width, height, width * 4);
-
     applyShapeMask(data, width, height);
 
+    int count = cairo_region_num_rectangles(damage);
+    for (int i = 0; i < count; i++) {
+        cairo_rectangle_int_t rect;
+        cairo_region_get_rectangle(damage, i, &rect);
+        cairo_rectangle(context, rect.x, rect.y, rect.width, rect.height);
+    }
+    cairo_clip(context);
+
     cairo_set_source_surface(context, cairo_surface, 0, 0);
     cairo_set_operator(context, CAIRO_OPERATOR_SOURCE);
     cairo_paint(context);
 
 #ifdef GLASS_GTK3
     gdk_window_end_paint(gdk_window);
-    cairo_region_destroy(region);
 #endif
 
     cairo_destroy(context);
     cairo_surface_destroy(cairo_surface);
+    cairo_region_destroy(damage);
 }
 
 void WindowContextBase::add_child(WindowContextTop* child) {
@@ -685,6 +780,15 @@ WindowContextBase::~WindowContextBase() {
         xim.im = NULL;
     }
 
+    if (paint_surface) {
+        cairo_surface_destroy(paint_surface);
+        paint_surface = NULL;
+    }
+    if (paint_damage) {
+        cairo_region_destroy(paint_damage);
+        paint_damage = NULL;
+    }
+
     gtk_widget_destroy(gtk_widget);
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -187,6 +187,14 @@ protected:
     bool is_mouse_entered;
     bool is_disabled;
 
+    /*
+     * paint_surface keeps the last frame passed to paint(), so that the next
+     * one can be diffed against it and only the changed areas repainted.
+     * paint_damage collects exposed areas that must be repainted regardless.
+     */
+    cairo_surface_t* paint_surface;
+    cairo_region_t* paint_damage;
+
     /*
      * sm_grab_window points to WindowContext holding a mouse grab.
      * It is mostly used for popup windows.
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -30,6 +30,8 @@
 #include <JTransform.h>
 
 #include <PiscesBlit.h>
+#include <PiscesBlitSpans.h>
+#include <PiscesThreads.h>
 #include <PiscesSysutils.h>
 
 #include <PiscesRenderer.inl>
@@ -377,7 +379,7 @@ fillRect(JNIEnv *env, jobject this, Renderer* rdr,
     jobject surfaceHandle;
     jint x_from, x_to, y_from, y_to;
     jint lfrac, rfrac, tfrac, bfrac;
-    jint rows_to_render_by_loop, rows_being_rendered;
+    jint rows_to_render_by_loop;
 
     lfrac = (0x10000 - (x & 0xFFFF)) & 0xFFFF;
     rfrac = (x + w) & 0xFFFF;
@@ -507,22 +509,7 @@ fillRect(JNIEnv *env, jobject this, Renderer* rdr,
         }
 
         // emit "full" lines that are in the middle
-        while (rows_to_render_by_loop > 0) {
-            rows_being_rendered = MIN(rows_to_render_by_loop, NUM_ALPHA_ROWS);
-
-            if (rdr->_genPaint) {
-                size_t l = (x_to - x_from + 1) * rows_being_rendered;
-                ALLOC3(rdr->_paint, jint, l);
-                rdr->_genPaint(rdr, rows_being_rendered);
-            }
-            rdr->_emitLine(rdr, rows_being_rendered, 0x10000);
-
-            rows_to_render_by_loop -= rows_being_rendered;
-            rdr->_currX = x_from;
-            rdr->_currY += rows_being_rendered;
-            rdr->_currImageOffset = rdr->_currY * surface->width;
-            rdr->_rowNum += rows_being_rendered;
-        }
+        emitRectRows(rdr, rows_to_render_by_loop);
 
         // emit fractional bottom line
         if (bfrac) {
@@ -735,6 +722,28 @@ JNIEXPORT void JNICALL Java_com_sun_pisces_PiscesRenderer_setLCDGammaCorrectionI
     initGammaArrays(gamma);
 }
 
+/*
+ * Class:     com_sun_pisces_PiscesRenderer
+ * Method:    setThreadingImpl
+ * Signature: (II)V
+ */
+JNIEXPORT void JNICALL Java_com_sun_pisces_PiscesRenderer_setThreadingImpl
+(JNIEnv *env, jclass cls, jint maxThreads, jint minBandSize)
+{
+    piscesSetThreading(maxThreads, minBandSize);
+}
+
+/*
+ * Class:     com_sun_pisces_PiscesRenderer
+ * Method:    setSIMDLevelImpl
+ * Signature: (I)I
+ */
+JNIEXPORT jint JNICALL Java_com_sun_pisces_PiscesRenderer_setSIMDLevelImpl
+(JNIEnv *env, jclass cls, jint level)
+{
+    return piscesSetSIMDLevel(level);
+}
+
 /*
  * Class:     com_sun_pisces_PiscesRenderer
  * Method:    fillLCDAlphaMaskImpl
@@ -789,8 +798,6 @@ static void fillAlphaMask(Renderer* rdr, jint minX, jint minY, jint maxX, jint m
     JNIEnv *env, jobject this, jint maskType, jbyteArray jmask,
     jint x, jint y, jint maskWidth, jint maskHeight, jint offset, jint stride)
 {
-    jint rowsToBeRendered, rowsBeingRendered;
-
     Surface* surface;
     jobject surfaceHandle;
 
@@ -823,25 +830,7 @@ static void fillAlphaMask(Renderer* rdr, jint minX, jint minY, jint maxX, jint m
             rdr->_rowNum = 0;
             rdr->_maskOffset = offset;
 
-            rowsToBeRendered = height;
-
-            while (rowsToBeRendered > 0) {
-                rowsBeingRendered = 1; //MIN(rowsToBeRendered, NUM_ALPHA_ROWS);
-
-                rdr->_currImageOffset = rdr->_currY * surface->width;
-                if (rdr->_genPaint) {
-                    size_t l = (width * rowsBeingRendered);
-                    ALLOC3(rdr->_paint, jint, l);
-                    rdr->_genPaint(rdr, rowsBeingRendered);
-                }
-                rdr->_emitRows(rdr, rowsBeingRendered);
-
-                rdr->_maskOffset += maskWidth;
-                rdr->_rowNum += rowsBeingRendered;
-                rowsToBeRendered -= rowsBeingRendered;
-                rdr->_currX = x;
-                rdr->_currY += rowsBeingRendered;
-            }
+            emitMaskRows(rdr, height, maskWidth, x);
 
             renderer_removeMask(rdr);
             (*env)->ReleasePrimitiveArrayCritical(env, jmask, mask, 0);
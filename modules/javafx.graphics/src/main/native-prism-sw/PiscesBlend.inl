@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Per-pixel blending helpers for the 8888 premultiplied surface, shared
+ * by the blit loops in PiscesBlit.c and the span loops in
+ * PiscesBlitSpans.c.
+ */
+
+#ifndef PISCES_BLEND_INL
+#define PISCES_BLEND_INL
+
+#include <PiscesDefs.h>
+
+#ifndef MAX_ALPHA
+#define MAX_ALPHA 255
+#endif
+
+static INLINE jint div255(jint x) {
+    return (x*257 + 257) >> 16;
+}
+
+static INLINE jint A(jint x) {
+    return (x >> 24) & 0xFF;
+}
+static INLINE jint R(jint x) {
+    return (x >> 16) & 0xFF;
+}
+static INLINE jint G(jint x) {
+    return (x >> 8) & 0xFF;
+}
+static INLINE jint B(jint x) {
+    return x & 0xFF;
+}
+
+// *intData are premultiplied, sred, sgreen, sblue are non-premultiplied
+static INLINE void
+blendSrcOver8888_pre(jint *intData,
+                             jint aval,
+                             jint sred, jint sgreen, jint sblue) {
+    jint ival = *intData;
+    //destination alpha
+    jint dalpha = (ival >> 24) & 0xff;
+    //destination components premultiplied by dalpha
+    jint dred = (ival >> 16) & 0xff;
+    jint dgreen = (ival >> 8) & 0xff;
+    jint dblue = ival & 0xff;
+
+    jint oneminusaval = (255 - aval);
+
+    jint oalpha  = div255(255 * aval    + oneminusaval * dalpha);
+    jint ored    = div255(sred * aval   + oneminusaval * dred);
+    jint ogreen  = div255(sgreen * aval + oneminusaval * dgreen);
+    jint oblue   = div255(sblue * aval  + oneminusaval * dblue);
+
+    *intData = (oalpha << 24) | (ored << 16) | (ogreen << 8) | oblue;
+}
+
+// *intData are premultiplied, sred, sgreen, sblue are premultiplied
+static INLINE void
+blendSrcOver8888_pre_pre(jint *intData, jint frac,
+                             jint aval,
+                             jint sred, jint sgreen, jint sblue) {
+    jint ival = *intData;
+    //destination alpha
+    jint dalpha = (ival >> 24) & 0xff;
+    //destination components premultiplied by dalpha
+    jint dred = (ival >> 16) & 0xff;
+    jint dgreen = (ival >> 8) & 0xff;
+    jint dblue = ival & 0xff;
+
+    jint aval2 = (aval * frac) >> 8;
+    jint oneminusaval = (255 - aval2);
+
+    jint oalpha  = aval2                  + div255(oneminusaval * dalpha);
+    jint ored    = ((sred * frac) >> 8)   + div255(oneminusaval * dred);
+    jint ogreen  = ((sgreen * frac) >> 8) + div255(oneminusaval * dgreen);
+    jint oblue   = ((sblue * frac) >> 8)  + div255(oneminusaval * dblue);
+
+    *intData = (oalpha << 24) | (ored << 16) | (ogreen << 8) | oblue;
+}
+
+// *intData are premultiplied, sred, sgreen, sblue are NOT premultiplied
+// it is required that final alpha must be fully opaque (0xFF)
+static INLINE void
+blendLCDSrcOver8888_pre(jint *intData,
+                             jint ared, jint agreen, jint ablue,
+                             jint sred, jint sgreen, jint sblue,
+                             const jint *gammaArray, const jint *invGammaArray)
+{
+    jint ival = *intData;
+    //destination alpha
+    jint dalpha = (ival >> 24) & 0xff;
+    //destination components premultiplied by dalpha
+    jint dred = (ival >> 16) & 0xff;
+    jint dgreen = (ival >> 8) & 0xff;
+    jint dblue = ival & 0xff;
+
+    jint ored, ogreen, oblue;
+
+    dred = invGammaArray[dred];
+    dgreen = invGammaArray[dgreen];
+    dblue = invGammaArray[dblue];
+
+    ored    = div255(ared * sred     + (255 - ared) * dred);
+    ogreen  = div255(agreen * sgreen + (255 - agreen) * dgreen);
+    oblue   = div255(ablue * sblue   + (255 - ablue) * dblue);
+
+    ored = gammaArray[ored];
+    ogreen = gammaArray[ogreen];
+    oblue = gammaArray[oblue];
+
+    *intData = 0xFF000000 | (ored << 16) | (ogreen << 8) | oblue;
+}
+
+static INLINE void
+blendSrc8888_pre(jint *intData,
+                 jint aval, jint raaval,
+                 jint sred, jint sgreen, jint sblue) {
+    jint denom;
+
+    jint ival = *intData;
+    jint dalpha = (ival >> 24) & 0xff;
+    //premultiplied color components
+    jint dred =   (ival >> 16) & 0xff;
+    jint dgreen = (ival >>  8) & 0xff;
+    jint dblue =  (ival & 0xff);
+
+    denom = 255 * aval + dalpha * raaval;
+    if (denom == 0) {
+        // The output is transparent black
+        *intData = 0x00000000;
+    } else {
+        jint oalpha, ored, ogreen, oblue;
+        oalpha  = div255(denom);
+        ored    = div255(aval * sred   + raaval * dred);
+        ogreen  = div255(aval * sgreen + raaval * dgreen);
+        oblue   = div255(aval * sblue  + raaval * dblue);
+
+        ival = (oalpha << 24) | (ored << 16) | (ogreen << 8) | oblue;
+        *intData = ival;
+    }
+}
+
+// sred, sgreen, sblue are all premultiplied
+static INLINE void
+blendSrc8888_pre_pre(jint *intData,
+                 jint aval, jint raaval,
+                 jint sred, jint sgreen, jint sblue) {
+    jint denom;
+
+    jint ival = *intData;
+    jint dalpha = (ival >> 24) & 0xff;
+    //premultiplied color components
+    jint dred =   (ival >> 16) & 0xff;
+    jint dgreen = (ival >>  8) & 0xff;
+    jint dblue =  (ival & 0xff);
+
+    denom = 255 * aval + dalpha * raaval;
+    if (denom == 0) {
+        // The output is transparent black
+        *intData = 0x00000000;
+    } else {
+        jint oalpha, ored, ogreen, oblue;
+        oalpha  = div255(denom);
+        ored    = sred   + div255(raaval * dred);
+        ogreen  = sgreen + div255(raaval * dgreen);
+        oblue   = sblue  + div255(raaval * dblue);
+
+        ival = (oalpha << 24) | (ored << 16) | (ogreen << 8) | oblue;
+        *intData = ival;
+    }
+}
+
+#endif
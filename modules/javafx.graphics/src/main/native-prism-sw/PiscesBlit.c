@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -24,6 +24,9 @@
  */
 
 #include <PiscesBlit.h>
+#include <PiscesBlitSpans.h>
+#include <PiscesThreads.h>
+#include <PiscesBlend.inl>
 
 #include <PiscesUtil.h>
 #include <PiscesRenderer.h>
@@ -41,40 +44,6 @@ static jfloat currentGamma = -1;
 static jint gammaArray[256];
 static jint invGammaArray[256];
 
-static INLINE void blendSrcOver8888_pre(jint *intData, jint aval, jint sred,
-                                 jint sgreen, jint sblue);
-static INLINE void blendSrcOver8888_pre_pre(jint *intData, jint frac,
-                             jint aval,
-                             jint sred, jint sgreen, jint sblue);
-static INLINE void blendSrcOver8888_pre_pre_fullFrac(jint *intData, jint aval,
-                             jint sred, jint sgreen, jint sblue);
-
-
-static INLINE void blendLCDSrcOver8888_pre(jint *intData,
-    jint ared, jint agreen, jint ablue, jint sred, jint sgreen, jint sblue);
-
-static INLINE void blendSrc8888_pre(jint *intData, jint aval, jint raaval, jint sred,
-                             jint sgreen, jint sblue);
-static INLINE void blendSrc8888_pre_pre(jint *intData, jint aval, jint raaval, jint sred,
-                             jint sgreen, jint sblue);
-
-static INLINE jint div255(jint x) {
-    return (x*257 + 257) >> 16;
-}
-
-static INLINE jint A(jint x) {
-    return (x >> 24) & 0xFF;
-}
-static INLINE jint R(jint x) {
-    return (x >> 16) & 0xFF;
-}
-static INLINE jint G(jint x) {
-    return (x >> 8) & 0xFF;
-}
-static INLINE jint B(jint x) {
-    return x & 0xFF;
-}
-
 void
 emitLineSource8888_pre(Renderer *rdr, jint height, jint frac) {
     jint j, minX, maxX, w, iidx;
@@ -211,7 +180,7 @@ emitLinePTSource8888_pre(Renderer *rdr, jint height, jint frac) {
 
 void
 emitLineSourceOver8888_pre(Renderer *rdr, jint height, jint frac) {
-    jint j, minX, maxX, w, iidx;
+    jint j, k, n, minX, maxX, w, iidx;
 
     jint *intData = rdr->_data;
     jint imageOffset = rdr->_currImageOffset;
@@ -257,6 +226,10 @@ emitLineSourceOver8888_pre(Renderer *rdr, jint height, jint frac) {
     } else {
         jint lalpha = (lfrac * alpha) >> 16;
         jint ralpha = (rfrac * alpha) >> 16;
+        jint aval[PISCES_SPAN_LENGTH];
+        for (k = 0; k < PISCES_SPAN_LENGTH; k++) {
+            aval[k] = alpha;
+        }
         for (j = 0; j < height; j++) {
             iidx = imageOffset + minX * imagePixelStride;
             a = intData + iidx;
@@ -264,10 +237,11 @@ emitLineSourceOver8888_pre(Renderer *rdr, jint height, jint frac) {
                 blendSrcOver8888_pre(a, lalpha, cred, cgreen, cblue);
                 a += imagePixelStride;
             }
-            am = a + w;
-            while (a < am) {
-                blendSrcOver8888_pre(a, alpha, cred, cgreen, cblue);
-                a += imagePixelStride;
+            for (k = 0; k < w; k += n) {
+                n = (w - k < PISCES_SPAN_LENGTH) ? (w - k) : PISCES_SPAN_LENGTH;
+                blendSpanSrcOver8888_pre(a, imagePixelStride, aval, n,
+                    cred, cgreen, cblue);
+                a += n * imagePixelStride;
             }
             if (rfrac) {
                 blendSrcOver8888_pre(a, ralpha, cred, cgreen, cblue);
@@ -279,7 +253,8 @@ emitLineSourceOver8888_pre(Renderer *rdr, jint height, jint frac) {
 
 void
 emitLinePTSourceOver8888_pre(Renderer *rdr, jint height, jint frac) {
-    jint j, minX, maxX, w, iidx, aidx;
+    jint j, k, n, minX, maxX, w, iidx, aidx;
+    jint fullFrac[PISCES_SPAN_LENGTH];
     jint paint_offset = 0;
 
     jint *intData = rdr->_data;
@@ -288,7 +263,7 @@ emitLinePTSourceOver8888_pre(Renderer *rdr, jint height, jint frac) {
     jint imagePixelStride = rdr->_imagePixelStride;
 
     jint* paint = rdr->_paint;
-    jint cval, palpha, paint_stride;
+    jint cval, paint_stride;
 
     jint *a, *am;
     jlong llfrac = (rdr->_el_lfrac * (jlong)frac);
@@ -302,6 +277,10 @@ emitLinePTSourceOver8888_pre(Renderer *rdr, jint height, jint frac) {
     w -= (lfrac) ? 1 : 0;
     w -= (rfrac) ? 1 : 0;
 
+    for (k = 0; k < PISCES_SPAN_LENGTH; k++) {
+        fullFrac[k] = 1 << 8;
+    }
+
     for (j = 0; j < height; j++) {
         aidx = paint_offset;
         iidx = imageOffset + minX * imagePixelStride;
@@ -314,21 +293,12 @@ emitLinePTSourceOver8888_pre(Renderer *rdr, jint height, jint frac) {
         }
         am = a + w;
         if (frac == 0x10000) { // full coverage
-            while (a < am) {
-                cval = paint[aidx];
-                palpha = A(cval);
-                switch (palpha) {
-                case 0:
-                    break;
-                case MAX_ALPHA:
-                    *a = cval;
-                    break;
-                default:
-                    blendSrcOver8888_pre_pre_fullFrac(a, palpha, R(cval), G(cval), B(cval));
-                    break;
-                }
-                a += imagePixelStride;
-                aidx++;
+            for (k = 0; k < w; k += n) {
+                n = (w - k < PISCES_SPAN_LENGTH) ? (w - k) : PISCES_SPAN_LENGTH;
+                blendSpanPTSrcOver8888_pre(a, imagePixelStride, paint + aidx,
+                    fullFrac, n);
+                a += n * imagePixelStride;
+                aidx += n;
             }
         } else {
             while (a < am) {
@@ -350,18 +320,17 @@ emitLinePTSourceOver8888_pre(Renderer *rdr, jint height, jint frac) {
 
 void
 blitSrc8888_pre(Renderer *rdr, jint height) {
-    jint j;
+    jint j, k, n;
     jint minX, maxX, w;
-    jint iidx, aval, acoverage;
+    jint iidx;
     jint aval_relative;
+    jint coverage[PISCES_SPAN_LENGTH];
 
     jint *intData = rdr->_data;
     jint imageOffset = rdr->_currImageOffset;
     jint imageScanlineStride = rdr->_imageScanlineStride;
     jint imagePixelStride = rdr->_imagePixelStride;
     jint *alpha = rdr->_rowAAInt;
-    jint alphaOffset = 0;
-    jint alphaStride = rdr->_alphaWidth;
 
     jint *a, *am;
 
@@ -382,29 +351,31 @@ blitSrc8888_pre(Renderer *rdr, jint height) {
         a = alpha;
         am = a + w;
         while (a < am) {
-            aval_relative += *a;
-            *a++ = 0;
-            acoverage = alphaMap[aval_relative] & 0xff;
-            if (acoverage == MAX_ALPHA) {
-                intData[iidx] = (calpha << 24) | (cred << 16) | (cgreen << 8) | cblue;
-            } else if (acoverage > 0) {
-                aval = ((acoverage+1) * calpha) >> 8;
-                blendSrc8888_pre(&intData[iidx], aval, 255 - acoverage,
-                    cred, cgreen, cblue);
+            n = (jint)(am - a);
+            if (n > PISCES_SPAN_LENGTH) {
+                n = PISCES_SPAN_LENGTH;
             }
-            iidx += imagePixelStride;
+            for (k = 0; k < n; k++) {
+                aval_relative += a[k];
+                a[k] = 0;
+                coverage[k] = alphaMap[aval_relative] & 0xff;
+            }
+            blendSpanSrc8888_pre(&intData[iidx], imagePixelStride, coverage, n,
+                calpha, cred, cgreen, cblue);
+            a += n;
+            iidx += n * imagePixelStride;
         }
 
         imageOffset += imageScanlineStride;
-        alphaOffset += alphaStride;
     }
 }
 
 void
 blitSrcMask8888_pre(Renderer *rdr, jint height) {
-    jint j;
+    jint j, k, n;
     jint minX, maxX, w;
-    jint iidx, aval, acoverage;
+    jint iidx;
+    jint coverage[PISCES_SPAN_LENGTH];
 
     jint *intData = rdr->_data;
     jint imageOffset = rdr->_currImageOffset;
@@ -431,16 +402,17 @@ blitSrcMask8888_pre(Renderer *rdr, jint height) {
         a = alpha + alphaOffset;
         am = a + w;
         while (a < am) {
-            acoverage = *a++ & 0xff;
-            // run in integers otherwise it overflows
-            if (acoverage == MAX_ALPHA) {
-                intData[iidx] = (calpha << 24) | (cred << 16) | (cgreen << 8) | cblue;
-            } else if (acoverage > 0) {
-                aval = ((acoverage+1) * calpha) >> 8;
-                blendSrc8888_pre(&intData[iidx], aval, 255 - acoverage,
-                    cred, cgreen, cblue);
+            n = (jint)(am - a);
+            if (n > PISCES_SPAN_LENGTH) {
+                n = PISCES_SPAN_LENGTH;
+            }
+            for (k = 0; k < n; k++) {
+                coverage[k] = a[k] & 0xff;
             }
-            iidx += imagePixelStride;
+            blendSpanSrc8888_pre(&intData[iidx], imagePixelStride, coverage, n,
+                calpha, cred, cgreen, cblue);
+            a += n;
+            iidx += n * imagePixelStride;
         }
 
         imageOffset += imageScanlineStride;
@@ -450,10 +422,11 @@ blitSrcMask8888_pre(Renderer *rdr, jint height) {
 
 void
 blitPTSrc8888_pre(Renderer *rdr, jint height) {
-    jint j;
+    jint j, k, n;
     jint minX, maxX, w;
-    jint cval, aidx, iidx, aval, acoverage;
+    jint aidx, iidx;
     jint aval_relative;
+    jint coverage[PISCES_SPAN_LENGTH];
 
     jint *intData = rdr->_data;
     jint imageOffset = rdr->_currImageOffset;
@@ -466,7 +439,6 @@ blitPTSrc8888_pre(Renderer *rdr, jint height) {
     jbyte *alphaMap = rdr->alphaMap;
 
     jint* paint = rdr->_paint;
-    jint palpha;
 
     minX = rdr->_minTouched;
     maxX = rdr->_maxTouched;
@@ -480,24 +452,23 @@ blitPTSrc8888_pre(Renderer *rdr, jint height) {
         a = alpha;
         am = a + w;
         while (a < am) {
+            n = (jint)(am - a);
+            if (n > PISCES_SPAN_LENGTH) {
+                n = PISCES_SPAN_LENGTH;
+            }
             assert(aidx >= 0);
-            assert(aidx < rdr->_paint_length);
-
-            cval = paint[aidx];
-            palpha = A(cval);
+            assert(aidx + n <= rdr->_paint_length);
 
-            aval_relative += *a;
-            *a++ = 0;
-            acoverage = alphaMap[aval_relative] & 0xff;
-
-            if (acoverage == MAX_ALPHA) {
-                intData[iidx] = cval;
-            } else if (acoverage > 0) {
-                aval = ((acoverage+1) * palpha) >> 8;
-                blendSrc8888_pre_pre(&intData[iidx], aval, 255 - acoverage, R(cval), G(cval), B(cval));
+            for (k = 0; k < n; k++) {
+                aval_relative += a[k];
+                a[k] = 0;
+                coverage[k] = alphaMap[aval_relative] & 0xff;
             }
-            iidx += imagePixelStride;
-            ++aidx;
+            blendSpanPTSrc8888_pre(&intData[iidx], imagePixelStride,
+                paint + aidx, coverage, n);
+            a += n;
+            iidx += n * imagePixelStride;
+            aidx += n;
         }
 
         imageOffset += imageScanlineStride;
@@ -506,9 +477,10 @@ blitPTSrc8888_pre(Renderer *rdr, jint height) {
 
 void
 blitPTSrcMask8888_pre(Renderer *rdr, jint height) {
-    jint j;
+    jint j, k, n;
     jint minX, maxX, w;
-    jint cval, aidx, iidx, aval, acoverage;
+    jint aidx, iidx;
+    jint coverage[PISCES_SPAN_LENGTH];
 
     jint *intData = rdr->_data;
     jint imageOffset = rdr->_currImageOffset;
@@ -520,7 +492,6 @@ blitPTSrcMask8888_pre(Renderer *rdr, jint height) {
     jbyte *a, *am;
 
     jint* paint = rdr->_paint;
-    jint palpha;
 
     minX = rdr->_minTouched;
     maxX = rdr->_maxTouched;
@@ -533,19 +504,18 @@ blitPTSrcMask8888_pre(Renderer *rdr, jint height) {
         a = alpha + alphaOffset;
         am = a + w;
         while (a < am) {
-            cval = paint[aidx];
-            palpha = A(cval);
-
-            acoverage = *a++ & 0xff;
-
-            if (acoverage == MAX_ALPHA) {
-                intData[iidx] = cval;
-            } else if (acoverage > 0) {
-                aval = ((acoverage+1) * palpha) >> 8;
-                blendSrc8888_pre_pre(&intData[iidx], aval, 255 - acoverage, R(cval), G(cval), B(cval));
+            n = (jint)(am - a);
+            if (n > PISCES_SPAN_LENGTH) {
+                n = PISCES_SPAN_LENGTH;
+            }
+            for (k = 0; k < n; k++) {
+                coverage[k] = a[k] & 0xff;
             }
-            iidx += imagePixelStride;
-            ++aidx;
+            blendSpanPTSrc8888_pre(&intData[iidx], imagePixelStride,
+                paint + aidx, coverage, n);
+            a += n;
+            iidx += n * imagePixelStride;
+            aidx += n;
         }
 
         imageOffset += imageScanlineStride;
@@ -554,18 +524,17 @@ blitPTSrcMask8888_pre(Renderer *rdr, jint height) {
 
 void
 blitSrcOver8888_pre(Renderer *rdr, jint height) {
-    jint j;
+    jint j, k, n;
     jint minX, maxX, w;
-    jint  iidx, aval;
+    jint iidx;
     jint aval_relative;
+    jint aval[PISCES_SPAN_LENGTH];
 
     jint *intData = rdr->_data;
     jint imageOffset = rdr->_currImageOffset;
     jint imageScanlineStride = rdr->_imageScanlineStride;
     jint imagePixelStride = rdr->_imagePixelStride;
     jint *alpha = rdr->_rowAAInt;
-    jint alphaOffset = 0;
-    jint alphaStride = rdr->_alphaWidth;
 
     jint *a, *am;
 
@@ -586,30 +555,33 @@ blitSrcOver8888_pre(Renderer *rdr, jint height) {
         a = alpha;
         am = a + w;
         while (a < am) {
-            aval_relative += *a;
-            *a++ = 0;
-            if (aval_relative) {
-                aval = alphaMap[aval_relative] & 0xff;
-                aval = ((aval+1) * calpha) >> 8;
-                if (aval == MAX_ALPHA) {
-                    intData[iidx] = 0xff000000 | (cred << 16) | (cgreen << 8) | cblue;
-                } else if (aval > 0) {
-                    blendSrcOver8888_pre(&intData[iidx], aval, cred, cgreen, cblue);
-                }
+            n = (jint)(am - a);
+            if (n > PISCES_SPAN_LENGTH) {
+                n = PISCES_SPAN_LENGTH;
+            }
+            for (k = 0; k < n; k++) {
+                aval_relative += a[k];
+                a[k] = 0;
+                aval[k] = (aval_relative)
+                    ? (((alphaMap[aval_relative] & 0xff) + 1) * calpha) >> 8
+                    : 0;
             }
-            iidx += imagePixelStride;
+            blendSpanSrcOver8888_pre(&intData[iidx], imagePixelStride, aval, n,
+                cred, cgreen, cblue);
+            a += n;
+            iidx += n * imagePixelStride;
         }
 
         imageOffset += imageScanlineStride;
-        alphaOffset += alphaStride;
     }
 }
 
 void
 blitSrcOverMask8888_pre(Renderer *rdr, jint height) {
-    jint j;
+    jint j, k, n;
     jint minX, maxX, w;
-    jint iidx, aval;
+    jint iidx;
+    jint aval[PISCES_SPAN_LENGTH];
 
     jint *intData = rdr->_data;
     jint imageOffset = rdr->_currImageOffset;
@@ -636,18 +608,18 @@ blitSrcOverMask8888_pre(Renderer *rdr, jint height) {
         a = alpha + alphaOffset;
         am = a + w;
         while (a < am) {
-            if (*a) {
-                aval = *a & 0xff;
+            n = (jint)(am - a);
+            if (n > PISCES_SPAN_LENGTH) {
+                n = PISCES_SPAN_LENGTH;
+            }
+            for (k = 0; k < n; k++) {
                 // run in integers otherwise it overflows
-                aval = ((aval+1) * calpha) >> 8;
-                if (aval == MAX_ALPHA) {
-                    intData[iidx] = 0xff000000 | (cred << 16) | (cgreen << 8) | cblue;
-                } else if (aval > 0) {
-                    blendSrcOver8888_pre(&intData[iidx], aval, cred, cgreen, cblue);
-                }
+                aval[k] = (a[k]) ? (((a[k] & 0xff) + 1) * calpha) >> 8 : 0;
             }
-            a++;
-            iidx += imagePixelStride;
+            blendSpanSrcOver8888_pre(&intData[iidx], imagePixelStride, aval, n,
+                cred, cgreen, cblue);
+            a += n;
+            iidx += n * imagePixelStride;
         }
 
         imageOffset += imageScanlineStride;
@@ -659,7 +631,7 @@ void
 blitSrcOverLCDMask8888_pre(Renderer *rdr, jint height) {
     jint j;
     jint minX, maxX, w;
-    jint iidx, aval_ismax, ared, agreen, ablue;
+    jint iidx;
 
     jint *intData = rdr->_data;
     jint imageOffset = rdr->_currImageOffset;
@@ -669,8 +641,6 @@ blitSrcOverLCDMask8888_pre(Renderer *rdr, jint height) {
     jint alphaOffset = rdr->_maskOffset;
     jint alphaStride = rdr->_alphaWidth;
 
-    jbyte *a, *am;
-
     jint calpha = invGammaArray[rdr->_calpha];
     jint cred = invGammaArray[rdr->_cred];
     jint cgreen = invGammaArray[rdr->_cgreen];
@@ -683,26 +653,9 @@ blitSrcOverLCDMask8888_pre(Renderer *rdr, jint height) {
     for (j = 0; j < height; j++) {
         iidx = imageOffset + minX * imagePixelStride;
 
-        a = alpha + alphaOffset;
-        am = a + 3*w;
-        while (a < am) {
-            ared = *a++ & 0xff;
-            agreen = *a++ & 0xff;
-            ablue = *a++ & 0xff;
-            if (calpha < MAX_ALPHA) {
-                ared = ((ared+1) * calpha) >> 8;
-                agreen = ((agreen+1) * calpha) >> 8;
-                ablue = ((ablue+1) * calpha) >> 8;
-            }
-            aval_ismax = ared & agreen & ablue;
-            if (aval_ismax == MAX_ALPHA) {
-                intData[iidx] = 0xff000000 | (cred << 16) | (cgreen << 8) | cblue;
-            } else {
-                blendLCDSrcOver8888_pre(&intData[iidx], ared, agreen, ablue,
-                    cred, cgreen, cblue);
-            }
-            iidx += imagePixelStride;
-        }
+        blendSpanLCDSrcOver8888_pre(&intData[iidx], imagePixelStride,
+            alpha + alphaOffset, w, calpha, cred, cgreen, cblue,
+            gammaArray, invGammaArray);
 
         imageOffset += imageScanlineStride;
         alphaOffset += alphaStride;
@@ -711,10 +664,11 @@ blitSrcOverLCDMask8888_pre(Renderer *rdr, jint height) {
 
 void
 blitPTSrcOver8888_pre(Renderer *rdr, jint height) {
-    jint j;
+    jint j, k, n;
     jint minX, maxX, w;
-    jint cval, aidx, iidx, aval;
+    jint aidx, iidx;
     jint aval_relative;
+    jint frac[PISCES_SPAN_LENGTH];
 
     jint *intData = rdr->_data;
     jint imageOffset = rdr->_currImageOffset;
@@ -727,7 +681,6 @@ blitPTSrcOver8888_pre(Renderer *rdr, jint height) {
     jbyte *alphaMap = rdr->alphaMap;
 
     jint* paint = rdr->_paint;
-    jint palpha, malpha;
 
     minX = rdr->_minTouched;
     maxX = rdr->_maxTouched;
@@ -741,26 +694,25 @@ blitPTSrcOver8888_pre(Renderer *rdr, jint height) {
         a = alpha;
         am = a + w;
         while (a < am) {
+            n = (jint)(am - a);
+            if (n > PISCES_SPAN_LENGTH) {
+                n = PISCES_SPAN_LENGTH;
+            }
             assert(aidx >= 0);
-            assert(aidx < rdr->_paint_length);
-
-            cval = paint[aidx];
-            palpha = A(cval);
-
-            aval_relative += *a;
-            *a++ = 0;
-            if (aval_relative) {
-                malpha = alphaMap[aval_relative] & 0xff;
-                aval = ((malpha+1) * palpha) >> 8;
-
-                if (aval == MAX_ALPHA) {
-                    intData[iidx] = cval;
-                } else if (aval > 0) {
-                    blendSrcOver8888_pre_pre(&intData[iidx], malpha+1, palpha, R(cval), G(cval), B(cval));
-                }
+            assert(aidx + n <= rdr->_paint_length);
+
+            for (k = 0; k < n; k++) {
+                aval_relative += a[k];
+                a[k] = 0;
+                frac[k] = (aval_relative)
+                    ? (alphaMap[aval_relative] & 0xff) + 1
+                    : 0;
             }
-            iidx += imagePixelStride;
-            ++aidx;
+            blendSpanPTSrcOver8888_pre(&intData[iidx], imagePixelStride,
+                paint + aidx, frac, n);
+            a += n;
+            iidx += n * imagePixelStride;
+            aidx += n;
         }
 
         imageOffset += imageScanlineStride;
@@ -769,9 +721,10 @@ blitPTSrcOver8888_pre(Renderer *rdr, jint height) {
 
 void
 blitPTSrcOverMask8888_pre(Renderer *rdr, jint height) {
-    jint j;
+    jint j, k, n;
     jint minX, maxX, w;
-    jint cval, aidx, iidx, aval;
+    jint aidx, iidx;
+    jint frac[PISCES_SPAN_LENGTH];
 
     jint *intData = rdr->_data;
     jint imageOffset = rdr->_currImageOffset;
@@ -783,7 +736,6 @@ blitPTSrcOverMask8888_pre(Renderer *rdr, jint height) {
     jbyte *a, *am;
 
     jint* paint = rdr->_paint;
-    jint palpha, malpha;
 
     minX = rdr->_minTouched;
     maxX = rdr->_maxTouched;
@@ -796,22 +748,18 @@ blitPTSrcOverMask8888_pre(Renderer *rdr, jint height) {
         a = alpha + alphaOffset;
         am = a + w;
         while (a < am) {
-            if (*a) {
-                cval = paint[aidx];
-                palpha = A(cval);
-
-                malpha = *a & 0xff;
-                aval = ((malpha+1) * palpha) >> 8;
-
-                if (aval == MAX_ALPHA) {
-                    intData[iidx] = cval;
-                } else if (aval > 0) {
-                    blendSrcOver8888_pre_pre(&intData[iidx], malpha+1, palpha, R(cval), G(cval), B(cval));
-                }
+            n = (jint)(am - a);
+            if (n > PISCES_SPAN_LENGTH) {
+                n = PISCES_SPAN_LENGTH;
+            }
+            for (k = 0; k < n; k++) {
+                frac[k] = (a[k]) ? (a[k] & 0xff) + 1 : 0;
             }
-            a++;
-            iidx += imagePixelStride;
-            ++aidx;
+            blendSpanPTSrcOver8888_pre(&intData[iidx], imagePixelStride,
+                paint + aidx, frac, n);
+            a += n;
+            iidx += n * imagePixelStride;
+            aidx += n;
         }
 
         imageOffset += imageScanlineStride;
@@ -860,165 +808,151 @@ clearRect8888_any(Renderer *rdr, jint x, jint y, jint w, jint h) {
     //fflush(stdout);
 }
 
-// *intData are premultiplied, sred, sgreen, sblue are non-premultiplied
-static void
-blendSrcOver8888_pre(jint *intData,
-                             jint aval,
-                             jint sred, jint sgreen, jint sblue) {
-    jint ival = *intData;
-    //destination alpha
-    jint dalpha = (ival >> 24) & 0xff;
-    //destination components premultiplied by dalpha
-    jint dred = (ival >> 16) & 0xff;
-    jint dgreen = (ival >> 8) & 0xff;
-    jint dblue = ival & 0xff;
-
-    jint oneminusaval = (255 - aval);
-
-    jint oalpha  = div255(255 * aval    + oneminusaval * dalpha);
-    jint ored    = div255(sred * aval   + oneminusaval * dred);
-    jint ogreen  = div255(sgreen * aval + oneminusaval * dgreen);
-    jint oblue   = div255(sblue * aval  + oneminusaval * dblue);
-
-    *intData = (oalpha << 24) | (ored << 16) | (ogreen << 8) | oblue;
-}
+/* BANDED ROWS routines */
 
-// *intData are premultiplied, sred, sgreen, sblue are premultiplied
-static void
-blendSrcOver8888_pre_pre(jint *intData, jint frac,
-                             jint aval,
-                             jint sred, jint sgreen, jint sblue) {
-    jint ival = *intData;
-    //destination alpha
-    jint dalpha = (ival >> 24) & 0xff;
-    //destination components premultiplied by dalpha
-    jint dred = (ival >> 16) & 0xff;
-    jint dgreen = (ival >> 8) & 0xff;
-    jint dblue = ival & 0xff;
-
-    jint aval2 = (aval * frac) >> 8;
-    jint oneminusaval = (255 - aval2);
-
-    jint oalpha  = aval2                  + div255(oneminusaval * dalpha);
-    jint ored    = ((sred * frac) >> 8)   + div255(oneminusaval * dred);
-    jint ogreen  = ((sgreen * frac) >> 8) + div255(oneminusaval * dgreen);
-    jint oblue   = ((sblue * frac) >> 8)  + div255(oneminusaval * dblue);
-
-    *intData = (oalpha << 24) | (ored << 16) | (ogreen << 8) | oblue;
+typedef struct {
+    Renderer *rdr;
+    jint lines;
+    jint maskWidth;
+    jint x;
+} RowBands;
+
+/*
+ * Returns the renderer a band of rows is drawn with, positioned at the
+ * first row of the band: the shared one when the band is the whole fill,
+ * otherwise a copy with its own paint buffer. The paint buffer is made
+ * large enough for paintRows rows. Returns NULL and sets the memory error
+ * flag if an allocation fails.
+ */
+static Renderer *
+bandRenderer(RowBands *bands, jint start, jint end, jint paintRows) {
+    Renderer *rdr = bands->rdr;
+    if (start != 0 || end != bands->lines) {
+        Renderer *copy = my_malloc(Renderer, 1);
+        if (copy == NULL) {
+            setMemErrorFlag();
+            return NULL;
+        }
+        memcpy(copy, rdr, sizeof(Renderer));
+        copy->_paint = NULL;
+        copy->_paint_length = 0;
+        rdr = copy;
+    }
+    if (rdr->_genPaint) {
+        size_t l = rdr->_alphaWidth * paintRows;
+        ALLOC3(rdr->_paint, jint, l);
+        if (rdr->_paint == NULL) {
+            rdr->_paint_length = 0;
+            setMemErrorFlag();
+            if (rdr != bands->rdr) {
+                my_free(rdr);
+            }
+            return NULL;
+        }
+    }
+    rdr->_currY += start;
+    rdr->_currImageOffset = rdr->_currY * rdr->_imageScanlineStride;
+    rdr->_rowNum += start;
+    rdr->_maskOffset += start * bands->maskWidth;
+    return rdr;
 }
 
-// *intData are premultiplied, sred, sgreen, sblue are premultiplied
 static void
-blendSrcOver8888_pre_pre_fullFrac(jint *intData, jint aval,
-                             jint sred, jint sgreen, jint sblue) {
-    jint ival = *intData;
-    //destination alpha
-    jint dalpha = (ival >> 24) & 0xff;
-    //destination components premultiplied by dalpha
-    jint dred = (ival >> 16) & 0xff;
-    jint dgreen = (ival >> 8) & 0xff;
-    jint dblue = ival & 0xff;
-
-    jint oneminusaval = (255 - aval);
-
-    jint oalpha  = aval   + div255(oneminusaval * dalpha);
-    jint ored    = sred   + div255(oneminusaval * dred);
-    jint ogreen  = sgreen + div255(oneminusaval * dgreen);
-    jint oblue   = sblue  + div255(oneminusaval * dblue);
-
-    *intData = (oalpha << 24) | (ored << 16) | (ogreen << 8) | oblue;
+releaseBandRenderer(RowBands *bands, Renderer *rdr) {
+    if (rdr != bands->rdr) {
+        my_free(rdr->_paint);
+        my_free(rdr);
+    }
 }
 
-// *intData are premultiplied, sred, sgreen, sblue are NOT premultiplied
-// it is required that final alpha must be fully opaque (0xFF)
 static void
-blendLCDSrcOver8888_pre(jint *intData,
-                             jint ared, jint agreen, jint ablue,
-                             jint sred, jint sgreen, jint sblue)
-{
-    jint ival = *intData;
-    //destination alpha
-    jint dalpha = (ival >> 24) & 0xff;
-    //destination components premultiplied by dalpha
-    jint dred = (ival >> 16) & 0xff;
-    jint dgreen = (ival >> 8) & 0xff;
-    jint dblue = ival & 0xff;
-
-    jint ored, ogreen, oblue;
-
-    dred = invGammaArray[dred];
-    dgreen = invGammaArray[dgreen];
-    dblue = invGammaArray[dblue];
-
-    ored    = div255(ared * sred     + (255 - ared) * dred);
-    ogreen  = div255(agreen * sgreen + (255 - agreen) * dgreen);
-    oblue   = div255(ablue * sblue   + (255 - ablue) * dblue);
-
-    ored = gammaArray[ored];
-    ogreen = gammaArray[ogreen];
-    oblue = gammaArray[oblue];
-
-    *intData = 0xFF000000 | (ored << 16) | (ogreen << 8) | oblue;
+emitRectBand(void *data, jint start, jint end) {
+    RowBands *bands = (RowBands *)data;
+    Renderer *rdr = bandRenderer(bands, start, end, MIN(end - start, NUM_ALPHA_ROWS));
+    jint rowsToBeRendered, rowsBeingRendered;
+
+    if (rdr == NULL) {
+        return;
+    }
+    rowsToBeRendered = end - start;
+    while (rowsToBeRendered > 0) {
+        rowsBeingRendered = MIN(rowsToBeRendered, NUM_ALPHA_ROWS);
+
+        if (rdr->_genPaint) {
+            rdr->_genPaint(rdr, rowsBeingRendered);
+        }
+        rdr->_emitLine(rdr, rowsBeingRendered, 0x10000);
+
+        rowsToBeRendered -= rowsBeingRendered;
+        rdr->_currX = bands->x;
+        rdr->_currY += rowsBeingRendered;
+        rdr->_currImageOffset = rdr->_currY * rdr->_imageScanlineStride;
+        rdr->_rowNum += rowsBeingRendered;
+    }
+    releaseBandRenderer(bands, rdr);
 }
 
 static void
-blendSrc8888_pre(jint *intData,
-                 jint aval, jint raaval,
-                 jint sred, jint sgreen, jint sblue) {
-    jint denom;
-
-    jint ival = *intData;
-    jint dalpha = (ival >> 24) & 0xff;
-    //premultiplied color components
-    jint dred =   (ival >> 16) & 0xff;
-    jint dgreen = (ival >>  8) & 0xff;
-    jint dblue =  (ival & 0xff);
-
-    denom = 255 * aval + dalpha * raaval;
-    if (denom == 0) {
-        // The output is transparent black
-        *intData = 0x00000000;
-    } else {
-        jint oalpha, ored, ogreen, oblue;
-        oalpha  = div255(denom);
-        ored    = div255(aval * sred   + raaval * dred);
-        ogreen  = div255(aval * sgreen + raaval * dgreen);
-        oblue   = div255(aval * sblue  + raaval * dblue);
-
-        ival = (oalpha << 24) | (ored << 16) | (ogreen << 8) | oblue;
-        *intData = ival;
+emitMaskBand(void *data, jint start, jint end) {
+    RowBands *bands = (RowBands *)data;
+    Renderer *rdr = bandRenderer(bands, start, end, 1);
+    jint rowsToBeRendered;
+
+    if (rdr == NULL) {
+        return;
+    }
+    // every row but the first starts at the mask edge
+    if (start > 0) {
+        rdr->_currX = bands->x;
+    }
+    for (rowsToBeRendered = end - start; rowsToBeRendered > 0; rowsToBeRendered--) {
+        if (rdr->_genPaint) {
+            rdr->_genPaint(rdr, 1);
+        }
+        rdr->_emitRows(rdr, 1);
+
+        rdr->_maskOffset += bands->maskWidth;
+        rdr->_rowNum++;
+        rdr->_currX = bands->x;
+        rdr->_currY++;
+        rdr->_currImageOffset = rdr->_currY * rdr->_imageScanlineStride;
     }
+    releaseBandRenderer(bands, rdr);
 }
 
-// sred, sgreen, sblue are all premultiplied
 static void
-blendSrc8888_pre_pre(jint *intData,
-                 jint aval, jint raaval,
-                 jint sred, jint sgreen, jint sblue) {
-    jint denom;
-
-    jint ival = *intData;
-    jint dalpha = (ival >> 24) & 0xff;
-    //premultiplied color components
-    jint dred =   (ival >> 16) & 0xff;
-    jint dgreen = (ival >>  8) & 0xff;
-    jint dblue =  (ival & 0xff);
-
-    denom = 255 * aval + dalpha * raaval;
-    if (denom == 0) {
-        // The output is transparent black
-        *intData = 0x00000000;
-    } else {
-        jint oalpha, ored, ogreen, oblue;
-        oalpha  = div255(denom);
-        ored    = sred   + div255(raaval * dred);
-        ogreen  = sgreen + div255(raaval * dgreen);
-        oblue   = sblue  + div255(raaval * dblue);
-
-        ival = (oalpha << 24) | (ored << 16) | (ogreen << 8) | oblue;
-        *intData = ival;
+emitBands(Renderer *rdr, jint rows, jint maskWidth, jint x, PiscesBandFunc func) {
+    RowBands bands;
+    jint currY = rdr->_currY;
+    jint rowNum = rdr->_rowNum;
+    jint maskOffset = rdr->_maskOffset;
+
+    if (rows <= 0) {
+        return;
     }
+    bands.rdr = rdr;
+    bands.lines = rows;
+    bands.maskWidth = maskWidth;
+    bands.x = x;
+    piscesRunBands(rows, rdr->_alphaWidth, func, &bands);
+
+    rdr->_currX = x;
+    rdr->_currY = currY + rows;
+    rdr->_currImageOffset = rdr->_currY * rdr->_imageScanlineStride;
+    rdr->_rowNum = rowNum + rows;
+    rdr->_maskOffset = maskOffset + rows * maskWidth;
+}
+
+void
+emitRectRows(Renderer *rdr, jint rows) {
+    emitBands(rdr, rows, 0, rdr->_currX, emitRectBand);
+}
+
+void
+emitMaskRows(Renderer *rdr, jint rows, jint maskWidth, jint x) {
+    emitBands(rdr, rows, maskWidth, x, emitMaskBand);
 }
+/* BANDED ROWS routines END */
 
 void initGammaArrays(jfloat gamma) {
     if (currentGamma != gamma) {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -65,4 +65,18 @@ void emitLinePTSource8888_pre(Renderer *rdr, jint height, jint frac);
 void emitLineSourceOver8888_pre(Renderer *rdr, jint height, jint frac);
 void emitLinePTSourceOver8888_pre(Renderer *rdr, jint height, jint frac);
 
+/*
+ * Emits the next 'rows' full rows of the rectangle set up by fillRect,
+ * starting at the renderer's _currY, and advances the row state past
+ * them. Disjoint bands of rows run on the renderer threads when
+ * piscesSetThreading() allows it.
+ */
+void emitRectRows(Renderer *rdr, jint rows);
+
+/*
+ * Same as emitRectRows() for the rows of the current alpha or LCD mask.
+ * maskWidth is the length of a mask row and x the left edge of the mask.
+ */
+void emitMaskRows(Renderer *rdr, jint rows, jint maskWidth, jint x);
+
 #endif
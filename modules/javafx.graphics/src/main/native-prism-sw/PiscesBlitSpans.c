@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <PiscesBlitSpans.h>
+#include <PiscesBlend.inl>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define PISCES_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define PISCES_NEON
+#include <arm_neon.h>
+#endif
+
+static jint simdLevel = -1;
+
+static jint detectSIMDLevel() {
+#if defined(PISCES_X86)
+#ifdef _MSC_VER
+    int info[4];
+    int maxLeaf;
+    __cpuid(info, 0);
+    maxLeaf = info[0];
+    __cpuid(info, 1);
+    if ((info[3] & (1 << 26)) == 0) {
+        return PISCES_SIMD_NONE;
+    }
+    // AVX2 also needs the OS to save the YMM registers (OSXSAVE + XCR0).
+    if (maxLeaf >= 7 && (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0
+            && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        if ((info[1] & (1 << 5)) != 0) {
+            return PISCES_SIMD_AVX2;
+        }
+    }
+    return PISCES_SIMD_SSE2;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return PISCES_SIMD_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return PISCES_SIMD_SSE2;
+    }
+    return PISCES_SIMD_NONE;
+#endif
+#elif defined(PISCES_NEON)
+    return PISCES_SIMD_NEON;
+#else
+    return PISCES_SIMD_NONE;
+#endif
+}
+
+jint piscesGetSIMDLevel() {
+    // Benign race: every thread computes the same value.
+    if (simdLevel < 0) {
+        simdLevel = detectSIMDLevel();
+    }
+    return simdLevel;
+}
+
+jint piscesSetSIMDLevel(jint level) {
+    jint supported = detectSIMDLevel();
+    jboolean ok;
+    switch (level) {
+    case PISCES_SIMD_SSE2:
+        ok = (supported == PISCES_SIMD_SSE2 || supported == PISCES_SIMD_AVX2);
+        break;
+    case PISCES_SIMD_AVX2:
+    case PISCES_SIMD_NEON:
+        ok = (supported == level);
+        break;
+    default:
+        ok = XNI_FALSE;
+        break;
+    }
+    simdLevel = ok ? level : PISCES_SIMD_NONE;
+    return simdLevel;
+}
+
+/* Scalar span loops, also used for the tails of the SIMD ones. */
+
+static void
+blendSpanSrcOver8888_pre_scalar(jint *intData, jint pixelStride,
+                                const jint *aval, jint count,
+                                jint cred, jint cgreen, jint cblue) {
+    jint i;
+    jint solid = 0xff000000 | (cred << 16) | (cgreen << 8) | cblue;
+    for (i = 0; i < count; i++) {
+        if (aval[i] == MAX_ALPHA) {
+            *intData = solid;
+        } else if (aval[i] > 0) {
+            blendSrcOver8888_pre(intData, aval[i], cred, cgreen, cblue);
+        }
+        intData += pixelStride;
+    }
+}
+
+static void
+blendSpanSrc8888_pre_scalar(jint *intData, jint pixelStride,
+                            const jint *coverage, jint count,
+                            jint calpha, jint cred, jint cgreen, jint cblue) {
+    jint i, acoverage, aval;
+    jint solid = (calpha << 24) | (cred << 16) | (cgreen << 8) | cblue;
+    for (i = 0; i < count; i++) {
+        acoverage = coverage[i];
+        if (acoverage == MAX_ALPHA) {
+            *intData = solid;
+        } else if (acoverage > 0) {
+            aval = ((acoverage+1) * calpha) >> 8;
+            blendSrc8888_pre(intData, aval, 255 - acoverage,
+                cred, cgreen, cblue);
+        }
+        intData += pixelStride;
+    }
+}
+
+static void
+blendSpanPTSrcOver8888_pre_scalar(jint *intData, jint pixelStride,
+                                  const jint *paint, const jint *frac, jint count) {
+    jint i, cval, palpha, aval;
+    for (i = 0; i < count; i++) {
+        if (frac[i]) {
+            cval = paint[i];
+            palpha = A(cval);
+            aval = (frac[i] * palpha) >> 8;
+            if (aval == MAX_ALPHA) {
+                *intData = cval;
+            } else if (aval > 0) {
+                blendSrcOver8888_pre_pre(intData, frac[i], palpha, R(cval), G(cval), B(cval));
+            }
+        }
+        intData += pixelStride;
+    }
+}
+
+static void
+blendSpanPTSrc8888_pre_scalar(jint *intData, jint pixelStride,
+                              const jint *paint, const jint *coverage, jint count) {
+    jint i, cval, acoverage, aval;
+    for (i = 0; i < count; i++) {
+        cval = paint[i];
+        acoverage = coverage[i];
+        if (acoverage == MAX_ALPHA) {
+            *intData = cval;
+        } else if (acoverage > 0) {
+            aval = ((acoverage+1) * A(cval)) >> 8;
+            blendSrc8888_pre_pre(intData, aval, 255 - acoverage, R(cval), G(cval), B(cval));
+        }
+        intData += pixelStride;
+    }
+}
+
+static void
+blendSpanLCDSrcOver8888_pre_scalar(jint *intData, jint pixelStride,
+                                   const jbyte *mask, jint count,
+                                   jint calpha, jint cred, jint cgreen, jint cblue,
+                                   const jint *gammaArray, const jint *invGammaArray) {
+    jint i, ared, agreen, ablue;
+    jint solid = 0xff000000 | (cred << 16) | (cgreen << 8) | cblue;
+    for (i = 0; i < count; i++) {
+        ared = *mask++ & 0xff;
+        agreen = *mask++ & 0xff;
+        ablue = *mask++ & 0xff;
+        if (calpha < MAX_ALPHA) {
+            ared = ((ared+1) * calpha) >> 8;
+            agreen = ((agreen+1) * calpha) >> 8;
+            ablue = ((ablue+1) * calpha) >> 8;
+        }
+        if ((ared & agreen & ablue) == MAX_ALPHA) {
+            *intData = solid;
+        } else {
+            blendLCDSrcOver8888_pre(intData, ared, agreen, ablue,
+                cred, cgreen, cblue, gammaArray, invGammaArray);
+        }
+        intData += pixelStride;
+    }
+}
+
+/*
+ * SIMD span loops, instantiated from PiscesBlitSpans.inl once per
+ * instruction set. The vector macros below work on lanes of 32-bit
+ * pixels; vmul16 is only exact for products that fit in 16 bits, which
+ * holds for every product of an 8-bit component and an 8- or 9-bit
+ * weight.
+ */
+
+#if defined(PISCES_X86)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PISCES_TARGET_SSE2 __attribute__((target("sse2")))
+#define PISCES_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PISCES_TARGET_SSE2
+#define PISCES_TARGET_AVX2
+#endif
+
+#define SPAN_NAME(name)     name##_sse2
+#define SPAN_TARGET         PISCES_TARGET_SSE2
+#define VN                  4
+#define vint                __m128i
+#define vload(p)            _mm_loadu_si128((const __m128i *) (p))
+#define vstore(p, v)        _mm_storeu_si128((__m128i *) (p), v)
+#define vset1(x)            _mm_set1_epi32(x)
+#define vadd(a, b)          _mm_add_epi32(a, b)
+#define vsub(a, b)          _mm_sub_epi32(a, b)
+#define vmul16(a, b)        _mm_mullo_epi16(a, b)
+#define vsrl(v, n)          _mm_srli_epi32(v, n)
+#define vsll(v, n)          _mm_slli_epi32(v, n)
+#define vand(a, b)          _mm_and_si128(a, b)
+#define vor(a, b)           _mm_or_si128(a, b)
+#define vandnot(m, v)       _mm_andnot_si128(m, v)
+#define vcmpeq(a, b)        _mm_cmpeq_epi32(a, b)
+#define vallzero(v)         (_mm_movemask_epi8(_mm_cmpeq_epi32(v, _mm_setzero_si128())) == 0xffff)
+#include <PiscesBlitSpans.inl>
+
+#define SPAN_NAME(name)     name##_avx2
+#define SPAN_TARGET         PISCES_TARGET_AVX2
+#define VN                  8
+#define vint                __m256i
+#define vload(p)            _mm256_loadu_si256((const __m256i *) (p))
+#define vstore(p, v)        _mm256_storeu_si256((__m256i *) (p), v)
+#define vset1(x)            _mm256_set1_epi32(x)
+#define vadd(a, b)          _mm256_add_epi32(a, b)
+#define vsub(a, b)          _mm256_sub_epi32(a, b)
+#define vmul16(a, b)        _mm256_mullo_epi16(a, b)
+#define vsrl(v, n)          _mm256_srli_epi32(v, n)
+#define vsll(v, n)          _mm256_slli_epi32(v, n)
+#define vand(a, b)          _mm256_and_si256(a, b)
+#define vor(a, b)           _mm256_or_si256(a, b)
+#define vandnot(m, v)       _mm256_andnot_si256(m, v)
+#define vcmpeq(a, b)        _mm256_cmpeq_epi32(a, b)
+#define vallzero(v)         _mm256_testz_si256(v, v)
+#define vgather(table, idx) _mm256_i32gather_epi32((const int *) (table), idx, 4)
+#include <PiscesBlitSpans.inl>
+
+#elif defined(PISCES_NEON)
+
+static INLINE int neonAllZero(uint32x4_t v) {
+    uint32x2_t t = vorr_u32(vget_low_u32(v), vget_high_u32(v));
+    return vget_lane_u32(vpmax_u32(t, t), 0) == 0;
+}
+
+#define SPAN_NAME(name)     name##_neon
+#define SPAN_TARGET
+#define VN                  4
+#define vint                uint32x4_t
+#define vload(p)            vld1q_u32((const uint32_t *) (p))
+#define vstore(p, v)        vst1q_u32((uint32_t *) (p), v)
+#define vset1(x)            vdupq_n_u32((uint32_t) (x))
+#define vadd(a, b)          vaddq_u32(a, b)
+#define vsub(a, b)          vsubq_u32(a, b)
+#define vmul16(a, b)        vmulq_u32(a, b)
+#define vsrl(v, n)          vshrq_n_u32(v, n)
+#define vsll(v, n)          vshlq_n_u32(v, n)
+#define vand(a, b)          vandq_u32(a, b)
+#define vor(a, b)           vorrq_u32(a, b)
+#define vandnot(m, v)       vbicq_u32(v, m)
+#define vcmpeq(a, b)        vceqq_u32(a, b)
+#define vallzero(v)         neonAllZero(v)
+#include <PiscesBlitSpans.inl>
+
+#endif
+
+/* Dispatch. The SIMD loops need contiguous pixels. */
+
+#if defined(PISCES_X86)
+#define DISPATCH_SPAN(name, args)                                \
+    if (pixelStride == 1) {                                      \
+        switch (piscesGetSIMDLevel()) {                          \
+        case PISCES_SIMD_AVX2: name##_avx2 args; return;         \
+        case PISCES_SIMD_SSE2: name##_sse2 args; return;         \
+        }                                                        \
+    }
+#elif defined(PISCES_NEON)
+#define DISPATCH_SPAN(name, args)                                \
+    if (pixelStride == 1 && piscesGetSIMDLevel() == PISCES_SIMD_NEON) { \
+        name##_neon args;                                        \
+        return;                                                  \
+    }
+#else
+#define DISPATCH_SPAN(name, args)
+#endif
+
+void
+blendSpanSrcOver8888_pre(jint *intData, jint pixelStride,
+                         const jint *aval, jint count,
+                         jint cred, jint cgreen, jint cblue) {
+    DISPATCH_SPAN(blendSpanSrcOver8888_pre,
+                  (intData, aval, count, cred, cgreen, cblue))
+    blendSpanSrcOver8888_pre_scalar(intData, pixelStride, aval, count,
+                                    cred, cgreen, cblue);
+}
+
+void
+blendSpanSrc8888_pre(jint *intData, jint pixelStride,
+                     const jint *coverage, jint count,
+                     jint calpha, jint cred, jint cgreen, jint cblue) {
+    DISPATCH_SPAN(blendSpanSrc8888_pre,
+                  (intData, coverage, count, calpha, cred, cgreen, cblue))
+    blendSpanSrc8888_pre_scalar(intData, pixelStride, coverage, count,
+                                calpha, cred, cgreen, cblue);
+}
+
+void
+blendSpanPTSrcOver8888_pre(jint *intData, jint pixelStride,
+                           const jint *paint, const jint *frac, jint count) {
+    DISPATCH_SPAN(blendSpanPTSrcOver8888_pre,
+                  (intData, paint, frac, count))
+    blendSpanPTSrcOver8888_pre_scalar(intData, pixelStride, paint, frac, count);
+}
+
+void
+blendSpanPTSrc8888_pre(jint *intData, jint pixelStride,
+                       const jint *paint, const jint *coverage, jint count) {
+    DISPATCH_SPAN(blendSpanPTSrc8888_pre,
+                  (intData, paint, coverage, count))
+    blendSpanPTSrc8888_pre_scalar(intData, pixelStride, paint, coverage, count);
+}
+
+void
+blendSpanLCDSrcOver8888_pre(jint *intData, jint pixelStride,
+                            const jbyte *mask, jint count,
+                            jint calpha, jint cred, jint cgreen, jint cblue,
+                            const jint *gammaArray, const jint *invGammaArray) {
+    DISPATCH_SPAN(blendSpanLCDSrcOver8888_pre,
+                  (intData, mask, count, calpha, cred, cgreen, cblue,
+                   gammaArray, invGammaArray))
+    blendSpanLCDSrcOver8888_pre_scalar(intData, pixelStride, mask, count,
+                                       calpha, cred, cgreen, cblue,
+                                       gammaArray, invGammaArray);
+}
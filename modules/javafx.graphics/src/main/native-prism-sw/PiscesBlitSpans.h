@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef PISCES_BLIT_SPANS_H
+#define PISCES_BLIT_SPANS_H
+
+#include <PiscesDefs.h>
+
+/*
+ * Blend loops over one span of an 8888 premultiplied surface. The blit
+ * routines in PiscesBlit.c compute the per-pixel coverage of a span and
+ * hand the blending to these functions, which use SSE2/AVX2 (selected at
+ * runtime) or NEON (when compiled in) on contiguous spans and the scalar
+ * blend helpers otherwise. All variants produce identical pixels.
+ */
+
+#define PISCES_SIMD_NONE 0
+#define PISCES_SIMD_SSE2 1
+#define PISCES_SIMD_AVX2 2
+#define PISCES_SIMD_NEON 3
+
+/* Longest span the blit routines pass at once. */
+#define PISCES_SPAN_LENGTH 64
+
+/*
+ * Returns the SIMD level used by the span loops.
+ */
+jint piscesGetSIMDLevel();
+
+/*
+ * Restricts the span loops to the given SIMD level; PISCES_SIMD_NONE
+ * selects the scalar loops. Returns the level actually selected, which
+ * is the given one if the CPU supports it and PISCES_SIMD_NONE otherwise.
+ * Meant for tests and benchmarks comparing the variants.
+ */
+jint piscesSetSIMDLevel(jint level);
+
+/*
+ * SRC_OVER of a solid non-premultiplied color. aval[i] is the final
+ * alpha of pixel i: 0 leaves it, MAX_ALPHA stores the opaque color.
+ */
+void blendSpanSrcOver8888_pre(jint *intData, jint pixelStride,
+                              const jint *aval, jint count,
+                              jint cred, jint cgreen, jint cblue);
+
+/*
+ * SRC of a solid non-premultiplied color. coverage[i] is the coverage of
+ * pixel i: 0 leaves it, MAX_ALPHA stores the color.
+ */
+void blendSpanSrc8888_pre(jint *intData, jint pixelStride,
+                          const jint *coverage, jint count,
+                          jint calpha, jint cred, jint cgreen, jint cblue);
+
+/*
+ * SRC_OVER of premultiplied paint. frac[i] is the coverage of pixel i
+ * plus one (1..256), or 0 to leave the pixel.
+ */
+void blendSpanPTSrcOver8888_pre(jint *intData, jint pixelStride,
+                                const jint *paint, const jint *frac, jint count);
+
+/*
+ * SRC of premultiplied paint. coverage[i] is the coverage of pixel i:
+ * 0 leaves it, MAX_ALPHA stores the paint.
+ */
+void blendSpanPTSrc8888_pre(jint *intData, jint pixelStride,
+                            const jint *paint, const jint *coverage, jint count);
+
+/*
+ * SRC_OVER of a solid color through an LCD (3 bytes per pixel) mask.
+ * The color components are already in linear space (invGammaArray).
+ */
+void blendSpanLCDSrcOver8888_pre(jint *intData, jint pixelStride,
+                                 const jbyte *mask, jint count,
+                                 jint calpha, jint cred, jint cgreen, jint cblue,
+                                 const jint *gammaArray, const jint *invGammaArray);
+
+#endif
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Vector span loops for PiscesBlitSpans.c. This file is included once per
+ * instruction set, with SPAN_NAME, SPAN_TARGET, VN and the v* macros
+ * defined by the includer; it undefines them all at the end.
+ *
+ * Every loop produces exactly the same pixels as its scalar counterpart,
+ * including the cases where a premultiplied component overflows 255 and
+ * spills into its neighbour.
+ */
+
+#define vselect(m, a, b)    vor(vand(m, a), vandnot(m, b))
+#define vdiv255(x)          vsrl(vadd(vadd(vsll(x, 8), x), vset1(257)), 16)
+#define vA(v)               vsrl(v, 24)
+#define vR(v)               vand(vsrl(v, 16), vset1(0xff))
+#define vG(v)               vand(vsrl(v, 8), vset1(0xff))
+#define vB(v)               vand(v, vset1(0xff))
+
+#ifndef vgather
+#define SPAN_OWN_GATHER
+static SPAN_TARGET vint
+SPAN_NAME(gather)(const jint *table, vint idx) {
+    jint index[VN], value[VN];
+    jint k;
+    vstore(index, idx);
+    for (k = 0; k < VN; k++) {
+        value[k] = table[index[k]];
+    }
+    return vload(value);
+}
+#define vgather(table, idx) SPAN_NAME(gather)(table, idx)
+#endif
+
+static SPAN_TARGET void
+SPAN_NAME(blendSpanSrcOver8888_pre)(jint *intData, const jint *aval, jint count,
+                                    jint cred, jint cgreen, jint cblue) {
+    vint zero = vset1(0);
+    vint max = vset1(MAX_ALPHA);
+    vint solid = vset1(0xff000000 | (cred << 16) | (cgreen << 8) | cblue);
+    vint sr = vset1(cred);
+    vint sg = vset1(cgreen);
+    vint sb = vset1(cblue);
+    vint av, om, d, o;
+    jint i;
+
+    for (i = 0; i + VN <= count; i += VN) {
+        av = vload(aval + i);
+        if (vallzero(av)) {
+            continue;
+        }
+        d = vload(intData + i);
+        om = vsub(max, av);
+        o = vsll(vdiv255(vadd(vmul16(max, av), vmul16(om, vA(d)))), 24);
+        o = vor(o, vsll(vdiv255(vadd(vmul16(sr, av), vmul16(om, vR(d)))), 16));
+        o = vor(o, vsll(vdiv255(vadd(vmul16(sg, av), vmul16(om, vG(d)))), 8));
+        o = vor(o, vdiv255(vadd(vmul16(sb, av), vmul16(om, vB(d)))));
+        o = vselect(vcmpeq(av, max), solid, o);
+        o = vselect(vcmpeq(av, zero), d, o);
+        vstore(intData + i, o);
+    }
+    if (i < count) {
+        blendSpanSrcOver8888_pre_scalar(intData + i, 1, aval + i, count - i,
+                                        cred, cgreen, cblue);
+    }
+}
+
+static SPAN_TARGET void
+SPAN_NAME(blendSpanSrc8888_pre)(jint *intData, const jint *coverage, jint count,
+                                jint calpha, jint cred, jint cgreen, jint cblue) {
+    vint zero = vset1(0);
+    vint one = vset1(1);
+    vint max = vset1(MAX_ALPHA);
+    vint solid = vset1((calpha << 24) | (cred << 16) | (cgreen << 8) | cblue);
+    vint sa = vset1(calpha);
+    vint sr = vset1(cred);
+    vint sg = vset1(cgreen);
+    vint sb = vset1(cblue);
+    vint cov, av, rav, denom, d, o;
+    jint i;
+
+    for (i = 0; i + VN <= count; i += VN) {
+        cov = vload(coverage + i);
+        if (vallzero(cov)) {
+            continue;
+        }
+        d = vload(intData + i);
+        av = vsrl(vmul16(vadd(cov, one), sa), 8);
+        rav = vsub(max, cov);
+        denom = vadd(vmul16(max, av), vmul16(vA(d), rav));
+        o = vsll(vdiv255(denom), 24);
+        o = vor(o, vsll(vdiv255(vadd(vmul16(av, sr), vmul16(rav, vR(d)))), 16));
+        o = vor(o, vsll(vdiv255(vadd(vmul16(av, sg), vmul16(rav, vG(d)))), 8));
+        o = vor(o, vdiv255(vadd(vmul16(av, sb), vmul16(rav, vB(d)))));
+        o = vandnot(vcmpeq(denom, zero), o);
+        o = vselect(vcmpeq(cov, max), solid, o);
+        o = vselect(vcmpeq(cov, zero), d, o);
+        vstore(intData + i, o);
+    }
+    if (i < count) {
+        blendSpanSrc8888_pre_scalar(intData + i, 1, coverage + i, count - i,
+                                    calpha, cred, cgreen, cblue);
+    }
+}
+
+static SPAN_TARGET void
+SPAN_NAME(blendSpanPTSrcOver8888_pre)(jint *intData, const jint *paint,
+                                      const jint *frac, jint count) {
+    vint zero = vset1(0);
+    vint max = vset1(MAX_ALPHA);
+    vint f, p, av, om, d, o;
+    jint i;
+
+    for (i = 0; i + VN <= count; i += VN) {
+        f = vload(frac + i);
+        if (vallzero(f)) {
+            continue;
+        }
+        p = vload(paint + i);
+        d = vload(intData + i);
+        av = vsrl(vmul16(f, vA(p)), 8);
+        om = vsub(max, av);
+        o = vsll(vadd(av, vdiv255(vmul16(om, vA(d)))), 24);
+        o = vor(o, vsll(vadd(vsrl(vmul16(vR(p), f), 8), vdiv255(vmul16(om, vR(d)))), 16));
+        o = vor(o, vsll(vadd(vsrl(vmul16(vG(p), f), 8), vdiv255(vmul16(om, vG(d)))), 8));
+        o = vor(o, vadd(vsrl(vmul16(vB(p), f), 8), vdiv255(vmul16(om, vB(d)))));
+        o = vselect(vcmpeq(av, max), p, o);
+        o = vselect(vcmpeq(av, zero), d, o);
+        vstore(intData + i, o);
+    }
+    if (i < count) {
+        blendSpanPTSrcOver8888_pre_scalar(intData + i, 1, paint + i, frac + i,
+                                          count - i);
+    }
+}
+
+static SPAN_TARGET void
+SPAN_NAME(blendSpanPTSrc8888_pre)(jint *intData, const jint *paint,
+                                  const jint *coverage, jint count) {
+    vint zero = vset1(0);
+    vint one = vset1(1);
+    vint max = vset1(MAX_ALPHA);
+    vint cov, p, av, rav, denom, d, o;
+    jint i;
+
+    for (i = 0; i + VN <= count; i += VN) {
+        cov = vload(coverage + i);
+        if (vallzero(cov)) {
+            continue;
+        }
+        p = vload(paint + i);
+        d = vload(intData + i);
+        av = vsrl(vmul16(vadd(cov, one), vA(p)), 8);
+        rav = vsub(max, cov);
+        denom = vadd(vmul16(max, av), vmul16(vA(d), rav));
+        o = vsll(vdiv255(denom), 24);
+        o = vor(o, vsll(vadd(vR(p), vdiv255(vmul16(rav, vR(d)))), 16));
+        o = vor(o, vsll(vadd(vG(p), vdiv255(vmul16(rav, vG(d)))), 8));
+        o = vor(o, vadd(vB(p), vdiv255(vmul16(rav, vB(d)))));
+        o = vandnot(vcmpeq(denom, zero), o);
+        o = vselect(vcmpeq(cov, max), p, o);
+        o = vselect(vcmpeq(cov, zero), d, o);
+        vstore(intData + i, o);
+    }
+    if (i < count) {
+        blendSpanPTSrc8888_pre_scalar(intData + i, 1, paint + i, coverage + i,
+                                      count - i);
+    }
+}
+
+static SPAN_TARGET void
+SPAN_NAME(blendSpanLCDSrcOver8888_pre)(jint *intData, const jbyte *mask, jint count,
+                                       jint calpha, jint cred, jint cgreen, jint cblue,
+                                       const jint *gammaArray, const jint *invGammaArray) {
+    vint one = vset1(1);
+    vint max = vset1(MAX_ALPHA);
+    vint opaque = vset1(0xff000000);
+    vint solid = vset1(0xff000000 | (cred << 16) | (cgreen << 8) | cblue);
+    vint sa = vset1(calpha);
+    vint sr = vset1(cred);
+    vint sg = vset1(cgreen);
+    vint sb = vset1(cblue);
+    vint ar, ag, ab, d, o;
+    jint mr[VN], mg[VN], mb[VN];
+    jint i, k;
+
+    for (i = 0; i + VN <= count; i += VN) {
+        for (k = 0; k < VN; k++) {
+            mr[k] = mask[0] & 0xff;
+            mg[k] = mask[1] & 0xff;
+            mb[k] = mask[2] & 0xff;
+            mask += 3;
+        }
+        ar = vload(mr);
+        ag = vload(mg);
+        ab = vload(mb);
+        if (calpha < MAX_ALPHA) {
+            ar = vsrl(vmul16(vadd(ar, one), sa), 8);
+            ag = vsrl(vmul16(vadd(ag, one), sa), 8);
+            ab = vsrl(vmul16(vadd(ab, one), sa), 8);
+        }
+        d = vload(intData + i);
+        o = vsll(vgather(gammaArray, vdiv255(vadd(vmul16(ar, sr),
+                vmul16(vsub(max, ar), vgather(invGammaArray, vR(d)))))), 16);
+        o = vor(o, vsll(vgather(gammaArray, vdiv255(vadd(vmul16(ag, sg),
+                vmul16(vsub(max, ag), vgather(invGammaArray, vG(d)))))), 8));
+        o = vor(o, vgather(gammaArray, vdiv255(vadd(vmul16(ab, sb),
+                vmul16(vsub(max, ab), vgather(invGammaArray, vB(d)))))));
+        o = vor(o, opaque);
+        o = vselect(vcmpeq(vand(vand(ar, ag), ab), max), solid, o);
+        vstore(intData + i, o);
+    }
+    if (i < count) {
+        blendSpanLCDSrcOver8888_pre_scalar(intData + i, 1, mask, count - i,
+                                           calpha, cred, cgreen, cblue,
+                                           gammaArray, invGammaArray);
+    }
+}
+
+#ifdef SPAN_OWN_GATHER
+#undef SPAN_OWN_GATHER
+#endif
+#undef vgather
+#undef vselect
+#undef vdiv255
+#undef vA
+#undef vR
+#undef vG
+#undef vB
+#undef SPAN_NAME
+#undef SPAN_TARGET
+#undef VN
+#undef vint
+#undef vload
+#undef vstore
+#undef vset1
+#undef vadd
+#undef vsub
+#undef vmul16
+#undef vsrl
+#undef vsll
+#undef vand
+#undef vor
+#undef vandnot
+#undef vcmpeq
+#undef vallzero
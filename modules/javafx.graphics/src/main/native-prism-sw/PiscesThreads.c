@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -23,33 +23,20 @@
  * questions.
  */
 
-package com.sun.webkit.security;
+#include <PiscesThreads.h>
+#include "BandThreadPool.h"
 
-import com.sun.javafx.webkit.WCMessageDigestImpl;
-import com.sun.webkit.perf.WCMessageDigestPerfLogger;
-import java.nio.ByteBuffer;
-
-public abstract class WCMessageDigest {
-    /**
-     * Creates the instance of WCMessageDigest for the given algorithm.
-     * @param algorithm the name of the algorithm like SHA-1, SHA-256.
-     */
-    protected static WCMessageDigest getInstance(String algorithm) {
-        try {
-            WCMessageDigest digest = new WCMessageDigestImpl(algorithm);
-            return WCMessageDigestPerfLogger.isEnabled() ? new WCMessageDigestPerfLogger(digest) : digest;
-        } catch (Exception ex) {
-            return null;
-        }
-    }
+void
+piscesSetThreading(jint maxThreads, jint minBandSize) {
+    bandPoolSetThreading(maxThreads, minBandSize);
+}
 
-    /**
-     * Update the digest using the specified ByteBuffer.
-     */
-    public abstract void addBytes(ByteBuffer input);
+jint
+piscesGetThreadCount() {
+    return bandPoolMaxThreads;
+}
 
-    /**
-     * Returns the computed hash value.
-     */
-    public abstract byte[] computeHash();
+void
+piscesRunBands(jint lines, jint lineSize, PiscesBandFunc func, void *data) {
+    bandPoolRun(lines, lineSize, func, data);
 }
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef PISCES_THREADS_H
+#define PISCES_THREADS_H
+
+#include <PiscesDefs.h>
+
+/*
+ * A fixed pool of native worker threads that run disjoint bands of rows
+ * of one fill in parallel, implemented in BandThreadPool.h. The workers
+ * never call into the JVM, so they may run while the caller holds
+ * critical arrays.
+ */
+
+typedef void (*PiscesBandFunc)(void *data, jint start, jint end);
+
+/*
+ * Sets the maximum number of threads working on one fill (including the
+ * calling thread) and the minimum number of pixels per band. One thread,
+ * the default, renders everything on the calling thread.
+ */
+void piscesSetThreading(jint maxThreads, jint minBandSize);
+
+/*
+ * Returns the maximum number of threads working on one fill.
+ */
+jint piscesGetThreadCount();
+
+/*
+ * Splits [0, lines) into contiguous bands of at least minBandSize pixels,
+ * given lineSize pixels per line, and calls func once per band. Returns
+ * after all bands have completed. If the pool is already busy with a
+ * fill from another thread, all bands run on the calling thread.
+ */
+void piscesRunBands(jint lines, jint lineSize, PiscesBandFunc func, void *data);
+
+#endif
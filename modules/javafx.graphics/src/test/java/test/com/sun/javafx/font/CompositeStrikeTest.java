@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.javafx.font;
+
+import com.sun.javafx.font.CompositeStrike;
+import com.sun.javafx.font.FontStrike;
+import com.sun.javafx.font.Glyph;
+import com.sun.javafx.font.PGFont;
+import com.sun.javafx.font.PrismFontFactory;
+import com.sun.javafx.geom.transform.BaseTransform;
+import java.util.Arrays;
+import org.junit.Test;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotEquals;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assume.assumeTrue;
+
+public class CompositeStrikeTest {
+
+    /* Strikes which rasterize glyphs in batches (FreeType) store the
+     * bitmaps of one batch in a single array, so glyphs prepared through
+     * the composite strike share their pixel data.
+     */
+    @Test
+    public void testPrepareGlyphsBatchesSlotGlyphs() {
+        PrismFontFactory factory = PrismFontFactory.getFontFactory();
+        /* An unusual size, so that no other test has cached the glyphs */
+        PGFont font = factory.createFont("System", 37.25f);
+        FontStrike strike = font.getStrike(BaseTransform.IDENTITY_TRANSFORM);
+        assertTrue(strike instanceof CompositeStrike);
+        CompositeStrike composite = (CompositeStrike)strike;
+        FontStrike slot0 = composite.getStrikeSlot(0);
+        assertNotNull(slot0);
+        assumeTrue(slot0.getClass().getSimpleName().equals("FTFontStrike"));
+
+        int[] codes = new int[3];
+        String text = "AVW";
+        for (int i = 0; i < codes.length; i++) {
+            codes[i] = font.getFontResource().getGlyphMapper().charToGlyph(text.charAt(i));
+            assertEquals(0, codes[i] >>> 24);
+        }
+        Arrays.sort(codes);
+        composite.prepareGlyphs(codes, codes.length);
+
+        Glyph first = composite.getGlyph(codes[0]);
+        for (int i = 1; i < codes.length; i++) {
+            Glyph glyph = composite.getGlyph(codes[i]);
+            assertSame("glyph " + i + " not rasterized in the batch",
+                       first.getPixelData(), glyph.getPixelData());
+            assertNotEquals(first.getPixelDataOffset(), glyph.getPixelDataOffset());
+        }
+    }
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.pisces;
+
+import com.sun.glass.utils.NativeLibLoader;
+import com.sun.pisces.JavaSurface;
+import com.sun.pisces.PiscesRenderer;
+import com.sun.pisces.RendererBase;
+import com.sun.pisces.Transform6;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Random;
+import org.junit.AfterClass;
+import org.junit.BeforeClass;
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+/**
+ * Checks that the SIMD span loops of the software pipeline produce exactly
+ * the pixels of the scalar ones, for every SIMD level the CPU supports.
+ */
+public class PiscesBlitSpansTest {
+
+    private static final int WIDTH = 80;
+    private static final int HEIGHT = 64;
+    private static final int MAX_SPAN = 67;
+
+    private static final List<Integer> levels = new ArrayList<>();
+
+    @BeforeClass
+    public static void setupOnce() {
+        NativeLibLoader.loadLibrary("prism_sw");
+        for (int level = 1; level <= 3; level++) {
+            if (PiscesRenderer.setSIMDLevel(level) == level) {
+                levels.add(level);
+            }
+        }
+    }
+
+    @AfterClass
+    public static void tearDownOnce() {
+        // Go back to the best level, as selected at startup
+        int best = levels.isEmpty() ? 0 : levels.get(levels.size() - 1);
+        PiscesRenderer.setSIMDLevel(best);
+    }
+
+    // Premultiplied pixels, including some with a color component above
+    // the alpha, which the loops must treat the same way
+    private static int[] createPixels(Random random) {
+        int[] pixels = new int[WIDTH * HEIGHT];
+        for (int i = 0; i < pixels.length; i++) {
+            int a = random.nextInt(256);
+            if (random.nextInt(8) == 0) {
+                pixels[i] = (a << 24) | random.nextInt(1 << 24);
+            } else {
+                pixels[i] = (a << 24)
+                        | (random.nextInt(a + 1) << 16)
+                        | (random.nextInt(a + 1) << 8)
+                        | random.nextInt(a + 1);
+            }
+        }
+        return pixels;
+    }
+
+    private static byte[] createMask(Random random, int size) {
+        byte[] mask = new byte[size];
+        random.nextBytes(mask);
+        // Runs of empty and full coverage take the shortcuts of the loops
+        for (int i = 0; i < size; i += 16) {
+            int value = random.nextInt(3);
+            if (value < 2) {
+                for (int j = i; j < Math.min(i + random.nextInt(16), size); j++) {
+                    mask[j] = (byte) (value == 0 ? 0 : 0xff);
+                }
+            }
+        }
+        return mask;
+    }
+
+    private static void fillSpans(PiscesRenderer renderer, Random random, boolean lcd) {
+        for (int y = 0; y < HEIGHT; y++) {
+            int width = 1 + (y % MAX_SPAN);
+            int x = random.nextInt(WIDTH - Math.min(width, WIDTH - 1));
+            width = Math.min(width, WIDTH - x);
+            if (lcd) {
+                renderer.fillLCDAlphaMask(createMask(random, width * 3), x, y, width * 3, 1, 0, width * 3);
+            } else {
+                renderer.fillAlphaMask(createMask(random, width), x, y, width, 1, 0, width);
+            }
+        }
+    }
+
+    private static int[] render(int level, long seed) {
+        assertEquals(level, PiscesRenderer.setSIMDLevel(level));
+        Random random = new Random(seed);
+        int[] pixels = createPixels(random);
+        JavaSurface surface = new JavaSurface(pixels, RendererBase.TYPE_INT_ARGB_PRE, WIDTH, HEIGHT);
+        PiscesRenderer renderer = new PiscesRenderer(surface);
+
+        renderer.setCompositeRule(RendererBase.COMPOSITE_SRC_OVER);
+        renderer.setColor(0x40, 0x80, 0xc0, 0xa0);
+        fillSpans(renderer, random, false);
+        renderer.fillRect((3 << 16) + 0x4000, (5 << 16) + 0x8000, 61 << 16, 7 << 16);
+        renderer.setColor(0xff, 0x20, 0x10, 0xff);
+        fillSpans(renderer, random, false);
+
+        renderer.setCompositeRule(RendererBase.COMPOSITE_SRC);
+        renderer.setColor(0x10, 0xe0, 0x70, 0x90);
+        fillSpans(renderer, random, false);
+        renderer.fillRect(7 << 16, 20 << 16, 53 << 16, 9 << 16);
+
+        int[] texture = createPixels(random);
+        Transform6 transform = new Transform6(1 << 16, 0, 0, 1 << 16, 0, 0);
+        renderer.setCompositeRule(RendererBase.COMPOSITE_SRC_OVER);
+        renderer.setTexture(RendererBase.TYPE_INT_ARGB_PRE, texture, WIDTH, HEIGHT, WIDTH,
+                transform, false, false, true);
+        fillSpans(renderer, random, false);
+        renderer.fillRect(11 << 16, 33 << 16, 47 << 16, 11 << 16);
+        renderer.setCompositeRule(RendererBase.COMPOSITE_SRC);
+        fillSpans(renderer, random, false);
+
+        renderer.setCompositeRule(RendererBase.COMPOSITE_SRC_OVER);
+        renderer.setLCDGammaCorrection(1.4f);
+        renderer.setColor(0x20, 0x30, 0x40, 0xff);
+        fillSpans(renderer, random, true);
+        renderer.setColor(0xe0, 0xd0, 0xc0, 0x80);
+        fillSpans(renderer, random, true);
+
+        return pixels;
+    }
+
+    @Test
+    public void testSIMDLevelsMatchScalar() {
+        for (long seed = 1; seed <= 4; seed++) {
+            int[] expected = render(0, seed);
+            for (int level : levels) {
+                assertArrayEquals("SIMD level " + level + ", seed " + seed,
+                        expected, render(level, seed));
+            }
+        }
+    }
+
+    @Test
+    public void testUnsupportedLevelSelectsScalar() {
+        assertEquals(0, PiscesRenderer.setSIMDLevel(-1));
+        assertEquals(0, PiscesRenderer.setSIMDLevel(4));
+        if (!levels.contains(3)) {
+            assertEquals(0, PiscesRenderer.setSIMDLevel(3));
+        }
+    }
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -39,6 +39,9 @@
 // HEVC/H.265 support should be available in 56 and up
 #define HEVC_SUPPORT           (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(56,0,0))
 
+// AV_PIX_FMT_P010LE is available in 57 and up
+#define P010_SUPPORT           (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57,0,0))
+
 // "codec" field was removed from AVStream in 59 and "codecpar" should be used
 // instead.
 #define CODEC_PAR              (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59,0,0))
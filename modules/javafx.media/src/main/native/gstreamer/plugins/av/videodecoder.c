@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -45,8 +45,12 @@ enum
     PROP_0,
     PROP_CODEC_ID,
     PROP_IS_SUPPORTED,
+    PROP_THREAD_COUNT,
 };
 
+// Upper limit for the number of decoding threads picked automatically.
+#define MAX_AUTO_THREAD_COUNT 16
+
 /*
  * The input capabilities.
  */
@@ -65,7 +69,7 @@ static GstStaticPadTemplate sink_template =
  */
 #define SOURCE_CAPS           \
     "video/x-raw-yuv, "       \
-    "format = (string) I420"
+    "format = (string) { I420, YV12, NV12, P010_10LE, I420_10LE, Y42B, I422_10LE }"
 
 static GstStaticPadTemplate source_template =
     GST_STATIC_PAD_TEMPLATE("src",
@@ -118,6 +122,9 @@ static GstFlowReturn        videodecoder_chain(GstPad *pad, GstObject *parent, G
 
 static void                 videodecoder_init_state(VideoDecoder *decoder);
 static void                 videodecoder_state_reset(VideoDecoder *decoder);
+static void                 videodecoder_init_context(BaseDecoder *base);
+static void                 videodecoder_drain(VideoDecoder *decoder);
+static void                 videodecoder_clear_pending_inputs(VideoDecoder *decoder);
 
 static gboolean videodecoder_configure(VideoDecoder *decoder, GstCaps *sink_caps);
 
@@ -143,6 +150,8 @@ static void videodecoder_class_init(VideoDecoderClass *klass)
 
     element_class->change_state = videodecoder_change_state;
 
+    BASEDECODER_CLASS(klass)->init_context = videodecoder_init_context;
+
     gobject_class->dispose = videodecoder_dispose;
     gobject_class->set_property = videodecoder_set_property;
     gobject_class->get_property = videodecoder_get_property;
@@ -154,6 +163,11 @@ static void videodecoder_class_init(VideoDecoderClass *klass)
     g_object_class_install_property (gobject_class, PROP_IS_SUPPORTED,
         g_param_spec_boolean ("is-supported", "Is supported", "Is codec ID supported", FALSE,
         (GParamFlags)(G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property (gobject_class, PROP_THREAD_COUNT,
+        g_param_spec_int ("thread-count", "Thread count",
+        "Number of decoding threads, 0 to pick it from the number of processors", 0, 64, 0,
+        (GParamFlags)(G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS)));
 }
 
 static void videodecoder_init(VideoDecoder *decoder)
@@ -172,6 +186,24 @@ static void videodecoder_init(VideoDecoder *decoder)
     gst_element_add_pad(GST_ELEMENT(decoder), base->srcpad);
 }
 
+/*
+ * Lets libavcodec decode on several threads. Frame threads decode consecutive
+ * frames in parallel and delay the output by one frame per thread, slice
+ * threads split a frame when the stream has several slices.
+ */
+static void videodecoder_init_context(BaseDecoder *base)
+{
+    VideoDecoder *decoder = VIDEODECODER(base);
+
+    BASEDECODER_CLASS(parent_class)->init_context(base);
+
+    if (decoder->thread_count > 0)
+        base->context->thread_count = decoder->thread_count;
+    else
+        base->context->thread_count = MIN(g_get_num_processors(), MAX_AUTO_THREAD_COUNT);
+    base->context->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+}
+
 void videodecoder_close_decoder(VideoDecoder *decoder)
 {
 #if HEVC_SUPPORT
@@ -234,6 +266,9 @@ static void videodecoder_set_property(GObject *object, guint property_id, const
     case PROP_CODEC_ID:
         decoder->codec_id = g_value_get_int(value);
         break;
+    case PROP_THREAD_COUNT:
+        decoder->thread_count = g_value_get_int(value);
+        break;
     default:
         break;
     }
@@ -249,6 +284,9 @@ static void videodecoder_get_property(GObject *object, guint property_id, GValue
         is_supported = videodecoder_is_decoder_by_codec_id_supported(decoder->codec_id);
         g_value_set_boolean(value, is_supported);
         break;
+    case PROP_THREAD_COUNT:
+        g_value_set_int(value, decoder->thread_count);
+        break;
     default:
         break;
     }
@@ -308,6 +346,11 @@ static gboolean videodecoder_sink_event(GstPad *pad, GstObject *parent, GstEvent
             BASEDECODER(decoder)->is_flushing = TRUE;
             break;
 
+        case GST_EVENT_EOS:
+            // Push the frames the decoding threads still hold.
+            videodecoder_drain(decoder);
+            break;
+
         case GST_EVENT_FLUSH_STOP:
             // Stop flushing buffers.
             videodecoder_state_reset(decoder);
@@ -365,10 +408,15 @@ static void videodecoder_init_state(VideoDecoder *decoder)
     decoder->u_offset = 0;
     decoder->v_offset = 0;
     decoder->uv_blocksize = 0;
+    decoder->plane_count = 3;
+    decoder->chroma_shift = 1;
+    decoder->pix_fmt = -1;
     decoder->frame_size = 0;
     decoder->discont = FALSE;
+    videodecoder_clear_pending_inputs(decoder);
     decoder->codec_id = JFX_CODEC_ID_UNKNOWN;
 #if HEVC_SUPPORT
+    decoder->needs_conversion = FALSE;
     decoder->sws_context = NULL;
     decoder->dest_frame = NULL;
     decoder->swscale_module = NULL;
@@ -442,6 +490,7 @@ static void videodecoder_state_reset(VideoDecoder *decoder)
 {
     decoder->frame_finished = 1;
     basedecoder_flush(BASEDECODER(decoder));
+    videodecoder_clear_pending_inputs(decoder);
 }
 
 #if HEVC_SUPPORT
@@ -536,6 +585,45 @@ static gboolean videodecoder_init_converter(VideoDecoder *decoder)
     return TRUE;
 }
 
+/*
+ * Returns the caps format to push frames of the given pixel format as they
+ * are decoded, or NULL if they need to be converted to YUV420P. jfxmedia
+ * converts these formats to RGB in one pass. 4:4:4 and 12 bit formats still
+ * need the conversion. chroma_shift is set to 1 when the chroma planes have
+ * half as many rows as the luma plane.
+ */
+static const gchar* videodecoder_get_native_format(int pix_fmt, unsigned int *plane_count, unsigned int *chroma_shift)
+{
+    *chroma_shift = 1;
+    switch (pix_fmt)
+    {
+    case AV_PIX_FMT_YUV420P:
+        *plane_count = 3;
+        return "YV12";
+    case AV_PIX_FMT_YUV420P10LE:
+        *plane_count = 3;
+        return "I420_10LE";
+    case AV_PIX_FMT_YUV422P:
+        *plane_count = 3;
+        *chroma_shift = 0;
+        return "Y42B";
+    case AV_PIX_FMT_YUV422P10LE:
+        *plane_count = 3;
+        *chroma_shift = 0;
+        return "I422_10LE";
+    case AV_PIX_FMT_NV12:
+        *plane_count = 2;
+        return "NV12";
+#if P010_SUPPORT
+    case AV_PIX_FMT_P010LE:
+        *plane_count = 2;
+        return "P010_10LE";
+#endif // P010_SUPPORT
+    default:
+        return NULL;
+    }
+}
+
 static gboolean videodecoder_convert_frame(VideoDecoder *decoder)
 {
     BaseDecoder *base = BASEDECODER(decoder);
@@ -564,6 +652,7 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
 {
     BaseDecoder *base = BASEDECODER(decoder);
     gboolean set_linesize = TRUE;
+    const gchar *format = "YV12";
     int linesize0 = 0;
     int linesize1 = 0;
     int linesize2 = 0;
@@ -579,16 +668,21 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
 #endif // NEW_CODEC_ID
 
     if (caps == NULL ||
-        decoder->width != width || decoder->height != height)
+        decoder->width != width || decoder->height != height ||
+        decoder->pix_fmt != base->frame->format)
     {
         decoder->width = width;
         decoder->height = height;
+        decoder->pix_fmt = base->frame->format;
 
 #if HEVC_SUPPORT
-    // Setup scaler and color converter if pixel format is not AV_PIX_FMT_YUV420P.
-    // We will get different pixel format for H.265 10-bit such as
-    // AV_PIX_FMT_YUV422P10LE. Scaling should not happen if resolution is same.
-    if (base->frame->format != AV_PIX_FMT_YUV420P)
+    // Frames in the formats jfxmedia converts to RGB are pushed as decoded.
+    // Other formats, such as AV_PIX_FMT_YUV444P10LE for some H.265 10-bit
+    // streams, are converted to AV_PIX_FMT_YUV420P first. Scaling should not
+    // happen since resolution is same.
+    format = videodecoder_get_native_format(base->frame->format, &decoder->plane_count, &decoder->chroma_shift);
+    decoder->needs_conversion = (format == NULL);
+    if (decoder->needs_conversion)
     {
         if (!videodecoder_init_converter(decoder))
         {
@@ -599,15 +693,9 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
             return FALSE;
         }
 
-        if (!videodecoder_convert_frame(decoder))
-        {
-            gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
-                                             GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
-                                             g_strdup("videodecoder_convert_frame() failed"), NULL,
-                                             ("videodecoder.c"), ("videodecoder_configure_sourcepad"), 0);
-
-            return FALSE;
-        }
+        format = "YV12";
+        decoder->plane_count = 3;
+        decoder->chroma_shift = 1;
 
         linesize0 = decoder->dest_frame->linesize[0];
         linesize1 = decoder->dest_frame->linesize[1];
@@ -617,7 +705,8 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
     }
 #endif // HEVC_SUPPORT
 
-        decoder->discont = (caps != NULL);
+        if (caps != NULL)
+            decoder->discont = TRUE;
 
         if (set_linesize)
         {
@@ -627,24 +716,40 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
         }
 
         decoder->u_offset = linesize0 * decoder->height;
-        decoder->uv_blocksize = linesize1 * decoder->height / 2;
+        decoder->uv_blocksize = linesize1 * (decoder->height >> decoder->chroma_shift);
 
         decoder->v_offset = decoder->u_offset + decoder->uv_blocksize;
-        decoder->frame_size = (linesize0 + linesize1) * decoder->height;
-
-        GstCaps *src_caps = gst_caps_new_simple("video/x-raw-yuv",
-                                                "format", G_TYPE_STRING, "YV12",
-                                                "width", G_TYPE_INT, decoder->width,
-                                                "height", G_TYPE_INT, decoder->height,
-                                                "stride-y", G_TYPE_INT, linesize0,
-                                                "stride-u", G_TYPE_INT, linesize1,
-                                                "stride-v", G_TYPE_INT, linesize2,
-                                                "offset-y", G_TYPE_INT, 0,
-                                                "offset-u", G_TYPE_INT, decoder->u_offset,
-                                                "offset-v", G_TYPE_INT, decoder->v_offset,
-                                                "framerate", GST_TYPE_FRACTION, 2997, 100,
-                                                NULL);
+        decoder->frame_size = decoder->u_offset + decoder->uv_blocksize * (decoder->plane_count - 1);
 
+        GstCaps *src_caps = NULL;
+        if (decoder->plane_count == 2)
+        {
+            src_caps = gst_caps_new_simple("video/x-raw-yuv",
+                                           "format", G_TYPE_STRING, format,
+                                           "width", G_TYPE_INT, decoder->width,
+                                           "height", G_TYPE_INT, decoder->height,
+                                           "stride-y", G_TYPE_INT, linesize0,
+                                           "stride-uv", G_TYPE_INT, linesize1,
+                                           "offset-y", G_TYPE_INT, 0,
+                                           "offset-uv", G_TYPE_INT, decoder->u_offset,
+                                           "framerate", GST_TYPE_FRACTION, 2997, 100,
+                                           NULL);
+        }
+        else
+        {
+            src_caps = gst_caps_new_simple("video/x-raw-yuv",
+                                           "format", G_TYPE_STRING, format,
+                                           "width", G_TYPE_INT, decoder->width,
+                                           "height", G_TYPE_INT, decoder->height,
+                                           "stride-y", G_TYPE_INT, linesize0,
+                                           "stride-u", G_TYPE_INT, linesize1,
+                                           "stride-v", G_TYPE_INT, linesize2,
+                                           "offset-y", G_TYPE_INT, 0,
+                                           "offset-u", G_TYPE_INT, decoder->u_offset,
+                                           "offset-v", G_TYPE_INT, decoder->v_offset,
+                                           "framerate", GST_TYPE_FRACTION, 2997, 100,
+                                           NULL);
+        }
 
         GstEvent *caps_event = gst_event_new_caps(src_caps);
         if (caps_event == NULL || !gst_pad_push_event (base->srcpad, caps_event))
@@ -666,18 +771,74 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
 
     return TRUE;
 }
+
 /***********************************************************************************
  * chain
  ***********************************************************************************/
-static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffer *buf)
+static void videodecoder_clear_pending_inputs(VideoDecoder *decoder)
+{
+    int i;
+    for (i = 0; i < MAX_PENDING_INPUTS; i++)
+    {
+        decoder->pending_inputs[i].timestamp = GST_CLOCK_TIME_NONE;
+        decoder->pending_inputs[i].duration = GST_CLOCK_TIME_NONE;
+        decoder->pending_inputs[i].discont = FALSE;
+    }
+    decoder->next_pending_input = 0;
+}
+
+// Remembers the duration and discont flag of an input buffer until the frame
+// decoded from it comes out, which with frame threads can be several buffers
+// later. That frame is found by the timestamp reordered_opaque carries.
+static void videodecoder_add_pending_input(VideoDecoder *decoder, GstBuffer *buf)
+{
+    PendingInput *input;
+
+    if (!GST_BUFFER_TIMESTAMP_IS_VALID(buf))
+    {
+        // The frame cannot be matched, flag the next one.
+        if (GST_BUFFER_IS_DISCONT(buf))
+            decoder->discont = TRUE;
+        return;
+    }
+
+    input = &decoder->pending_inputs[decoder->next_pending_input];
+    decoder->next_pending_input = (decoder->next_pending_input + 1) % MAX_PENDING_INPUTS;
+    // An entry overwritten before its frame came out keeps its discont flag.
+    if (GST_CLOCK_TIME_IS_VALID(input->timestamp) && input->discont)
+        decoder->discont = TRUE;
+
+    input->timestamp = GST_BUFFER_TIMESTAMP(buf);
+    input->duration = GST_BUFFER_DURATION(buf);
+    input->discont = GST_BUFFER_IS_DISCONT(buf);
+}
+
+// Returns the duration of the input buffer with the given timestamp, or
+// GST_CLOCK_TIME_NONE if there is none, and sets discont from its flag.
+static GstClockTime videodecoder_take_pending_input(VideoDecoder *decoder, GstClockTime timestamp, gboolean *discont)
+{
+    int i;
+    for (i = 0; i < MAX_PENDING_INPUTS; i++)
+    {
+        PendingInput *input = &decoder->pending_inputs[i];
+        if (input->timestamp == timestamp)
+        {
+            *discont = input->discont;
+            input->timestamp = GST_CLOCK_TIME_NONE;
+            return input->duration;
+        }
+    }
+
+    *discont = FALSE;
+    return GST_CLOCK_TIME_NONE;
+}
+
+// Pushes the frame just decoded into base->frame.
+static GstFlowReturn videodecoder_push_frame(VideoDecoder *decoder)
 {
-    VideoDecoder  *decoder = VIDEODECODER(parent);
     BaseDecoder   *base = BASEDECODER(decoder);
     GstFlowReturn  result = GST_FLOW_OK;
-    int            num_dec = NO_DATA_USED;
-    GstMapInfo     info;
     GstMapInfo     info2;
-    gboolean       unmap_buf = FALSE;
     gboolean       set_frame_values = TRUE;
     int64_t        reordered_opaque = AV_NOPTS_VALUE;
     unsigned int   out_buf_size = 0;
@@ -685,6 +846,232 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
     uint8_t*       data0 = NULL;
     uint8_t*       data1 = NULL;
     uint8_t*       data2 = NULL;
+    gboolean       discont = FALSE;
+
+    if (!videodecoder_configure_sourcepad(decoder))
+        return GST_FLOW_ERROR;
+
+#if HEVC_SUPPORT
+    // Check to see if we need to convert frame to YUV420p
+    if (decoder->needs_conversion)
+    {
+        if (!videodecoder_convert_frame(decoder))
+        {
+            gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
+                                     GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
+                                     g_strdup("Video frame conversion failed"), NULL,
+                                     ("videodecoder.c"), ("videodecoder_push_frame"), 0);
+
+            return GST_FLOW_ERROR;
+        }
+
+        reordered_opaque = decoder->dest_frame->reordered_opaque;
+        data0 = decoder->dest_frame->data[0];
+        data1 = decoder->dest_frame->data[1];
+        data2 = decoder->dest_frame->data[2];
+        set_frame_values = FALSE;
+    }
+#endif // HEVC_SUPPORT
+
+    if (set_frame_values)
+    {
+        // Each frame carries the timestamp of the packet it was decoded
+        // from, also when frame threads return it several packets later.
+        reordered_opaque = base->frame->reordered_opaque;
+        data0 = base->frame->data[0];
+        data1 = base->frame->data[1];
+        data2 = base->frame->data[2];
+    }
+
+    GstBuffer *outbuf = gst_buffer_new_allocate(NULL, decoder->frame_size, NULL);
+    if (outbuf == NULL)
+    {
+        if (result != GST_FLOW_FLUSHING)
+        {
+            gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
+                                     GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
+                                     g_strdup("Decoded video buffer allocation failed"), NULL,
+                                     ("videodecoder.c"), ("videodecoder_push_frame"), 0);
+        }
+    }
+    else
+    {
+        GST_BUFFER_OFFSET(outbuf) = base->context->frame_number;
+        if (reordered_opaque != AV_NOPTS_VALUE)
+        {
+            GST_BUFFER_TIMESTAMP(outbuf) = reordered_opaque;
+            GST_BUFFER_DURATION(outbuf) = videodecoder_take_pending_input(decoder, reordered_opaque, &discont);
+        }
+
+        if (!gst_buffer_map(outbuf, &info2, GST_MAP_WRITE))
+        {
+            // INLINE - gst_buffer_unref()
+            gst_buffer_unref(outbuf);
+            gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
+                             g_strdup("Decoded video buffer allocation failed"), NULL, ("videodecoder.c"), ("videodecoder_push_frame"), 0);
+            return GST_FLOW_OK;
+        }
+
+        // Copy image by parts from different arrays.
+        if (decoder->frame_size > (unsigned int)info2.maxsize) // maxsize should be same or more due to alignment
+        {
+            gst_buffer_unmap(outbuf, &info2);
+            // INLINE - gst_buffer_unref()
+            gst_buffer_unref(outbuf);
+            gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
+                             g_strdup("Wrong buffer size"), NULL, ("videodecoder.c"), ("videodecoder_push_frame"), 0);
+            return GST_FLOW_OK;
+        }
+
+        out_buf_size = decoder->frame_size;
+        if (out_buf_size >= decoder->u_offset)
+        {
+            memcpy(info2.data, data0, decoder->u_offset);
+            out_buf_size -= decoder->u_offset;
+            if (out_buf_size >= decoder->uv_blocksize &&
+                decoder->uv_blocksize <= decoder->frame_size &&
+                decoder->u_offset <= (decoder->frame_size - decoder->uv_blocksize))
+            {
+                memcpy(info2.data + decoder->u_offset, data1, decoder->uv_blocksize);
+                out_buf_size -= decoder->uv_blocksize;
+                // Only planar formats have a separate V plane.
+                if (decoder->plane_count == 3)
+                {
+                    if (out_buf_size >= decoder->uv_blocksize &&
+                        decoder->uv_blocksize <= decoder->frame_size &&
+                        decoder->v_offset <= (decoder->frame_size - decoder->uv_blocksize))
+                    {
+                        memcpy(info2.data + decoder->v_offset, data2, decoder->uv_blocksize);
+                    }
+                    else
+                    {
+                        copy_error = TRUE;
+                    }
+                }
+            }
+            else
+            {
+                copy_error = TRUE;
+            }
+        }
+        else
+        {
+            copy_error = TRUE;
+        }
+
+        gst_buffer_unmap(outbuf, &info2);
+
+        if (copy_error)
+        {
+            // INLINE - gst_buffer_unref()
+            gst_buffer_unref(outbuf);
+            gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
+                             g_strdup("Copy data failed"), NULL, ("videodecoder.c"), ("videodecoder_push_frame"), 0);
+            return GST_FLOW_OK;
+        }
+
+        GST_BUFFER_OFFSET_END(outbuf) = GST_BUFFER_OFFSET_NONE;
+
+        if (decoder->discont || discont)
+        {
+#ifdef DEBUG_OUTPUT
+            g_print("Video discont: frame size=%dx%d\n", base->context->width, base->context->height);
+#endif
+            GST_BUFFER_FLAG_SET(outbuf, GST_BUFFER_FLAG_DISCONT);
+            decoder->discont = FALSE;
+        }
+
+
+#ifdef VERBOSE_DEBUG
+        g_print("videodecoder: pushing buffer ts=%.4f sec", (double)GST_BUFFER_TIMESTAMP(outbuf)/GST_SECOND);
+#endif
+        result = gst_pad_push(base->srcpad, outbuf);
+#ifdef VERBOSE_DEBUG
+        g_print(" done, res=%s\n", gst_flow_get_name(result));
+#endif
+    }
+
+    return result;
+}
+
+#if USE_SEND_RECEIVE
+// Pushes all the frames the decoder has ready. With frame threading a packet
+// does not give a frame right away, and later packets may give several.
+static GstFlowReturn videodecoder_receive_frames(VideoDecoder *decoder)
+{
+    BaseDecoder   *base = BASEDECODER(decoder);
+    GstFlowReturn  result = GST_FLOW_OK;
+
+    while (result == GST_FLOW_OK && avcodec_receive_frame(base->context, base->frame) == 0)
+    {
+        decoder->frame_finished = 1;
+        result = videodecoder_push_frame(decoder);
+    }
+
+    return result;
+}
+
+// Sends decoder->packet and pushes the frames it gives. Frames left in the
+// decoder because a push failed make it refuse the next packet with EAGAIN,
+// so they are taken out first and the packet is sent again. Frames that
+// still cannot be pushed are dropped rather than the packet.
+static int videodecoder_send_packet(VideoDecoder *decoder, GstFlowReturn *result)
+{
+    BaseDecoder   *base = BASEDECODER(decoder);
+    int            ret = avcodec_send_packet(base->context, &decoder->packet);
+
+    *result = GST_FLOW_OK;
+    if (ret == AVERROR(EAGAIN))
+    {
+        *result = videodecoder_receive_frames(decoder);
+        while (*result != GST_FLOW_OK && avcodec_receive_frame(base->context, base->frame) == 0)
+            ;
+        ret = avcodec_send_packet(base->context, &decoder->packet);
+    }
+
+    if (ret == 0 && *result == GST_FLOW_OK)
+        *result = videodecoder_receive_frames(decoder);
+
+    return ret;
+}
+#endif // USE_SEND_RECEIVE
+
+// Pushes the frames still held by the decoder at the end of the stream.
+static void videodecoder_drain(VideoDecoder *decoder)
+{
+    BaseDecoder   *base = BASEDECODER(decoder);
+
+    if (!base->is_initialized || base->context == NULL || base->is_flushing)
+        return;
+
+#if USE_SEND_RECEIVE
+    if (avcodec_send_packet(base->context, NULL) == 0)
+        videodecoder_receive_frames(decoder);
+#else
+    av_init_packet(&decoder->packet);
+    decoder->packet.data = NULL;
+    decoder->packet.size = 0;
+    do
+    {
+        decoder->frame_finished = 0;
+        if (avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, &decoder->packet) < 0)
+            break;
+    } while (decoder->frame_finished > 0 && videodecoder_push_frame(decoder) == GST_FLOW_OK);
+#endif
+
+    // The decoder takes new packets only after a flush once drained.
+    basedecoder_flush(base);
+    videodecoder_clear_pending_inputs(decoder);
+}
+
+static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffer *buf)
+{
+    VideoDecoder  *decoder = VIDEODECODER(parent);
+    BaseDecoder   *base = BASEDECODER(decoder);
+    GstFlowReturn  result = GST_FLOW_OK;
+    int            num_dec = NO_DATA_USED;
+    GstMapInfo     info;
+    gboolean       unmap_buf = FALSE;
 
     if (base->is_flushing)  // Reject buffers in flushing state.
     {
@@ -706,6 +1093,8 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
 
     unmap_buf = TRUE;
 
+    videodecoder_add_pending_input(decoder, buf);
+
     if (!base->is_hls)
     {
         if (av_new_packet(&decoder->packet, info.size) == 0)
@@ -716,15 +1105,7 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
             else
                 base->context->reordered_opaque = AV_NOPTS_VALUE;
 #if USE_SEND_RECEIVE
-            num_dec = avcodec_send_packet(base->context, &decoder->packet);
-            if (num_dec == 0)
-            {
-                num_dec = avcodec_receive_frame(base->context, base->frame);
-                if (num_dec == 0)
-                    decoder->frame_finished = 1;
-                else
-                    decoder->frame_finished = 0;
-            }
+            num_dec = videodecoder_send_packet(decoder, &result);
 #else
             num_dec = avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, &decoder->packet);
 #endif
@@ -752,15 +1133,7 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
             base->context->reordered_opaque = AV_NOPTS_VALUE;
 
 #if USE_SEND_RECEIVE
-        num_dec = avcodec_send_packet(base->context, &decoder->packet);
-        if (num_dec == 0)
-        {
-            num_dec = avcodec_receive_frame(base->context, base->frame);
-            if (num_dec == 0)
-                decoder->frame_finished = 1;
-            else
-                decoder->frame_finished = 0;
-        }
+        num_dec = videodecoder_send_packet(decoder, &result);
 #else
         num_dec = avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, &decoder->packet);
 #endif
@@ -775,148 +1148,10 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
         goto _exit;
     }
 
+#if !USE_SEND_RECEIVE
     if (decoder->frame_finished > 0)
-    {
-        if (!videodecoder_configure_sourcepad(decoder))
-            result = GST_FLOW_ERROR;
-        else
-        {
-#if HEVC_SUPPORT
-            // Check to see if we need to convert frame to YUV420p
-            if (base->frame->format != AV_PIX_FMT_YUV420P)
-            {
-                if (!videodecoder_convert_frame(decoder))
-                {
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
-                                             GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
-                                             g_strdup("Video frame conversion failed"), NULL,
-                                             ("videodecoder.c"), ("videodecoder_chain"), 0);
-
-                    result = GST_FLOW_ERROR;
-                    goto _exit;
-                }
-
-                reordered_opaque = decoder->dest_frame->reordered_opaque;
-                data0 = decoder->dest_frame->data[0];
-                data1 = decoder->dest_frame->data[1];
-                data2 = decoder->dest_frame->data[2];
-                set_frame_values = FALSE;
-            }
-#endif // HEVC_SUPPORTf
-
-            if (set_frame_values)
-            {
-                reordered_opaque = base->frame->reordered_opaque;
-                data0 = base->frame->data[0];
-                data1 = base->frame->data[1];
-                data2 = base->frame->data[2];
-            }
-
-            GstBuffer *outbuf = gst_buffer_new_allocate(NULL, decoder->frame_size, NULL);
-            if (outbuf == NULL)
-            {
-                if (result != GST_FLOW_FLUSHING)
-                {
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
-                                             GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
-                                             g_strdup("Decoded video buffer allocation failed"), NULL,
-                                             ("videodecoder.c"), ("videodecoder_chain"), 0);
-                }
-            }
-            else
-            {
-                GST_BUFFER_OFFSET(outbuf) = base->context->frame_number;
-                if (reordered_opaque != AV_NOPTS_VALUE)
-                {
-                    GST_BUFFER_TIMESTAMP(outbuf) = reordered_opaque;
-                    GST_BUFFER_DURATION(outbuf) = GST_BUFFER_DURATION(buf); // Duration for video usually same
-                }
-
-                if (!gst_buffer_map(outbuf, &info2, GST_MAP_WRITE))
-                {
-                    // INLINE - gst_buffer_unref()
-                    gst_buffer_unref(outbuf);
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
-                                     g_strdup("Decoded video buffer allocation failed"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
-                    goto _exit;
-                }
-
-                // Copy image by parts from different arrays.
-                if (decoder->frame_size > (unsigned int)info2.maxsize) // maxsize should be same or more due to alignment
-                {
-                    gst_buffer_unmap(outbuf, &info2);
-                    // INLINE - gst_buffer_unref()
-                    gst_buffer_unref(outbuf);
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
-                                     g_strdup("Wrong buffer size"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
-                    goto _exit;
-                }
-
-                out_buf_size = decoder->frame_size;
-                if (out_buf_size >= decoder->u_offset)
-                {
-                    memcpy(info2.data, data0, decoder->u_offset);
-                    out_buf_size -= decoder->u_offset;
-                    if (out_buf_size >= decoder->uv_blocksize &&
-                        decoder->uv_blocksize <= decoder->frame_size &&
-                        decoder->u_offset <= (decoder->frame_size - decoder->uv_blocksize))
-                    {
-                        memcpy(info2.data + decoder->u_offset, data1, decoder->uv_blocksize);
-                        out_buf_size -= decoder->uv_blocksize;
-                        if (out_buf_size >= decoder->uv_blocksize &&
-                            decoder->uv_blocksize <= decoder->frame_size &&
-                            decoder->v_offset <= (decoder->frame_size - decoder->uv_blocksize))
-                        {
-                            memcpy(info2.data + decoder->v_offset, data2, decoder->uv_blocksize);
-                        }
-                        else
-                        {
-                            copy_error = TRUE;
-                        }
-                    }
-                    else
-                    {
-                        copy_error = TRUE;
-                    }
-                }
-                else
-                {
-                    copy_error = TRUE;
-                }
-
-                gst_buffer_unmap(outbuf, &info2);
-
-                if (copy_error)
-                {
-                    // INLINE - gst_buffer_unref()
-                    gst_buffer_unref(outbuf);
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
-                                     g_strdup("Copy data failed"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
-                    goto _exit;
-                }
-
-                GST_BUFFER_OFFSET_END(outbuf) = GST_BUFFER_OFFSET_NONE;
-
-                if (decoder->discont || GST_BUFFER_IS_DISCONT(buf))
-                {
-#ifdef DEBUG_OUTPUT
-                    g_print("Video discont: frame size=%dx%d\n", base->context->width, base->context->height);
+        result = videodecoder_push_frame(decoder);
 #endif
-                    GST_BUFFER_FLAG_SET(outbuf, GST_BUFFER_FLAG_DISCONT);
-                    decoder->discont = FALSE;
-                }
-
-
-#ifdef VERBOSE_DEBUG
-                g_print("videodecoder: pushing buffer ts=%.4f sec", (double)GST_BUFFER_TIMESTAMP(outbuf)/GST_SECOND);
-#endif
-                result = gst_pad_push(base->srcpad, outbuf);
-#ifdef VERBOSE_DEBUG
-                g_print(" done, res=%s\n", gst_flow_get_name(result));
-#endif
-            }
-        }
-    }
 
 _exit:
     if (unmap_buf)
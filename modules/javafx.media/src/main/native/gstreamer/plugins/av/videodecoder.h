@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -64,6 +64,16 @@ typedef int (*sws_scale_ptr)(struct SwsContext *c, const uint8_t *const srcSlice
 typedef struct _VideoDecoder      VideoDecoder;
 typedef struct _VideoDecoderClass VideoDecoderClass;
 
+// Enough for the frames held by 16 frame threads plus the reorder delay.
+#define MAX_PENDING_INPUTS 64
+
+// Input buffer values the decoded frame is pushed with, found by timestamp.
+typedef struct {
+    GstClockTime timestamp;
+    GstClockTime duration;
+    gboolean     discont;
+} PendingInput;
+
 struct _VideoDecoder {
     BaseDecoder parent;
 
@@ -76,12 +86,20 @@ struct _VideoDecoder {
     unsigned int u_offset;
     unsigned int v_offset;
     unsigned int uv_blocksize;
+    unsigned int plane_count;    // 2 when U and V are interleaved
+    unsigned int chroma_shift;   // 1 when the chroma planes have half the rows
+    gint         pix_fmt;        // of the decoded frames
 
     AVPacket     packet;
+    PendingInput pending_inputs[MAX_PENDING_INPUTS]; // of the buffers sent to the decoder
+    guint        next_pending_input;
 
     gint         codec_id;
+    gint         thread_count;   // property controlled, 0 picks it from the number of CPUs
 
 #if HEVC_SUPPORT
+    // Formats jfxmedia cannot convert are converted to YUV420P first
+    gboolean           needs_conversion;
     struct SwsContext *sws_context;
     AVFrame           *dest_frame;
 
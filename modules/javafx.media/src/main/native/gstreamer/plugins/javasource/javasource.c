@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -34,6 +34,10 @@ GST_DEBUG_CATEGORY (java_source_debug);
 
 #define MAX_READ_SIZE 65536
 
+#define DEFAULT_READ_AHEAD_BLOCK_SIZE (256 * 1024)
+#define MAX_READ_AHEAD_BLOCK_SIZE     (16 * 1024 * 1024)
+#define MAX_READ_AHEAD_BLOCKS         64
+
 /***********************************************************************************
 * HLS Properties and Values
 ***********************************************************************************/
@@ -54,6 +58,8 @@ enum
     SIGNAL_COPY_BLOCK,
     SIGNAL_CLOSE_CONNECTION,
     SIGNAL_PROPERTY,
+    SIGNAL_READER_STARTED,
+    SIGNAL_READER_STOPPED,
     LAST_SIGNAL
 };
 
@@ -66,7 +72,9 @@ enum
     PROP_STOP_ON_PAUSE,
     PROP_LOCATION,
     PROP_MIMETYPE,
-    PROP_HLS_MODE
+    PROP_HLS_MODE,
+    PROP_READ_AHEAD_BLOCKS,
+    PROP_READ_AHEAD_BLOCK_SIZE
 };
 
 /***********************************************************************************
@@ -106,6 +114,17 @@ struct _JavaSource
     gchar*        location; // property controlled
     gchar*        mimetype; // property controlled
     gdouble       rate;
+
+    // Read-ahead. Guarded by lock, except for the buffer being filled which
+    // only the read-ahead thread touches.
+    guint         read_ahead_blocks; // property controlled, 0 disables read-ahead
+    guint         read_ahead_block_size; // property controlled
+    GThread       *read_ahead_thread;
+    GCond         read_ahead_cond;
+    GQueue        read_ahead_queue; // filled buffers in stream order
+    gboolean      read_ahead_running;
+    gint          read_ahead_status; // EOS_CODE or OTHER_ERROR_CODE when the thread stopped reading
+    gint          read_ahead_waiting; // streaming thread waits for data, atomic
 };
 
 struct _JavaSourceClass
@@ -221,6 +240,17 @@ static void java_source_class_init (JavaSourceClass *klass)
         g_param_spec_string ("mimetype", "Source Mimetype", "Mimetype of the source", NULL,
         G_PARAM_WRITABLE | G_PARAM_STATIC_STRINGS | GST_PARAM_MUTABLE_READY));
 
+    g_object_class_install_property (gobject_klass, PROP_READ_AHEAD_BLOCKS,
+        g_param_spec_uint ("read-ahead-blocks", "Read-ahead blocks",
+        "Number of blocks read ahead by a separate thread in push mode, 0 reads on the streaming thread",
+        0, MAX_READ_AHEAD_BLOCKS, 0,
+        G_PARAM_WRITABLE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS | GST_PARAM_MUTABLE_READY));
+
+    g_object_class_install_property (gobject_klass, PROP_READ_AHEAD_BLOCK_SIZE,
+        g_param_spec_uint ("read-ahead-block-size", "Read-ahead block size", "Size in bytes of the blocks read ahead",
+        4096, MAX_READ_AHEAD_BLOCK_SIZE, DEFAULT_READ_AHEAD_BLOCK_SIZE,
+        G_PARAM_WRITABLE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS | GST_PARAM_MUTABLE_READY));
+
     klass->signals[SIGNAL_SEEK_DATA] = g_signal_new ("seek-data",
         G_TYPE_FROM_CLASS (klass),
         G_SIGNAL_RUN_LAST | G_SIGNAL_NO_HOOKS,
@@ -284,6 +314,27 @@ static void java_source_class_init (JavaSourceClass *klass)
         G_TYPE_INT, /* return_type */
         2,    /* n_params */
         G_TYPE_INT, G_TYPE_INT);
+
+    // Emitted on the read-ahead thread before its first read and after its last one
+    klass->signals[SIGNAL_READER_STARTED] = g_signal_new ("reader-started",
+        G_TYPE_FROM_CLASS (klass),
+        G_SIGNAL_RUN_LAST | G_SIGNAL_NO_HOOKS,
+        0,
+        NULL, /* accumulator */
+        NULL, /* accu_data */
+        g_cclosure_marshal_VOID__VOID,
+        G_TYPE_NONE, /* return_type */
+        0     /* n_params */ );
+
+    klass->signals[SIGNAL_READER_STOPPED] = g_signal_new ("reader-stopped",
+        G_TYPE_FROM_CLASS (klass),
+        G_SIGNAL_RUN_LAST | G_SIGNAL_NO_HOOKS,
+        0,
+        NULL, /* accumulator */
+        NULL, /* accu_data */
+        g_cclosure_marshal_VOID__VOID,
+        G_TYPE_NONE, /* return_type */
+        0     /* n_params */ );
 }
 
 static void java_source_init(JavaSource *element)
@@ -300,6 +351,12 @@ static void java_source_init(JavaSource *element)
     gst_element_add_pad (GST_ELEMENT (element), element->srcpad);
 
     g_mutex_init(&element->lock);
+    g_cond_init(&element->read_ahead_cond);
+    g_queue_init(&element->read_ahead_queue);
+    element->read_ahead_thread = NULL;
+    element->read_ahead_running = FALSE;
+    element->read_ahead_status = 0;
+    element->read_ahead_waiting = FALSE;
 
     element->mode = MODE_DEFAULT;
 
@@ -341,6 +398,12 @@ static void java_source_set_property (GObject *object, guint prop_id,
     case PROP_MIMETYPE:
         element->mimetype = g_strdup(g_value_get_string (value));
         break;
+    case PROP_READ_AHEAD_BLOCKS:
+        element->read_ahead_blocks = g_value_get_uint (value);
+        break;
+    case PROP_READ_AHEAD_BLOCK_SIZE:
+        element->read_ahead_block_size = g_value_get_uint (value);
+        break;
     default:
         break;
     }
@@ -359,9 +422,13 @@ static void java_source_get_property (GObject *object, guint prop_id,
     }
 }
 
+static void java_source_read_ahead_flush(JavaSource *element);
+
 static void java_source_finalize (GObject *object)
 {
     JavaSource *element = JAVA_SOURCE(object);
+    java_source_read_ahead_flush(element);
+    g_cond_clear(&element->read_ahead_cond);
     g_mutex_clear(&element->lock);
     g_free(element->location);
     if (element->mimetype)
@@ -369,6 +436,202 @@ static void java_source_finalize (GObject *object)
     G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+/***********************************************************************************
+* Read-ahead
+*
+* In push mode a separate thread can read the stream from Java into large
+* buffers, so that the streaming thread does not wait for the Java callbacks
+* and only pushes the buffers that have already been filled. Up to
+* read_ahead_blocks filled buffers are queued, a buffer is handed out early
+* when the streaming thread runs out of data. The thread emits reader-started
+* and reader-stopped around its reads, so that the handlers can set up their
+* per thread state (such as a JVM attachment) once rather than on every read.
+***********************************************************************************/
+static gboolean java_source_read_ahead_enabled(JavaSource *element)
+{
+    return element->read_ahead_blocks > 0 && (element->mode & MODE_DEFAULT) == MODE_DEFAULT;
+}
+
+// Must be called with the lock held.
+static void java_source_read_ahead_flush(JavaSource *element)
+{
+    GstBuffer *buffer;
+    while ((buffer = (GstBuffer*)g_queue_pop_head(&element->read_ahead_queue)) != NULL)
+        gst_buffer_unref(buffer);
+    element->read_ahead_status = 0;
+}
+
+// Waits until there is room for another buffer in the queue.
+// Returns FALSE when the thread has to stop.
+static gboolean java_source_read_ahead_wait(JavaSource *element)
+{
+    gboolean result;
+
+    g_mutex_lock(&element->lock);
+    while (element->read_ahead_running && g_queue_get_length(&element->read_ahead_queue) >= element->read_ahead_blocks)
+        g_cond_wait(&element->read_ahead_cond, &element->lock);
+    result = element->read_ahead_running;
+    g_mutex_unlock(&element->lock);
+
+    return result;
+}
+
+static void java_source_read_ahead_queue(JavaSource *element, GstBuffer *buffer, GstMapInfo *info, gsize size)
+{
+    gst_buffer_unmap(buffer, info);
+    gst_buffer_set_size(buffer, size);
+
+    g_mutex_lock(&element->lock);
+    if (element->read_ahead_running)
+    {
+        g_queue_push_tail(&element->read_ahead_queue, buffer);
+        buffer = NULL;
+    }
+    g_cond_broadcast(&element->read_ahead_cond);
+    g_mutex_unlock(&element->lock);
+
+    if (buffer)
+        gst_buffer_unref(buffer);
+}
+
+static gpointer java_source_read_ahead_thread(gpointer data)
+{
+    JavaSource *element = JAVA_SOURCE(data);
+    GstBuffer  *buffer = NULL;
+    GstMapInfo info;
+    gsize      filled = 0;
+    gint       size = 0;
+
+    g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READER_STARTED], 0);
+
+    while (java_source_read_ahead_wait(element))
+    {
+        g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_NEXT_BLOCK], 0, &size);
+        if (size > 0)
+        {
+            if (buffer && filled + size > info.size)
+            {
+                java_source_read_ahead_queue(element, buffer, &info, filled);
+                buffer = NULL;
+            }
+
+            if (buffer == NULL)
+            {
+                buffer = gst_buffer_new_allocate(NULL, MAX(element->read_ahead_block_size, (guint)size), NULL);
+                if (buffer && !gst_buffer_map(buffer, &info, GST_MAP_WRITE))
+                {
+                    gst_buffer_unref(buffer);
+                    buffer = NULL;
+                }
+                if (buffer == NULL)
+                {
+                    size = OTHER_ERROR_CODE;
+                    break;
+                }
+                filled = 0;
+            }
+
+            g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_COPY_BLOCK], 0, info.data + filled, size);
+            filled += size;
+
+            if (filled == info.size || g_atomic_int_get(&element->read_ahead_waiting))
+            {
+                java_source_read_ahead_queue(element, buffer, &info, filled);
+                buffer = NULL;
+            }
+        }
+        else if (size < 0)
+            break;
+    }
+
+    if (buffer)
+        java_source_read_ahead_queue(element, buffer, &info, filled);
+
+    g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READER_STOPPED], 0);
+
+    g_mutex_lock(&element->lock);
+    if (element->read_ahead_running && size < 0)
+        element->read_ahead_status = size;
+    g_cond_broadcast(&element->read_ahead_cond);
+    g_mutex_unlock(&element->lock);
+
+    return NULL;
+}
+
+/*
+ * Takes the next buffer read ahead and returns its size, starting the
+ * read-ahead thread if needed. Returns EOS_CODE or OTHER_ERROR_CODE once the
+ * queued data has run out after the end of the stream or an error, and 0 if
+ * the element is being flushed.
+ */
+static gint java_source_read_ahead_pop(JavaSource *element, GstBuffer **buffer)
+{
+    gint size = 0;
+
+    *buffer = NULL;
+
+    g_mutex_lock(&element->lock);
+    if (element->srcresult == GST_FLOW_OK && element->read_ahead_thread == NULL)
+    {
+        element->read_ahead_running = TRUE;
+        element->read_ahead_status = 0;
+        element->read_ahead_thread = g_thread_try_new("JavaSourceReadAhead", java_source_read_ahead_thread, element, NULL);
+        if (element->read_ahead_thread == NULL)
+        {
+            element->read_ahead_running = FALSE;
+            size = OTHER_ERROR_CODE;
+        }
+    }
+
+    while (size == 0 && element->srcresult == GST_FLOW_OK)
+    {
+        *buffer = (GstBuffer*)g_queue_pop_head(&element->read_ahead_queue);
+        if (*buffer)
+        {
+            size = (gint)gst_buffer_get_size(*buffer);
+            g_cond_broadcast(&element->read_ahead_cond);
+        }
+        else if (element->read_ahead_status < 0)
+            size = element->read_ahead_status;
+        else if (element->read_ahead_running)
+        {
+            g_atomic_int_set(&element->read_ahead_waiting, TRUE);
+            g_cond_wait(&element->read_ahead_cond, &element->lock);
+            g_atomic_int_set(&element->read_ahead_waiting, FALSE);
+        }
+        else
+            break;
+    }
+    g_mutex_unlock(&element->lock);
+
+    return size;
+}
+
+/*
+ * Stops the read-ahead thread and drops the data it has read. Called before
+ * seeking and closing the connection, which must not run concurrently with
+ * the reads. srcresult must have been set to a value other than GST_FLOW_OK
+ * beforehand, so that the streaming thread does not start reading again.
+ */
+static void java_source_read_ahead_stop(JavaSource *element)
+{
+    GThread *thread;
+
+    g_mutex_lock(&element->lock);
+    thread = element->read_ahead_thread;
+    element->read_ahead_thread = NULL;
+    element->read_ahead_running = FALSE;
+    g_cond_broadcast(&element->read_ahead_cond);
+    g_mutex_unlock(&element->lock);
+
+    if (thread)
+        g_thread_join(thread);
+
+    g_mutex_lock(&element->lock);
+    java_source_read_ahead_flush(element);
+    g_mutex_unlock(&element->lock);
+}
+
 /***********************************************************************************
 * activate_push handler. Called when the pipeline switches to or from push mode,
 * depending on the 'active' flag.
@@ -396,6 +659,8 @@ static gboolean java_source_activatemode(GstPad *pad, GstObject *parent, GstPadM
                 element->srcresult = GST_FLOW_FLUSHING;
                 g_mutex_unlock(&element->lock);
 
+                java_source_read_ahead_stop(element);
+
                 return gst_pad_stop_task(pad);
             }
 
@@ -450,6 +715,8 @@ static gboolean java_source_perform_seek(JavaSource *element, GstPad *pad, GstEv
     element->srcresult = GST_FLOW_FLUSHING;
     g_mutex_unlock(&element->lock);
 
+    java_source_read_ahead_stop(element);
+
     if ((element->mode & MODE_HLS_LIVE) != MODE_HLS_LIVE)
         GST_PAD_STREAM_LOCK(pad);
 
@@ -627,23 +894,36 @@ next_event:
             {
                 gint     size;
                 GstMapInfo info;
-                g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_NEXT_BLOCK], 0, &size);
-                if (size > 0)
+                GstBuffer *buffer = NULL;
+
+                if (java_source_read_ahead_enabled(element))
+                    size = java_source_read_ahead_pop(element, &buffer);
+                else
                 {
-                    GstBuffer *buffer = gst_buffer_new_allocate(NULL, size, NULL);
-                    if (buffer)
+                    g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_NEXT_BLOCK], 0, &size);
+                    if (size > 0)
                     {
-                        GST_BUFFER_OFFSET(buffer) = element->position;
-
-                        if (!gst_buffer_map(buffer, &info, GST_MAP_WRITE))
+                        buffer = gst_buffer_new_allocate(NULL, size, NULL);
+                        if (buffer)
                         {
-                            result = GST_FLOW_ERROR;
-                            break;
-                        }
+                            if (!gst_buffer_map(buffer, &info, GST_MAP_WRITE))
+                            {
+                                result = GST_FLOW_ERROR;
+                                break;
+                            }
 
-                        g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_COPY_BLOCK], 0, info.data, size);
+                            g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_COPY_BLOCK], 0, info.data, size);
 
-                        gst_buffer_unmap(buffer, &info);
+                            gst_buffer_unmap(buffer, &info);
+                        }
+                    }
+                }
+
+                if (size > 0)
+                {
+                    if (buffer)
+                    {
+                        GST_BUFFER_OFFSET(buffer) = element->position;
 
                         if (element->discont)
                         {
@@ -919,11 +1199,16 @@ static GstStateChangeReturn java_source_change_state (GstElement *e,
     case GST_STATE_CHANGE_PLAYING_TO_PAUSED:
         g_mutex_lock(&element->lock);
         if (element->stop_on_pause)
+        {
             element->srcresult = GST_FLOW_FLUSHING;
+            g_cond_broadcast(&element->read_ahead_cond); // wake up the streaming thread waiting for data
+        }
         g_mutex_unlock(&element->lock);
         break;
 
     case GST_STATE_CHANGE_READY_TO_NULL:
+        java_source_read_ahead_stop(element); // no reads may follow close-connection
+
         g_mutex_lock(&element->lock);
         if (!element->stop_on_pause)
             element->srcresult = GST_FLOW_FLUSHING;
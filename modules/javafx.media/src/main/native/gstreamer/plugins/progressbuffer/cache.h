@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -30,11 +30,18 @@
 
 typedef struct _Cache Cache;
 
+// Default amount of cached data kept in memory before the cache spills to its file.
+#define CACHE_DEFAULT_MEMORY_LIMIT (4 * 1024 * 1024)
+
 void      cache_static_init(void); // Must be called only once from the ProgressBuffer class initializer
 
 Cache*    create_cache();
 void      destroy_cache(Cache* instance);
 
+// Sets how much of the cached data may be kept in memory. Data written past
+// the limit goes to the backing file. Takes effect for newly cached data.
+void           cache_set_memory_limit(Cache* cache, gint64 limit);
+
 // Writes a buffer.
 void           cache_write_buffer(Cache* cache, GstBuffer* buffer);
 
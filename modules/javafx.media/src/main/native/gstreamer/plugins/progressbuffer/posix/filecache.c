@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -26,20 +26,54 @@
 #include <cache.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <errno.h>
 #include <fcntl.h>
+#include <string.h>
 #include <unistd.h>
 
 #define DEFAULT_BUFFER_SIZE 4096
+
+// The cache is kept in separately mapped chunks. Buffers read from the cache
+// are views of the chunk mappings, which hold a reference to their chunk, so
+// the data is not copied again after it has been written.
+#define CHUNK_SIZE (1024 * 1024)
+
 static const char *tempDir = NULL;
 
+// The memory and file space of a cache. Chunks give theirs back when their
+// last reference is dropped, which may happen on any thread and after the
+// cache has been destroyed, so the store is shared by the cache and its
+// chunks.
+typedef struct _CacheStore
+{
+    gint    refcount;
+    GMutex  lock;
+    gint64  memory_size;  // anonymous memory of the chunks not released yet
+    GArray* free_regions; // gint64 file offsets of released chunks
+} CacheStore;
+
+typedef struct _CacheChunk
+{
+    gint        refcount;
+    CacheStore* store;
+    guint8*     data;
+    gint64      file_offset; // -1 for anonymous memory
+    gsize       written;     // end of the data written to the chunk so far
+} CacheChunk;
+
 struct _Cache
 {
-    char*   filename;
-    int     readHandle;
-    int     writeHandle;
+    char*       filename;
+    int         handle;
+    gint64      file_size;
 
-    gint64  read_position;
-    gint64  write_position;
+    GPtrArray*  chunks; // CacheChunk* by position / CHUNK_SIZE, or NULL
+    CacheStore* store;
+    gint64      memory_limit;
+
+    gint64      read_position;
+    gint64      write_position;
 };
 
 void cache_static_init(void)
@@ -47,6 +81,68 @@ void cache_static_init(void)
     tempDir = g_get_tmp_dir();
 }
 
+static CacheStore* cache_store_new(void)
+{
+    CacheStore* store = g_try_new(CacheStore, 1);
+    if (store)
+    {
+        store->refcount = 1;
+        g_mutex_init(&store->lock);
+        store->memory_size = 0;
+        store->free_regions = g_array_new(FALSE, FALSE, sizeof(gint64));
+    }
+    return store;
+}
+
+static void cache_store_unref(CacheStore* store)
+{
+    if (g_atomic_int_dec_and_test(&store->refcount))
+    {
+        g_array_free(store->free_regions, TRUE);
+        g_mutex_clear(&store->lock);
+        g_free(store);
+    }
+}
+
+// Takes CHUNK_SIZE bytes of memory if that stays within limit.
+static gboolean cache_store_reserve_memory(CacheStore* store, gint64 limit)
+{
+    gboolean result;
+
+    g_mutex_lock(&store->lock);
+    result = store->memory_size + CHUNK_SIZE <= limit;
+    if (result)
+        store->memory_size += CHUNK_SIZE;
+    g_mutex_unlock(&store->lock);
+    return result;
+}
+
+// Takes the file region of a released chunk, returns -1 if there is none.
+static gint64 cache_store_take_region(CacheStore* store)
+{
+    gint64 result = -1;
+
+    g_mutex_lock(&store->lock);
+    if (store->free_regions->len > 0)
+    {
+        result = g_array_index(store->free_regions, gint64, store->free_regions->len - 1);
+        g_array_set_size(store->free_regions, store->free_regions->len - 1);
+    }
+    g_mutex_unlock(&store->lock);
+    return result;
+}
+
+// Gives back the memory (file_offset < 0) or the file region of a chunk.
+static void cache_store_release(CacheStore* store, gint64 file_offset)
+{
+    g_mutex_lock(&store->lock);
+    if (file_offset < 0)
+        store->memory_size -= CHUNK_SIZE;
+    else
+        g_array_append_val(store->free_regions, file_offset);
+    g_mutex_unlock(&store->lock);
+}
+
 Cache* create_cache()
 {
     Cache* result= (Cache*)g_try_malloc(sizeof(Cache));
@@ -55,78 +151,252 @@ Cache* create_cache()
         result->filename = g_build_filename(tempDir, "jfxmpbXXXXXX", NULL);
         if (result->filename == NULL)
             goto _error_exit;
-        else
-        {
-        result->writeHandle = g_mkstemp_full(result->filename, O_RDWR, S_IRUSR|S_IWUSR);
-            result->readHandle = open(result->filename, O_RDONLY, 0);
 
-            if(result->writeHandle < 0 || result->readHandle < 0)
-                goto _error_exit;
+        result->handle = g_mkstemp_full(result->filename, O_RDWR, S_IRUSR|S_IWUSR);
+        if (result->handle < 0)
+            goto _error_exit;
 
         if (unlink(result->filename) < 0)
         {
-            close (result->writeHandle);
-            close (result->readHandle);
-        goto _error_exit;
+            close(result->handle);
+            goto _error_exit;
         }
 
-            result->read_position = result->write_position = 0;
+        result->store = cache_store_new();
+        if (result->store == NULL)
+        {
+            close(result->handle);
+            goto _error_exit;
         }
+
+        result->file_size = 0;
+        result->chunks = g_ptr_array_new();
+        result->memory_limit = CACHE_DEFAULT_MEMORY_LIMIT;
+        result->read_position = result->write_position = 0;
     }
     return result;
 
 _error_exit:
+    g_free(result->filename);
     g_free(result);
     return NULL;
 }
 
+static void cache_chunk_unref(CacheChunk* chunk)
+{
+    if (g_atomic_int_dec_and_test(&chunk->refcount))
+    {
+        munmap(chunk->data, CHUNK_SIZE);
+        // Buffers downstream no longer use the chunk, so its memory or file
+        // region can be used for new chunks.
+        cache_store_release(chunk->store, chunk->file_offset);
+        cache_store_unref(chunk->store);
+        g_free(chunk);
+    }
+}
+
+static void cache_release_chunk(Cache* cache, guint index)
+{
+    CacheChunk* chunk = (CacheChunk*)g_ptr_array_index(cache->chunks, index);
+    if (chunk)
+    {
+        g_ptr_array_index(cache->chunks, index) = NULL;
+        cache_chunk_unref(chunk);
+    }
+}
+
 void destroy_cache(Cache* instance)
 {
-    close(instance->writeHandle);
-    close(instance->readHandle);
+    guint i;
+
+    // Chunks still used by buffers downstream stay mapped until those are
+    // released. The mappings keep the unlinked file alive.
+    for (i = 0; i < instance->chunks->len; i++)
+        cache_release_chunk(instance, i);
+    g_ptr_array_free(instance->chunks, TRUE);
+    cache_store_unref(instance->store);
+
+    close(instance->handle);
     g_free(instance->filename);
 
     g_free(instance);
 }
 
+void cache_set_memory_limit(Cache* cache, gint64 limit)
+{
+    cache->memory_limit = limit;
+}
+
+// Allocates a chunk in anonymous memory within the memory limit of the cache,
+// and in the backing file otherwise, reusing the file region of a released
+// chunk if there is one.
+static CacheChunk* cache_chunk_new(Cache* cache)
+{
+    CacheStore* store = cache->store;
+    CacheChunk* chunk = g_try_new(CacheChunk, 1);
+    if (chunk == NULL)
+        return NULL;
+
+    chunk->refcount = 1;
+    chunk->store = store;
+    chunk->written = 0;
+
+    if (cache_store_reserve_memory(store, cache->memory_limit))
+    {
+        chunk->data = mmap(NULL, CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+        if (chunk->data != MAP_FAILED)
+        {
+            chunk->file_offset = -1;
+            g_atomic_int_inc(&store->refcount);
+            return chunk;
+        }
+        cache_store_release(store, -1);
+    }
+
+    chunk->file_offset = cache_store_take_region(store);
+    if (chunk->file_offset < 0)
+        chunk->file_offset = cache->file_size;
+
+    // The file is only extended by the writes, and only the written part of
+    // a chunk is ever read, so the mapping never touches pages past the end
+    // of the file.
+    chunk->data = mmap(NULL, CHUNK_SIZE, PROT_READ, MAP_SHARED, cache->handle, chunk->file_offset);
+    if (chunk->data == MAP_FAILED)
+    {
+        if (chunk->file_offset < cache->file_size)
+            cache_store_release(store, chunk->file_offset);
+        g_free(chunk);
+        return NULL;
+    }
+    if (chunk->file_offset == cache->file_size)
+        cache->file_size += CHUNK_SIZE;
+    g_atomic_int_inc(&store->refcount);
+    return chunk;
+}
+
+static gsize cache_chunk_write(Cache* cache, CacheChunk* chunk, gsize offset, const guint8* data, gsize size)
+{
+    gsize total = 0;
+
+    if (chunk->file_offset < 0)
+    {
+        memcpy(chunk->data + offset, data, size);
+        total = size;
+    }
+    else
+    {
+        // Written through the file rather than the mapping, so that running
+        // out of disk space fails the write instead of raising SIGBUS.
+        while (total < size)
+        {
+            ssize_t written = pwrite(cache->handle, data + total, size - total, chunk->file_offset + offset + total);
+            if (written < 0 && errno == EINTR)
+                continue;
+            if (written <= 0)
+                break;
+            total += written;
+        }
+    }
+
+    if (offset + total > chunk->written)
+        chunk->written = offset + total;
+    return total;
+}
+
+// Returns the chunk to write to at position. A chunk that is rewritten after
+// the write position went back is copied first if buffers still use it, so
+// that the data they hold does not change.
+static CacheChunk* cache_get_writable_chunk(Cache* cache, gint64 position)
+{
+    guint index = (guint)(position / CHUNK_SIZE);
+    gsize offset = (gsize)(position % CHUNK_SIZE);
+    CacheChunk* chunk;
+    CacheChunk* result;
+
+    if (index >= cache->chunks->len)
+        g_ptr_array_set_size(cache->chunks, index + 1);
+
+    chunk = (CacheChunk*)g_ptr_array_index(cache->chunks, index);
+    if (chunk != NULL && (offset >= chunk->written || g_atomic_int_get(&chunk->refcount) == 1))
+        return chunk;
+
+    result = cache_chunk_new(cache);
+    if (result == NULL)
+        return NULL;
+
+    if (chunk != NULL)
+    {
+        if (cache_chunk_write(cache, result, 0, chunk->data, offset) < offset)
+        {
+            cache_chunk_unref(result);
+            return NULL;
+        }
+        cache_release_chunk(cache, index);
+    }
+    g_ptr_array_index(cache->chunks, index) = result;
+    return result;
+}
+
 void cache_write_buffer(Cache* cache, GstBuffer* buffer)
 {
     GstMapInfo info;
     if (gst_buffer_map(buffer, &info, GST_MAP_READ))
     {
-        ssize_t written = write(cache->writeHandle, info.data, info.size);
-        if (written > 0)
+        const guint8* data = info.data;
+        gsize remaining = info.size;
+
+        while (remaining > 0)
+        {
+            gsize offset = (gsize)(cache->write_position % CHUNK_SIZE);
+            gsize size = MIN(remaining, CHUNK_SIZE - offset);
+            CacheChunk* chunk = cache_get_writable_chunk(cache, cache->write_position);
+            gsize written = chunk ? cache_chunk_write(cache, chunk, offset, data, size) : 0;
+
             cache->write_position += written;
+            data += written;
+            remaining -= written;
+            if (written < size)
+                break;
+        }
         gst_buffer_unmap(buffer, &info);
     }
 }
 
+// Returns a view of size bytes at position, which must be within one chunk.
+static GstMemory* cache_get_memory(Cache* cache, gint64 position, gsize size)
+{
+    guint index = (guint)(position / CHUNK_SIZE);
+    CacheChunk* chunk = index < cache->chunks->len ? (CacheChunk*)g_ptr_array_index(cache->chunks, index) : NULL;
+
+    if (chunk == NULL)
+        return NULL;
+
+    g_atomic_int_inc(&chunk->refcount);
+    return gst_memory_new_wrapped(GST_MEMORY_FLAG_READONLY, chunk->data, CHUNK_SIZE,
+                                  (gsize)(position % CHUNK_SIZE), size, chunk, (GDestroyNotify)cache_chunk_unref);
+}
+
 gint64 cache_read_buffer(Cache* cache, GstBuffer** buffer)
 {
-    guint8 *data = (guint8*)g_try_malloc(DEFAULT_BUFFER_SIZE);
+    gint64 available = cache->write_position - cache->read_position;
+    GstMemory* memory;
     *buffer = NULL;
 
-    if (data)
+    if (available > 0)
     {
-        ssize_t size = 0;
-        if ((cache->write_position - cache->read_position) > 0 &&
-            (cache->write_position - cache->read_position) < DEFAULT_BUFFER_SIZE)
-            size = cache->write_position - cache->read_position;
-        else
-            size = DEFAULT_BUFFER_SIZE;
-
-        ssize_t read_bytes = read(cache->readHandle, data, size);
-        if (read_bytes > 0)
+        gsize size = MIN(available, DEFAULT_BUFFER_SIZE);
+        size = MIN(size, CHUNK_SIZE - (gsize)(cache->read_position % CHUNK_SIZE));
+
+        memory = cache_get_memory(cache, cache->read_position, size);
+        if (memory)
         {
-            *buffer = gst_buffer_new_wrapped_full(0, data, DEFAULT_BUFFER_SIZE, 0, read_bytes, data, g_free);
-            if (*buffer != NULL)
-                GST_BUFFER_OFFSET(*buffer) = cache->read_position;
+            *buffer = gst_buffer_new();
+            gst_buffer_append_memory(*buffer, memory);
+            GST_BUFFER_OFFSET(*buffer) = cache->read_position;
 
-            cache->read_position += read_bytes;
+            cache->read_position += size;
             return cache->read_position;
         }
-        else // read error, deleting buffer to avoid leaking.
-            g_free(data);
     }
 
     return 0;
@@ -134,60 +404,48 @@ gint64 cache_read_buffer(Cache* cache, GstBuffer** buffer)
 
 GstFlowReturn cache_read_buffer_from_position(Cache* cache, gint64 start_position, guint size, GstBuffer** buffer)
 {
-    GstFlowReturn result = GST_FLOW_ERROR;
+    gint64 position = start_position;
+    gsize remaining = size;
     *buffer = NULL;
 
-    if (cache_set_read_position(cache, start_position))
-    {
-        guint8 *data = (guint8*)g_try_malloc(size);
-        if (data)
+    if (start_position < 0 || start_position + size > cache->write_position)
+        return GST_FLOW_ERROR;
+
+    *buffer = gst_buffer_new();
+    while (remaining > 0)
     {
-        ssize_t read_bytes = read(cache->readHandle, data, size);
-            if (read_bytes == size)
-            {
-                *buffer = gst_buffer_new_wrapped_full(0, data, size, 0, read_bytes, data, g_free);
-                if (*buffer != NULL)
-                {
-                    GST_BUFFER_OFFSET(*buffer) = cache->read_position;
-                    result = GST_FLOW_OK;
-                }
-            }
-            else
-            g_free(data); // Wrong size, deleting buffer to avoid leaking.
-
-            cache->read_position += read_bytes;
-    }
+        gsize part = MIN(remaining, CHUNK_SIZE - (gsize)(position % CHUNK_SIZE));
+        GstMemory* memory = cache_get_memory(cache, position, part);
+        if (memory == NULL)
+        {
+            gst_buffer_unref(*buffer);
+            *buffer = NULL;
+            return GST_FLOW_ERROR;
+        }
+        gst_buffer_append_memory(*buffer, memory);
+        position += part;
+        remaining -= part;
     }
-    return result;
-}
 
-static inline gboolean cache_set_handler_position(int handle, guint64 position)
-{
-    return lseek(handle, position, SEEK_SET) >= 0;
+    GST_BUFFER_OFFSET(*buffer) = start_position;
+    cache->read_position = start_position + size;
+    return GST_FLOW_OK;
 }
 
 gboolean cache_set_write_position(Cache* cache, gint64 position)
 {
-    gboolean result = (position == cache->write_position);
-    if (!result)
-    {
-        result = cache_set_handler_position(cache->writeHandle, position);
-        if (result)
-            cache->write_position = position;
-    }
-    return result;
+    if (position < 0)
+        return FALSE;
+    cache->write_position = position;
+    return TRUE;
 }
 
 gboolean cache_set_read_position(Cache* cache, gint64 position)
 {
-    gboolean result = (position == cache->read_position);
-    if (!result)
-    {
-        result = cache_set_handler_position(cache->readHandle, position);
-        if (result)
-            cache->read_position = position;
-    }
-    return result;
+    if (position < 0)
+        return FALSE;
+    cache->read_position = position;
+    return TRUE;
 }
 
 gboolean cache_has_enough_data(Cache* cache)
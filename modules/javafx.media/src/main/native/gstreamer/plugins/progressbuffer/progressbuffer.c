@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -48,7 +48,8 @@ enum
     PROP_THRESHOLD,
     PROP_BANDWIDTH,
     PROP_PREBUFFER_TIME,
-    PROP_WAIT_TOLERANCE
+    PROP_WAIT_TOLERANCE,
+    PROP_MEMORY_CACHE_SIZE
 };
 
 /***********************************************************************************
@@ -85,6 +86,7 @@ struct _ProgressBuffer
     gdouble       bandwidth; // property accessible.
     gdouble       prebuffer_time; // property controlled.
     gdouble       wait_tolerance; // property controlled.
+    guint64       memory_cache_size; // property controlled.
     GTimer        *bandwidth_timer;
 
     gboolean      unexpected;
@@ -238,6 +240,15 @@ static void progress_buffer_class_init (ProgressBufferClass *klass)
                                                           2.0  /* default value */,
                                                           G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
 
+    g_object_class_install_property (gobject_class, PROP_MEMORY_CACHE_SIZE,
+                                     g_param_spec_uint64 ("memory-cache-size",
+                                                          "Memory cache size",
+                                                          "Amount of downloaded data in bytes kept in memory before the cache uses its file.",
+                                                          0  /* minimum value */,
+                                                          G_MAXINT64 /* maximum value */,
+                                                          CACHE_DEFAULT_MEMORY_LIMIT /* default value */,
+                                                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
+
     cache_static_init();
 }
 
@@ -289,6 +300,9 @@ static void progress_buffer_set_property (GObject *object, guint property_id,
         case PROP_WAIT_TOLERANCE:
             element->wait_tolerance = g_value_get_double(value);
             break;
+        case PROP_MEMORY_CACHE_SIZE:
+            element->memory_cache_size = g_value_get_uint64(value);
+            break;
 
         default:
             break;
@@ -322,6 +336,10 @@ static void progress_buffer_get_property (GObject *object, guint property_id,
             g_value_set_double(value, element->wait_tolerance);
             break;
 
+        case PROP_MEMORY_CACHE_SIZE:
+            g_value_set_uint64(value, element->memory_cache_size);
+            break;
+
         default:
             break;
     }
@@ -649,6 +667,7 @@ static GstFlowReturn progress_buffer_enqueue_item(ProgressBuffer *element, GstMi
                         gst_event_unref(event); // INLINE - gst_event_unref()
                         return GST_FLOW_ERROR;
                     }
+                    cache_set_memory_limit(element->cache, (gint64)element->memory_cache_size);
                 }
                 else
                 {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -84,6 +84,11 @@ void destroy_cache(Cache* instance)
     g_free(instance);
 }
 
+void cache_set_memory_limit(Cache* cache, gint64 limit)
+{
+    // All data goes through the temporary file here.
+}
+
 void cache_write_buffer(Cache* cache, GstBuffer* buffer)
 {
     DWORD written = 0;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -72,6 +72,13 @@ public:
     /* Get or set properties. Value parameter and return value depends on prop value. */
     virtual int Property(int prop, int value) = 0;
 
+    /* AttachReaderThread is called on a thread that is about to make a series of
+     * ReadNextBlock/CopyBlock calls, DetachReaderThread on the same thread after
+     * the last of them.
+     */
+    virtual void AttachReaderThread() = 0;
+    virtual void DetachReaderThread() = 0;
+
     /* Virtual destructor */
     virtual ~CStreamCallbacks() {}
 };
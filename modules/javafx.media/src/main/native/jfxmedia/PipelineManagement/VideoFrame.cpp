@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -75,6 +75,11 @@ CVideoFrame::FrameType CVideoFrame::GetType()
     return m_typeFrame;
 }
 
+bool CVideoFrame::IsNativeOnly()
+{
+    return m_typeFrame >= YCbCr_NV12;
+}
+
 bool CVideoFrame::HasAlpha()
 {
     return m_bHasAlpha;
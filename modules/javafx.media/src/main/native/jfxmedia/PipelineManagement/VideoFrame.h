@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -48,7 +48,14 @@ public:
         BGRA_PRE = 2,
         YCbCr_420p = 100,
         YCbCr_422 = 101,
-        YCbCr_422_rev = 102
+        YCbCr_422_rev = 102,
+        // Native only: decoder output that is converted to BGRA_PRE before
+        // it reaches Java, see IsNativeOnly().
+        YCbCr_NV12 = 200,
+        YCbCr_P010 = 201,
+        YCbCr_420p10 = 202,
+        YCbCr_422planar = 203,
+        YCbCr_422planar10 = 204
     };
 
 public:
@@ -66,6 +73,7 @@ public:
 
     FrameType           GetType();
     bool                HasAlpha();
+    bool                IsNativeOnly();
 
     unsigned int        GetPlaneCount();
     void                SetPlaneCount(unsigned int count);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -380,6 +380,675 @@ const uint16_t color_tBU[256] = {
 };
 // --- End tables
 
+// --- Begin row converters
+/*
+ * Row converters used for 4:2:2, NV12 and P010 sources, and for 4:2:0
+ * sources when AVX2 or NEON is available. They use the fixed point scheme
+ * of the SSE2 4:2:0 converters below: samples are scaled to 16 bits
+ * (8 bit samples shifted left by 8, P010 samples are already MSB aligned),
+ * multiplied by the coefficients keeping the high 16 bits of the product,
+ * and summed with 5 fractional bits. Every variant produces the same
+ * pixels as the SSE2 4:2:0 code.
+ */
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CC_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define CC_TARGET_SSE2 __attribute__((target("sse2")))
+#define CC_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CC_TARGET_SSE2
+#define CC_TARGET_AVX2
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CC_NEON
+#include <arm_neon.h>
+#endif
+
+#define CC_C0    0x2543     /* 1.1644 * 8192 */
+#define CC_C1    0x4097     /* 2.0184 * 8192 */
+#define CC_C4    0x0c8b     /* abs(-0.3920 * 8192) */
+#define CC_C5    0x1a06     /* abs(-0.8132 * 8192) */
+#define CC_C8    0x3317     /* 1.5966 * 8192 */
+#define CC_COFF0 (-0x22a0)  /* -276.9856 * 32 */
+#define CC_COFF1 0x10f4     /* 135.6352 * 32 */
+#define CC_COFF2 (-0x1be0)  /* -222.9952 * 32 */
+
+/* Source layouts, one chroma pair per two pixels */
+enum {
+    CC_PLANAR,          /* Y plane, separate U and V planes */
+    CC_SEMIPLANAR,      /* Y plane, interleaved UV plane (NV12) */
+    CC_SEMIPLANAR16,    /* 16 bit MSB aligned Y and interleaved UV (P010) */
+    CC_UYVY,            /* packed U Y0 V Y1 */
+    CC_YUYV,            /* packed Y0 U Y1 V */
+    CC_PLANAR10,        /* 16 bit LSB aligned 10 bit Y, U and V planes */
+    CC_LAYOUT_COUNT
+};
+
+/* Bytes between luma samples and between samples of a chroma plane */
+static const int32_t cc_y_step[CC_LAYOUT_COUNT] = { 1, 1, 2, 2, 2, 2 };
+static const int32_t cc_c_step[CC_LAYOUT_COUNT] = { 1, 2, 4, 4, 4, 2 };
+
+typedef void (*ColorConvertRowFunc)(uint8_t *dst, const uint8_t *y,
+                                    const uint8_t *u, const uint8_t *v,
+                                    int32_t width, int bgra);
+
+static int cc_simd_level = -1;
+
+static int cc_detect_simd_level(void)
+{
+#if defined(CC_X86)
+#ifdef _MSC_VER
+    int info[4];
+    int maxLeaf;
+    __cpuid(info, 0);
+    maxLeaf = info[0];
+    __cpuid(info, 1);
+    if ((info[3] & (1 << 26)) == 0) {
+        return COLOR_CONVERT_SIMD_NONE;
+    }
+    // AVX2 also needs the OS to save the YMM registers (OSXSAVE + XCR0).
+    if (maxLeaf >= 7 && (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0
+            && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        if ((info[1] & (1 << 5)) != 0) {
+            return COLOR_CONVERT_SIMD_AVX2;
+        }
+    }
+    return COLOR_CONVERT_SIMD_SSE2;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return COLOR_CONVERT_SIMD_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return COLOR_CONVERT_SIMD_SSE2;
+    }
+    return COLOR_CONVERT_SIMD_NONE;
+#endif
+#elif defined(CC_NEON)
+    return COLOR_CONVERT_SIMD_NEON;
+#else
+    return COLOR_CONVERT_SIMD_NONE;
+#endif
+}
+
+int ColorConvert_GetSIMDLevel(void)
+{
+    // Benign race: every thread computes the same value.
+    if (cc_simd_level < 0) {
+        cc_simd_level = cc_detect_simd_level();
+    }
+    return cc_simd_level;
+}
+
+int ColorConvert_SetSIMDLevel(int level)
+{
+    int supported = cc_detect_simd_level();
+    int ok;
+    switch (level) {
+        case COLOR_CONVERT_SIMD_SSE2:
+            ok = (supported == COLOR_CONVERT_SIMD_SSE2 || supported == COLOR_CONVERT_SIMD_AVX2);
+            break;
+        case COLOR_CONVERT_SIMD_AVX2:
+        case COLOR_CONVERT_SIMD_NEON:
+            ok = (supported == level);
+            break;
+        default:
+            ok = 0;
+            break;
+    }
+    cc_simd_level = ok ? level : COLOR_CONVERT_SIMD_NONE;
+    return cc_simd_level;
+}
+
+static inline uint8_t cc_clamp(int32_t x)
+{
+    return x < 0 ? 0 : (x > 255 ? 255 : (uint8_t)x);
+}
+
+/* Samples are scaled to 16 bits, shift moves 10 bit samples up */
+static inline int32_t cc_sample(const uint8_t *p, int wide, int shift)
+{
+    return wide ? (uint16_t)(*(const uint16_t*)p << shift) : (p[0] << 8);
+}
+
+static inline void cc_store_pixel(uint8_t *d, int32_t ys,
+                                  int32_t cb, int32_t cg, int32_t cr, int bgra)
+{
+    int32_t yy = (ys * CC_C0) >> 16;
+    uint8_t b = cc_clamp((yy + cb) >> 5);
+    uint8_t g = cc_clamp((yy + cg) >> 5);
+    uint8_t r = cc_clamp((yy + cr) >> 5);
+
+    if (bgra) {
+        d[0] = b; d[1] = g; d[2] = r; d[3] = 0xff;
+    } else {
+        d[0] = 0xff; d[1] = r; d[2] = g; d[3] = b;
+    }
+}
+
+/*
+ * Converts pixels [start, width) of a row. This is the reference for the
+ * SIMD variants and converts their tails.
+ */
+static void cc_row_scalar(uint8_t *dst, const uint8_t *y, const uint8_t *u,
+                          const uint8_t *v, int32_t start, int32_t width,
+                          int layout, int bgra)
+{
+    int32_t ys = cc_y_step[layout];
+    int32_t cs = cc_c_step[layout];
+    int wide = (layout == CC_SEMIPLANAR16 || layout == CC_PLANAR10);
+    int shift = (layout == CC_PLANAR10) ? 6 : 0;
+    int32_t i;
+
+    dst += 4 * start;
+    y += start * ys;
+    u += (start >> 1) * cs;
+    v += (start >> 1) * cs;
+
+    for (i = start; i < width; i += 2) {
+        int32_t us = cc_sample(u, wide, shift);
+        int32_t vs = cc_sample(v, wide, shift);
+        int32_t cb = ((us * CC_C1) >> 16) + CC_COFF0;
+        int32_t cg = CC_COFF1 - ((us * CC_C4) >> 16) - ((vs * CC_C5) >> 16);
+        int32_t cr = ((vs * CC_C8) >> 16) + CC_COFF2;
+
+        cc_store_pixel(dst, cc_sample(y, wide, shift), cb, cg, cr, bgra);
+        dst += 4;
+        y += ys;
+        if (i + 1 < width) {
+            cc_store_pixel(dst, cc_sample(y, wide, shift), cb, cg, cr, bgra);
+            dst += 4;
+            y += ys;
+        }
+        u += cs;
+        v += cs;
+    }
+}
+
+#define CC_SCALAR_ROW(name, layout)                                         \
+static void cc_row_##name##_scalar(uint8_t *dst, const uint8_t *y,          \
+                                   const uint8_t *u, const uint8_t *v,      \
+                                   int32_t width, int bgra)                 \
+{                                                                           \
+    cc_row_scalar(dst, y, u, v, 0, width, layout, bgra);                    \
+}
+
+CC_SCALAR_ROW(planar, CC_PLANAR)
+CC_SCALAR_ROW(semiplanar, CC_SEMIPLANAR)
+CC_SCALAR_ROW(semiplanar16, CC_SEMIPLANAR16)
+CC_SCALAR_ROW(uyvy, CC_UYVY)
+CC_SCALAR_ROW(yuyv, CC_YUYV)
+CC_SCALAR_ROW(planar10, CC_PLANAR10)
+
+static const ColorConvertRowFunc cc_rows_scalar[CC_LAYOUT_COUNT] = {
+    cc_row_planar_scalar, cc_row_semiplanar_scalar, cc_row_semiplanar16_scalar,
+    cc_row_uyvy_scalar, cc_row_yuyv_scalar, cc_row_planar10_scalar
+};
+
+/*
+ * The SIMD rows load a block of pixels as scaled 16 bit luma and chroma,
+ * convert it with a common routine and hand the remainder of the row to
+ * cc_row_scalar.
+ */
+#define CC_SIMD_ROW(name, isa, target, block, layout, load)                 \
+target static void cc_row_##name##_##isa(uint8_t *dst, const uint8_t *y,    \
+                                         const uint8_t *u, const uint8_t *v,\
+                                         int32_t width, int bgra)           \
+{                                                                           \
+    int32_t i = 0;                                                          \
+    for (; i + block <= width; i += block) {                                \
+        load(y + i * cc_y_step[layout], u + (i >> 1) * cc_c_step[layout],   \
+             v + (i >> 1) * cc_c_step[layout], dst + 4 * i, bgra);          \
+    }                                                                       \
+    cc_row_scalar(dst, y, u, v, i, width, layout, bgra);                    \
+}
+
+#if defined(CC_X86)
+// --- SSE2, 16 pixels per block
+
+CC_TARGET_SSE2 static inline void
+cc_convert16_sse2(uint8_t *d, __m128i ylo, __m128i yhi, __m128i cu, __m128i cv, int bgra)
+{
+    const __m128i x_alpha = _mm_set1_epi8((char)0xff);
+    __m128i x_b, x_g, x_r, x_lo, x_hi, x_t0, x_t1;
+
+    __m128i x_cb = _mm_add_epi16(_mm_mulhi_epu16(cu, _mm_set1_epi16(CC_C1)),
+                                 _mm_set1_epi16(CC_COFF0));
+    __m128i x_cg = _mm_sub_epi16(_mm_set1_epi16(CC_COFF1),
+                                 _mm_add_epi16(_mm_mulhi_epu16(cu, _mm_set1_epi16(CC_C4)),
+                                               _mm_mulhi_epu16(cv, _mm_set1_epi16(CC_C5))));
+    __m128i x_cr = _mm_add_epi16(_mm_mulhi_epu16(cv, _mm_set1_epi16(CC_C8)),
+                                 _mm_set1_epi16(CC_COFF2));
+
+    ylo = _mm_mulhi_epu16(ylo, _mm_set1_epi16(CC_C0));
+    yhi = _mm_mulhi_epu16(yhi, _mm_set1_epi16(CC_C0));
+
+    x_lo = _mm_srai_epi16(_mm_add_epi16(ylo, _mm_unpacklo_epi16(x_cb, x_cb)), 5);
+    x_hi = _mm_srai_epi16(_mm_add_epi16(yhi, _mm_unpackhi_epi16(x_cb, x_cb)), 5);
+    x_b = _mm_packus_epi16(x_lo, x_hi);
+    x_lo = _mm_srai_epi16(_mm_add_epi16(ylo, _mm_unpacklo_epi16(x_cg, x_cg)), 5);
+    x_hi = _mm_srai_epi16(_mm_add_epi16(yhi, _mm_unpackhi_epi16(x_cg, x_cg)), 5);
+    x_g = _mm_packus_epi16(x_lo, x_hi);
+    x_lo = _mm_srai_epi16(_mm_add_epi16(ylo, _mm_unpacklo_epi16(x_cr, x_cr)), 5);
+    x_hi = _mm_srai_epi16(_mm_add_epi16(yhi, _mm_unpackhi_epi16(x_cr, x_cr)), 5);
+    x_r = _mm_packus_epi16(x_lo, x_hi);
+
+    if (bgra) {
+        x_t0 = _mm_unpacklo_epi8(x_b, x_g);
+        x_t1 = _mm_unpacklo_epi8(x_r, x_alpha);
+        x_lo = _mm_unpackhi_epi8(x_b, x_g);
+        x_hi = _mm_unpackhi_epi8(x_r, x_alpha);
+    } else {
+        x_t0 = _mm_unpacklo_epi8(x_alpha, x_r);
+        x_t1 = _mm_unpacklo_epi8(x_g, x_b);
+        x_lo = _mm_unpackhi_epi8(x_alpha, x_r);
+        x_hi = _mm_unpackhi_epi8(x_g, x_b);
+    }
+    _mm_storeu_si128((__m128i*)d, _mm_unpacklo_epi16(x_t0, x_t1));
+    _mm_storeu_si128((__m128i*)(d + 16), _mm_unpackhi_epi16(x_t0, x_t1));
+    _mm_storeu_si128((__m128i*)(d + 32), _mm_unpacklo_epi16(x_lo, x_hi));
+    _mm_storeu_si128((__m128i*)(d + 48), _mm_unpackhi_epi16(x_lo, x_hi));
+}
+
+/* Splits 16 bit U0 V0 U1 V1 ... lanes of two registers into U and V */
+CC_TARGET_SSE2 static inline void
+cc_split_uv16_sse2(__m128i c0, __m128i c1, __m128i *cu, __m128i *cv)
+{
+    c0 = _mm_shufflelo_epi16(c0, _MM_SHUFFLE(3, 1, 2, 0));
+    c0 = _mm_shufflehi_epi16(c0, _MM_SHUFFLE(3, 1, 2, 0));
+    c0 = _mm_shuffle_epi32(c0, _MM_SHUFFLE(3, 1, 2, 0));
+    c1 = _mm_shufflelo_epi16(c1, _MM_SHUFFLE(3, 1, 2, 0));
+    c1 = _mm_shufflehi_epi16(c1, _MM_SHUFFLE(3, 1, 2, 0));
+    c1 = _mm_shuffle_epi32(c1, _MM_SHUFFLE(3, 1, 2, 0));
+    *cu = _mm_unpacklo_epi64(c0, c1);
+    *cv = _mm_unpackhi_epi64(c0, c1);
+}
+
+CC_TARGET_SSE2 static inline void
+cc_block_planar_sse2(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    const __m128i x_zero = _mm_setzero_si128();
+    __m128i x_y = _mm_loadu_si128((const __m128i*)y);
+    cc_convert16_sse2(d, _mm_unpacklo_epi8(x_zero, x_y), _mm_unpackhi_epi8(x_zero, x_y),
+                      _mm_unpacklo_epi8(x_zero, _mm_loadl_epi64((const __m128i*)u)),
+                      _mm_unpacklo_epi8(x_zero, _mm_loadl_epi64((const __m128i*)v)), bgra);
+}
+
+CC_TARGET_SSE2 static inline void
+cc_block_semiplanar_sse2(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    const __m128i x_zero = _mm_setzero_si128();
+    __m128i x_y = _mm_loadu_si128((const __m128i*)y);
+    __m128i x_uv = _mm_loadu_si128((const __m128i*)u);
+    cc_convert16_sse2(d, _mm_unpacklo_epi8(x_zero, x_y), _mm_unpackhi_epi8(x_zero, x_y),
+                      _mm_slli_epi16(x_uv, 8),
+                      _mm_and_si128(x_uv, _mm_set1_epi16((short)0xff00)), bgra);
+}
+
+CC_TARGET_SSE2 static inline void
+cc_block_semiplanar16_sse2(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    __m128i x_u, x_v;
+    cc_split_uv16_sse2(_mm_loadu_si128((const __m128i*)u),
+                       _mm_loadu_si128((const __m128i*)(u + 16)), &x_u, &x_v);
+    cc_convert16_sse2(d, _mm_loadu_si128((const __m128i*)y),
+                      _mm_loadu_si128((const __m128i*)(y + 16)), x_u, x_v, bgra);
+}
+
+CC_TARGET_SSE2 static inline void
+cc_block_uyvy_sse2(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    const __m128i x_mask = _mm_set1_epi16((short)0xff00);
+    __m128i x_p0 = _mm_loadu_si128((const __m128i*)u);
+    __m128i x_p1 = _mm_loadu_si128((const __m128i*)(u + 16));
+    __m128i x_u, x_v;
+    cc_split_uv16_sse2(_mm_slli_epi16(x_p0, 8), _mm_slli_epi16(x_p1, 8), &x_u, &x_v);
+    cc_convert16_sse2(d, _mm_and_si128(x_p0, x_mask), _mm_and_si128(x_p1, x_mask),
+                      x_u, x_v, bgra);
+}
+
+CC_TARGET_SSE2 static inline void
+cc_block_yuyv_sse2(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    const __m128i x_mask = _mm_set1_epi16((short)0xff00);
+    __m128i x_p0 = _mm_loadu_si128((const __m128i*)y);
+    __m128i x_p1 = _mm_loadu_si128((const __m128i*)(y + 16));
+    __m128i x_u, x_v;
+    cc_split_uv16_sse2(_mm_and_si128(x_p0, x_mask), _mm_and_si128(x_p1, x_mask), &x_u, &x_v);
+    cc_convert16_sse2(d, _mm_slli_epi16(x_p0, 8), _mm_slli_epi16(x_p1, 8),
+                      x_u, x_v, bgra);
+}
+
+CC_TARGET_SSE2 static inline void
+cc_block_planar10_sse2(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    cc_convert16_sse2(d, _mm_slli_epi16(_mm_loadu_si128((const __m128i*)y), 6),
+                      _mm_slli_epi16(_mm_loadu_si128((const __m128i*)(y + 16)), 6),
+                      _mm_slli_epi16(_mm_loadu_si128((const __m128i*)u), 6),
+                      _mm_slli_epi16(_mm_loadu_si128((const __m128i*)v), 6), bgra);
+}
+
+CC_SIMD_ROW(planar, sse2, CC_TARGET_SSE2, 16, CC_PLANAR, cc_block_planar_sse2)
+CC_SIMD_ROW(semiplanar, sse2, CC_TARGET_SSE2, 16, CC_SEMIPLANAR, cc_block_semiplanar_sse2)
+CC_SIMD_ROW(semiplanar16, sse2, CC_TARGET_SSE2, 16, CC_SEMIPLANAR16, cc_block_semiplanar16_sse2)
+CC_SIMD_ROW(uyvy, sse2, CC_TARGET_SSE2, 16, CC_UYVY, cc_block_uyvy_sse2)
+CC_SIMD_ROW(yuyv, sse2, CC_TARGET_SSE2, 16, CC_YUYV, cc_block_yuyv_sse2)
+CC_SIMD_ROW(planar10, sse2, CC_TARGET_SSE2, 16, CC_PLANAR10, cc_block_planar10_sse2)
+
+static const ColorConvertRowFunc cc_rows_sse2[CC_LAYOUT_COUNT] = {
+    cc_row_planar_sse2, cc_row_semiplanar_sse2, cc_row_semiplanar16_sse2,
+    cc_row_uyvy_sse2, cc_row_yuyv_sse2, cc_row_planar10_sse2
+};
+
+// --- AVX2, 32 pixels per block
+
+/*
+ * ylo and yhi hold pixels 0-15 and 16-31, cu and cv the 16 chroma pairs,
+ * all in memory order. The 128 bit lanes are reordered on the way so the
+ * stores come out in memory order too.
+ */
+CC_TARGET_AVX2 static inline void
+cc_convert32_avx2(uint8_t *d, __m256i ylo, __m256i yhi, __m256i cu, __m256i cv, int bgra)
+{
+    const __m256i y_alpha = _mm256_set1_epi8((char)0xff);
+    __m256i y_b, y_g, y_r, y_c, y_t0, y_t1, y_t2, y_t3, y_p0, y_p1, y_p2, y_p3;
+
+    __m256i y_cb = _mm256_add_epi16(_mm256_mulhi_epu16(cu, _mm256_set1_epi16(CC_C1)),
+                                    _mm256_set1_epi16(CC_COFF0));
+    __m256i y_cg = _mm256_sub_epi16(_mm256_set1_epi16(CC_COFF1),
+                                    _mm256_add_epi16(_mm256_mulhi_epu16(cu, _mm256_set1_epi16(CC_C4)),
+                                                     _mm256_mulhi_epu16(cv, _mm256_set1_epi16(CC_C5))));
+    __m256i y_cr = _mm256_add_epi16(_mm256_mulhi_epu16(cv, _mm256_set1_epi16(CC_C8)),
+                                    _mm256_set1_epi16(CC_COFF2));
+
+    ylo = _mm256_mulhi_epu16(ylo, _mm256_set1_epi16(CC_C0));
+    yhi = _mm256_mulhi_epu16(yhi, _mm256_set1_epi16(CC_C0));
+
+    // Duplicating chroma within 128 bit lanes needs pairs 0-3,8-11 | 4-7,12-15
+    // packus then yields pixels 0-7,16-23 | 8-15,24-31
+#define CC_CHANNEL_AVX2(c, out)                                             \
+    y_c = _mm256_permute4x64_epi64(c, 0xd8);                                \
+    out = _mm256_packus_epi16(                                              \
+            _mm256_srai_epi16(_mm256_add_epi16(ylo, _mm256_unpacklo_epi16(y_c, y_c)), 5), \
+            _mm256_srai_epi16(_mm256_add_epi16(yhi, _mm256_unpackhi_epi16(y_c, y_c)), 5));
+    CC_CHANNEL_AVX2(y_cb, y_b)
+    CC_CHANNEL_AVX2(y_cg, y_g)
+    CC_CHANNEL_AVX2(y_cr, y_r)
+#undef CC_CHANNEL_AVX2
+
+    if (bgra) {
+        y_t0 = _mm256_unpacklo_epi8(y_b, y_g);        // 0-7 | 8-15
+        y_t1 = _mm256_unpacklo_epi8(y_r, y_alpha);
+        y_t2 = _mm256_unpackhi_epi8(y_b, y_g);        // 16-23 | 24-31
+        y_t3 = _mm256_unpackhi_epi8(y_r, y_alpha);
+    } else {
+        y_t0 = _mm256_unpacklo_epi8(y_alpha, y_r);
+        y_t1 = _mm256_unpacklo_epi8(y_g, y_b);
+        y_t2 = _mm256_unpackhi_epi8(y_alpha, y_r);
+        y_t3 = _mm256_unpackhi_epi8(y_g, y_b);
+    }
+    y_p0 = _mm256_unpacklo_epi16(y_t0, y_t1);         // 0-3 | 8-11
+    y_p1 = _mm256_unpackhi_epi16(y_t0, y_t1);         // 4-7 | 12-15
+    y_p2 = _mm256_unpacklo_epi16(y_t2, y_t3);         // 16-19 | 24-27
+    y_p3 = _mm256_unpackhi_epi16(y_t2, y_t3);         // 20-23 | 28-31
+    _mm256_storeu_si256((__m256i*)d, _mm256_permute2x128_si256(y_p0, y_p1, 0x20));
+    _mm256_storeu_si256((__m256i*)(d + 32), _mm256_permute2x128_si256(y_p0, y_p1, 0x31));
+    _mm256_storeu_si256((__m256i*)(d + 64), _mm256_permute2x128_si256(y_p2, y_p3, 0x20));
+    _mm256_storeu_si256((__m256i*)(d + 96), _mm256_permute2x128_si256(y_p2, y_p3, 0x31));
+}
+
+/* Splits 16 bit U0 V0 U1 V1 ... lanes of two registers into U and V */
+CC_TARGET_AVX2 static inline void
+cc_split_uv16_avx2(__m256i c0, __m256i c1, __m256i *cu, __m256i *cv)
+{
+    const __m256i y_mask = _mm256_set1_epi32(0xffff);
+    *cu = _mm256_permute4x64_epi64(
+            _mm256_packus_epi32(_mm256_and_si256(c0, y_mask), _mm256_and_si256(c1, y_mask)), 0xd8);
+    *cv = _mm256_permute4x64_epi64(
+            _mm256_packus_epi32(_mm256_srli_epi32(c0, 16), _mm256_srli_epi32(c1, 16)), 0xd8);
+}
+
+CC_TARGET_AVX2 static inline __m256i cc_load_scaled_avx2(const uint8_t *p)
+{
+    return _mm256_slli_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)p)), 8);
+}
+
+CC_TARGET_AVX2 static inline void
+cc_block_planar_avx2(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    cc_convert32_avx2(d, cc_load_scaled_avx2(y), cc_load_scaled_avx2(y + 16),
+                      cc_load_scaled_avx2(u), cc_load_scaled_avx2(v), bgra);
+}
+
+CC_TARGET_AVX2 static inline void
+cc_block_semiplanar_avx2(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    __m256i y_uv = _mm256_loadu_si256((const __m256i*)u);
+    cc_convert32_avx2(d, cc_load_scaled_avx2(y), cc_load_scaled_avx2(y + 16),
+                      _mm256_slli_epi16(y_uv, 8),
+                      _mm256_and_si256(y_uv, _mm256_set1_epi16((short)0xff00)), bgra);
+}
+
+CC_TARGET_AVX2 static inline void
+cc_block_semiplanar16_avx2(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    __m256i y_u, y_v;
+    cc_split_uv16_avx2(_mm256_loadu_si256((const __m256i*)u),
+                       _mm256_loadu_si256((const __m256i*)(u + 32)), &y_u, &y_v);
+    cc_convert32_avx2(d, _mm256_loadu_si256((const __m256i*)y),
+                      _mm256_loadu_si256((const __m256i*)(y + 32)), y_u, y_v, bgra);
+}
+
+CC_TARGET_AVX2 static inline void
+cc_block_uyvy_avx2(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    const __m256i y_mask = _mm256_set1_epi16((short)0xff00);
+    __m256i y_p0 = _mm256_loadu_si256((const __m256i*)u);
+    __m256i y_p1 = _mm256_loadu_si256((const __m256i*)(u + 32));
+    __m256i y_u, y_v;
+    cc_split_uv16_avx2(_mm256_slli_epi16(y_p0, 8), _mm256_slli_epi16(y_p1, 8), &y_u, &y_v);
+    cc_convert32_avx2(d, _mm256_and_si256(y_p0, y_mask), _mm256_and_si256(y_p1, y_mask),
+                      y_u, y_v, bgra);
+}
+
+CC_TARGET_AVX2 static inline void
+cc_block_yuyv_avx2(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    const __m256i y_mask = _mm256_set1_epi16((short)0xff00);
+    __m256i y_p0 = _mm256_loadu_si256((const __m256i*)y);
+    __m256i y_p1 = _mm256_loadu_si256((const __m256i*)(y + 32));
+    __m256i y_u, y_v;
+    cc_split_uv16_avx2(_mm256_and_si256(y_p0, y_mask), _mm256_and_si256(y_p1, y_mask), &y_u, &y_v);
+    cc_convert32_avx2(d, _mm256_slli_epi16(y_p0, 8), _mm256_slli_epi16(y_p1, 8),
+                      y_u, y_v, bgra);
+}
+
+CC_TARGET_AVX2 static inline __m256i cc_load_planar10_avx2(const uint8_t *p)
+{
+    return _mm256_slli_epi16(_mm256_loadu_si256((const __m256i*)p), 6);
+}
+
+CC_TARGET_AVX2 static inline void
+cc_block_planar10_avx2(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    cc_convert32_avx2(d, cc_load_planar10_avx2(y), cc_load_planar10_avx2(y + 32),
+                      cc_load_planar10_avx2(u), cc_load_planar10_avx2(v), bgra);
+}
+
+CC_SIMD_ROW(planar, avx2, CC_TARGET_AVX2, 32, CC_PLANAR, cc_block_planar_avx2)
+CC_SIMD_ROW(semiplanar, avx2, CC_TARGET_AVX2, 32, CC_SEMIPLANAR, cc_block_semiplanar_avx2)
+CC_SIMD_ROW(semiplanar16, avx2, CC_TARGET_AVX2, 32, CC_SEMIPLANAR16, cc_block_semiplanar16_avx2)
+CC_SIMD_ROW(uyvy, avx2, CC_TARGET_AVX2, 32, CC_UYVY, cc_block_uyvy_avx2)
+CC_SIMD_ROW(yuyv, avx2, CC_TARGET_AVX2, 32, CC_YUYV, cc_block_yuyv_avx2)
+CC_SIMD_ROW(planar10, avx2, CC_TARGET_AVX2, 32, CC_PLANAR10, cc_block_planar10_avx2)
+
+static const ColorConvertRowFunc cc_rows_avx2[CC_LAYOUT_COUNT] = {
+    cc_row_planar_avx2, cc_row_semiplanar_avx2, cc_row_semiplanar16_avx2,
+    cc_row_uyvy_avx2, cc_row_yuyv_avx2, cc_row_planar10_avx2
+};
+
+#elif defined(CC_NEON)
+// --- NEON, 16 pixels per block
+
+static inline uint16x8_t cc_mulhi_neon(uint16x8_t a, uint16_t c)
+{
+    return vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(a), c), 16),
+                        vshrn_n_u32(vmull_n_u16(vget_high_u16(a), c), 16));
+}
+
+static inline uint8x16_t cc_channel_neon(int16x8_t ylo, int16x8_t yhi, int16x8_t c)
+{
+    int16x8x2_t c2 = vzipq_s16(c, c);
+    return vcombine_u8(vqmovun_s16(vshrq_n_s16(vaddq_s16(ylo, c2.val[0]), 5)),
+                       vqmovun_s16(vshrq_n_s16(vaddq_s16(yhi, c2.val[1]), 5)));
+}
+
+static inline void
+cc_convert16_neon(uint8_t *d, uint16x8_t ylo, uint16x8_t yhi, uint16x8_t cu, uint16x8_t cv, int bgra)
+{
+    int16x8_t cb = vaddq_s16(vreinterpretq_s16_u16(cc_mulhi_neon(cu, CC_C1)), vdupq_n_s16(CC_COFF0));
+    int16x8_t cg = vsubq_s16(vdupq_n_s16(CC_COFF1),
+                             vreinterpretq_s16_u16(vaddq_u16(cc_mulhi_neon(cu, CC_C4),
+                                                             cc_mulhi_neon(cv, CC_C5))));
+    int16x8_t cr = vaddq_s16(vreinterpretq_s16_u16(cc_mulhi_neon(cv, CC_C8)), vdupq_n_s16(CC_COFF2));
+    int16x8_t yl = vreinterpretq_s16_u16(cc_mulhi_neon(ylo, CC_C0));
+    int16x8_t yh = vreinterpretq_s16_u16(cc_mulhi_neon(yhi, CC_C0));
+    uint8x16x4_t px;
+
+    if (bgra) {
+        px.val[0] = cc_channel_neon(yl, yh, cb);
+        px.val[1] = cc_channel_neon(yl, yh, cg);
+        px.val[2] = cc_channel_neon(yl, yh, cr);
+        px.val[3] = vdupq_n_u8(0xff);
+    } else {
+        px.val[0] = vdupq_n_u8(0xff);
+        px.val[1] = cc_channel_neon(yl, yh, cr);
+        px.val[2] = cc_channel_neon(yl, yh, cg);
+        px.val[3] = cc_channel_neon(yl, yh, cb);
+    }
+    vst4q_u8(d, px);
+}
+
+static inline void
+cc_block_planar_neon(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    uint8x16_t py = vld1q_u8(y);
+    cc_convert16_neon(d, vshll_n_u8(vget_low_u8(py), 8), vshll_n_u8(vget_high_u8(py), 8),
+                      vshll_n_u8(vld1_u8(u), 8), vshll_n_u8(vld1_u8(v), 8), bgra);
+}
+
+static inline void
+cc_block_semiplanar_neon(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    uint8x16_t py = vld1q_u8(y);
+    uint8x8x2_t uv = vld2_u8(u);
+    cc_convert16_neon(d, vshll_n_u8(vget_low_u8(py), 8), vshll_n_u8(vget_high_u8(py), 8),
+                      vshll_n_u8(uv.val[0], 8), vshll_n_u8(uv.val[1], 8), bgra);
+}
+
+static inline void
+cc_block_semiplanar16_neon(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    uint16x8x2_t uv = vld2q_u16((const uint16_t*)u);
+    cc_convert16_neon(d, vld1q_u16((const uint16_t*)y), vld1q_u16((const uint16_t*)(y + 16)),
+                      uv.val[0], uv.val[1], bgra);
+}
+
+static inline void
+cc_block_uyvy_neon(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    uint8x8x4_t p = vld4_u8(u);    // U, Y0, V, Y1
+    uint8x8x2_t py = vzip_u8(p.val[1], p.val[3]);
+    cc_convert16_neon(d, vshll_n_u8(py.val[0], 8), vshll_n_u8(py.val[1], 8),
+                      vshll_n_u8(p.val[0], 8), vshll_n_u8(p.val[2], 8), bgra);
+}
+
+static inline void
+cc_block_yuyv_neon(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    uint8x8x4_t p = vld4_u8(y);    // Y0, U, Y1, V
+    uint8x8x2_t py = vzip_u8(p.val[0], p.val[2]);
+    cc_convert16_neon(d, vshll_n_u8(py.val[0], 8), vshll_n_u8(py.val[1], 8),
+                      vshll_n_u8(p.val[1], 8), vshll_n_u8(p.val[3], 8), bgra);
+}
+
+static inline void
+cc_block_planar10_neon(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *d, int bgra)
+{
+    cc_convert16_neon(d, vshlq_n_u16(vld1q_u16((const uint16_t*)y), 6),
+                      vshlq_n_u16(vld1q_u16((const uint16_t*)(y + 16)), 6),
+                      vshlq_n_u16(vld1q_u16((const uint16_t*)u), 6),
+                      vshlq_n_u16(vld1q_u16((const uint16_t*)v), 6), bgra);
+}
+
+CC_SIMD_ROW(planar, neon, , 16, CC_PLANAR, cc_block_planar_neon)
+CC_SIMD_ROW(semiplanar, neon, , 16, CC_SEMIPLANAR, cc_block_semiplanar_neon)
+CC_SIMD_ROW(semiplanar16, neon, , 16, CC_SEMIPLANAR16, cc_block_semiplanar16_neon)
+CC_SIMD_ROW(uyvy, neon, , 16, CC_UYVY, cc_block_uyvy_neon)
+CC_SIMD_ROW(yuyv, neon, , 16, CC_YUYV, cc_block_yuyv_neon)
+CC_SIMD_ROW(planar10, neon, , 16, CC_PLANAR10, cc_block_planar10_neon)
+
+static const ColorConvertRowFunc cc_rows_neon[CC_LAYOUT_COUNT] = {
+    cc_row_planar_neon, cc_row_semiplanar_neon, cc_row_semiplanar16_neon,
+    cc_row_uyvy_neon, cc_row_yuyv_neon, cc_row_planar10_neon
+};
+#endif
+
+static ColorConvertRowFunc cc_row_func(int layout)
+{
+    switch (ColorConvert_GetSIMDLevel()) {
+#if defined(CC_X86)
+        case COLOR_CONVERT_SIMD_AVX2:
+            return cc_rows_avx2[layout];
+        case COLOR_CONVERT_SIMD_SSE2:
+            return cc_rows_sse2[layout];
+#elif defined(CC_NEON)
+        case COLOR_CONVERT_SIMD_NEON:
+            return cc_rows_neon[layout];
+#endif
+        default:
+            return cc_rows_scalar[layout];
+    }
+}
+
+/*
+ * Converts a frame row by row. Chroma rows are shared by 1 << chroma_shift
+ * luma rows. For the packed layouts y, u and v point into the same plane.
+ */
+static int cc_convert_frame(int layout, int bgra, uint8_t *dst, int32_t dst_stride,
+                            int32_t width, int32_t height,
+                            const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                            int32_t y_stride, int32_t u_stride, int32_t v_stride,
+                            int chroma_shift)
+{
+    ColorConvertRowFunc row;
+    int32_t j;
+
+    if (dst == NULL || y == NULL || u == NULL || v == NULL)
+        return 1;
+
+    if (width <= 0 || height <= 0)
+        return 1;
+
+    row = cc_row_func(layout);
+    for (j = 0; j < height; j++) {
+        int32_t cj = j >> chroma_shift;
+        row(dst + (intptr_t)j * dst_stride,
+            y + (intptr_t)j * y_stride,
+            u + (intptr_t)cj * u_stride,
+            v + (intptr_t)cj * v_stride,
+            width, bgra);
+    }
+
+    return 0;
+}
+// --- End row converters
+
 // --- Begin YCbCr420p conversion functions
 #if ENABLE_SIMD_SSE2
 // --- Begin SSE2 YCbCr420p conversion functions
@@ -989,6 +1658,11 @@ int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
     __m64 *pm_u, *pm_v;
     uint8_t *pY1, *pY2, *pU, *pV, *pD1, *pD2, *pd1, *pd2;
 
+    if (ColorConvert_GetSIMDLevel() == COLOR_CONVERT_SIMD_AVX2) {
+        return cc_convert_frame(CC_PLANAR, 0, argb, argb_stride, width, height,
+                                y, u, v, y_stride, u_stride, v_stride, 1);
+    }
+
     __m128i (*load_si128) (const __m128i*);
     if (((intptr_t)y % 16) != 0 || ((intptr_t)u % 16) != 0 || ((intptr_t)v % 16) != 0 || (y_stride % 16) != 0 || (u_stride % 16) != 0 || (v_stride % 16) != 0)
         load_si128 = &inline_loadu_si128;
@@ -1956,6 +2630,11 @@ int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
     __m64 *pm_u, *pm_v;
     uint8_t *pY1, *pY2, *pU, *pV, *pD1, *pD2, *pd1, *pd2;
 
+    if (ColorConvert_GetSIMDLevel() == COLOR_CONVERT_SIMD_AVX2) {
+        return cc_convert_frame(CC_PLANAR, 1, bgra, bgra_stride, width, height,
+                                y, u, v, y_stride, u_stride, v_stride, 1);
+    }
+
     __m128i (*load_si128) (const __m128i*);
     if (((intptr_t)y % 16) != 0 || ((intptr_t)u % 16) != 0 || ((intptr_t)v % 16) != 0 || (y_stride % 16) != 0 || (u_stride % 16) != 0 || (v_stride % 16) != 0)
         load_si128 = &inline_loadu_si128;
@@ -2384,7 +3063,8 @@ int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
                                      int32_t v_stride,
                                      int32_t u_stride)
 {
-    return 1; // NOTE: Not implemented
+    return cc_convert_frame(CC_PLANAR, 0, argb, argb_stride, width, height,
+                            y, u, v, y_stride, u_stride, v_stride, 1);
 }
 
 int ColorConvert_YCbCr420p_to_BGRA32(uint8_t *bgra,
@@ -2518,6 +3198,11 @@ int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
 
     uint8_t *const pClip = (uint8_t *const)color_tClip + 288 * 2;
 
+    if (ColorConvert_GetSIMDLevel() == COLOR_CONVERT_SIMD_NEON) {
+        return cc_convert_frame(CC_PLANAR, 1, bgra, bgra_stride, width, height,
+                                y, u, v, y_stride, u_stride, v_stride, 1);
+    }
+
     if (bgra == NULL || y == NULL || u == NULL || v == NULL)
         return 1;
 
@@ -2597,6 +3282,22 @@ int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
 
 // --- Begin YCbCr422p conversion functions
 
+/*
+ * The 4:2:2 converters take packed UYVY or YUYV data: y, v and u point to
+ * the first sample of each kind in the plane and the same stride is used
+ * for all of them.
+ */
+static int cc_packed422_layout(const uint8_t *y, const uint8_t *v, const uint8_t *u)
+{
+    if (u + 1 == y && u + 2 == v) {
+        return CC_UYVY;
+    }
+    if (y + 1 == u && y + 3 == v) {
+        return CC_YUYV;
+    }
+    return -1;
+}
+
 int ColorConvert_YCbCr422p_to_ARGB32_no_alpha(uint8_t *argb,
                                               int32_t argb_stride,
                                               int32_t width,
@@ -2607,7 +3308,13 @@ int ColorConvert_YCbCr422p_to_ARGB32_no_alpha(uint8_t *argb,
                                               int32_t y_stride,
                                               int32_t uv_stride)
 {
-    return 1; // NOTE: Not implemented
+    int layout = cc_packed422_layout(y, v, u);
+
+    if (layout < 0 || y_stride != uv_stride)
+        return 1;
+
+    return cc_convert_frame(layout, 0, argb, argb_stride, width, height,
+                            y, u, v, y_stride, uv_stride, uv_stride, 0);
 }
 
 int ColorConvert_YCbCr422p_to_BGRA32_no_alpha(uint8_t *bgra,
@@ -2620,67 +3327,181 @@ int ColorConvert_YCbCr422p_to_BGRA32_no_alpha(uint8_t *bgra,
                                               int32_t y_stride,
                                               int32_t uv_stride)
 {
-    int32_t i, j;
-    const uint8_t *say1, *sau, *sav, *sly1, *slu, *slv;
-    uint8_t *da1, *dl1;
-
-    int32_t BBi = 554;
-    int32_t RRi = 446;
-
-    uint8_t *const pClip = (uint8_t *const)color_tClip + 288 * 2;
+    int layout = cc_packed422_layout(y, v, u);
 
-    if (bgra == NULL || y == NULL || u == NULL || v == NULL)
+    if (layout < 0 || y_stride != uv_stride)
         return 1;
 
-    if (width <= 0 || height <= 0)
-        return 1;
+    return cc_convert_frame(layout, 1, bgra, bgra_stride, width, height,
+                            y, u, v, y_stride, uv_stride, uv_stride, 0);
+}
+// --- End YCbCr422p conversion functions
 
-    if (width & 1)
+// --- Begin NV12 and P010 conversion functions
+
+int ColorConvert_NV12_to_ARGB32_no_alpha(uint8_t *argb,
+                                         int32_t argb_stride,
+                                         int32_t width,
+                                         int32_t height,
+                                         const uint8_t *y,
+                                         const uint8_t *uv,
+                                         int32_t y_stride,
+                                         int32_t uv_stride)
+{
+    if (uv == NULL)
         return 1;
 
-    sly1 = say1 = y;
-    slu = sau = u;
-    slv = sav = v;
-    dl1 = da1 = bgra;
+    return cc_convert_frame(CC_SEMIPLANAR, 0, argb, argb_stride, width, height,
+                            y, uv, uv + 1, y_stride, uv_stride, uv_stride, 1);
+}
 
-    for (j = 0; j < height; j++) {
-        for (i = 0; i < (width >> 1); i++) {
-            int32_t sf01, sf03, sf1, sf2, sfr, sfg, sfb;
+int ColorConvert_NV12_to_BGRA32_no_alpha(uint8_t *bgra,
+                                         int32_t bgra_stride,
+                                         int32_t width,
+                                         int32_t height,
+                                         const uint8_t *y,
+                                         const uint8_t *uv,
+                                         int32_t y_stride,
+                                         int32_t uv_stride)
+{
+    if (uv == NULL)
+        return 1;
 
-            sf1 = sau[0];
-            sf2 = sav[0];
+    return cc_convert_frame(CC_SEMIPLANAR, 1, bgra, bgra_stride, width, height,
+                            y, uv, uv + 1, y_stride, uv_stride, uv_stride, 1);
+}
 
-            sf01 = say1[0];
-            sf03 = say1[2];
+int ColorConvert_P010_to_ARGB32_no_alpha(uint8_t *argb,
+                                         int32_t argb_stride,
+                                         int32_t width,
+                                         int32_t height,
+                                         const uint16_t *y,
+                                         const uint16_t *uv,
+                                         int32_t y_stride,
+                                         int32_t uv_stride)
+{
+    if (uv == NULL)
+        return 1;
 
-            sfr = color_tRV[sf2] - RRi;
-            sfg = color_tGU[sf1] - color_tGV[sf2];
-            sfb = color_tBU[sf1] - BBi;
+    return cc_convert_frame(CC_SEMIPLANAR16, 0, argb, argb_stride, width, height,
+                            (const uint8_t*)y, (const uint8_t*)uv, (const uint8_t*)(uv + 1),
+                            y_stride, uv_stride, uv_stride, 1);
+}
 
-            sf01 = color_tYY[sf01];
-            sf03 = color_tYY[sf03];
+int ColorConvert_P010_to_BGRA32_no_alpha(uint8_t *bgra,
+                                         int32_t bgra_stride,
+                                         int32_t width,
+                                         int32_t height,
+                                         const uint16_t *y,
+                                         const uint16_t *uv,
+                                         int32_t y_stride,
+                                         int32_t uv_stride)
+{
+    if (uv == NULL)
+        return 1;
 
-            TCLAMP_U8(sf01 + sfr, da1[2]);
-            TCLAMP_U8(sf01 + sfg, da1[1]);
-            SCLAMP_U8(sf01 + sfb, da1[0]);
-            TCLAMP_U8(sf03 + sfr, da1[6]);
-            TCLAMP_U8(sf03 + sfg, da1[5]);
-            SCLAMP_U8(sf03 + sfb, da1[4]);
+    return cc_convert_frame(CC_SEMIPLANAR16, 1, bgra, bgra_stride, width, height,
+                            (const uint8_t*)y, (const uint8_t*)uv, (const uint8_t*)(uv + 1),
+                            y_stride, uv_stride, uv_stride, 1);
+}
+// --- End NV12 and P010 conversion functions
+
+// --- Begin YCbCr420p10 conversion functions
+
+int ColorConvert_YCbCr420p10_to_ARGB32_no_alpha(uint8_t *argb,
+                                                int32_t argb_stride,
+                                                int32_t width,
+                                                int32_t height,
+                                                const uint16_t *y,
+                                                const uint16_t *v,
+                                                const uint16_t *u,
+                                                int32_t y_stride,
+                                                int32_t v_stride,
+                                                int32_t u_stride)
+{
+    return cc_convert_frame(CC_PLANAR10, 0, argb, argb_stride, width, height,
+                            (const uint8_t*)y, (const uint8_t*)u, (const uint8_t*)v,
+                            y_stride, u_stride, v_stride, 1);
+}
 
-            da1[3] = da1[7] = 0xff;
+int ColorConvert_YCbCr420p10_to_BGRA32_no_alpha(uint8_t *bgra,
+                                                int32_t bgra_stride,
+                                                int32_t width,
+                                                int32_t height,
+                                                const uint16_t *y,
+                                                const uint16_t *v,
+                                                const uint16_t *u,
+                                                int32_t y_stride,
+                                                int32_t v_stride,
+                                                int32_t u_stride)
+{
+    return cc_convert_frame(CC_PLANAR10, 1, bgra, bgra_stride, width, height,
+                            (const uint8_t*)y, (const uint8_t*)u, (const uint8_t*)v,
+                            y_stride, u_stride, v_stride, 1);
+}
+// --- End YCbCr420p10 conversion functions
+
+// --- Begin YCbCr422 planar conversion functions
+
+int ColorConvert_YCbCr422planar_to_ARGB32_no_alpha(uint8_t *argb,
+                                                   int32_t argb_stride,
+                                                   int32_t width,
+                                                   int32_t height,
+                                                   const uint8_t *y,
+                                                   const uint8_t *v,
+                                                   const uint8_t *u,
+                                                   int32_t y_stride,
+                                                   int32_t v_stride,
+                                                   int32_t u_stride)
+{
+    return cc_convert_frame(CC_PLANAR, 0, argb, argb_stride, width, height,
+                            y, u, v, y_stride, u_stride, v_stride, 0);
+}
 
-            say1 += 4;
-            sau += 4;
-            sav += 4;
-            da1 += 8;
-        }
+int ColorConvert_YCbCr422planar_to_BGRA32_no_alpha(uint8_t *bgra,
+                                                   int32_t bgra_stride,
+                                                   int32_t width,
+                                                   int32_t height,
+                                                   const uint8_t *y,
+                                                   const uint8_t *v,
+                                                   const uint8_t *u,
+                                                   int32_t y_stride,
+                                                   int32_t v_stride,
+                                                   int32_t u_stride)
+{
+    return cc_convert_frame(CC_PLANAR, 1, bgra, bgra_stride, width, height,
+                            y, u, v, y_stride, u_stride, v_stride, 0);
+}
 
-        sly1 = say1 = ((uint8_t *)sly1 + y_stride);
-        slu = sau = ((uint8_t *)slu + uv_stride);
-        slv = sav = ((uint8_t *)slv + uv_stride);
-        dl1 = da1 = ((uint8_t *)dl1 + bgra_stride);
-    }
+int ColorConvert_YCbCr422planar10_to_ARGB32_no_alpha(uint8_t *argb,
+                                                     int32_t argb_stride,
+                                                     int32_t width,
+                                                     int32_t height,
+                                                     const uint16_t *y,
+                                                     const uint16_t *v,
+                                                     const uint16_t *u,
+                                                     int32_t y_stride,
+                                                     int32_t v_stride,
+                                                     int32_t u_stride)
+{
+    return cc_convert_frame(CC_PLANAR10, 0, argb, argb_stride, width, height,
+                            (const uint8_t*)y, (const uint8_t*)u, (const uint8_t*)v,
+                            y_stride, u_stride, v_stride, 0);
+}
 
-    return 0;
+int ColorConvert_YCbCr422planar10_to_BGRA32_no_alpha(uint8_t *bgra,
+                                                     int32_t bgra_stride,
+                                                     int32_t width,
+                                                     int32_t height,
+                                                     const uint16_t *y,
+                                                     const uint16_t *v,
+                                                     const uint16_t *u,
+                                                     int32_t y_stride,
+                                                     int32_t v_stride,
+                                                     int32_t u_stride)
+{
+    return cc_convert_frame(CC_PLANAR10, 1, bgra, bgra_stride, width, height,
+                            (const uint8_t*)y, (const uint8_t*)u, (const uint8_t*)v,
+                            y_stride, u_stride, v_stride, 0);
 }
-// --- End YCbCr422p conversion functions
+// --- End YCbCr422 planar conversion functions
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -32,6 +32,21 @@
 extern "C" {
 #endif
 
+    /*
+     * SIMD levels of the converters. The level is detected on first use;
+     * ColorConvert_SetSIMDLevel() restricts it, which is meant for tests and
+     * benchmarks comparing the variants, and returns the level actually
+     * selected (COLOR_CONVERT_SIMD_NONE if the CPU lacks the requested one).
+     * All levels produce identical pixels.
+     */
+#define COLOR_CONVERT_SIMD_NONE 0
+#define COLOR_CONVERT_SIMD_SSE2 1
+#define COLOR_CONVERT_SIMD_AVX2 2
+#define COLOR_CONVERT_SIMD_NEON 3
+
+    int ColorConvert_GetSIMDLevel(void);
+    int ColorConvert_SetSIMDLevel(int level);
+
     int ColorConvert_YCbCr420p_to_ARGB32(uint8_t *argb,
                                          int32_t argb_stride,
                                          int32_t width,
@@ -101,6 +116,127 @@ extern "C" {
                                                   int32_t y_stride,
                                                   int32_t uv_stride);
 
+    /*
+     * NV12: Y plane followed by a plane of interleaved U and V samples at
+     * half the horizontal and vertical resolution.
+     */
+    int ColorConvert_NV12_to_ARGB32_no_alpha(uint8_t *argb,
+                                             int32_t argb_stride,
+                                             int32_t width,
+                                             int32_t height,
+                                             const uint8_t *y,
+                                             const uint8_t *uv,
+                                             int32_t y_stride,
+                                             int32_t uv_stride);
+
+    int ColorConvert_NV12_to_BGRA32_no_alpha(uint8_t *bgra,
+                                             int32_t bgra_stride,
+                                             int32_t width,
+                                             int32_t height,
+                                             const uint8_t *y,
+                                             const uint8_t *uv,
+                                             int32_t y_stride,
+                                             int32_t uv_stride);
+
+    /*
+     * P010: NV12 layout with 16 bit little endian samples holding 10 bits
+     * in their most significant bits. Strides are in bytes.
+     */
+    int ColorConvert_P010_to_ARGB32_no_alpha(uint8_t *argb,
+                                             int32_t argb_stride,
+                                             int32_t width,
+                                             int32_t height,
+                                             const uint16_t *y,
+                                             const uint16_t *uv,
+                                             int32_t y_stride,
+                                             int32_t uv_stride);
+
+    int ColorConvert_P010_to_BGRA32_no_alpha(uint8_t *bgra,
+                                             int32_t bgra_stride,
+                                             int32_t width,
+                                             int32_t height,
+                                             const uint16_t *y,
+                                             const uint16_t *uv,
+                                             int32_t y_stride,
+                                             int32_t uv_stride);
+
+    /*
+     * YCbCr420p10: YCbCr420p with 16 bit little endian samples holding 10
+     * bits in their least significant bits, as libavcodec decodes 10 bit
+     * streams. Strides are in bytes.
+     */
+    int ColorConvert_YCbCr420p10_to_ARGB32_no_alpha(uint8_t *argb,
+                                                    int32_t argb_stride,
+                                                    int32_t width,
+                                                    int32_t height,
+                                                    const uint16_t *y,
+                                                    const uint16_t *v,
+                                                    const uint16_t *u,
+                                                    int32_t y_stride,
+                                                    int32_t v_stride,
+                                                    int32_t u_stride);
+
+    int ColorConvert_YCbCr420p10_to_BGRA32_no_alpha(uint8_t *bgra,
+                                                    int32_t bgra_stride,
+                                                    int32_t width,
+                                                    int32_t height,
+                                                    const uint16_t *y,
+                                                    const uint16_t *v,
+                                                    const uint16_t *u,
+                                                    int32_t y_stride,
+                                                    int32_t v_stride,
+                                                    int32_t u_stride);
+
+    /*
+     * YCbCr422planar: Y, U and V planes with chroma at half the horizontal
+     * and the full vertical resolution, as libavcodec decodes 4:2:2
+     * streams. The 10 variant takes 16 bit little endian samples holding 10
+     * bits in their least significant bits. Strides are in bytes.
+     */
+    int ColorConvert_YCbCr422planar_to_ARGB32_no_alpha(uint8_t *argb,
+                                                       int32_t argb_stride,
+                                                       int32_t width,
+                                                       int32_t height,
+                                                       const uint8_t *y,
+                                                       const uint8_t *v,
+                                                       const uint8_t *u,
+                                                       int32_t y_stride,
+                                                       int32_t v_stride,
+                                                       int32_t u_stride);
+
+    int ColorConvert_YCbCr422planar_to_BGRA32_no_alpha(uint8_t *bgra,
+                                                       int32_t bgra_stride,
+                                                       int32_t width,
+                                                       int32_t height,
+                                                       const uint8_t *y,
+                                                       const uint8_t *v,
+                                                       const uint8_t *u,
+                                                       int32_t y_stride,
+                                                       int32_t v_stride,
+                                                       int32_t u_stride);
+
+    int ColorConvert_YCbCr422planar10_to_ARGB32_no_alpha(uint8_t *argb,
+                                                         int32_t argb_stride,
+                                                         int32_t width,
+                                                         int32_t height,
+                                                         const uint16_t *y,
+                                                         const uint16_t *v,
+                                                         const uint16_t *u,
+                                                         int32_t y_stride,
+                                                         int32_t v_stride,
+                                                         int32_t u_stride);
+
+    int ColorConvert_YCbCr422planar10_to_BGRA32_no_alpha(uint8_t *bgra,
+                                                         int32_t bgra_stride,
+                                                         int32_t width,
+                                                         int32_t height,
+                                                         const uint16_t *y,
+                                                         const uint16_t *v,
+                                                         const uint16_t *u,
+                                                         int32_t y_stride,
+                                                         int32_t v_stride,
+                                                         int32_t u_stride);
+
 #ifdef __cplusplus
 };
 #endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -42,7 +42,9 @@ jmethodID CJavaInputStreamCallbacks::m_CloseConnectionMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_PropertyMID = 0;
 
 CJavaInputStreamCallbacks::CJavaInputStreamCallbacks()
-    : m_ConnectionHolder(0)
+    : m_ConnectionHolder(0),
+      m_jvm(NULL),
+      m_ReaderAttached(false)
 {}
 
 CJavaInputStreamCallbacks::~CJavaInputStreamCallbacks()
@@ -318,3 +320,21 @@ int CJavaInputStreamCallbacks::Property(int prop, int value)
 
     return result;
 }
+
+/**
+ * Attaches the reader thread to the JVM for all of its reads, so that the
+ * CJavaEnvironment of each read finds it attached instead of attaching and
+ * detaching it every time. Only one reader thread runs at a time.
+ */
+void CJavaInputStreamCallbacks::AttachReaderThread()
+{
+    GetJavaEnvironment(m_jvm, m_ReaderAttached);
+}
+
+void CJavaInputStreamCallbacks::DetachReaderThread()
+{
+    if (m_ReaderAttached) {
+        m_jvm->DetachCurrentThread();
+        m_ReaderAttached = false;
+    }
+}
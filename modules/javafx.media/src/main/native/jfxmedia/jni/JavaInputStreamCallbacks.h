@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -46,11 +46,14 @@ virtual ~CJavaInputStreamCallbacks();
     int64_t Seek(int64_t position);
     void CloseConnection();
     int  Property(int prop, int value);
+    void AttachReaderThread();
+    void DetachReaderThread();
 
 private:
     jobject          m_ConnectionHolder;
 
     JavaVM           *m_jvm;
+    jboolean         m_ReaderAttached;
     static jfieldID  m_BufferFID;
     static jmethodID m_NeedBufferMID;
     static jmethodID m_ReadNextBlockMID;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -62,6 +62,7 @@ CGstAVPlaybackPipeline::CGstAVPlaybackPipeline(const GstElementContainer& elemen
     m_videoCodecErrorCode = ERROR_NONE;
     m_bStaticPipeline = false; // For now all video pipelines are dynamic
     m_FirstPTS = GST_CLOCK_TIME_NONE;
+    m_pVideoFramePool = new CGstVideoFramePool();
 }
 
 /**
@@ -75,6 +76,9 @@ CGstAVPlaybackPipeline::~CGstAVPlaybackPipeline()
     g_print ("CGstAVPlaybackPipeline::~CGstAVPlaybackPipeline()\n");
 #endif
     LOGGER_LOGMSG(LOGGER_DEBUG, "CGstAVPlaybackPipeline::~CGstAVPlaybackPipeline()");
+
+    // Frames still held by Java keep the pool alive.
+    m_pVideoFramePool->Release();
 }
 
 /**
@@ -335,14 +339,15 @@ GstFlowReturn CGstAVPlaybackPipeline::OnAppSinkHaveFrame(GstElement* pElem, CGst
 
     //***** Create a VideoFrame object
     CGstVideoFrame* pVideoFrame = new CGstVideoFrame();
-    if (!pVideoFrame->Init(pSample))
+    if (!pVideoFrame->Init(pSample, pPipeline->m_pVideoFramePool))
     {
         gst_sample_unref(pSample);
         delete pVideoFrame;
         return GST_FLOW_OK;
     }
 
-    if (pVideoFrame->IsValid() && pPipeline->m_pEventDispatcher)
+    pVideoFrame = ToDisplayFormat(pVideoFrame);
+    if (pVideoFrame != NULL && pVideoFrame->IsValid() && pPipeline->m_pEventDispatcher)
     {
         CPlayerEventDispatcher* pEventDispatcher = pPipeline->m_pEventDispatcher;
 
@@ -413,14 +418,15 @@ GstFlowReturn CGstAVPlaybackPipeline::OnAppSinkPreroll(GstElement* pElem, CGstAV
         }
 
         CGstVideoFrame* pVideoFrame = new CGstVideoFrame();
-        if (!pVideoFrame->Init(pSample))
+        if (!pVideoFrame->Init(pSample, pPipeline->m_pVideoFramePool))
         {
             // INLINE - gst_sample_unref()
             gst_sample_unref (pSample);
             delete pVideoFrame;
             return GST_FLOW_OK;
         }
-        if (pVideoFrame->IsValid()) {
+        pVideoFrame = ToDisplayFormat(pVideoFrame);
+        if (pVideoFrame != NULL && pVideoFrame->IsValid()) {
             if (!pPipeline->m_pEventDispatcher->SendNewFrameEvent(pVideoFrame))
             {
                 if (!pPipeline->m_pEventDispatcher->SendPlayerMediaErrorEvent(ERROR_JNI_SEND_NEW_FRAME_EVENT))
@@ -442,6 +448,26 @@ GstFlowReturn CGstAVPlaybackPipeline::OnAppSinkPreroll(GstElement* pElem, CGstAV
     return GST_FLOW_OK;
 }
 
+/**
+ * CGstAVPlaybackPipeline::ToDisplayFormat()
+ *
+ * Java renders YCbCr 4:2:0, 4:2:2 and RGB frames. Frames the decoder passes on
+ * in other formats are converted to BGRA_PRE here in a single pass, the given
+ * frame is deleted when it is replaced.
+ *
+ * @param   pVideoFrame video frame to convert
+ * @return  frame to send to Java, NULL if the conversion failed
+ */
+CGstVideoFrame* CGstAVPlaybackPipeline::ToDisplayFormat(CGstVideoFrame* pVideoFrame)
+{
+    if (!pVideoFrame->IsValid() || !pVideoFrame->IsNativeOnly())
+        return pVideoFrame;
+
+    CVideoFrame* pConvertedFrame = pVideoFrame->ConvertToFormat(CVideoFrame::BGRA_PRE);
+    delete pVideoFrame;
+    return static_cast<CGstVideoFrame*>(pConvertedFrame);
+}
+
 void CGstAVPlaybackPipeline::OnAppSinkVideoFrameDiscont(CGstAVPlaybackPipeline* pPipeline, GstSample *pSample)
 {
     gint width, height;
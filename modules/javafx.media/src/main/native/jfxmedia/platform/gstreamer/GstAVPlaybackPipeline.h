@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -31,6 +31,7 @@
 #include <PipelineManagement/PipelineOptions.h>
 #include "GstAudioPlaybackPipeline.h"
 #include "GstPipelineFactory.h"
+#include "GstVideoFrame.h"
 
 
 /**
@@ -68,6 +69,7 @@ private:
     static GstFlowReturn     OnAppSinkPreroll(GstElement* pElem, CGstAVPlaybackPipeline* pPipeline);
     static GstFlowReturn     OnAppSinkHaveFrame(GstElement* pElem, CGstAVPlaybackPipeline* pPipeline);
     static void     OnAppSinkVideoFrameDiscont(CGstAVPlaybackPipeline* pPipeline, GstSample *pSample);
+    static CGstVideoFrame*   ToDisplayFormat(CGstVideoFrame* pVideoFrame);
     static GstPadProbeReturn VideoDecoderSrcProbe(GstPad* pPad, GstPadProbeInfo *pInfo, CGstAVPlaybackPipeline* pPipeline);
 
     inline float    GetEncodedVideoFrameRate()
@@ -83,6 +85,7 @@ private:
     gfloat                  m_EncodedVideoFrameRate;
     int                     m_videoCodecErrorCode;
     GstClockTime            m_FirstPTS;
+    CGstVideoFramePool*     m_pVideoFramePool;
 };
 
 #endif  //_GST_AV_PLAYBACK_PIPELINE_H_
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -48,6 +48,9 @@
 #define HLS_VALUE_MIMETYPE_FMP4 3
 #define HLS_VALUE_MIMETYPE_AAC  4
 
+// Stream sources read this many blocks ahead on a separate thread (javasource "read-ahead-blocks")
+#define STREAM_READ_AHEAD_BLOCKS 4
+
 
 //*************************************************************************************************
 //********** class CGstPipelineFactory
@@ -210,12 +213,16 @@ uint32_t CGstPipelineFactory::CreateSourceElement(CLocator* locator, GstElement*
             g_signal_connect (javaSource, "seek-data", G_CALLBACK (SourceSeekData), callbacks);
             g_signal_connect (javaSource, "close-connection", G_CALLBACK (SourceCloseConnection), callbacks);
             g_signal_connect (javaSource, "property", G_CALLBACK (SourceProperty), callbacks);
+            g_signal_connect (javaSource, "reader-started", G_CALLBACK (SourceReaderStarted), callbacks);
+            g_signal_connect (javaSource, "reader-stopped", G_CALLBACK (SourceReaderStopped), callbacks);
 
             if (isRandomAccess)
                 g_signal_connect (javaSource, "read-block", G_CALLBACK (SourceReadBlock), callbacks);
 
             if (hlsMode == 1)
                 g_object_set (javaSource, "hls-mode", TRUE, NULL);
+            else
+                g_object_set (javaSource, "read-ahead-blocks", STREAM_READ_AHEAD_BLOCKS, NULL);
 
             if (streamMimeType == HLS_VALUE_MIMETYPE_MP2T)
                 g_object_set (javaSource, "mimetype", CONTENT_TYPE_MP2T, NULL);
@@ -312,6 +319,16 @@ int CGstPipelineFactory::SourceProperty(GstElement *src, int prop, int value, gp
     return ((CStreamCallbacks*)data)->Property(prop, value);
 }
 
+void CGstPipelineFactory::SourceReaderStarted(GstElement *src, gpointer data)
+{
+    ((CStreamCallbacks*)data)->AttachReaderThread();
+}
+
+void CGstPipelineFactory::SourceReaderStopped(GstElement *src, gpointer data)
+{
+    ((CStreamCallbacks*)data)->DetachReaderThread();
+}
+
 void CGstPipelineFactory::SourceCloseConnection(GstElement *src, gpointer data)
 {
     CStreamCallbacks* callbacks = (CStreamCallbacks*)data;
@@ -322,6 +339,8 @@ void CGstPipelineFactory::SourceCloseConnection(GstElement *src, gpointer data)
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceSeekData), callbacks);
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceCloseConnection), callbacks);
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceProperty), callbacks);
+    g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceReaderStarted), callbacks);
+    g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceReaderStopped), callbacks);
     delete callbacks;
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -47,6 +47,10 @@ static void free_aligned_buffer(gpointer ptr)
     }
 }
 
+// Number of freed buffers CGstVideoFramePool keeps around
+#define FRAME_POOL_MAX_FREE_BLOCKS 6
+#define FRAME_POOL_ALIGNMENT       64
+
 static GstBuffer *alloc_aligned_buffer(guint size)
 {
     // allocate a new GstBuffer of the given size plus some for padding and alignment
@@ -72,6 +76,128 @@ static GstBuffer *alloc_aligned_buffer(guint size)
     return gst_buffer_new_wrapped_full((GstMemoryFlags)0, alignedData, alignedSize, 0, alignedSize, newData, free_aligned_buffer);
 }
 
+//*************************************************************************************************
+//********** class CGstVideoFramePool
+//*************************************************************************************************
+struct CGstVideoFramePool::Block
+{
+    CGstVideoFramePool* pPool;
+    guint8*             pAllocation;
+    guint8*             pData;
+    guint               uiSize;
+};
+
+CGstVideoFramePool::CGstVideoFramePool()
+{
+    g_mutex_init(&m_Mutex);
+    m_iRefCount = 1;
+    m_uiBlockSize = 0;
+    m_pFreeBlocks = NULL;
+    m_uiFreeCount = 0;
+}
+
+CGstVideoFramePool::~CGstVideoFramePool()
+{
+    Drain();
+    g_mutex_clear(&m_Mutex);
+}
+
+void CGstVideoFramePool::AddRef()
+{
+    g_atomic_int_inc(&m_iRefCount);
+}
+
+void CGstVideoFramePool::Release()
+{
+    if (g_atomic_int_dec_and_test(&m_iRefCount))
+        delete this;
+}
+
+// Frees the blocks kept for reuse. Must be called with the mutex held or from the destructor.
+void CGstVideoFramePool::Drain()
+{
+    for (GSList* item = m_pFreeBlocks; item != NULL; item = item->next)
+    {
+        Block* pBlock = (Block*)item->data;
+        g_free(pBlock->pAllocation);
+        delete pBlock;
+        LOWLEVELPERF_COUNTERDEC("CGstVideoFramePool allocated", 1, 1);
+    }
+    g_slist_free(m_pFreeBlocks);
+    m_pFreeBlocks = NULL;
+    m_uiFreeCount = 0;
+}
+
+GstBuffer *CGstVideoFramePool::AllocBuffer(guint size)
+{
+    Block* pBlock = NULL;
+
+    if (size > (G_MAXUINT - FRAME_POOL_ALIGNMENT)) {
+        return NULL;
+    }
+
+    g_mutex_lock(&m_Mutex);
+    if (size != m_uiBlockSize) {
+        // New caps, the buffers in use are freed when they come back.
+        // The first allocation only sets the size.
+        if (m_uiBlockSize != 0) {
+            Drain();
+            LOWLEVELPERF_RESETCOUNTER("CGstVideoFramePool drained");
+        }
+        m_uiBlockSize = size;
+    }
+    if (m_pFreeBlocks != NULL) {
+        pBlock = (Block*)m_pFreeBlocks->data;
+        m_pFreeBlocks = g_slist_delete_link(m_pFreeBlocks, m_pFreeBlocks);
+        m_uiFreeCount--;
+        LOWLEVELPERF_RESETCOUNTER("CGstVideoFramePool reused");
+    }
+    g_mutex_unlock(&m_Mutex);
+
+    if (NULL == pBlock) {
+        guint8* pAllocation = (guint8*)g_try_malloc(size + FRAME_POOL_ALIGNMENT - 1);
+        if (NULL == pAllocation) {
+            return NULL;
+        }
+
+        pBlock = new Block;
+        pBlock->pPool = this;
+        pBlock->pAllocation = pAllocation;
+        pBlock->pData = (guint8*)(((intptr_t)pAllocation + FRAME_POOL_ALIGNMENT - 1) & ~(intptr_t)(FRAME_POOL_ALIGNMENT - 1));
+        pBlock->uiSize = size;
+        LOWLEVELPERF_COUNTERINC("CGstVideoFramePool allocated", 1, 1);
+    }
+
+    // Each outstanding buffer keeps the pool alive.
+    AddRef();
+    return gst_buffer_new_wrapped_full((GstMemoryFlags)0, pBlock->pData, size, 0, size, pBlock, ReleaseBlock);
+}
+
+void CGstVideoFramePool::ReleaseBlock(gpointer data)
+{
+    Block* pBlock = (Block*)data;
+    CGstVideoFramePool* pPool = pBlock->pPool;
+
+    g_mutex_lock(&pPool->m_Mutex);
+    if (pBlock->uiSize == pPool->m_uiBlockSize && pPool->m_uiFreeCount < FRAME_POOL_MAX_FREE_BLOCKS) {
+        pPool->m_pFreeBlocks = g_slist_prepend(pPool->m_pFreeBlocks, pBlock);
+        pPool->m_uiFreeCount++;
+        pBlock = NULL;
+    }
+    g_mutex_unlock(&pPool->m_Mutex);
+
+    if (NULL != pBlock) {
+        g_free(pBlock->pAllocation);
+        delete pBlock;
+        LOWLEVELPERF_COUNTERDEC("CGstVideoFramePool allocated", 1, 1);
+    }
+
+    pPool->Release();
+}
+
+//*************************************************************************************************
+//********** class CGstVideoFrame
+//*************************************************************************************************
 GstCaps *create_RGB_caps(CVideoFrame::FrameType type, guint width, guint height, guint encodedWidth, guint encodedHeight, guint stride)
 {
     gint red_mask, green_mask, blue_mask, alpha_mask;
@@ -113,6 +239,7 @@ CGstVideoFrame::CGstVideoFrame()
     m_pSample = NULL;
     m_pBuffer = NULL;
     m_bIsI420 = false;
+    m_pPool = NULL;
 }
 
 CGstVideoFrame::~CGstVideoFrame()
@@ -121,12 +248,20 @@ CGstVideoFrame::~CGstVideoFrame()
 
     if (NULL != m_pBuffer)
         Dispose();
+
+    if (NULL != m_pPool)
+        m_pPool->Release();
 }
 
-bool CGstVideoFrame::Init(GstSample* sample)
+bool CGstVideoFrame::Init(GstSample* sample, CGstVideoFramePool* pPool)
 {
     LOWLEVELPERF_COUNTERINC("CGstVideoFrame", 1, 1);
 
+    // Converted frames are allocated from the pool of the stream.
+    m_pPool = pPool;
+    if (NULL != m_pPool)
+        m_pPool->AddRef();
+
     // Increment the ref count as this object will be created
     // by the video sink and pushed into the FrameQueue.
     m_pSample = gst_sample_ref(sample);
@@ -179,6 +314,16 @@ void CGstVideoFrame::SetFrameCaps(GstCaps *newCaps)
     } else if (gst_structure_has_name(str, "video/x-raw-yuv")) {
         if (sFormatFourCC != NULL && g_ascii_strcasecmp(sFormatFourCC, FOURCC_UYVY) == 0) {
             m_typeFrame = YCbCr_422;
+        } else if (sFormatFourCC != NULL && g_ascii_strcasecmp(sFormatFourCC, FOURCC_NV12) == 0) {
+            m_typeFrame = YCbCr_NV12;
+        } else if (sFormatFourCC != NULL && g_ascii_strcasecmp(sFormatFourCC, FOURCC_P010) == 0) {
+            m_typeFrame = YCbCr_P010;
+        } else if (sFormatFourCC != NULL && g_ascii_strcasecmp(sFormatFourCC, FOURCC_I420_10LE) == 0) {
+            m_typeFrame = YCbCr_420p10;
+        } else if (sFormatFourCC != NULL && g_ascii_strcasecmp(sFormatFourCC, FOURCC_Y42B) == 0) {
+            m_typeFrame = YCbCr_422planar;
+        } else if (sFormatFourCC != NULL && g_ascii_strcasecmp(sFormatFourCC, FOURCC_I422_10LE) == 0) {
+            m_typeFrame = YCbCr_422planar10;
         } else {
             if (sFormatFourCC != NULL && g_ascii_strcasecmp(sFormatFourCC, FOURCC_I420) == 0) {
                 m_bIsI420 = true;
@@ -300,6 +445,72 @@ void CGstVideoFrame::SetFrameCaps(GstCaps *newCaps)
             break;
         }
 
+        case YCbCr_NV12:
+        case YCbCr_P010: {
+            unsigned int offset = 0;
+            unsigned int sampleSize = (m_typeFrame == YCbCr_P010) ? 2 : 1;
+            SetPlaneCount(2);
+
+            if (!gst_structure_get_int(str, "stride-y", (int*)&m_puiPlaneStrides[0])) {
+                m_puiPlaneStrides[0] = m_uiEncodedWidth * sampleSize;
+            }
+            if (!gst_structure_get_int(str, "stride-uv", (int*)&m_puiPlaneStrides[1])) {
+                m_puiPlaneStrides[1] = m_puiPlaneStrides[0];
+            }
+
+            gst_structure_get_int(str, "offset-y", (int*)&offset);
+            m_pulPlaneSize[0] = CalcSize(m_puiPlaneStrides[0], m_uiEncodedHeight, &m_bIsValid);
+            m_pvPlaneData[0] = CalcPlanePointer((intptr_t)m_pvBufferBaseAddress, offset,
+                                                m_pulPlaneSize[0], m_ulBufferSize, &m_bIsValid);
+
+            // Interleaved Cb and Cr
+            offset += m_pulPlaneSize[0];
+            gst_structure_get_int(str, "offset-uv", (int*)&offset);
+            m_pulPlaneSize[1] = CalcSize(m_puiPlaneStrides[1], (m_uiEncodedHeight/2), &m_bIsValid);
+            m_pvPlaneData[1] = CalcPlanePointer((intptr_t)m_pvBufferBaseAddress, offset,
+                                                m_pulPlaneSize[1], m_ulBufferSize, &m_bIsValid);
+            break;
+        }
+
+        case YCbCr_420p10:
+        case YCbCr_422planar:
+        case YCbCr_422planar10: {
+            unsigned int offset = 0;
+            unsigned int sampleSize = (m_typeFrame == YCbCr_422planar) ? 1 : 2;
+            unsigned int chromaHeight = (m_typeFrame == YCbCr_420p10) ? m_uiEncodedHeight/2 : m_uiEncodedHeight;
+            SetPlaneCount(3);
+
+            // Strides are in bytes
+            if (!gst_structure_get_int(str, "stride-y", (int*)&m_puiPlaneStrides[0])) {
+                m_puiPlaneStrides[0] = m_uiEncodedWidth * sampleSize;
+            }
+            if (!gst_structure_get_int(str, "stride-u", (int*)&m_puiPlaneStrides[1])) {
+                m_puiPlaneStrides[1] = m_uiEncodedWidth * sampleSize / 2;
+            }
+            if (!gst_structure_get_int(str, "stride-v", (int*)&m_puiPlaneStrides[2])) {
+                m_puiPlaneStrides[2] = m_puiPlaneStrides[1];
+            }
+
+            // I420 ordering, Cb before Cr
+            gst_structure_get_int(str, "offset-y", (int*)&offset);
+            m_pulPlaneSize[0] = CalcSize(m_puiPlaneStrides[0], m_uiEncodedHeight, &m_bIsValid);
+            m_pvPlaneData[0] = CalcPlanePointer((intptr_t)m_pvBufferBaseAddress, offset,
+                                                m_pulPlaneSize[0], m_ulBufferSize, &m_bIsValid);
+
+            offset += m_pulPlaneSize[0];
+            gst_structure_get_int(str, "offset-u", (int*)&offset);
+            m_pulPlaneSize[1] = CalcSize(m_puiPlaneStrides[1], chromaHeight, &m_bIsValid);
+            m_pvPlaneData[1] = CalcPlanePointer((intptr_t)m_pvBufferBaseAddress, offset,
+                                                m_pulPlaneSize[1], m_ulBufferSize, &m_bIsValid);
+
+            offset += m_pulPlaneSize[1];
+            gst_structure_get_int(str, "offset-v", (int*)&offset);
+            m_pulPlaneSize[2] = CalcSize(m_puiPlaneStrides[2], chromaHeight, &m_bIsValid);
+            m_pvPlaneData[2] = CalcPlanePointer((intptr_t)m_pvBufferBaseAddress, offset,
+                                                m_pulPlaneSize[2], m_ulBufferSize, &m_bIsValid);
+            break;
+        }
+
         default:
             SetPlaneCount(1);
             if (!gst_structure_get_int(str, "line_stride", (int*)&m_puiPlaneStrides[0])) {
@@ -340,6 +551,14 @@ void CGstVideoFrame::Dispose()
     }
 }
 
+GstBuffer *CGstVideoFrame::AllocBuffer(guint size)
+{
+    if (NULL != m_pPool)
+        return m_pPool->AllocBuffer(size);
+    else
+        return alloc_aligned_buffer(size);
+}
+
 CVideoFrame *CGstVideoFrame::ConvertToFormat(FrameType type)
 {
     CGstVideoFrame *newFrame = NULL;
@@ -368,6 +587,14 @@ CVideoFrame *CGstVideoFrame::ConvertToFormat(FrameType type)
             newFrame = ConvertFromYCbCr422(type);
             break;
 
+        case YCbCr_NV12:
+        case YCbCr_P010:
+        case YCbCr_420p10:
+        case YCbCr_422planar:
+        case YCbCr_422planar10:
+            newFrame = ConvertFromDecoderYCbCr(type);
+            break;
+
         default:
             break;
     }
@@ -413,7 +640,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr420p(FrameType destType)
         return NULL;
     }
 
-    destBuffer = alloc_aligned_buffer(alloc_size);
+    destBuffer = AllocBuffer(alloc_size);
     if (!destBuffer) {
         return NULL;
     }
@@ -495,7 +722,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr420p(FrameType destType)
 
     if (0 == status && destSample) {
         CGstVideoFrame *newFrame = new CGstVideoFrame();
-        bool result = newFrame->Init(destSample) && newFrame->IsValid();
+        bool result = newFrame->Init(destSample, m_pPool) && newFrame->IsValid();
         // INLINE - gst_sample_unref()
         gst_buffer_unref(destBuffer); // else we'll have a massive memory leak!
         // INLINE - gst_sample_unref()
@@ -544,7 +771,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr422(FrameType destType)
         return NULL;
     }
 
-    destBuffer = alloc_aligned_buffer(alloc_size);
+    destBuffer = AllocBuffer(alloc_size);
     if (!destBuffer) {
         return NULL;
     }
@@ -598,7 +825,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr422(FrameType destType)
 
     if (0 == status && destBuffer) {
         CGstVideoFrame *newFrame = new CGstVideoFrame();
-        bool result = newFrame->Init(destSample) && newFrame->IsValid();
+        bool result = newFrame->Init(destSample, m_pPool) && newFrame->IsValid();
         // INLINE - gst_buffer_unref()
         gst_buffer_unref(destBuffer); // else we'll have a massive memory leak!
         // INLINE - gst_sample_unref()
@@ -613,6 +840,175 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr422(FrameType destType)
     return NULL;
 }
 
+/*
+ * Converts the formats the av video decoder passes on as it decodes them
+ * straight to RGB, without an intermediate YCbCr 4:2:0 frame.
+ */
+CGstVideoFrame *CGstVideoFrame::ConvertFromDecoderYCbCr(FrameType destType)
+{
+    GstSample *destSample;
+    GstBuffer *destBuffer;
+    GstCaps *destCaps;
+    GstMapInfo info;
+    guint stride = 0;
+    guint alloc_size = 0;
+    int status = 1;
+    bool bgra = (destType == BGRA_PRE);
+
+    // Make sure we do not have an integer overflow
+    if (m_uiEncodedWidth <= (G_MAXUINT / 4)) {
+        stride = m_uiEncodedWidth * 4;
+    } else {
+        return NULL;
+    }
+
+    if (stride <= (G_MAXUINT - 16)) {
+        stride = ((stride + 15) & ~15); // round up to multiple of 16 bytes
+    } else {
+        return NULL;
+    }
+
+    if (m_uiEncodedHeight > 0 && stride <= (G_MAXUINT / m_uiEncodedHeight)) {
+        alloc_size = stride * m_uiEncodedHeight;
+    } else {
+        return NULL;
+    }
+
+    destBuffer = AllocBuffer(alloc_size);
+    if (!destBuffer) {
+        return NULL;
+    }
+
+    // copy buffer info
+    GST_BUFFER_TIMESTAMP(destBuffer) = GST_BUFFER_TIMESTAMP(m_pBuffer);
+    GST_BUFFER_OFFSET(destBuffer) = GST_BUFFER_OFFSET(m_pBuffer);
+    GST_BUFFER_DURATION(destBuffer) = GST_BUFFER_DURATION(m_pBuffer);
+
+    if (!gst_buffer_map(destBuffer, &info, GST_MAP_WRITE)) {
+        // INLINE - gst_buffer_unref()
+        gst_buffer_unref(destBuffer);
+        return NULL;
+    }
+
+    // now do the conversion
+    switch (m_typeFrame) {
+        case YCbCr_NV12:
+            status = bgra
+                ? ColorConvert_NV12_to_BGRA32_no_alpha(info.data, stride,
+                        m_uiEncodedWidth, m_uiEncodedHeight,
+                        (const uint8_t*)m_pvPlaneData[0], (const uint8_t*)m_pvPlaneData[1],
+                        m_puiPlaneStrides[0], m_puiPlaneStrides[1])
+                : ColorConvert_NV12_to_ARGB32_no_alpha(info.data, stride,
+                        m_uiEncodedWidth, m_uiEncodedHeight,
+                        (const uint8_t*)m_pvPlaneData[0], (const uint8_t*)m_pvPlaneData[1],
+                        m_puiPlaneStrides[0], m_puiPlaneStrides[1]);
+            break;
+
+        case YCbCr_P010:
+            status = bgra
+                ? ColorConvert_P010_to_BGRA32_no_alpha(info.data, stride,
+                        m_uiEncodedWidth, m_uiEncodedHeight,
+                        (const uint16_t*)m_pvPlaneData[0], (const uint16_t*)m_pvPlaneData[1],
+                        m_puiPlaneStrides[0], m_puiPlaneStrides[1])
+                : ColorConvert_P010_to_ARGB32_no_alpha(info.data, stride,
+                        m_uiEncodedWidth, m_uiEncodedHeight,
+                        (const uint16_t*)m_pvPlaneData[0], (const uint16_t*)m_pvPlaneData[1],
+                        m_puiPlaneStrides[0], m_puiPlaneStrides[1]);
+            break;
+
+        case YCbCr_420p10:
+            status = bgra
+                ? ColorConvert_YCbCr420p10_to_BGRA32_no_alpha(info.data, stride,
+                        m_uiEncodedWidth, m_uiEncodedHeight,
+                        (const uint16_t*)m_pvPlaneData[0],
+                        (const uint16_t*)m_pvPlaneData[2],
+                        (const uint16_t*)m_pvPlaneData[1],
+                        m_puiPlaneStrides[0], m_puiPlaneStrides[2], m_puiPlaneStrides[1])
+                : ColorConvert_YCbCr420p10_to_ARGB32_no_alpha(info.data, stride,
+                        m_uiEncodedWidth, m_uiEncodedHeight,
+                        (const uint16_t*)m_pvPlaneData[0],
+                        (const uint16_t*)m_pvPlaneData[2],
+                        (const uint16_t*)m_pvPlaneData[1],
+                        m_puiPlaneStrides[0], m_puiPlaneStrides[2], m_puiPlaneStrides[1]);
+            break;
+
+        case YCbCr_422planar:
+            status = bgra
+                ? ColorConvert_YCbCr422planar_to_BGRA32_no_alpha(info.data, stride,
+                        m_uiEncodedWidth, m_uiEncodedHeight,
+                        (const uint8_t*)m_pvPlaneData[0],
+                        (const uint8_t*)m_pvPlaneData[2],
+                        (const uint8_t*)m_pvPlaneData[1],
+                        m_puiPlaneStrides[0], m_puiPlaneStrides[2], m_puiPlaneStrides[1])
+                : ColorConvert_YCbCr422planar_to_ARGB32_no_alpha(info.data, stride,
+                        m_uiEncodedWidth, m_uiEncodedHeight,
+                        (const uint8_t*)m_pvPlaneData[0],
+                        (const uint8_t*)m_pvPlaneData[2],
+                        (const uint8_t*)m_pvPlaneData[1],
+                        m_puiPlaneStrides[0], m_puiPlaneStrides[2], m_puiPlaneStrides[1]);
+            break;
+
+        case YCbCr_422planar10:
+            status = bgra
+                ? ColorConvert_YCbCr422planar10_to_BGRA32_no_alpha(info.data, stride,
+                        m_uiEncodedWidth, m_uiEncodedHeight,
+                        (const uint16_t*)m_pvPlaneData[0],
+                        (const uint16_t*)m_pvPlaneData[2],
+                        (const uint16_t*)m_pvPlaneData[1],
+                        m_puiPlaneStrides[0], m_puiPlaneStrides[2], m_puiPlaneStrides[1])
+                : ColorConvert_YCbCr422planar10_to_ARGB32_no_alpha(info.data, stride,
+                        m_uiEncodedWidth, m_uiEncodedHeight,
+                        (const uint16_t*)m_pvPlaneData[0],
+                        (const uint16_t*)m_pvPlaneData[2],
+                        (const uint16_t*)m_pvPlaneData[1],
+                        m_puiPlaneStrides[0], m_puiPlaneStrides[2], m_puiPlaneStrides[1]);
+            break;
+
+        default:
+            break;
+    }
+
+    gst_buffer_unmap(destBuffer, &info);
+
+    destCaps = create_RGB_caps(destType, m_uiWidth, m_uiHeight, m_uiEncodedWidth, m_uiEncodedHeight, stride);
+    if (!destCaps) {
+        // INLINE - gst_buffer_unref()
+        gst_buffer_unref(destBuffer);
+        return NULL;
+    }
+
+    destSample = gst_sample_new(destBuffer, destCaps, NULL, NULL);
+    if (!destSample) {
+        gst_caps_unref(destCaps);
+        // INLINE - gst_buffer_unref()
+        gst_buffer_unref(destBuffer);
+        return NULL;
+    }
+
+    gst_caps_unref(destCaps);
+
+    if (0 == status) {
+        CGstVideoFrame *newFrame = new CGstVideoFrame();
+        bool result = newFrame->Init(destSample, m_pPool) && newFrame->IsValid();
+        // INLINE - gst_buffer_unref()
+        gst_buffer_unref(destBuffer); // else we'll have a massive memory leak!
+        // INLINE - gst_sample_unref()
+        gst_sample_unref(destSample); // else we'll have a massive memory leak!
+        if (result) {
+            return newFrame;
+        } else {
+            delete newFrame;
+        }
+    } else {
+        // INLINE - gst_buffer_unref()
+        gst_buffer_unref(destBuffer);
+        // INLINE - gst_sample_unref()
+        gst_sample_unref(destSample);
+    }
+
+    return NULL;
+}
+
 CGstVideoFrame *CGstVideoFrame::ConvertSwapRGB(FrameType destType)
 {
     GstSample *destSample;
@@ -625,7 +1021,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertSwapRGB(FrameType destType)
 
     size = gst_buffer_get_size(m_pBuffer);
 
-    destBuffer = alloc_aligned_buffer(size);
+    destBuffer = AllocBuffer(size);
     if (!destBuffer) {
         return NULL;
     }
@@ -712,7 +1108,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertSwapRGB(FrameType destType)
 
     if (destBuffer) {
         CGstVideoFrame *newFrame = new CGstVideoFrame();
-        bool result = newFrame->Init(destSample) && newFrame->IsValid();
+        bool result = newFrame->Init(destSample, m_pPool) && newFrame->IsValid();
         // INLINE - gst_buffer_unref()
         gst_buffer_unref(destBuffer); // else we'll have a massive memory leak!
         // INLINE - gst_sample_unref()
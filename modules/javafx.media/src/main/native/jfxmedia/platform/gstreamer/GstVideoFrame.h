@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -31,6 +31,43 @@
 
 #define FOURCC_I420 "I420"
 #define FOURCC_UYVY "UYVY"
+#define FOURCC_NV12 "NV12"
+#define FOURCC_P010 "P010_10LE"
+#define FOURCC_I420_10LE "I420_10LE"
+#define FOURCC_Y42B "Y42B"
+#define FOURCC_I422_10LE "I422_10LE"
+
+/**
+ * class CGstVideoFramePool
+ *
+ * Recycles the output buffers of CGstVideoFrame::ConvertToFormat() for one stream.
+ * Buffers are 64 byte aligned. Freed buffers are kept for reuse as long as the
+ * converted frames keep the same size, a new size drains the pool. The pool is
+ * reference counted since frames and their buffers may outlive the pipeline.
+ */
+class CGstVideoFramePool
+{
+public:
+    CGstVideoFramePool();
+
+    void AddRef();
+    void Release();
+
+    GstBuffer *AllocBuffer(guint size);
+
+private:
+    ~CGstVideoFramePool();
+
+    struct Block;
+    static void ReleaseBlock(gpointer data);
+    void        Drain();
+
+    GMutex      m_Mutex;
+    gint        m_iRefCount;
+    guint       m_uiBlockSize;
+    GSList*     m_pFreeBlocks;
+    guint       m_uiFreeCount;
+};
 
 /**
  * class CGstVideoFrame
@@ -48,7 +85,7 @@ public:
      * Initialize a VideoFrame that wraps the given GstBuffer. The frame caps are
      * extracted from the buffer itself.
      */
-    bool Init(GstSample* sample);
+    bool Init(GstSample* sample, CGstVideoFramePool* pPool = NULL);
 
     virtual void Dispose();
 
@@ -69,9 +106,13 @@ private:
     void*       m_pvBufferBaseAddress;
     unsigned long m_ulBufferSize;
     bool        m_bIsI420;
+    CGstVideoFramePool* m_pPool;
+
+    GstBuffer *AllocBuffer(guint size);
 
     CGstVideoFrame *ConvertSwapRGB(FrameType destType);
     CGstVideoFrame *ConvertFromYCbCr420p(FrameType destType);
     CGstVideoFrame *ConvertFromYCbCr422(FrameType destType);
+    CGstVideoFrame *ConvertFromDecoderYCbCr(FrameType destType);
 };
 #endif  //_GST_VIDEO_FRAME_H_
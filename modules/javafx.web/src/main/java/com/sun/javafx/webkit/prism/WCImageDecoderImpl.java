@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -33,6 +33,7 @@ import com.sun.javafx.iio.ImageStorage;
 import com.sun.javafx.iio.ImageStorageException;
 import com.sun.javafx.logging.PlatformLogger;
 import com.sun.javafx.logging.PlatformLogger.Level;
+import com.sun.webkit.Invoker;
 import com.sun.webkit.graphics.WCGraphicsManager;
 import com.sun.webkit.graphics.WCImage;
 import com.sun.webkit.graphics.WCImageDecoder;
@@ -60,6 +61,8 @@ final class WCImageDecoderImpl extends WCImageDecoder {
     private volatile byte[] data;
     private volatile int dataSize = 0;
     private String fileNameExtension;
+    // Serializes decoding, which runs outside of the monitor of this decoder.
+    private final Object decodeLock = new Object();
 
     static {
         log = PlatformLogger.getLogger(WCImageDecoderImpl.class.getName());
@@ -173,19 +176,21 @@ final class WCImageDecoderImpl extends WCImageDecoder {
         setFrames(loadFrames(in));
     }
 
-    private synchronized ImageFrame[] loadFrames(InputStream in) {
+    private ImageFrame[] loadFrames(InputStream in) {
         if (log.isLoggable(Level.FINE)) {
             log.fine(String.format("%X Decoding frames", hashCode()));
         }
-        try {
-            return ImageStorage.getInstance().loadAll(in, readerListener, 0, 0, true, 1.0f, false);
-        } catch (ImageStorageException e) {
-            return null; // consider image missing
-        } finally {
+        synchronized (decodeLock) {
             try {
-                in.close();
-            } catch (IOException e) {
-                // ignore
+                return ImageStorage.getInstance().loadAll(in, readerListener, 0, 0, true, 1.0f, false);
+            } catch (ImageStorageException e) {
+                return null; // consider image missing
+            } finally {
+                try {
+                    in.close();
+                } catch (IOException e) {
+                    // ignore
+                }
             }
         }
     }
@@ -257,20 +262,16 @@ final class WCImageDecoderImpl extends WCImageDecoder {
     }
 
     @Override protected int getFrameCount() {
-        // Initiate full decode to get frame count.
-        // NOTE: This method will be called just before
-        // rendering the given image, so there will not
-        // be any performance degrade while initiating a
-        // full decode.
-        if (fullDataReceived) {
+        // Only GIF images can have more than one frame, so there is no need
+        // to decode other images here. Their decoding is left to getFrame(),
+        // which the web engine may call from one of its decoder threads.
+        if (fullDataReceived && "gif".equalsIgnoreCase(fileNameExtension)) {
             getImageFrame(0);
         }
         return frameCount;
     }
 
-    // Avoid redundant decoding by async decoder threads, currently we don't
-    // support per frame decoding.
-    @Override protected synchronized WCImageFrame getFrame(int idx) {
+    @Override protected WCImageFrame getFrame(int idx) {
         ImageFrame frame = getImageFrame(idx);
         if (frame != null) {
             if (log.isLoggable(Level.FINE)) {
@@ -326,17 +327,33 @@ final class WCImageDecoderImpl extends WCImageDecoder {
         return getFrameMetadata(idx) != null && framesDecoded;
     }
 
-    private synchronized ImageFrame getImageFrame(int idx) {
-        if (!fullDataReceived) {
-            startLoader();
-        } else if (fullDataReceived && !framesDecoded) {
-            destroyLoader();
-            setFrames(loadFrames()); // re-decode frames if they have been destroyed
-            framesDecoded = true;
+    // Decoding holds decodeLock only, so that the frame metadata queries made
+    // while an image is decoded on a decoder thread do not wait for it.
+    private ImageFrame getImageFrame(int idx) {
+        synchronized (decodeLock) {
+            boolean decode = false;
+            synchronized (this) {
+                // The loader service may only be used on the event thread
+                if (!fullDataReceived) {
+                    Invoker.getInvoker().invokeOnEventThread(this::startLoader);
+                } else if (!framesDecoded) {
+                    Invoker.getInvoker().invokeOnEventThread(this::destroyLoader);
+                    decode = true;
+                }
+            }
+            if (decode) {
+                ImageFrame[] decodedFrames = loadFrames(); // re-decode frames if they have been destroyed
+                synchronized (this) {
+                    setFrames(decodedFrames);
+                    framesDecoded = true;
+                }
+            }
+            synchronized (this) {
+                return (idx >= 0) && (this.frames != null) && (this.frames.length > idx)
+                        ? this.frames[idx]
+                        : null;
+            }
         }
-        return (idx >= 0) && (this.frames != null) && (this.frames.length > idx)
-                ? this.frames[idx]
-                : null;
     }
 
     private synchronized PrismImage getPrismImage(int idx, ImageFrame frame) {
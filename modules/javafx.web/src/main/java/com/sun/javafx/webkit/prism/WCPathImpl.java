@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -243,6 +243,45 @@ final class WCPathImpl extends WCPath<Path2D> {
         path.append(((WCPathImpl)p).path, false);
     }
 
+    @Override
+    public void addSegments(float[] segments) {
+        if (log.isLoggable(Level.FINE)) {
+            log.fine("WCPathImpl({0}).addSegments({1})",
+                    new Object[] {getID(), segments.length});
+        }
+        int i = 0;
+        while (i < segments.length) {
+            final int type = (int) segments[i++];
+            switch (type) {
+                case WCPathIterator.SEG_MOVETO:
+                    path.moveTo(segments[i], segments[i + 1]);
+                    i += 2;
+                    break;
+                case WCPathIterator.SEG_LINETO:
+                    path.lineTo(segments[i], segments[i + 1]);
+                    i += 2;
+                    break;
+                case WCPathIterator.SEG_QUADTO:
+                    path.quadTo(segments[i], segments[i + 1],
+                                segments[i + 2], segments[i + 3]);
+                    i += 4;
+                    break;
+                case WCPathIterator.SEG_CUBICTO:
+                    path.curveTo(segments[i], segments[i + 1],
+                                 segments[i + 2], segments[i + 3],
+                                 segments[i + 4], segments[i + 5]);
+                    i += 6;
+                    break;
+                case WCPathIterator.SEG_CLOSE:
+                    path.closePath();
+                    continue;
+                default:
+                    throw new IllegalArgumentException("Unknown segment type: " + type);
+            }
+            hasCP = true;
+        }
+    }
+
     @Override
     public void closeSubpath() {
         if (log.isLoggable(Level.FINE)) {
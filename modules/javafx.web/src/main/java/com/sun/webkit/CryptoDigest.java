@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.webkit;
+
+/**
+ * The SHA digests that WebKit computes natively for WebCrypto, exposed to
+ * tests and benchmarks. The jfxwebkit library must have been loaded, which
+ * creating a {@code WebPage} does.
+ */
+public final class CryptoDigest {
+
+    public static final int SHA_1 = 0;
+    public static final int SHA_224 = 1;
+    public static final int SHA_256 = 2;
+    public static final int SHA_384 = 3;
+    public static final int SHA_512 = 4;
+
+    private CryptoDigest() {
+    }
+
+    /**
+     * Digests {@code data} {@code count} times with the same native digest,
+     * adding it in chunks of {@code chunkSize} bytes, and returns the
+     * digests one after the other. With {@code portable} set, SHA-1 and
+     * SHA-256 use the portable block functions instead of the ones selected
+     * for this CPU.
+     */
+    public static byte[] digest(int algorithm, byte[] data, int chunkSize, int count, boolean portable) {
+        if (algorithm < SHA_1 || algorithm > SHA_512 || chunkSize <= 0 || count <= 0) {
+            throw new IllegalArgumentException();
+        }
+        return twkDigest(algorithm, data, chunkSize, count, portable);
+    }
+
+    /**
+     * Returns the name of the SHA-1 and SHA-256 block functions selected
+     * for this CPU.
+     */
+    public static String getAcceleration() {
+        return twkGetAcceleration();
+    }
+
+    private static native byte[] twkDigest(int algorithm, byte[] data, int chunkSize, int count, boolean portable);
+
+    private static native String twkGetAcceleration();
+}
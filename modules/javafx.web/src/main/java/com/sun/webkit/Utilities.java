@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -27,6 +27,7 @@ package com.sun.webkit;
 
 import java.lang.reflect.InvocationTargetException;
 import java.lang.reflect.Method;
+import java.lang.reflect.Modifier;
 import java.security.AccessControlContext;
 import java.security.AccessController;
 import java.security.PrivilegedActionException;
@@ -92,6 +93,56 @@ public abstract class Utilities {
         "sun.misc"
     );
 
+    // Prefixes of packages whose methods are always invoked through
+    // fwkInvokeWithContext
+    private static final List<String> DIRECT_INVOCATION_REJECT_LIST = List.of(
+        "java.",
+        "javax.",
+        "javafx.",
+        "jdk.",
+        "netscape.",
+        "sun.",
+        "com.sun."
+    );
+
+    /*
+     * Returns true if JavaScript may call the method with a plain JNI call
+     * instead of fwkInvokeWithContext. This is only the case for public
+     * methods of public application classes in exported packages, that is
+     * the methods fwkInvokeWithContext would invoke without restrictions,
+     * and only while no security manager is installed, since only
+     * fwkInvokeWithContext honours the access control context of the page.
+     * The native side asks once per method of each bound object and caches
+     * the answer.
+     */
+    @SuppressWarnings("removal")
+    private static boolean fwkIsDirectInvocationAllowed(final Method method) {
+        if (System.getSecurityManager() != null) {
+            return false;
+        }
+
+        final Class<?> clazz = method.getDeclaringClass();
+        if (!Modifier.isPublic(clazz.getModifiers())
+                || !Modifier.isPublic(method.getModifiers())
+                || Modifier.isStatic(method.getModifiers())) {
+            return false;
+        }
+
+        final ClassLoader loader = clazz.getClassLoader();
+        if (loader == null || loader == ClassLoader.getPlatformClassLoader()) {
+            return false;
+        }
+
+        final String className = clazz.getName();
+        for (String prefix : DIRECT_INVOCATION_REJECT_LIST) {
+            if (className.startsWith(prefix)) {
+                return false;
+            }
+        }
+
+        return clazz.getModule().isExported(clazz.getPackageName());
+    }
+
     @SuppressWarnings("removal")
     private static Object fwkInvokeWithContext(final Method method,
                                                final Object instance,
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -158,8 +158,21 @@ public final class WebPage {
                     "com.sun.webkit.useCSS3D", "false"));
             useCSS3D = useCSS3D && Platform.isSupported(ConditionalFeature.SCENE3D);
 
+            // Keeps the painted page in tiles that are only repainted where
+            // the page changes. Not used while the page is composited.
+            final boolean useTileCache = Boolean.valueOf(System.getProperty(
+                    "com.sun.webkit.useTileCache", "false"));
+
+            // The on-disk bytecode cache of large scripts is only enabled
+            // when a cache directory is given. Its size is in megabytes.
+            final String bytecodeCacheDirectory = System.getProperty(
+                    "com.sun.webkit.bytecodeCacheDirectory");
+            final long bytecodeCacheSize = Long.getLong(
+                    "com.sun.webkit.bytecodeCacheSize", 64) * 1024 * 1024;
+
             // Initialize WTF, WebCore and JavaScriptCore.
-            twkInitWebCore(useJIT, useDFGJIT, useCSS3D);
+            twkInitWebCore(useJIT, useDFGJIT, useCSS3D, useTileCache,
+                    bytecodeCacheDirectory, bytecodeCacheSize);
 
             // Inform the native webkit code when either the JVM or the
             // JavaFX runtime is being shutdown
@@ -2548,8 +2561,47 @@ public final class WebPage {
         return twkWorkerThreadCount();
     }
 
+    /**
+     * Returns the memory footprint of the process in bytes as WebKit
+     * measures it, the resident set size on Linux.
+     */
+    public static long getMemoryFootprint() {
+        return twkGetMemoryFootprint();
+    }
+
+    /**
+     * Returns the free memory cached by the WebKit allocator to the system.
+     */
+    public static void releaseFreeMemory() {
+        Invoker.getInvoker().checkEventThread();
+        twkReleaseFreeMemory();
+    }
+
+    /**
+     * Returns the number of rectangles WebCore asked to repaint and the
+     * number of rectangles passed to {@code fwkRepaint} after coalescing.
+     */
+    public long[] getRepaintRectCounts() {
+        lockPage();
+        try {
+            if (isDisposed) {
+                log.fine("getRepaintRectCounts() request for a disposed web page.");
+                return new long[2];
+            }
+            return twkGetRepaintRectCounts(getPage());
+        } finally {
+            unlockPage();
+        }
+    }
+
     private static native int twkWorkerThreadCount();
 
+    private static native long twkGetMemoryFootprint();
+
+    private static native void twkReleaseFreeMemory();
+
+    private native long[] twkGetRepaintRectCounts(long pPage);
+
     private void fwkDidClearWindowObject(long pContext, long pWindowObject) {
         if (pageClient != null) {
             pageClient.didClearWindowObject(pContext, pWindowObject);
@@ -2621,7 +2673,9 @@ public final class WebPage {
     // Native methods
     // *************************************************************************
 
-    private static native void twkInitWebCore(boolean useJIT, boolean useDFGJIT, boolean useCSS3D);
+    private static native void twkInitWebCore(boolean useJIT, boolean useDFGJIT, boolean useCSS3D,
+                                              boolean useTileCache, String bytecodeCacheDirectory,
+                                              long bytecodeCacheSize);
     private native long twkCreatePage(boolean editable);
     private native void twkInit(long pPage, boolean usePlugins, float devicePixelScale);
     private native void twkDestroyPage(long pPage);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -80,6 +80,13 @@ public abstract class WCPath<P> extends Ref {
 
     public abstract void addPath(WCPath path);
 
+    /**
+     * Appends a batch of segments to this path. Each segment is encoded
+     * as its type, one of the {@code WCPathIterator.SEG_*} constants,
+     * followed by the coordinates of its points.
+     */
+    public abstract void addSegments(float[] segments);
+
     public abstract void closeSubpath();
 
     public abstract boolean isEmpty();
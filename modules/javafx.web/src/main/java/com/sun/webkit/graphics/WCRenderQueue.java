@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -73,7 +73,7 @@ public abstract class WCRenderQueue extends Ref {
         currentBuffer.setBuffer(buffer);
         buffers.addLast(currentBuffer);
         currentBuffer = new BufferData();
-        size += buffer.capacity();
+        size += buffer.remaining();
         if (size > MAX_QUEUE_SIZE && gc!=null) {
             // It is isolated queue over the canvas image [image-gc!=null].
             // We need to flush the changes periodically
@@ -127,7 +127,10 @@ public abstract class WCRenderQueue extends Ref {
         flush();
     }
 
-    private void fwkAddBuffer(ByteBuffer buffer) {
+    private void fwkAddBuffer(ByteBuffer buffer, int length) {
+        // The native side recycles its buffers, so the same ByteBuffer
+        // may come back here with a different length.
+        buffer.clear().limit(length);
         addBuffer(buffer);
     }
 
@@ -161,8 +164,20 @@ public abstract class WCRenderQueue extends Ref {
         disposeGraphics();
     }
 
+    /**
+     * Returns the number of native buffers taken from the buffer pool
+     * shared by all render queues and the number allocated because the
+     * pool had none of the right size.
+     */
+    public static long[] getBufferPoolCounts() {
+        Invoker.getInvoker().checkEventThread();
+        return twkGetBufferPoolCounts();
+    }
+
     private native void twkRelease(Object[] bufs);
 
+    private static native long[] twkGetBufferPoolCounts();
+
     /*is called from native*/
     private int refString(String str) {
         return currentBuffer.addString(str);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -29,6 +29,7 @@ import java.nio.ByteBuffer;
 import java.util.Queue;
 import java.util.concurrent.ConcurrentLinkedQueue;
 import java.util.concurrent.Semaphore;
+import java.util.concurrent.atomic.AtomicInteger;
 
 /**
  * A pool of byte buffers that can be shared by multiple concurrent
@@ -42,6 +43,18 @@ final class ByteBufferPool {
     private final Queue<ByteBuffer> byteBuffers =
             new ConcurrentLinkedQueue<>();
 
+    /**
+     * The maximum number of byte buffers kept in the shared collection.
+     * Buffers owned by native code may come back in bursts, when a large
+     * resource is released, and are dropped beyond this count.
+     */
+    private static final int MAX_POOLED_BUFFER_COUNT = 64;
+
+    /**
+     * The number of byte buffers in the shared collection.
+     */
+    private final AtomicInteger pooledBufferCount = new AtomicInteger();
+
     /**
      * The size of each byte buffer.
      */
@@ -74,6 +87,37 @@ final class ByteBufferPool {
         return new ByteBufferAllocatorImpl(maxBufferCount);
     }
 
+    /**
+     * Takes a byte buffer for data that is handed over to native code,
+     * without the accounting of an allocator. The buffer is given back
+     * with {@link #recycle}.
+     */
+    ByteBuffer take() {
+        ByteBuffer byteBuffer = poll();
+        return byteBuffer != null ? byteBuffer : ByteBuffer.allocateDirect(bufferSize);
+    }
+
+    /**
+     * Returns a byte buffer to the shared collection. This method
+     * may be called on any thread.
+     */
+    void recycle(ByteBuffer byteBuffer) {
+        if (pooledBufferCount.incrementAndGet() > MAX_POOLED_BUFFER_COUNT) {
+            pooledBufferCount.decrementAndGet();
+            return;
+        }
+        byteBuffer.clear();
+        byteBuffers.add(byteBuffer);
+    }
+
+    private ByteBuffer poll() {
+        ByteBuffer byteBuffer = byteBuffers.poll();
+        if (byteBuffer != null) {
+            pooledBufferCount.decrementAndGet();
+        }
+        return byteBuffer;
+    }
+
     /**
      * The allocator implementation.
      */
@@ -100,7 +144,7 @@ final class ByteBufferPool {
         @Override
         public ByteBuffer allocate() throws InterruptedException {
             semaphore.acquire();
-            ByteBuffer byteBuffer = byteBuffers.poll();
+            ByteBuffer byteBuffer = poll();
             if (byteBuffer == null) {
                 byteBuffer = ByteBuffer.allocateDirect(bufferSize);
             }
@@ -112,9 +156,17 @@ final class ByteBufferPool {
          */
         @Override
         public void release(ByteBuffer byteBuffer) {
-            byteBuffer.clear();
-            byteBuffers.add(byteBuffer);
+            recycle(byteBuffer);
+            semaphore.release();
+        }
+
+        /**
+         * {@inheritDoc}
+         */
+        @Override
+        public Runnable transfer(ByteBuffer byteBuffer) {
             semaphore.release();
+            return () -> recycle(byteBuffer);
         }
     }
 }
@@ -133,4 +185,11 @@ interface ByteBufferAllocator {
      * Releases a byte buffer.
      */
     void release(ByteBuffer byteBuffer);
+
+    /**
+     * Stops accounting a byte buffer that is handed over to another owner,
+     * and returns the action that gives it back to the pool once that
+     * owner is done with it.
+     */
+    Runnable transfer(ByteBuffer byteBuffer);
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2019, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -80,6 +80,7 @@ final class HTTP2Loader extends URLLoaderBase {
             PlatformLogger.getLogger(URLLoader.class.getName());
 
     private final WebPage webPage;
+    private final ByteBufferPool byteBufferPool;
     private final boolean asynchronous;
     private String url;
     private String method;
@@ -367,6 +368,7 @@ final class HTTP2Loader extends URLLoaderBase {
               long data)
     {
         this.webPage = webPage;
+        this.byteBufferPool = byteBufferPool;
         this.asynchronous = asynchronous;
         this.url = url;
         this.method = method;
@@ -520,25 +522,51 @@ final class HTTP2Loader extends URLLoaderBase {
         return dbb.clear();
     }
 
-    private ByteBuffer copyToDirectBuffer(final ByteBuffer bb) {
-        return getDirectBuffer(bb.limit()).put(bb).flip();
-    }
-
     // another variant to use from createZIPEncodedBodySubscriber
     private void didReceiveData(final byte[] bytes, int size) {
         callBackIfNotCanceled(() -> {
-            notifyDidReceiveData(getDirectBuffer(size).put(bytes, 0, size).flip());
+            notifyDidReceiveData(getDirectBuffer(size).put(bytes, 0, size).flip(), null);
         });
     }
 
+    // The received buffers are gathered into pooled direct buffers which are
+    // handed over to the native code when full, so that their bytes are not
+    // copied again there. A partly filled last buffer is copied instead.
     private void didReceiveData(final List<ByteBuffer> bytes) {
-        callBackIfNotCanceled(() -> bytes.stream()
-                                          .map(this::copyToDirectBuffer)
-                                          .forEach(this::notifyDidReceiveData)
-        );
+        callBackIfNotCanceled(() -> {
+            ByteBuffer pooled = null;
+            for (ByteBuffer bb : bytes) {
+                while (bb.hasRemaining()) {
+                    if (pooled == null) {
+                        pooled = byteBufferPool.take();
+                    }
+                    int count = Math.min(bb.remaining(), pooled.remaining());
+                    pooled.put(pooled.position(), bb, bb.position(), count);
+                    pooled.position(pooled.position() + count);
+                    bb.position(bb.position() + count);
+                    if (!pooled.hasRemaining()) {
+                        transferToNative(pooled.flip());
+                        pooled = null;
+                    }
+                }
+            }
+            if (pooled != null) {
+                pooled.flip();
+                if (pooled.remaining() >= pooled.capacity() / 2) {
+                    transferToNative(pooled);
+                } else {
+                    notifyDidReceiveData(pooled, null);
+                    byteBufferPool.recycle(pooled);
+                }
+            }
+        });
+    }
+
+    private void transferToNative(ByteBuffer byteBuffer) {
+        notifyDidReceiveData(byteBuffer, () -> byteBufferPool.recycle(byteBuffer));
     }
 
-    private void notifyDidReceiveData(ByteBuffer byteBuffer) {
+    private void notifyDidReceiveData(ByteBuffer byteBuffer, Runnable release) {
         Invoker.getInvoker().checkEventThread();
         if (logger.isLoggable(Level.FINEST)) {
             logger.finest(String.format(
@@ -551,7 +579,7 @@ final class HTTP2Loader extends URLLoaderBase {
                     byteBuffer.remaining(),
                     data));
         }
-        twkDidReceiveData(byteBuffer, byteBuffer.position(), byteBuffer.remaining(), data);
+        twkDidReceiveData(byteBuffer, byteBuffer.position(), byteBuffer.remaining(), release, data);
     }
 
     private void didFinishLoading() {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -734,10 +734,22 @@ final class URLLoader extends URLLoaderBase implements Runnable {
     {
         callBack(() -> {
             if (!canceled) {
+                // Mostly full buffers are handed over to the native code
+                // instead of being copied, the tail of a response is copied
+                // so that a small chunk does not hold a whole buffer
+                if (byteBuffer.remaining() >= byteBuffer.capacity() / 2) {
+                    notifyDidReceiveData(
+                            byteBuffer,
+                            byteBuffer.position(),
+                            byteBuffer.remaining(),
+                            allocator.transfer(byteBuffer));
+                    return;
+                }
                 notifyDidReceiveData(
                         byteBuffer,
                         byteBuffer.position(),
-                        byteBuffer.remaining());
+                        byteBuffer.remaining(),
+                        null);
             }
             allocator.release(byteBuffer);
         });
@@ -745,7 +757,8 @@ final class URLLoader extends URLLoaderBase implements Runnable {
 
     private void notifyDidReceiveData(ByteBuffer byteBuffer,
                                       int position,
-                                      int remaining)
+                                      int remaining,
+                                      Runnable release)
     {
         if (logger.isLoggable(Level.FINEST)) {
             logger.finest(String.format(
@@ -758,7 +771,7 @@ final class URLLoader extends URLLoaderBase implements Runnable {
                     remaining,
                     data));
         }
-        twkDidReceiveData(byteBuffer, position, remaining, data);
+        twkDidReceiveData(byteBuffer, position, remaining, release, data);
     }
 
     private void didFinishLoading() {
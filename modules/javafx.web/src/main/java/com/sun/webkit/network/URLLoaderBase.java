@@ -56,9 +56,18 @@ abstract class URLLoaderBase {
                                                      String url,
                                                      long data);
 
+    /**
+     * Passes {@code remaining} bytes of a direct buffer, starting at
+     * {@code position}, to the native code. If {@code release} is
+     * {@code null} the bytes are copied and the buffer can be reused as soon
+     * as this method returns. Otherwise the native code takes ownership of
+     * the buffer without copying it and runs {@code release}, possibly on
+     * another thread, once it no longer references the buffer.
+     */
     protected static native void twkDidReceiveData(ByteBuffer byteBuffer,
                                                  int position,
                                                  int remaining,
+                                                 Runnable release,
                                                  long data);
 
     protected static native void twkDidFinishLoading(long data);
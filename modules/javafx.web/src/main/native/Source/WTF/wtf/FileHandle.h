@@ -45,7 +45,7 @@ class MappedFileData;
 
 enum class FileOpenMode : uint8_t;
 enum class MappedFileMode : bool;
-#if PLATFORM(JAVA)
+#if PLATFORM(JAVA) && OS(WINDOWS)
 typedef JGObject PlatformFileHandle;
 const PlatformFileHandle invalidPlatformFileHandle { nullptr };
 struct JavaHandleMarkableTraits{
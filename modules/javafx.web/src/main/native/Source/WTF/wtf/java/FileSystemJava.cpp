@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -36,9 +36,15 @@
 #if OS(WINDOWS)
     #include <windows.h>
 #else
+    #include <dirent.h>
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <fnmatch.h>
+    #include <sys/mman.h>
     #include <sys/types.h>
     #include <sys/stat.h>
     #include <unistd.h>
+    #include <wtf/CheckedArithmetic.h>
 #endif
 
 namespace WTF {
@@ -241,9 +247,361 @@ bool makeAllDirectories(const String& path)
 
 CString fileSystemRepresentation(const String& s)
 {
+#if OS(UNIX)
+    return s.utf8();
+#else
     return CString(s.latin1().data());
+#endif
+}
+
+#if OS(UNIX)
+// -----------------------------------------------------------------------
+//  On Linux and macOS file handles are plain file descriptors, so that
+//  WebCore can map files instead of reading them into the heap.
+// -----------------------------------------------------------------------
+FileHandle openFile(const String& path, FileOpenMode mode, FileAccessPermission permission, OptionSet<FileLockMode> lockMode, bool failIfFileExists)
+{
+    CString fsRep = fileSystemRepresentation(path);
+    if (fsRep.isNull())
+        return { };
+
+    int platformFlag = O_CLOEXEC;
+    switch (mode) {
+    case FileOpenMode::Read:
+        platformFlag |= O_RDONLY;
+        break;
+    case FileOpenMode::Truncate:
+        platformFlag |= (O_WRONLY | O_CREAT | O_TRUNC);
+        break;
+    case FileOpenMode::ReadWrite:
+        platformFlag |= (O_RDWR | O_CREAT);
+        break;
+#if OS(DARWIN)
+    case FileOpenMode::EventsOnly:
+        platformFlag |= O_EVTONLY;
+        break;
+#endif
+    }
+
+    if (failIfFileExists)
+        platformFlag |= (O_CREAT | O_EXCL);
+
+    int permissionFlag = 0;
+    if (permission == FileAccessPermission::User)
+        permissionFlag |= (S_IRUSR | S_IWUSR);
+    else if (permission == FileAccessPermission::All)
+        permissionFlag |= (S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+
+    return FileHandle::adopt(open(fsRep.data(), platformFlag, permissionFlag), lockMode);
+}
+
+void closeFile(PlatformFileHandle& handle)
+{
+    if (isHandleValid(handle)) {
+        ::close(handle);
+        handle = invalidPlatformFileHandle;
+    }
+}
+
+int readFromFile(PlatformFileHandle handle, void* data, int length)
+{
+    if (length < 0 || data == nullptr || !isHandleValid(handle)) {
+        return -1;
+    }
+    do {
+        auto bytesRead = ::read(handle, data, length);
+        if (bytesRead >= 0)
+            return static_cast<int>(bytesRead);
+    } while (errno == EINTR);
+    return -1;
+}
+
+int64_t readFromFile(PlatformFileHandle handle, std::span<uint8_t> data)
+{
+    return readFromFile(handle, data.data(), data.size());
+}
+
+int64_t writeToFile(PlatformFileHandle handle, std::span<const uint8_t> data)
+{
+    if (!isHandleValid(handle)) {
+        return -1;
+    }
+    do {
+        auto bytesWritten = ::write(handle, data.data(), data.size());
+        if (bytesWritten >= 0)
+            return bytesWritten;
+    } while (errno == EINTR);
+    return -1;
+}
+
+int writeToFile(PlatformFileHandle handle, const void* data, int length)
+{
+    if (length < 0 || data == nullptr) {
+        return -1;
+    }
+    return static_cast<int>(writeToFile(handle, std::span { static_cast<const uint8_t*>(data), static_cast<size_t>(length) }));
+}
+
+bool truncateFile(PlatformFileHandle handle, long long offset)
+{
+    // ftruncate returns 0 to indicate the success.
+    return isHandleValid(handle) && !ftruncate(handle, offset);
+}
+
+std::optional<uint64_t> fileSize(PlatformFileHandle handle)
+{
+    struct stat fileInfo;
+    if (!isHandleValid(handle) || fstat(handle, &fileInfo))
+        return std::nullopt;
+
+    return fileInfo.st_size;
+}
+
+bool flushFile(PlatformFileHandle handle)
+{
+    return isHandleValid(handle) && !fsync(handle);
+}
+
+std::optional<Vector<uint8_t>> readEntireFile(PlatformFileHandle handle)
+{
+    auto size = fileSize(handle);
+    if (!size)
+        return std::nullopt;
+
+    size_t bytesToRead;
+    if (!WTF::convertSafely(*size, bytesToRead))
+        return std::nullopt;
+
+    Vector<uint8_t> buffer(bytesToRead);
+    size_t totalBytesRead = 0;
+    while (totalBytesRead < bytesToRead) {
+        auto bytesRead = readFromFile(handle, buffer.mutableSpan().subspan(totalBytesRead));
+        if (bytesRead <= 0)
+            break;
+        totalBytesRead += bytesRead;
+    }
+
+    if (totalBytesRead != bytesToRead)
+        return std::nullopt;
+
+    return buffer;
+}
+
+std::optional<Vector<uint8_t>> readEntireFile(const String& path)
+{
+    auto handle = openFile(path, FileOpenMode::Read);
+    if (!handle)
+        return std::nullopt;
+
+    return handle.readAll();
+}
+
+std::optional<PlatformFileID> fileID(PlatformFileHandle handle)
+{
+    struct stat fileInfo;
+    if (!isHandleValid(handle) || fstat(handle, &fileInfo))
+        return std::nullopt;
+
+    return fileInfo.st_ino;
+}
+
+bool fileIDsAreEqual(std::optional<PlatformFileID> a, std::optional<PlatformFileID> b)
+{
+    return a == b;
+}
+
+long long seekFile(PlatformFileHandle handle, long long offset, FileSeekOrigin origin)
+{
+    if (!isHandleValid(handle)) {
+        return -1;
+    }
+    int whence = SEEK_SET;
+    switch (origin) {
+    case FileSeekOrigin::Beginning:
+        whence = SEEK_SET;
+        break;
+    case FileSeekOrigin::Current:
+        whence = SEEK_CUR;
+        break;
+    case FileSeekOrigin::End:
+        whence = SEEK_END;
+        break;
+    }
+    return lseek(handle, offset, whence);
+}
+
+std::optional<PlatformFileID> FileHandle::id()
+{
+    return fileID(platformHandle());
+}
+
+std::optional<MappedFileData> FileHandle::map(MappedFileMode mapMode, FileOpenMode openMode)
+{
+    if (!m_handle)
+        return std::nullopt;
+
+    auto fileLength = fileSize(platformHandle());
+    if (!fileLength)
+        return std::nullopt;
+
+    size_t size;
+    if (!WTF::convertSafely(*fileLength, size))
+        return std::nullopt;
+
+    // mmap() rejects empty mappings, an empty file maps to an empty span.
+    if (!size)
+        return MappedFileData { };
+
+    int pageProtection = PROT_READ;
+    switch (openMode) {
+    case FileOpenMode::Read:
+        pageProtection = PROT_READ;
+        break;
+    case FileOpenMode::Truncate:
+        pageProtection = PROT_WRITE;
+        break;
+    case FileOpenMode::ReadWrite:
+        pageProtection = PROT_READ | PROT_WRITE;
+        break;
+#if OS(DARWIN)
+    case FileOpenMode::EventsOnly:
+        ASSERT_NOT_REACHED();
+        return std::nullopt;
+#endif
+    }
+
+    auto fileData = MmapSpan<uint8_t>::mmap(nullptr, size, pageProtection, MAP_FILE | (mapMode == MappedFileMode::Shared ? MAP_SHARED : MAP_PRIVATE), platformHandle());
+    if (!fileData)
+        return std::nullopt;
+
+    return MappedFileData { WTF::move(fileData) };
+}
+
+std::optional<uint64_t> FileHandle::read(std::span<uint8_t> data)
+{
+    if (!m_handle)
+        return std::nullopt;
+
+    int64_t result = readFromFile(platformHandle(), data);
+    if (result < 0)
+        return std::nullopt;
+
+    return static_cast<uint64_t>(result);
+}
+
+std::optional<uint64_t> FileHandle::write(std::span<const uint8_t> data)
+{
+    if (!m_handle)
+        return std::nullopt;
+
+    int64_t result = writeToFile(platformHandle(), data);
+    if (result < 0)
+        return std::nullopt;
+
+    return static_cast<uint64_t>(result);
+}
+
+bool FileHandle::truncate(int64_t offset)
+{
+    return truncateFile(platformHandle(), offset);
+}
+
+bool FileHandle::flush()
+{
+    return flushFile(platformHandle());
+}
+
+void FileHandle::close()
+{
+    if (auto handle = std::exchange(m_handle, std::nullopt))
+        ::close(*handle);
+}
+
+std::optional<uint64_t> FileHandle::size()
+{
+    return fileSize(platformHandle());
+}
+
+std::optional<uint64_t> FileHandle::seek(int64_t offset, FileSeekOrigin origin)
+{
+    long long pos = seekFile(platformHandle(), offset, origin);
+
+    if (pos < 0)
+        return std::nullopt;
+
+    return static_cast<uint64_t>(pos);
+}
+
+std::optional<uint64_t> overwriteEntireFile(const String& path, std::span<const uint8_t> span)
+{
+    auto handle = openFile(path, FileOpenMode::Truncate);
+    if (!handle)
+        return std::nullopt;
+
+    return handle.write(span);
+}
+
+bool deleteFile(const String& path)
+{
+    // unlink(...) returns 0 on successful deletion of the path and non-zero in any other case.
+    return !unlink(fileSystemRepresentation(path).data());
+}
+
+bool moveFile(const String& oldPath, const String& newPath)
+{
+    // rename() atomically replaces an existing newPath.
+    return !rename(fileSystemRepresentation(oldPath).data(), fileSystemRepresentation(newPath).data());
+}
+
+Vector<String> listDirectory(const String& path)
+{
+    Vector<String> fileNames;
+    DIR* directory = opendir(fileSystemRepresentation(path).data());
+    if (!directory)
+        return fileNames;
+
+    while (auto* entry = readdir(directory)) {
+        const char* name = entry->d_name;
+        if (!strcmp(name, ".") || !strcmp(name, ".."))
+            continue;
+        fileNames.append(String::fromUTF8(name));
+    }
+    closedir(directory);
+    return fileNames;
+}
+
+Vector<String> listDirectory(const String& path, const String& filter)
+{
+    CString filterRep = fileSystemRepresentation(filter);
+    Vector<String> entries;
+    for (auto& fileName : listDirectory(path)) {
+        if (filterRep.isNull() || !fnmatch(filterRep.data(), fileName.utf8().data(), 0))
+            entries.append(pathByAppendingComponent(path, fileName));
+    }
+    return entries;
 }
 
+static const char* temporaryFileDirectory()
+{
+    if (auto* tmpDir = getenv("TMPDIR"))
+        return tmpDir;
+
+    return "/tmp";
+}
+
+std::pair<String, FileHandle> openTemporaryFile(StringView prefix, StringView suffix, const String& temporaryDirectory)
+{
+    String directory = temporaryDirectory.isEmpty() ? String::fromUTF8(temporaryFileDirectory()) : temporaryDirectory;
+    CString templatePath = fileSystemRepresentation(makeString(directory, '/', prefix, "-XXXXXX"_s, suffix));
+    int suffixLength = suffix.utf8().length();
+
+    auto handle = FileHandle::adopt(mkostemps(templatePath.mutableSpanIncludingNullTerminator().data(), suffixLength, O_CLOEXEC));
+    if (!handle)
+        return { String(), FileHandle() };
+
+    return { String::fromUTF8(templatePath.data()), WTF::move(handle) };
+}
+#else
 FileHandle openFile(const String& path, FileOpenMode mode, FileAccessPermission, OptionSet<FileLockMode> , bool failIfFileExists)
 {
     if (mode != FileOpenMode::Read) {
@@ -412,6 +770,7 @@ std::optional<uint64_t> FileHandle::seek(int64_t offset, FileSeekOrigin origin)
 
     return static_cast<uint64_t>(pos);
 }
+#endif // OS(UNIX)
 
 // -----------------------------------------------------------------------
 // Below methods are stubs as of now.
@@ -436,38 +795,6 @@ String directoryName(String const &)
     return String();
 }
 
-Vector<String> listDirectory(const String&, const String&)
-{
-    fprintf(stderr, "listDirectory(const String&, const String&) NOT IMPLEMENTED\n");
-    Vector<String> entities;
-    return entities;
-}
-
-Vector<String> listDirectory(const String&)
-{
-    fprintf(stderr, "listDirectory(const String&) NOT IMPLEMENTED\n");
-    Vector<String> entities;
-    return entities;
-}
-
-int writeToFile(PlatformFileHandle, const void* data, int length)
-{
-    fprintf(stderr, "writeToFile(PlatformFileHandle, const void* data, int length) NOT IMPLEMENTED\n");
-    UNUSED_PARAM(data);
-    UNUSED_PARAM(length);
-
-    return -1;
-}
-
-bool truncateFile(PlatformFileHandle, long long offset)
-{
-    fprintf(stderr, "truncateFile(PlatformFileHandle, long long offset) NOT IMPLEMENTED\n");
-
-    // FIXME: openjfx2.26 implement truncateFile
-    UNUSED_PARAM(offset);
-    return false;
-}
-
 std::optional<int32_t> getFileDeviceId(const String&)
 {
     fprintf(stderr, "getFileDeviceId(const String&) NOT IMPLEMENTED\n");
@@ -482,27 +809,12 @@ bool unmapViewOfFile(void* , size_t)
 }
 
 
-bool deleteFile(const String&)
-{
-    fprintf(stderr, "deleteFile(const String&) NOT IMPLEMENTED\n");
-    return false;
-}
-
 bool deleteEmptyDirectory(String const &)
 {
     fprintf(stderr, "deleteEmptyDirectory(String const &) NOT IMPLEMENTED\n");
     return false;
 }
 
-std::pair<String, FileHandle> openTemporaryFile(StringView prefix, StringView suffix, const String& temporaryDirectory)
-{
-    fprintf(stderr, "openTemporaryFile(const String&, PlatformFileHandle& handle, const String&) NOT IMPLEMENTED\n");
-    UNUSED_PARAM(prefix);
-    UNUSED_PARAM(suffix);
-    UNUSED_PARAM(temporaryDirectory);
-    return { String(), FileHandle() };
-}
-
 String parentPath(const String& path)
 {
     fprintf(stderr, "parentPath(const String& path) NOT IMPLEMENTED\n");
@@ -510,15 +822,6 @@ String parentPath(const String& path)
     return String();
 }
 
-bool moveFile(const String& oldPath, const String& newPath)
-{
-    fprintf(stderr, "moveFile(const String& oldPath, const String& newPath) NOT IMPLEMENTED\n");
-    UNUSED_PARAM(oldPath);
-    UNUSED_PARAM(newPath);
-
-    return false;
-}
-
 bool isHiddenFile(const String& path)
 {
     fprintf(stderr, "isHiddenFile(const String& path) NOT IMPLEMENTED\n");
@@ -556,6 +859,7 @@ void deleteAllFilesModifiedSince(const String& path, WallTime t)
     UNUSED_PARAM(t);
 }
 
+#if !OS(UNIX)
 bool flushFile(PlatformFileHandle handle)
 {
      fprintf(stderr, "flushFile(PlatformFileHandle) NOT IMPLEMENTED\n");
@@ -577,6 +881,7 @@ std::optional<Vector<uint8_t>> readEntireFile(const String& path)
     Vector<uint8_t> vec;
     return vec;
 }
+#endif
 
 bool deleteNonEmptyDirectory(String const &)
 {
@@ -584,6 +889,63 @@ bool deleteNonEmptyDirectory(String const &)
     return false;
 }
 
+#if !OS(UNIX)
+bool moveFile(const String& oldPath, const String& newPath)
+{
+    fprintf(stderr, "moveFile(const String& oldPath, const String& newPath) NOT IMPLEMENTED\n");
+    UNUSED_PARAM(oldPath);
+    UNUSED_PARAM(newPath);
+
+    return false;
+}
+
+Vector<String> listDirectory(const String&, const String&)
+{
+    fprintf(stderr, "listDirectory(const String&, const String&) NOT IMPLEMENTED\n");
+    Vector<String> entities;
+    return entities;
+}
+
+Vector<String> listDirectory(const String&)
+{
+    fprintf(stderr, "listDirectory(const String&) NOT IMPLEMENTED\n");
+    Vector<String> entities;
+    return entities;
+}
+
+int writeToFile(PlatformFileHandle, const void* data, int length)
+{
+    fprintf(stderr, "writeToFile(PlatformFileHandle, const void* data, int length) NOT IMPLEMENTED\n");
+    UNUSED_PARAM(data);
+    UNUSED_PARAM(length);
+
+    return -1;
+}
+
+bool truncateFile(PlatformFileHandle, long long offset)
+{
+    fprintf(stderr, "truncateFile(PlatformFileHandle, long long offset) NOT IMPLEMENTED\n");
+
+    // FIXME: openjfx2.26 implement truncateFile
+    UNUSED_PARAM(offset);
+    return false;
+}
+
+bool deleteFile(const String&)
+{
+    fprintf(stderr, "deleteFile(const String&) NOT IMPLEMENTED\n");
+    return false;
+}
+
+std::pair<String, FileHandle> openTemporaryFile(StringView prefix, StringView suffix, const String& temporaryDirectory)
+{
+    fprintf(stderr, "openTemporaryFile(const String&, PlatformFileHandle& handle, const String&) NOT IMPLEMENTED\n");
+    UNUSED_PARAM(prefix);
+    UNUSED_PARAM(suffix);
+    UNUSED_PARAM(temporaryDirectory);
+    return { String(), FileHandle() };
+}
+
 std::optional<uint64_t> fileSize(PlatformFileHandle handle)
 {
     long long size = 0;
@@ -623,6 +985,7 @@ int64_t readFromFile(PlatformFileHandle, std::span<uint8_t> data)
       fprintf(stderr, "readFromFile(PlatformFileHandle, std::span<uint8_t> data) NOT IMPLEMENTED\n");
       return 0;
 }
+#endif // !OS(UNIX)
 
 FileHandle createDumpFile(StringView filename, StringView extension, StringView path)
 {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2017, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -26,70 +26,39 @@
 #include "config.h"
 
 #include "CryptoDigest.h"
+#include "SHADigestJava.h"
+#include <algorithm>
 #include <jni.h>
 #include <wtf/java/JavaEnv.h>
-#include <wtf/java/JavaRef.h>
 
 namespace PAL {
 
 namespace CryptoDigestInternal {
 
-inline jclass GetMessageDigestClass(JNIEnv* env)
+static SHADigestJava::Algorithm toSHADigestAlgorithm(CryptoDigest::Algorithm algorithm)
 {
-    static JGClass messageDigestCls(
-        env->FindClass("com/sun/webkit/security/WCMessageDigest"));
-    ASSERT(messageDigestCls);
-    return messageDigestCls;
-}
-
-inline JLObject GetMessageDigestInstance(jstring algorithm)
-{
-    JNIEnv* env = WTF::GetJavaEnv();
-    if (!env) {
-        return { };
-    }
-
-    static jmethodID midGetInstance = env->GetStaticMethodID(
-        GetMessageDigestClass(env),
-        "getInstance",
-        "(Ljava/lang/String;)Lcom/sun/webkit/security/WCMessageDigest;");
-    ASSERT(midGetInstance);
-    JLObject jDigest = env->CallStaticObjectMethod(GetMessageDigestClass(env), midGetInstance, algorithm);
-    if (WTF::CheckAndClearException(env)) {
-        return { };
-    }
-    return jDigest;
-}
-
-jstring toJavaMessageDigestAlgorithm(CryptoDigest::Algorithm algorithm)
-{
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    const char* algorithmStr = "";
     switch (algorithm) {
         case CryptoDigest::Algorithm::SHA_1:
-            algorithmStr = "SHA-1";
-            break;
+            return SHADigestJava::Algorithm::SHA1;
         case CryptoDigest::Algorithm::DEPRECATED_SHA_224:
-            algorithmStr = "SHA-224";
-            break;
+            return SHADigestJava::Algorithm::SHA224;
         case CryptoDigest::Algorithm::SHA_256:
-            algorithmStr = "SHA-256";
-            break;
+            return SHADigestJava::Algorithm::SHA256;
         case CryptoDigest::Algorithm::SHA_384:
-            algorithmStr = "SHA-384";
-            break;
+            return SHADigestJava::Algorithm::SHA384;
         case CryptoDigest::Algorithm::SHA_512:
-            algorithmStr = "SHA-512";
-            break;
+            return SHADigestJava::Algorithm::SHA512;
     }
-    return env->NewStringUTF(algorithmStr);
+    ASSERT_NOT_REACHED();
+    return SHADigestJava::Algorithm::SHA256;
 }
 
 } // namespace CryptoDigestInternal
 
+// The digests used to go through java.security.MessageDigest, which cost a
+// JNI transition and a direct ByteBuffer for every chunk of input.
 struct CryptoDigestContext {
-    JGObject jDigest { };
+    std::optional<SHADigestJava> digest;
 };
 
 CryptoDigest::CryptoDigest()
@@ -105,53 +74,60 @@ std::unique_ptr<CryptoDigest> CryptoDigest::create(CryptoDigest::Algorithm algor
 {
     using namespace CryptoDigestInternal;
     auto digest = std::unique_ptr<CryptoDigest>(new CryptoDigest);
-    digest->m_context->jDigest = GetMessageDigestInstance(toJavaMessageDigestAlgorithm(algorithm));
+    digest->m_context->digest.emplace(toSHADigestAlgorithm(algorithm));
     return digest;
 }
 
 void CryptoDigest::addBytes(std::span<const uint8_t> input)
 {
-    using namespace CryptoDigestInternal;
-
-    JNIEnv* env = WTF::GetJavaEnv();
-    if (!m_context->jDigest || !env) {
-        return;
-    }
-
-    static jmethodID midUpdate = env->GetMethodID(
-        GetMessageDigestClass(env),
-        "addBytes",
-        "(Ljava/nio/ByteBuffer;)V");
-    ASSERT(midUpdate);
-    env->CallVoidMethod(jobject(m_context->jDigest), midUpdate, env->NewDirectByteBuffer(const_cast<void*>(reinterpret_cast<const void*>(input.data())), input.size()));
+    m_context->digest->addBytes(input);
 }
 
 Vector<uint8_t> CryptoDigest::computeHash()
 {
-    using namespace CryptoDigestInternal;
+    std::array<uint8_t, SHADigestJava::maximumHashLength> hash;
+    m_context->digest->computeHash(hash);
+    return std::span<const uint8_t> { hash }.first(m_context->digest->hashLength());
+}
 
-    JNIEnv* env = WTF::GetJavaEnv();
-    if (!m_context->jDigest || !env) {
-        return { };
-    }
+} // namespace PAL
 
-    static jmethodID midDigest = env->GetMethodID(
-        GetMessageDigestClass(env),
-        "computeHash",
-        "()[B");
-    ASSERT(midDigest);
+extern "C" {
 
-    JLocalRef<jbyteArray> jDigestBytes = static_cast<jbyteArray>(env->CallObjectMethod(jobject(m_context->jDigest), midDigest));
-    void* digest = env->GetPrimitiveArrayCritical(static_cast<jbyteArray>(jDigestBytes), 0);
-    if (!digest) {
-        return { };
+// Digests data count times with one SHADigestJava, fed in chunks of
+// chunkSize bytes, and returns the digests one after the other. Used by
+// the digest tests and benchmarks through com.sun.webkit.CryptoDigest.
+JNIEXPORT jbyteArray JNICALL Java_com_sun_webkit_CryptoDigest_twkDigest
+    (JNIEnv* env, jclass, jint algorithm, jbyteArray data, jint chunkSize, jint count, jboolean portable)
+{
+    using namespace PAL;
+    Vector<uint8_t> input(env->GetArrayLength(data));
+    env->GetByteArrayRegion(data, 0, input.size(), reinterpret_cast<jbyte*>(input.mutableSpan().data()));
+
+    SHADigestJava digest(static_cast<SHADigestJava::Algorithm>(algorithm),
+        portable ? SHADigestJava::Implementation::Portable : SHADigestJava::Implementation::Default);
+    size_t hashLength = digest.hashLength();
+    Vector<uint8_t> hashes(hashLength * count);
+    std::array<uint8_t, SHADigestJava::maximumHashLength> hash;
+    for (jint i = 0; i < count; i++) {
+        for (size_t offset = 0; offset < input.size(); offset += chunkSize)
+            digest.addBytes(input.span().subspan(offset, std::min<size_t>(chunkSize, input.size() - offset)));
+        digest.computeHash(hash);
+        std::copy_n(hash.begin(), hashLength, hashes.begin() + i * hashLength);
     }
 
-    Vector<uint8_t> result;
-    std::span<const uint8_t> createSpan(reinterpret_cast<const uint8_t*>(digest), env->GetArrayLength(jDigestBytes));
-    result.append(createSpan);
-    env->ReleasePrimitiveArrayCritical(jDigestBytes, digest, 0);
+    jbyteArray result = env->NewByteArray(hashes.size());
+    if (WTF::CheckAndClearException(env) || !result) {
+        return nullptr;
+    }
+    env->SetByteArrayRegion(result, 0, hashes.size(), reinterpret_cast<const jbyte*>(hashes.span().data()));
     return result;
 }
 
-} // namespace PAL
+JNIEXPORT jstring JNICALL Java_com_sun_webkit_CryptoDigest_twkGetAcceleration
+    (JNIEnv* env, jclass)
+{
+    return env->NewStringUTF(PAL::SHADigestJava::acceleration());
+}
+
+} // extern "C"
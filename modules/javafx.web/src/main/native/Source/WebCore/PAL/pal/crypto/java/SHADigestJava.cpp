@@ -0,0 +1,634 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "config.h"
+#include "SHADigestJava.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#if (CPU(X86) || CPU(X86_64)) && (COMPILER(GCC_COMPATIBLE) || COMPILER(MSVC))
+#define HAVE_SHA_DIGEST_X86 1
+#include <immintrin.h>
+#if COMPILER(MSVC)
+#include <intrin.h>
+#define SHA_DIGEST_X86_TARGET
+#else
+#include <cpuid.h>
+#define SHA_DIGEST_X86_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+#endif
+#endif
+
+// The ARMv8 cryptography extensions are optional. They are used when the
+// build targets them, as it does for Apple silicon. On Linux, GCC builds for
+// baseline ARMv8 compile them for the block functions only and use them when
+// the kernel reports the SHA-1 and SHA-2 capabilities.
+#if CPU(ARM64) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#define HAVE_SHA_DIGEST_ARM64 1
+#define SHA_DIGEST_ARM64_TARGET
+#include <arm_neon.h>
+#elif CPU(ARM64) && OS(LINUX) && COMPILER(GCC)
+#define HAVE_SHA_DIGEST_ARM64 1
+#define HAVE_SHA_DIGEST_ARM64_HWCAP 1
+#define SHA_DIGEST_ARM64_TARGET __attribute__((target("+crypto")))
+#include <arm_neon.h>
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+namespace PAL {
+
+namespace SHADigestJavaInternal {
+
+static const uint32_t sha1RoundConstants[4] = {
+    0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6
+};
+
+alignas(16) static const uint32_t sha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint64_t sha512RoundConstants[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+static inline uint32_t rotateRight(uint32_t value, unsigned count)
+{
+    return (value >> count) | (value << (32 - count));
+}
+
+static inline uint64_t rotateRight(uint64_t value, unsigned count)
+{
+    return (value >> count) | (value << (64 - count));
+}
+
+static inline uint32_t loadBigEndian32(const uint8_t* data)
+{
+    return (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | data[3];
+}
+
+static inline uint64_t loadBigEndian64(const uint8_t* data)
+{
+    return (uint64_t(loadBigEndian32(data)) << 32) | loadBigEndian32(data + 4);
+}
+
+static inline void storeBigEndian32(uint8_t* data, uint32_t value)
+{
+    data[0] = value >> 24;
+    data[1] = value >> 16;
+    data[2] = value >> 8;
+    data[3] = value;
+}
+
+static inline void storeBigEndian64(uint8_t* data, uint64_t value)
+{
+    storeBigEndian32(data, value >> 32);
+    storeBigEndian32(data + 4, value);
+}
+
+static void sha1Blocks(uint32_t* state, const uint8_t* data, size_t blockCount)
+{
+    for (; blockCount; --blockCount, data += 64) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; ++i)
+            w[i] = loadBigEndian32(data + 4 * i);
+        for (int i = 16; i < 80; ++i)
+            w[i] = rotateRight(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 31);
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+        for (int i = 0; i < 80; ++i) {
+            uint32_t f;
+            if (i < 20)
+                f = (b & c) | (~b & d);
+            else if (i < 40 || i >= 60)
+                f = b ^ c ^ d;
+            else
+                f = (b & c) | (b & d) | (c & d);
+            uint32_t temp = rotateRight(a, 27) + f + e + sha1RoundConstants[i / 20] + w[i];
+            e = d;
+            d = c;
+            c = rotateRight(b, 2);
+            b = a;
+            a = temp;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+    }
+}
+
+static void sha256Blocks(uint32_t* state, const uint8_t* data, size_t blockCount)
+{
+    for (; blockCount; --blockCount, data += 64) {
+        uint32_t w[64];
+        for (int i = 0; i < 16; ++i)
+            w[i] = loadBigEndian32(data + 4 * i);
+        for (int i = 16; i < 64; ++i) {
+            uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i) {
+            uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+            uint32_t temp1 = h + s1 + ((e & f) ^ (~e & g)) + sha256RoundConstants[i] + w[i];
+            uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+            uint32_t temp2 = s0 + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+static void sha512Blocks(uint64_t* state, const uint8_t* data, size_t blockCount)
+{
+    for (; blockCount; --blockCount, data += 128) {
+        uint64_t w[80];
+        for (int i = 0; i < 16; ++i)
+            w[i] = loadBigEndian64(data + 8 * i);
+        for (int i = 16; i < 80; ++i) {
+            uint64_t s0 = rotateRight(w[i - 15], 1) ^ rotateRight(w[i - 15], 8) ^ (w[i - 15] >> 7);
+            uint64_t s1 = rotateRight(w[i - 2], 19) ^ rotateRight(w[i - 2], 61) ^ (w[i - 2] >> 6);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 80; ++i) {
+            uint64_t s1 = rotateRight(e, 14) ^ rotateRight(e, 18) ^ rotateRight(e, 41);
+            uint64_t temp1 = h + s1 + ((e & f) ^ (~e & g)) + sha512RoundConstants[i] + w[i];
+            uint64_t s0 = rotateRight(a, 28) ^ rotateRight(a, 34) ^ rotateRight(a, 39);
+            uint64_t temp2 = s0 + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#if HAVE(SHA_DIGEST_X86)
+
+static bool cpuSupportsSHAExtensions()
+{
+    // SHA extensions: CPUID.(EAX=7,ECX=0):EBX[29]. SSSE3 and SSE4.1 are
+    // used for the byte swaps and the state shuffles.
+#if COMPILER(MSVC)
+    int registers[4];
+    __cpuid(registers, 0);
+    if (registers[0] < 7)
+        return false;
+    __cpuid(registers, 1);
+    bool hasSSE = (registers[2] & (1 << 9)) && (registers[2] & (1 << 19));
+    __cpuidex(registers, 7, 0);
+    return hasSSE && (registers[1] & (1 << 29));
+#else
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+    bool hasSSE = (ecx & bit_SSSE3) && (ecx & bit_SSE4_1);
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return false;
+    return hasSSE && (ebx & (1u << 29));
+#endif
+}
+
+// Four SHA-1 rounds, unrolled at compile time since the round function
+// selector has to be an immediate. Message words w[i + 4] are scheduled in
+// the slot of w[i] over the three following steps.
+template<int i>
+SHA_DIGEST_X86_TARGET static inline void sha1FourRoundsX86(__m128i& abcd, __m128i& previousABCD, __m128i& e0, __m128i* w, const uint8_t* data)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    if constexpr (i < 4)
+        w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)), byteSwap);
+    __m128i e = i ? _mm_sha1nexte_epu32(previousABCD, w[i & 3]) : _mm_add_epi32(e0, w[0]);
+    previousABCD = abcd;
+    abcd = _mm_sha1rnds4_epu32(abcd, e, i / 5);
+    if constexpr (i >= 1 && i <= 16)
+        w[(i - 1) & 3] = _mm_sha1msg1_epu32(w[(i - 1) & 3], w[i & 3]);
+    if constexpr (i >= 2 && i <= 17)
+        w[(i - 2) & 3] = _mm_xor_si128(w[(i - 2) & 3], w[i & 3]);
+    if constexpr (i >= 3 && i <= 18)
+        w[(i - 3) & 3] = _mm_sha1msg2_epu32(w[(i - 3) & 3], w[i & 3]);
+}
+
+template<int... i>
+SHA_DIGEST_X86_TARGET static void sha1BlocksX86(uint32_t* state, const uint8_t* data, size_t blockCount, std::integer_sequence<int, i...>)
+{
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1b);
+    __m128i e0 = _mm_set_epi32(state[4], 0, 0, 0);
+
+    for (; blockCount; --blockCount, data += 64) {
+        __m128i savedABCD = abcd;
+        __m128i savedE = e0;
+        __m128i previousABCD = abcd;
+        __m128i w[4];
+        (sha1FourRoundsX86<i>(abcd, previousABCD, e0, w, data), ...);
+        e0 = _mm_sha1nexte_epu32(previousABCD, savedE);
+        abcd = _mm_add_epi32(abcd, savedABCD);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1b));
+    state[4] = _mm_extract_epi32(e0, 3);
+}
+
+static void sha1BlocksX86(uint32_t* state, const uint8_t* data, size_t blockCount)
+{
+    sha1BlocksX86(state, data, blockCount, std::make_integer_sequence<int, 20>());
+}
+
+SHA_DIGEST_X86_TARGET static void sha256BlocksX86(uint32_t* state, const uint8_t* data, size_t blockCount)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // The instructions take the state as ABEF and CDGH.
+    __m128i dcba = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xb1);
+    __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1b);
+    __m128i abef = _mm_alignr_epi8(dcba, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, dcba, 0xf0);
+
+    for (; blockCount; --blockCount, data += 64) {
+        __m128i savedABEF = abef;
+        __m128i savedCDGH = cdgh;
+        __m128i w[4];
+        for (int i = 0; i < 4; ++i)
+            w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)), byteSwap);
+
+        // Each iteration does four rounds and schedules w[i + 4] in the slot
+        // of w[i].
+        for (int i = 0; i < 16; ++i) {
+            __m128i message = _mm_add_epi32(w[i & 3], _mm_load_si128(reinterpret_cast<const __m128i*>(sha256RoundConstants + 4 * i)));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, message);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(message, 0x0e));
+            if (i < 12) {
+                __m128i next = _mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]);
+                next = _mm_add_epi32(next, _mm_alignr_epi8(w[(i + 3) & 3], w[(i + 2) & 3], 4));
+                w[i & 3] = _mm_sha256msg2_epu32(next, w[(i + 3) & 3]);
+            }
+        }
+
+        abef = _mm_add_epi32(abef, savedABEF);
+        cdgh = _mm_add_epi32(cdgh, savedCDGH);
+    }
+
+    __m128i feba = _mm_shuffle_epi32(abef, 0x1b);
+    __m128i dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(feba, dchg, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+#endif // HAVE(SHA_DIGEST_X86)
+
+#if HAVE(SHA_DIGEST_ARM64)
+
+static bool cpuSupportsARMv8SHA()
+{
+#if HAVE(SHA_DIGEST_ARM64_HWCAP)
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    return (hwcap & HWCAP_SHA1) && (hwcap & HWCAP_SHA2);
+#else
+    return true;
+#endif
+}
+
+SHA_DIGEST_ARM64_TARGET static void sha1BlocksARM64(uint32_t* state, const uint8_t* data, size_t blockCount)
+{
+    uint32x4_t abcd = vld1q_u32(state);
+    uint32_t e0 = state[4];
+
+    for (; blockCount; --blockCount, data += 64) {
+        uint32x4_t savedABCD = abcd;
+        uint32_t savedE = e0;
+        uint32x4_t w[4];
+        for (int i = 0; i < 4; ++i)
+            w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+
+        // Each iteration does four rounds. w[i + 1] is scheduled in the slot
+        // of w[i - 3] once w[i] is available.
+        for (int i = 0; i < 20; ++i) {
+            uint32x4_t message = vaddq_u32(w[i & 3], vdupq_n_u32(sha1RoundConstants[i / 5]));
+            uint32_t e1 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+            if (i < 5)
+                abcd = vsha1cq_u32(abcd, e0, message);
+            else if (i >= 10 && i < 15)
+                abcd = vsha1mq_u32(abcd, e0, message);
+            else
+                abcd = vsha1pq_u32(abcd, e0, message);
+            e0 = e1;
+            if (i >= 3 && i <= 18) {
+                int next = (i + 1) & 3;
+                w[next] = vsha1su1q_u32(vsha1su0q_u32(w[next], w[(i + 2) & 3], w[(i + 3) & 3]), w[i & 3]);
+            }
+        }
+
+        e0 += savedE;
+        abcd = vaddq_u32(abcd, savedABCD);
+    }
+
+    vst1q_u32(state, abcd);
+    state[4] = e0;
+}
+
+SHA_DIGEST_ARM64_TARGET static void sha256BlocksARM64(uint32_t* state, const uint8_t* data, size_t blockCount)
+{
+    uint32x4_t abcd = vld1q_u32(state);
+    uint32x4_t efgh = vld1q_u32(state + 4);
+
+    for (; blockCount; --blockCount, data += 64) {
+        uint32x4_t savedABCD = abcd;
+        uint32x4_t savedEFGH = efgh;
+        uint32x4_t w[4];
+        for (int i = 0; i < 4; ++i)
+            w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+
+        // Each iteration does four rounds and schedules w[i + 4] in the slot
+        // of w[i].
+        for (int i = 0; i < 16; ++i) {
+            uint32x4_t message = vaddq_u32(w[i & 3], vld1q_u32(sha256RoundConstants + 4 * i));
+            if (i < 12)
+                w[i & 3] = vsha256su0q_u32(w[i & 3], w[(i + 1) & 3]);
+            uint32x4_t previousABCD = abcd;
+            abcd = vsha256hq_u32(abcd, efgh, message);
+            efgh = vsha256h2q_u32(efgh, previousABCD, message);
+            if (i < 12)
+                w[i & 3] = vsha256su1q_u32(w[i & 3], w[(i + 2) & 3], w[(i + 3) & 3]);
+        }
+
+        abcd = vaddq_u32(abcd, savedABCD);
+        efgh = vaddq_u32(efgh, savedEFGH);
+    }
+
+    vst1q_u32(state, abcd);
+    vst1q_u32(state + 4, efgh);
+}
+
+#endif // HAVE(SHA_DIGEST_ARM64)
+
+using BlockFunction = void (*)(uint32_t*, const uint8_t*, size_t);
+
+struct BlockFunctions {
+    BlockFunction sha1;
+    BlockFunction sha256;
+    const char* name;
+};
+
+static const BlockFunctions& blockFunctions()
+{
+    static const BlockFunctions functions = [] () -> BlockFunctions {
+#if HAVE(SHA_DIGEST_X86)
+        if (cpuSupportsSHAExtensions())
+            return { sha1BlocksX86, sha256BlocksX86, "x86 SHA extensions" };
+#endif
+#if HAVE(SHA_DIGEST_ARM64)
+        if (cpuSupportsARMv8SHA())
+            return { sha1BlocksARM64, sha256BlocksARM64, "ARMv8 cryptography extensions" };
+#endif
+        return { sha1Blocks, sha256Blocks, "portable" };
+    }();
+    return functions;
+}
+
+static const BlockFunctions& portableBlockFunctions()
+{
+    static const BlockFunctions functions = { sha1Blocks, sha256Blocks, "portable" };
+    return functions;
+}
+
+} // namespace SHADigestJavaInternal
+
+SHADigestJava::SHADigestJava(Algorithm algorithm, Implementation implementation)
+    : m_algorithm(algorithm)
+    , m_implementation(implementation)
+{
+    reset();
+}
+
+const char* SHADigestJava::acceleration()
+{
+    return SHADigestJavaInternal::blockFunctions().name;
+}
+
+void SHADigestJava::reset()
+{
+    static const uint32_t sha1InitialState[8] = {
+        0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0
+    };
+    static const uint32_t sha224InitialState[8] = {
+        0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4
+    };
+    static const uint32_t sha256InitialState[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    static const uint64_t sha384InitialState[8] = {
+        0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL, 0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+        0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL, 0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL
+    };
+    static const uint64_t sha512InitialState[8] = {
+        0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+        0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+    };
+
+    switch (m_algorithm) {
+    case Algorithm::SHA1:
+        std::copy_n(sha1InitialState, 8, m_state32.begin());
+        break;
+    case Algorithm::SHA224:
+        std::copy_n(sha224InitialState, 8, m_state32.begin());
+        break;
+    case Algorithm::SHA256:
+        std::copy_n(sha256InitialState, 8, m_state32.begin());
+        break;
+    case Algorithm::SHA384:
+        std::copy_n(sha384InitialState, 8, m_state64.begin());
+        break;
+    case Algorithm::SHA512:
+        std::copy_n(sha512InitialState, 8, m_state64.begin());
+        break;
+    }
+    m_bufferLength = 0;
+    m_length = 0;
+}
+
+size_t SHADigestJava::hashLength() const
+{
+    switch (m_algorithm) {
+    case Algorithm::SHA1:
+        return 20;
+    case Algorithm::SHA224:
+        return 28;
+    case Algorithm::SHA256:
+        return 32;
+    case Algorithm::SHA384:
+        return 48;
+    case Algorithm::SHA512:
+        return 64;
+    }
+    return 0;
+}
+
+void SHADigestJava::processBlocks(const uint8_t* data, size_t blockCount)
+{
+    using namespace SHADigestJavaInternal;
+
+    const BlockFunctions& functions = m_implementation == Implementation::Portable ? portableBlockFunctions() : blockFunctions();
+    switch (m_algorithm) {
+    case Algorithm::SHA1:
+        functions.sha1(m_state32.data(), data, blockCount);
+        break;
+    case Algorithm::SHA224:
+    case Algorithm::SHA256:
+        functions.sha256(m_state32.data(), data, blockCount);
+        break;
+    case Algorithm::SHA384:
+    case Algorithm::SHA512:
+        sha512Blocks(m_state64.data(), data, blockCount);
+        break;
+    }
+}
+
+void SHADigestJava::addBytes(std::span<const uint8_t> input)
+{
+    size_t blockSize = this->blockSize();
+    const uint8_t* data = input.data();
+    size_t length = input.size();
+    m_length += length;
+
+    if (m_bufferLength) {
+        size_t count = std::min(length, blockSize - m_bufferLength);
+        memcpy(m_buffer.data() + m_bufferLength, data, count);
+        m_bufferLength += count;
+        data += count;
+        length -= count;
+        if (m_bufferLength < blockSize)
+            return;
+        processBlocks(m_buffer.data(), 1);
+        m_bufferLength = 0;
+    }
+
+    // Whole blocks are hashed in place, without copying them to the buffer.
+    if (size_t blockCount = length / blockSize) {
+        processBlocks(data, blockCount);
+        data += blockCount * blockSize;
+        length -= blockCount * blockSize;
+    }
+
+    if (length) {
+        memcpy(m_buffer.data(), data, length);
+        m_bufferLength = length;
+    }
+}
+
+void SHADigestJava::computeHash(std::span<uint8_t, maximumHashLength> output)
+{
+    using namespace SHADigestJavaInternal;
+
+    // Append the 0x80 terminator, pad with zeros and end the last block with
+    // the message length in bits. SHA-384 and SHA-512 have a 128-bit length
+    // field, of which only the low 64 bits can be non-zero here.
+    size_t blockSize = this->blockSize();
+    size_t lengthFieldSize = blockSize / 8;
+    uint64_t bitLength = m_length * 8;
+
+    m_buffer[m_bufferLength++] = 0x80;
+    if (m_bufferLength > blockSize - lengthFieldSize) {
+        std::fill(m_buffer.begin() + m_bufferLength, m_buffer.begin() + blockSize, 0);
+        processBlocks(m_buffer.data(), 1);
+        m_bufferLength = 0;
+    }
+    std::fill(m_buffer.begin() + m_bufferLength, m_buffer.begin() + blockSize - 8, 0);
+    storeBigEndian64(m_buffer.data() + blockSize - 8, bitLength);
+    processBlocks(m_buffer.data(), 1);
+
+    size_t hashLength = this->hashLength();
+    if (m_algorithm >= Algorithm::SHA384) {
+        for (size_t i = 0; i < hashLength / 8; ++i)
+            storeBigEndian64(output.data() + 8 * i, m_state64[i]);
+    } else {
+        for (size_t i = 0; i < hashLength / 4; ++i)
+            storeBigEndian32(output.data() + 4 * i, m_state32[i]);
+    }
+
+    reset();
+}
+
+} // namespace PAL
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace PAL {
+
+// SHA-1 and SHA-2 message digests computed natively for CryptoDigest.
+//
+// The SHA-1 and SHA-256 block functions use the SHA extensions of x86
+// processors when the CPU reports them, and the ARMv8 cryptography
+// extensions when the build targets them or, on Linux, when the CPU reports
+// them. SHA-224 shares the SHA-256 block function; SHA-384 and SHA-512 are
+// computed with portable code.
+class SHADigestJava {
+public:
+    enum class Algorithm : uint8_t {
+        SHA1,
+        SHA224,
+        SHA256,
+        SHA384,
+        SHA512
+    };
+
+    // Portable makes SHA-1 and SHA-256 use the portable block functions
+    // whatever the CPU supports, so that tests can check both.
+    enum class Implementation : uint8_t {
+        Default,
+        Portable
+    };
+
+    static constexpr size_t maximumHashLength = 64;
+
+    explicit SHADigestJava(Algorithm, Implementation = Implementation::Default);
+
+    void addBytes(std::span<const uint8_t>);
+
+    // Writes the digest of the bytes added so far to the first
+    // hashLength() bytes of output, and starts a new digest.
+    void computeHash(std::span<uint8_t, maximumHashLength> output);
+    size_t hashLength() const;
+
+    // Name of the SHA-1 and SHA-256 block functions selected for this CPU.
+    static const char* acceleration();
+
+private:
+    void reset();
+    void processBlocks(const uint8_t*, size_t blockCount);
+    size_t blockSize() const { return m_algorithm >= Algorithm::SHA384 ? 128 : 64; }
+
+    Algorithm m_algorithm;
+    Implementation m_implementation;
+    std::array<uint32_t, 8> m_state32;
+    std::array<uint64_t, 8> m_state64;
+    std::array<uint8_t, 128> m_buffer;
+    size_t m_bufferLength { 0 };
+    uint64_t m_length { 0 };
+};
+
+} // namespace PAL
@@ -55,6 +55,13 @@ elseif (APPLE)
     )
 endif ()
 
+if (USE_WEBCORE_IMAGE_DECODERS)
+    include(platform/ImageDecoders.cmake)
+    list(APPEND WebCore_SOURCES
+        platform/image-decoders/java/ImageBackingStoreJava.cpp
+    )
+endif ()
+
 #FIXME: Workaround
 list(APPEND WebCoreTestSupport_LIBRARIES ${SQLite3_LIBRARIES})
 
@@ -106,6 +113,7 @@ list(APPEND WebCore_PRIVATE_FRAMEWORK_HEADERS
     platform/java/PageSupplementJava.h
     platform/java/PlatformJavaClasses.h
     platform/java/PluginWidgetJava.h
+    platform/java/ScriptBytecodeCacheJava.h
     platform/mock/GeolocationClientMock.h
     platform/network/java/AuthenticationChallenge.h
     platform/network/java/CertificateInfo.h
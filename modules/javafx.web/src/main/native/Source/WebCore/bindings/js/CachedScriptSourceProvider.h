@@ -31,6 +31,10 @@
 #include "CachedScriptFetcher.h"
 #include <JavaScriptCore/SourceProvider.h>
 
+#if PLATFORM(JAVA)
+#include "ScriptBytecodeCacheJava.h"
+#endif
+
 namespace WebCore {
 
 class CachedScriptSourceProvider final : public JSC::SourceProvider, public CachedResourceClient {
@@ -55,15 +59,28 @@ public:
         return m_cachedScript->codeBlockHashConcurrently(startOffset, endOffset, kind, isModuleType() ? CachedScript::ShouldDecodeAsUTF8Only::Yes : CachedScript::ShouldDecodeAsUTF8Only::No);
     }
 
+#if PLATFORM(JAVA)
+    RefPtr<JSC::CachedBytecode> cachedBytecode() const final { return m_bytecodeCache.cachedBytecode(source()); }
+    void cacheBytecode(const JSC::BytecodeCacheGenerator& generator) const final { m_bytecodeCache.cacheBytecode(source(), generator); }
+    void updateCache(const JSC::UnlinkedFunctionExecutable* executable, const JSC::SourceCode&, JSC::CodeSpecializationKind kind, const JSC::UnlinkedFunctionCodeBlock* codeBlock) const final { m_bytecodeCache.updateCache(executable, kind, codeBlock); }
+    void commitCachedBytecode() const final { m_bytecodeCache.commitCachedBytecode(); }
+#endif
+
 private:
     CachedScriptSourceProvider(CachedScript* cachedScript, JSC::SourceProviderSourceType sourceType, Ref<CachedScriptFetcher>&& scriptFetcher)
         : SourceProvider(JSC::SourceOrigin { cachedScript->response().url(), WTF::move(scriptFetcher) }, String(cachedScript->response().url().string()), cachedScript->response().isRedirected() ? String(cachedScript->url().string()) : String(), cachedScript->requiresPrivacyProtections() ? JSC::SourceTaintedOrigin::KnownTainted : JSC::SourceTaintedOrigin::Untainted, TextPosition(), sourceType)
         , m_cachedScript(cachedScript)
+#if PLATFORM(JAVA)
+        , m_bytecodeCache(cachedScript->response().url())
+#endif
     {
         m_cachedScript->addClient(*this);
     }
 
     CachedResourceHandle<CachedScript> m_cachedScript;
+#if PLATFORM(JAVA)
+    mutable ScriptBytecodeCacheJava m_bytecodeCache;
+#endif
 };
 
 inline unsigned CachedScriptSourceProvider::hash() const
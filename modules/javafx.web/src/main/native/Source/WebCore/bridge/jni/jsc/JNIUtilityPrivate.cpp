@@ -380,6 +380,69 @@ jthrowable dispatchJNICall(int count, RootObject*, jobject obj, bool isStatic, J
     return ex;
 }
 
+/*
+ * Calls an instance method with unboxed arguments, bypassing
+ * Utilities.fwkInvokeWithContext. Must only be used for methods that
+ * allow it (see JavaMethod::allowsDirectInvocation). The result has
+ * the same shape as the one of dispatchJNICall().
+ */
+jthrowable dispatchDirectJNICall(jobject obj, JavaType returnType, jmethodID methodId, jvalue* args, jvalue& result)
+{
+    // Since obj is WeakGlobalRef, creating a localref to safeguard instance() from GC
+    JLObject jlinstance(obj, true);
+
+    if (!jlinstance) {
+        LOG_ERROR("Could not get javaInstance for %p in JNIUtilityPrivate::dispatchDirectJNICall", (jobject)jlinstance);
+        return NULL;
+    }
+
+    switch (returnType) {
+    case JavaTypeVoid:
+        callJNIMethodIDA<void>(jlinstance, methodId, args);
+        break;
+    case JavaTypeArray:
+    case JavaTypeObject:
+        result.l = callJNIMethodIDA<jobject>(jlinstance, methodId, args);
+        break;
+    case JavaTypeChar:
+        // Characters are returned as java.lang.Character, as dispatchJNICall() does.
+        result.c = callJNIMethodIDA<jchar>(jlinstance, methodId, args);
+        break;
+    case JavaTypeBoolean:
+        result.z = callJNIMethodIDA<jboolean>(jlinstance, methodId, args);
+        break;
+    case JavaTypeByte:
+        result.b = callJNIMethodIDA<jbyte>(jlinstance, methodId, args);
+        break;
+    case JavaTypeShort:
+        result.s = callJNIMethodIDA<jshort>(jlinstance, methodId, args);
+        break;
+    case JavaTypeInt:
+        result.i = callJNIMethodIDA<jint>(jlinstance, methodId, args);
+        break;
+    case JavaTypeLong:
+        result.j = callJNIMethodIDA<jlong>(jlinstance, methodId, args);
+        break;
+    case JavaTypeFloat:
+        result.f = callJNIMethodIDA<jfloat>(jlinstance, methodId, args);
+        break;
+    case JavaTypeDouble:
+        result.d = callJNIMethodIDA<jdouble>(jlinstance, methodId, args);
+        break;
+    case JavaTypeInvalid:
+        /* Nothing to do */
+        break;
+    }
+
+    JNIEnv* env = getJNIEnv();
+    jthrowable ex = env->ExceptionOccurred();
+    env->ExceptionClear();
+    if (!ex && returnType == JavaTypeChar) {
+        result.l = jvalueToJObject(result, JavaTypeChar);
+    }
+    return ex;
+}
+
 } // end of namespace Bindings
 
 } // end of namespace JSC
@@ -307,19 +307,32 @@ JSValue JavaInstance::invokeMethod(JSGlobalObject* globalObject, CallFrame* call
         return jsUndefined();
     }
 
-    Vector<jobject> jArgs(count);
+    Vector<jvalue> jValueArgs(count);
+    Vector<JavaType> jTypes(count);
 
     for (int i = 0; i < count; i++) {
         CString javaClassName = jMethod->parameterAt(i).utf8();
-        JavaType jtype = javaTypeFromClassName(javaClassName.data());
-        jvalue jarg = convertValueToJValue(globalObject, m_rootObject.get(),
-            callFrame->argument(i), jtype, javaClassName.data());
-        jArgs[i] = jvalueToJObject(jarg, jtype);
+        jTypes[i] = javaTypeFromClassName(javaClassName.data());
+        jValueArgs[i] = convertValueToJValue(globalObject, m_rootObject.get(),
+            callFrame->argument(i), jTypes[i], javaClassName.data());
 #if !PLATFORM(JAVA)
         LOG(LiveConnect, "JavaInstance::invokeMethod arg[%d] = %s", i, callFrame->argument(i).toString(globalObject)->value(globalObject).ascii().data());
 #endif
     }
 
+    // Methods of application classes are called directly with unboxed
+    // arguments; everything else, including calls whose arguments do not
+    // match the parameter types, goes through the reflective, access
+    // checked Utilities.fwkInvokeWithContext, which rejects them.
+    const bool directCall = jMethod->allowsDirectInvocation()
+        && jMethod->acceptsArguments(getJNIEnv(), jValueArgs.span().data());
+
+    Vector<jobject> jArgs(directCall ? 0 : count);
+    if (!directCall) {
+        for (int i = 0; i < count; i++)
+            jArgs[i] = jvalueToJObject(jValueArgs[i], jTypes[i]);
+    }
+
     jvalue result;
 
     // Try to use the JNI abstraction first, otherwise fall back to
@@ -342,14 +355,20 @@ JSValue JavaInstance::invokeMethod(JSGlobalObject* globalObject, CallFrame* call
             return jsUndefined();
         }
 
-        // const char *callingURL = 0; // FIXME, need to propagate calling URL to Java
-        jmethodID methodId = getMethodID(obj, jMethod->name().utf8().data(), jMethod->signature());
-
-        jthrowable ex = dispatchJNICall(callFrame->argumentCount(), rootObject,
-                                        obj, jMethod->isStatic(),
-                                        jMethod->returnType(), methodId,
-                                        jArgs.mutableSpan().data(), result,
-                                        accessControlContext());
+        jthrowable ex;
+        if (directCall) {
+            ex = dispatchDirectJNICall(obj, jMethod->returnType(), jMethod->methodID(),
+                                       jValueArgs.mutableSpan().data(), result);
+        } else {
+            // const char *callingURL = 0; // FIXME, need to propagate calling URL to Java
+            jmethodID methodId = getMethodID(obj, jMethod->name().utf8().data(), jMethod->signature());
+
+            ex = dispatchJNICall(callFrame->argumentCount(), rootObject,
+                                 obj, jMethod->isStatic(),
+                                 jMethod->returnType(), methodId,
+                                 jArgs.mutableSpan().data(), result,
+                                 accessControlContext());
+        }
         if (ex != NULL) {
             JSValue exceptionDescription
               = (JavaInstance::create(ex, rootObject, accessControlContext())
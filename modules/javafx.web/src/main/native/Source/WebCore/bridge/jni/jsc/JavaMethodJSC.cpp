@@ -66,6 +66,13 @@ JavaMethod::JavaMethod(JNIEnv* env, jobject aMethod)
             if (!parameterName)
                 parameterName = env->NewStringUTF("<Unknown>");
             m_parameters.append(JavaString(env, parameterName).impl());
+            // Object parameter classes are kept for the argument check of
+            // direct invocations, see acceptsArguments().
+            JavaType parameterType = javaTypeFromClassName(m_parameters.last().utf8().data());
+            if (parameterType == JavaTypeObject || parameterType == JavaTypeArray)
+                m_parameterClasses.append(JGClass(static_cast<jclass>(env->NewLocalRef(aParameter))));
+            else
+                m_parameterClasses.append(JGClass());
             env->DeleteLocalRef(aParameter);
             env->DeleteLocalRef(parameterName);
         }
@@ -77,6 +84,19 @@ JavaMethod::JavaMethod(JNIEnv* env, jobject aMethod)
 
     jint modifiers = callJNIMethod<jint>(aMethod, "getModifiers", "()I");
     m_isStatic = (modifiers & 0x8) != 0;
+
+    m_methodID = env->FromReflectedMethod(aMethod);
+
+    static JGClass utilityClass(env->FindClass("com/sun/webkit/Utilities"));
+    static jmethodID isDirectInvocationAllowedMID = env->GetStaticMethodID(utilityClass,
+        "fwkIsDirectInvocationAllowed", "(Ljava/lang/reflect/Method;)Z");
+    ASSERT(isDirectInvocationAllowedMID);
+    m_allowsDirectInvocation = m_methodID && !m_isStatic
+        && env->CallStaticBooleanMethod(utilityClass, isDirectInvocationAllowedMID, aMethod);
+    if (env->ExceptionCheck()) {
+        env->ExceptionClear();
+        m_allowsDirectInvocation = false;
+    }
 }
 
 JavaMethod::~JavaMethod()
@@ -85,6 +105,22 @@ JavaMethod::~JavaMethod()
         fastFree(m_signature);
 }
 
+/*
+ * Method.invoke rejects arguments that are not instances of the parameter
+ * types, and JNI calls must never be given such arguments. JavaScript
+ * values convert to objects of whatever class they hold (or to a String),
+ * so a direct invocation needs the same check.
+ */
+bool JavaMethod::acceptsArguments(JNIEnv* env, const jvalue* args) const
+{
+    for (size_t i = 0; i < m_parameterClasses.size(); i++) {
+        jclass parameterClass = m_parameterClasses[i];
+        if (parameterClass && args[i].l && !env->IsInstanceOf(args[i].l, parameterClass))
+            return false;
+    }
+    return true;
+}
+
 // JNI method signatures use '/' between components of a class name, but
 // we get '.' between components from the reflection API.
 static void appendClassName(StringBuilder& builder, const char* className)
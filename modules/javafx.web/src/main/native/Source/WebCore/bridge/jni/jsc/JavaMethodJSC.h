@@ -50,17 +50,28 @@ public:
     const char* signature() const;
     JavaType returnType() const { return m_returnType; }
     bool isStatic() const { return m_isStatic; }
+    jmethodID methodID() const { return m_methodID; }
+    // Whether the method may be called with a plain JNI call instead of
+    // going through the reflective, access checked Utilities.fwkInvokeWithContext.
+    // Decided once, when the method is looked up for its bound object.
+    bool allowsDirectInvocation() const { return m_allowsDirectInvocation; }
+    // Whether each object argument is null or an instance of its parameter
+    // type. Direct invocations must check this first.
+    bool acceptsArguments(JNIEnv*, const jvalue* args) const;
 
     // Method implementation
     int numParameters() const { return m_parameters.size(); }
 
 private:
     Vector<WTF::String> m_parameters;
+    Vector<JGClass> m_parameterClasses; // null for primitive parameters
     JavaString m_name;
     mutable char* m_signature;
     JavaString m_returnTypeClassName;
     JavaType m_returnType;
     bool m_isStatic;
+    jmethodID m_methodID;
+    bool m_allowsDirectInvocation;
 };
 
 } // namespace Bindings
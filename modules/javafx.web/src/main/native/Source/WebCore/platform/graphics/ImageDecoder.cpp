@@ -27,7 +27,7 @@
 #include "ImageDecoder.h"
 
 #include "ImageFrame.h"
-#if !PLATFORM(JAVA)
+#if !PLATFORM(JAVA) || USE(WEBCORE_IMAGE_DECODERS)
 #include "ScalableImageDecoder.h"
 #endif
 #include <wtf/NeverDestroyed.h>
@@ -122,6 +122,15 @@ RefPtr<ImageDecoder> ImageDecoder::create(FragmentedSharedBuffer& data, const St
         return imageDecoder;
     return ImageDecoderCG::create(data, alphaOption, gammaAndColorProfileOption);
 #elif PLATFORM(JAVA)
+#if USE(WEBCORE_IMAGE_DECODERS)
+    // Formats known to ScalableImageDecoder are decoded natively, the Java
+    // decoder remains the fallback for everything else. Wait for enough
+    // data to sniff the signature before settling on the Java decoder.
+    if (auto imageDecoder = ScalableImageDecoder::create(data, alphaOption, gammaAndColorProfileOption))
+        return imageDecoder;
+    if (data.size() < ScalableImageDecoder::lengthOfLongestSignature)
+        return nullptr;
+#endif
     return ImageDecoderJava::create(data, alphaOption, gammaAndColorProfileOption);
 #else
     return ScalableImageDecoder::create(data, alphaOption, gammaAndColorProfileOption);
@@ -32,8 +32,41 @@
 #include <wtf/SystemTracing.h>
 #include <wtf/text/TextStream.h>
 
+#if PLATFORM(JAVA)
+#include <wtf/NeverDestroyed.h>
+#include <wtf/NumberOfCores.h>
+#include <wtf/WorkerPool.h>
+#include <wtf/java/JavaEnv.h>
+#endif
+
 namespace WebCore {
 
+#if PLATFORM(JAVA)
+// All images share a small pool instead of starting a decoding thread per
+// image, which a page full of large images would otherwise do.
+static WorkerPool& decodingWorkerPool()
+{
+    static NeverDestroyed<Ref<WorkerPool>> pool(WorkerPool::create("org.webkit.ImageDecoder"_s,
+        std::clamp<unsigned>(WTF::numberOfProcessorCores() / 2, 1, 4), 5_s));
+    return pool.get();
+}
+
+// Queue depth and latency of the pool, across all images. Only used on the main thread.
+struct DecodingStatistics {
+    unsigned pendingFrames { 0 };
+    unsigned maximumPendingFrames { 0 };
+    unsigned decodedFrames { 0 };
+    Seconds decodingTime;
+    Seconds latency;
+};
+
+static DecodingStatistics& decodingStatistics()
+{
+    static NeverDestroyed<DecodingStatistics> statistics;
+    return statistics;
+}
+#endif
+
 Ref<ImageFrameWorkQueue> ImageFrameWorkQueue::create(BitmapImageSource& source)
 {
     return adoptRef(*new ImageFrameWorkQueue(source));
@@ -56,6 +89,9 @@ void ImageFrameWorkQueue::start()
 {
     ASSERT(isMainThread());
 
+#if PLATFORM(JAVA)
+    decodeNext();
+#else
     if (m_workQueue)
         return;
 
@@ -108,16 +144,89 @@ void ImageFrameWorkQueue::start()
         // Ensure destruction happens on creation thread.
         callOnMainThread([protectedThis = WTF::move(protectedThis), protectedWorkQueue = WTF::move(protectedWorkQueue), protectedSource = WTF::move(protectedSource)] () mutable { });
     });
+#endif
+}
+
+#if PLATFORM(JAVA)
+// Requests of an image are decoded one at a time, in order: the next one is
+// posted to the pool when the previous frame has been published on the main
+// thread, so a worker never blocks waiting for requests of a single image.
+void ImageFrameWorkQueue::decodeNext()
+{
+    ASSERT(isMainThread());
+
+    if (m_decodeQueue.isEmpty())
+        return;
+
+    // Without a decoder none of the pending frames can be decoded, cancel
+    // them rather than leave the first one waiting at the head of the queue.
+    RefPtr decoder = protectedSource()->decoder();
+    if (!decoder) {
+        stop();
+        return;
+    }
+
+    auto request = m_decodeQueue.first();
+    auto postingTime = MonotonicTime::now();
+    auto& statistics = decodingStatistics();
+    statistics.maximumPendingFrames = std::max(statistics.maximumPendingFrames, ++statistics.pendingFrames);
+    LOG(Images, "ImageFrameWorkQueue::%s - %p - url: %s. Decoding frame at index = %d, %u frames pending.", __FUNCTION__, this, protectedSource()->sourceUTF8().data(), request.index, statistics.pendingFrames);
+
+    decodingWorkerPool().postTask([protectedThis = Ref { *this }, protectedSource = this->protectedSource(), protectedDecoder = decoder.releaseNonNull(), request, generation = m_generation, postingTime] () mutable {
+        // ImageDecoderJava calls into Java from this thread.
+        WTF::AttachThreadAsDaemonToJavaEnv autoAttach;
+        TraceScope tracingScope(AsyncImageDecodeStart, AsyncImageDecodeEnd);
+
+        auto startingTime = MonotonicTime::now();
+        PlatformImagePtr platformImage = protectedDecoder->createFrameImageAtIndex(request.index, request.subsamplingLevel, request.options);
+        RefPtr nativeImage = NativeImage::create(WTF::move(platformImage));
+
+        auto minimumDecodingDuration = protectedThis->minimumDecodingDurationForTesting();
+        auto decodingDuration = MonotonicTime::now() - startingTime;
+        if (minimumDecodingDuration > decodingDuration)
+            sleep(minimumDecodingDuration - decodingDuration);
+
+        // Release the references on the main thread, the decoder must not be destroyed after this thread is detached.
+        callOnMainThread([protectedThis = WTF::move(protectedThis), protectedSource = WTF::move(protectedSource), protectedDecoder = WTF::move(protectedDecoder), request, generation, postingTime, decodingDuration, nativeImage = WTF::move(nativeImage)] () mutable {
+            auto& statistics = decodingStatistics();
+            auto latency = MonotonicTime::now() - postingTime;
+            statistics.pendingFrames--;
+            statistics.decodedFrames++;
+            statistics.decodingTime += decodingDuration;
+            statistics.latency += latency;
+            LOG(Images, "ImageFrameWorkQueue::%s - %p - url: %s. Frame at index = %d decoded in %.1f ms, published after %.1f ms.", __FUNCTION__, protectedThis.ptr(), protectedSource->sourceUTF8().data(), request.index, decodingDuration.milliseconds(), latency.milliseconds());
+
+            // The queue may have been stopped or given another source before the frame was decoded.
+            if (generation != protectedThis->m_generation || protectedSource.ptr() != protectedThis->m_source.get()) {
+                LOG(Images, "ImageFrameWorkQueue::%s - %p - url: %s. Decoding was cancelled at index = %d.", __FUNCTION__, protectedThis.ptr(), protectedSource->sourceUTF8().data(), request.index);
+                return;
+            }
+
+            if (protectedThis->decodeQueue().isEmpty() || protectedThis->decodeQueue().first() != request)
+                return;
+
+            protectedThis->decodeQueue().removeFirst();
+            protectedSource->imageFrameDecodeAtIndexHasFinished(request.index, request.subsamplingLevel, request.animatingState, request.options, WTF::move(nativeImage));
+            protectedThis->decodeNext();
+        });
+    });
 }
+#endif
 
 void ImageFrameWorkQueue::dispatch(const Request& request)
 {
     ASSERT(isMainThread());
 
+#if PLATFORM(JAVA)
+    decodeQueue().append(request);
+    if (decodeQueue().size() == 1)
+        start();
+#else
     requestQueue().enqueue(request);
     decodeQueue().append(request);
 
     start();
+#endif
 }
 
 void ImageFrameWorkQueue::stop()
@@ -138,6 +247,9 @@ void ImageFrameWorkQueue::stop()
 
     m_decodeQueue.clear();
     m_workQueue = nullptr;
+#if PLATFORM(JAVA)
+    ++m_generation;
+#endif
 }
 
 bool ImageFrameWorkQueue::isPendingDecodingAtIndex(unsigned index, SubsamplingLevel subsamplingLevel, const DecodingOptions& options) const
@@ -156,6 +268,16 @@ void ImageFrameWorkQueue::dump(TextStream& ts) const
         return;
 
     ts.dumpProperty("pending-for-decoding"_s, m_decodeQueue.size());
+
+#if PLATFORM(JAVA)
+    auto& statistics = decodingStatistics();
+    ts.dumpProperty("pending-in-decoding-pool"_s, statistics.pendingFrames);
+    ts.dumpProperty("maximum-pending-in-decoding-pool"_s, statistics.maximumPendingFrames);
+    if (statistics.decodedFrames) {
+        ts.dumpProperty("average-decoding-time-ms"_s, statistics.decodingTime.milliseconds() / statistics.decodedFrames);
+        ts.dumpProperty("average-decoding-latency-ms"_s, statistics.latency.milliseconds() / statistics.decodedFrames);
+    }
+#endif
 }
 
 } // namespace WebCore
@@ -71,11 +71,19 @@ private:
 
     Seconds minimumDecodingDurationForTesting() const { return m_minimumDecodingDurationForTesting; }
 
+#if PLATFORM(JAVA)
+    void decodeNext();
+#endif
+
     ThreadSafeWeakPtr<BitmapImageSource> m_source;
 
     RefPtr<RequestQueue> m_requestQueue;
     DecodeQueue m_decodeQueue;
     RefPtr<WorkQueue> m_workQueue;
+#if PLATFORM(JAVA)
+    // Bumped by stop() so that frames decoded for a cancelled queue are dropped.
+    unsigned m_generation { 0 };
+#endif
 
     Seconds m_minimumDecodingDurationForTesting;
 };
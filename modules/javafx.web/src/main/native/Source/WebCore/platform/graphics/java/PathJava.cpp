@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -133,7 +133,8 @@ PathJava::PathJava(RefPtr<RQRef>&& platformPath, RefPtr<PathStream>&& elementsSt
 
 Ref<PathImpl> PathJava::copy() const
 {
-    auto platformPathCopy = createEmptyPath();
+    flushPendingSegments();
+    auto platformPathCopy = copyPath(m_platformPath);
 
     auto elementsStream = m_elementsStream ? RefPtr<PathImpl> { m_elementsStream->copy() } : nullptr;
 
@@ -142,9 +143,49 @@ Ref<PathImpl> PathJava::copy() const
 
 PlatformPathPtr PathJava::platformPath() const
 {
+    flushPendingSegments();
     return m_platformPath.get();
 }
 
+void PathJava::appendPendingSegment(jint type, std::initializer_list<FloatPoint> points)
+{
+    m_pendingSegments.append(static_cast<float>(type));
+    for (auto& point : points) {
+        m_pendingSegments.append(point.x());
+        m_pendingSegments.append(point.y());
+    }
+}
+
+/*
+ * Sends the accumulated move/line/curve/close segments to the Java path
+ * in a single call. Must be called before any other access to the Java
+ * path so that the segments are applied in order.
+ */
+void PathJava::flushPendingSegments() const
+{
+    if (m_pendingSegments.isEmpty()) {
+        return;
+    }
+    ASSERT(m_platformPath);
+
+    JNIEnv* env = WTF::GetJavaEnv();
+
+    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addSegments",
+        "([F)V");
+    ASSERT(mid);
+
+    JLocalRef<jfloatArray> segments(env->NewFloatArray(m_pendingSegments.size()));
+    if (!segments) {
+        WTF::CheckAndClearException(env);
+        return;
+    }
+    env->SetFloatArrayRegion(segments, 0, m_pendingSegments.size(), m_pendingSegments.span().data());
+    env->CallVoidMethod(*m_platformPath, mid, (jfloatArray)segments);
+    WTF::CheckAndClearException(env);
+
+    m_pendingSegments.clear();
+}
+
 bool PathJava::definitelyEqual(const PathImpl& otherImpl) const
 {
     RefPtr otherAsPathJava = dynamicDowncast<PathJava>(otherImpl);
@@ -162,61 +203,35 @@ void PathJava::add(PathContinuousRoundedRect continuousRoundedRect)
 
 void PathJava::add(PathMoveTo moveto)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "moveTo",
-        "(DD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid, (jdouble)moveto.point.x(), (jdouble)moveto.point.y());
-    WTF::CheckAndClearException(env);
+    if (m_elementsStream) {
+        m_elementsStream->add(moveto);
+    }
+    appendPendingSegment(com_sun_webkit_graphics_WCPathIterator_SEG_MOVETO, { moveto.point });
 }
 
 void PathJava::add(PathLineTo lineTo)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addLineTo",
-        "(DD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid, (jdouble)lineTo.point.x(), (jdouble)lineTo.point.y());
-    WTF::CheckAndClearException(env);
+    if (m_elementsStream) {
+        m_elementsStream->add(lineTo);
+    }
+    appendPendingSegment(com_sun_webkit_graphics_WCPathIterator_SEG_LINETO, { lineTo.point });
 }
 
 void PathJava::add(PathQuadCurveTo quadTo)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addQuadCurveTo",
-                                            "(DDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid, (jdouble)quadTo.controlPoint.x(), (jdouble)quadTo.controlPoint.y(), (jdouble)quadTo.endPoint.x(), (jdouble)quadTo.endPoint.y());
-    WTF::CheckAndClearException(env);
+    if (m_elementsStream) {
+        m_elementsStream->add(quadTo);
+    }
+    appendPendingSegment(com_sun_webkit_graphics_WCPathIterator_SEG_QUADTO, { quadTo.controlPoint, quadTo.endPoint });
 }
 
 void PathJava::add(PathBezierCurveTo bezierTo)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "addBezierCurveTo", "(DDDDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid,
-                        (jdouble)bezierTo.controlPoint1.x(), (jdouble)bezierTo.controlPoint1.y(),
-                        (jdouble)bezierTo.controlPoint2.x(), (jdouble)bezierTo.controlPoint2.y(),
-                        (jdouble)bezierTo.endPoint.x(), (jdouble)bezierTo.endPoint.y());
-    WTF::CheckAndClearException(env);
+    if (m_elementsStream) {
+        m_elementsStream->add(bezierTo);
+    }
+    appendPendingSegment(com_sun_webkit_graphics_WCPathIterator_SEG_CUBICTO,
+        { bezierTo.controlPoint1, bezierTo.controlPoint2, bezierTo.endPoint });
 }
 
 static inline float areaOfTriangleFormedByPoints(const FloatPoint& p1, const FloatPoint& p2, const FloatPoint& p3)
@@ -227,6 +242,10 @@ static inline float areaOfTriangleFormedByPoints(const FloatPoint& p1, const Flo
 void PathJava::add(PathArcTo arcTo)
 {
     ASSERT(m_platformPath);
+    if (m_elementsStream) {
+        m_elementsStream->add(arcTo);
+    }
+    flushPendingSegments();
 
     JNIEnv* env = WTF::GetJavaEnv();
 
@@ -243,6 +262,10 @@ void PathJava::add(PathArcTo arcTo)
 void PathJava::add(PathArc arc)
 {
     ASSERT(m_platformPath);
+    if (m_elementsStream) {
+        m_elementsStream->add(arc);
+    }
+    flushPendingSegments();
     bool clockwise = false;
     const RotationDirection direction = arc.direction;
     if (direction == RotationDirection::Counterclockwise) {
@@ -264,17 +287,23 @@ void PathJava::add(PathArc arc)
 }
 void PathJava::add(PathClosedArc closedArc)
 {
+    m_elementsStream = nullptr;
     notImplemented();
 }
 
 void PathJava::add(PathEllipse ellipse)
 {
+    m_elementsStream = nullptr;
     notImplemented();
 }
 
 void PathJava::add(PathEllipseInRect ellipseInRect)
 {
     ASSERT(m_platformPath);
+    if (m_elementsStream) {
+        m_elementsStream->add(ellipseInRect);
+    }
+    flushPendingSegments();
 
     JNIEnv* env = WTF::GetJavaEnv();
     static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addEllipse",
@@ -290,6 +319,10 @@ void PathJava::add(PathEllipseInRect ellipseInRect)
 void PathJava::add(PathRect rect)
 {
     ASSERT(m_platformPath);
+    if (m_elementsStream) {
+        m_elementsStream->add(rect);
+    }
+    flushPendingSegments();
 
     JNIEnv* env = WTF::GetJavaEnv();
 
@@ -308,22 +341,17 @@ void PathJava::add(PathRoundedRect roundedRect)
         addSegment(segment);
 }
 
-void PathJava::add(PathCloseSubpath)
+void PathJava::add(PathCloseSubpath closeSubpath)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "closeSubpath", "()V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid);
-    WTF::CheckAndClearException(env);
+    if (m_elementsStream) {
+        m_elementsStream->add(closeSubpath);
+    }
+    appendPendingSegment(com_sun_webkit_graphics_WCPathIterator_SEG_CLOSE, { });
 }
 
 void PathJava::addPath(const PathJava& path, const AffineTransform& transform)
 {
+    m_elementsStream = nullptr;
     notImplemented();
 }
 
@@ -362,7 +390,12 @@ bool PathJava::applyElements(const PathElementApplier& applier) const
 
 bool PathJava::isEmpty() const
 {
+    if (m_elementsStream) {
+        return m_elementsStream->segments().isEmpty();
+    }
+
     ASSERT(m_platformPath);
+    flushPendingSegments();
 
     JNIEnv* env = WTF::GetJavaEnv();
 
@@ -386,6 +419,10 @@ FloatPoint PathJava::currentPoint() const
 bool PathJava::transform(const AffineTransform& transform)
 {
     ASSERT(m_platformPath);
+    flushPendingSegments();
+    if (m_elementsStream && !m_elementsStream->transform(transform)) {
+        m_elementsStream = nullptr;
+    }
 
     JNIEnv* env = WTF::GetJavaEnv();
 
@@ -401,12 +438,165 @@ bool PathJava::transform(const AffineTransform& transform)
     return true;
 }
 
+/*
+ * The crossing counts below are those of com.sun.javafx.geom.Shape, which
+ * the Java path uses for contains(), so both give the same answer: +1 for
+ * every crossing of the ray to the right of (px, py) where y increases,
+ * -1 where it decreases and nothing where the point lies on the segment.
+ * Curves are subdivided until they are clear of the ray, not flattened.
+ */
+static int pointCrossingsForLine(float px, float py, float x0, float y0, float x1, float y1)
+{
+    if (py < y0 && py < y1)
+        return 0;
+    if (py >= y0 && py >= y1)
+        return 0;
+    if (px >= x0 && px >= x1)
+        return 0;
+    if (px < x0 && px < x1)
+        return (y0 < y1) ? 1 : -1;
+    float xintercept = x0 + (py - y0) * (x1 - x0) / (y1 - y0);
+    if (px >= xintercept)
+        return 0;
+    return (y0 < y1) ? 1 : -1;
+}
+
+static int pointCrossingsForQuad(float px, float py, float x0, float y0, float xc, float yc, float x1, float y1, int level)
+{
+    if (py < y0 && py < yc && py < y1)
+        return 0;
+    if (py >= y0 && py >= yc && py >= y1)
+        return 0;
+    if (px >= x0 && px >= xc && px >= x1)
+        return 0;
+    if (px < x0 && px < xc && px < x1) {
+        if (py >= y0) {
+            if (py < y1)
+                return 1;
+        } else if (py >= y1)
+            return -1;
+        return 0;
+    }
+    if (level > 52)
+        return pointCrossingsForLine(px, py, x0, y0, x1, y1);
+    float x0c = (x0 + xc) / 2;
+    float y0c = (y0 + yc) / 2;
+    float xc1 = (xc + x1) / 2;
+    float yc1 = (yc + y1) / 2;
+    xc = (x0c + xc1) / 2;
+    yc = (y0c + yc1) / 2;
+    if (std::isnan(xc) || std::isnan(yc))
+        return 0;
+    return pointCrossingsForQuad(px, py, x0, y0, x0c, y0c, xc, yc, level + 1)
+        + pointCrossingsForQuad(px, py, xc, yc, xc1, yc1, x1, y1, level + 1);
+}
+
+static int pointCrossingsForCubic(float px, float py, float x0, float y0, float xc0, float yc0, float xc1, float yc1, float x1, float y1, int level)
+{
+    if (py < y0 && py < yc0 && py < yc1 && py < y1)
+        return 0;
+    if (py >= y0 && py >= yc0 && py >= yc1 && py >= y1)
+        return 0;
+    if (px >= x0 && px >= xc0 && px >= xc1 && px >= x1)
+        return 0;
+    if (px < x0 && px < xc0 && px < xc1 && px < x1) {
+        if (py >= y0) {
+            if (py < y1)
+                return 1;
+        } else if (py >= y1)
+            return -1;
+        return 0;
+    }
+    if (level > 52)
+        return pointCrossingsForLine(px, py, x0, y0, x1, y1);
+    float xmid = (xc0 + xc1) / 2;
+    float ymid = (yc0 + yc1) / 2;
+    xc0 = (x0 + xc0) / 2;
+    yc0 = (y0 + yc0) / 2;
+    xc1 = (xc1 + x1) / 2;
+    yc1 = (yc1 + y1) / 2;
+    float xc0m = (xc0 + xmid) / 2;
+    float yc0m = (yc0 + ymid) / 2;
+    float xmc1 = (xmid + xc1) / 2;
+    float ymc1 = (ymid + yc1) / 2;
+    xmid = (xc0m + xmc1) / 2;
+    ymid = (yc0m + ymc1) / 2;
+    if (std::isnan(xmid) || std::isnan(ymid))
+        return 0;
+    return pointCrossingsForCubic(px, py, x0, y0, xc0, yc0, xc0m, yc0m, xmid, ymid, level + 1)
+        + pointCrossingsForCubic(px, py, xmid, ymid, xmc1, ymc1, xc1, yc1, x1, y1, level + 1);
+}
+
+/*
+ * Computes the winding number of the path around the point, as
+ * Shape.pointCrossingsForPath does. Every subpath is implicitly closed,
+ * as it is when the path is filled. Returns std::nullopt when the path
+ * has segments that can't be decomposed into elements (e.g. arcs).
+ */
+static std::optional<int> windingNumber(const PathStream& stream, const FloatPoint& point)
+{
+    float px = point.x();
+    float py = point.y();
+    int crossings = 0;
+    FloatPoint current;
+    FloatPoint subpathStart;
+    auto closeSubpath = [&] {
+        if (current.y() != subpathStart.y())
+            crossings += pointCrossingsForLine(px, py, current.x(), current.y(), subpathStart.x(), subpathStart.y());
+        current = subpathStart;
+    };
+    bool applied = stream.applyElements([&](const PathElement& element) {
+        switch (element.type) {
+        case PathElement::Type::MoveToPoint:
+            closeSubpath();
+            current = subpathStart = element.points[0];
+            break;
+        case PathElement::Type::AddLineToPoint: {
+            const FloatPoint& p1 = element.points[0];
+            crossings += pointCrossingsForLine(px, py, current.x(), current.y(), p1.x(), p1.y());
+            current = p1;
+            break;
+        }
+        case PathElement::Type::AddQuadCurveToPoint: {
+            const FloatPoint& c = element.points[0];
+            const FloatPoint& p1 = element.points[1];
+            crossings += pointCrossingsForQuad(px, py, current.x(), current.y(), c.x(), c.y(), p1.x(), p1.y(), 0);
+            current = p1;
+            break;
+        }
+        case PathElement::Type::AddCurveToPoint: {
+            const FloatPoint& c0 = element.points[0];
+            const FloatPoint& c1 = element.points[1];
+            const FloatPoint& p1 = element.points[2];
+            crossings += pointCrossingsForCubic(px, py, current.x(), current.y(), c0.x(), c0.y(), c1.x(), c1.y(), p1.x(), p1.y(), 0);
+            current = p1;
+            break;
+        }
+        case PathElement::Type::CloseSubpath:
+            closeSubpath();
+            break;
+        }
+    });
+    if (!applied) {
+        return std::nullopt;
+    }
+    closeSubpath();
+    return crossings;
+}
+
 bool PathJava::contains(const FloatPoint &point, WindRule rule) const
 {
     if (isEmpty() || !std::isfinite(point.x()) || !std::isfinite(point.y()))
         return false;
 
+    if (m_elementsStream) {
+        if (auto winding = windingNumber(*m_elementsStream, point)) {
+            return rule == WindRule::EvenOdd ? (*winding & 1) : *winding != 0;
+        }
+    }
+
     ASSERT(m_platformPath);
+    flushPendingSegments();
 
     JNIEnv* env = WTF::GetJavaEnv();
 
@@ -444,6 +634,8 @@ bool PathJava::strokeContains(const FloatPoint& p, const Function<void(GraphicsC
 
     gc.restore();
 
+    flushPendingSegments();
+
     JNIEnv* env = WTF::GetJavaEnv();
 
     static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "strokeContains",
@@ -474,48 +666,59 @@ FloatRect PathJava::boundingRect() const
     return strokeBoundingRect(nullptr);
 }
 
-FloatRect PathJava::strokeBoundingRect(const Function<void(GraphicsContext&)>& strokeStyleApplier) const
+static FloatRect platformPathBounds(RQRef& platformPath)
 {
-    ASSERT(m_platformPath);
-
     JNIEnv* env = WTF::GetJavaEnv();
 
     static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "getBounds",
             "()Lcom/sun/webkit/graphics/WCRectangle;");
     ASSERT(mid);
 
-    JLObject rect(env->CallObjectMethod(*m_platformPath, mid));
+    JLObject rect(env->CallObjectMethod(platformPath, mid));
     WTF::CheckAndClearException(env);
-    if (rect) {
-        static jfieldID rectxFID = env->GetFieldID(PG_GetRectangleClass(env), "x", "F");
-        ASSERT(rectxFID);
-        static jfieldID rectyFID = env->GetFieldID(PG_GetRectangleClass(env), "y", "F");
-        ASSERT(rectyFID);
-        static jfieldID rectwFID = env->GetFieldID(PG_GetRectangleClass(env), "w", "F");
-        ASSERT(rectwFID);
-        static jfieldID recthFID = env->GetFieldID(PG_GetRectangleClass(env), "h", "F");
-        ASSERT(recthFID);
-
-        FloatRect bounds(
-            float(env->GetFloatField(rect, rectxFID)),
-            float(env->GetFloatField(rect, rectyFID)),
-            float(env->GetFloatField(rect, rectwFID)),
-            float(env->GetFloatField(rect, recthFID)));
-        WTF::CheckAndClearException(env);
+    if (!rect) {
+        return FloatRect();
+    }
 
-        float thickness;
-        if (strokeStyleApplier) {
-            GraphicsContext& gc = scratchContext();
-            gc.save();
-            strokeStyleApplier(gc);
-            thickness = gc.strokeThickness();
-            gc.restore();
-            bounds.inflate(thickness / 2);
-        }
-        return bounds;
+    static jfieldID rectxFID = env->GetFieldID(PG_GetRectangleClass(env), "x", "F");
+    ASSERT(rectxFID);
+    static jfieldID rectyFID = env->GetFieldID(PG_GetRectangleClass(env), "y", "F");
+    ASSERT(rectyFID);
+    static jfieldID rectwFID = env->GetFieldID(PG_GetRectangleClass(env), "w", "F");
+    ASSERT(rectwFID);
+    static jfieldID recthFID = env->GetFieldID(PG_GetRectangleClass(env), "h", "F");
+    ASSERT(recthFID);
+
+    FloatRect bounds(
+        float(env->GetFloatField(rect, rectxFID)),
+        float(env->GetFloatField(rect, rectyFID)),
+        float(env->GetFloatField(rect, rectwFID)),
+        float(env->GetFloatField(rect, recthFID)));
+    WTF::CheckAndClearException(env);
+    return bounds;
+}
+
+FloatRect PathJava::strokeBoundingRect(const Function<void(GraphicsContext&)>& strokeStyleApplier) const
+{
+    ASSERT(m_platformPath);
+
+    FloatRect bounds;
+    if (m_elementsStream) {
+        bounds = m_elementsStream->boundingRect();
     } else {
-        return FloatRect();
+        flushPendingSegments();
+        bounds = platformPathBounds(*m_platformPath);
+    }
+
+    if (strokeStyleApplier) {
+        GraphicsContext& gc = scratchContext();
+        gc.save();
+        strokeStyleApplier(gc);
+        float thickness = gc.strokeThickness();
+        gc.restore();
+        bounds.inflate(thickness / 2);
     }
+    return bounds;
 }
 
 } // namespace WebCore
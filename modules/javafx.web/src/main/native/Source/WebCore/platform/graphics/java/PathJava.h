@@ -82,11 +82,19 @@ private:
 
     FloatPoint currentPoint() const final;
 
+    void appendPendingSegment(jint type, std::initializer_list<FloatPoint>);
+    void flushPendingSegments() const;
+
     FloatRect fastBoundingRect() const final;
     FloatRect boundingRect() const final;
 
     RefPtr<RQRef> m_platformPath;
+    // Native copy of the path, used for bounds and hit testing. It is
+    // null when the path was modified in a way PathStream can't follow.
     RefPtr<PathStream> m_elementsStream;
+    // Segments not yet sent to the Java path, encoded as the segment
+    // type (WCPathIterator.SEG_*) followed by its points.
+    mutable Vector<float> m_pendingSegments;
 };
 
 } // namespace WebCore
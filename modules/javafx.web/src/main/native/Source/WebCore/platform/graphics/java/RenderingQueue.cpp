@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -45,6 +45,62 @@ static Addr2ByteBuffer& getAddr2ByteBuffer()
     return container.get();
 }
 
+/*
+ * ByteBuffers released by Java are kept here and reused by the next
+ * RenderingQueue::freeSpace() call, so steady-state painting does not
+ * allocate. The buffers are taken in RenderingQueue::freeSpace() and
+ * returned in twkRelease(); both run on the Event thread, so the pool
+ * needs no synchronization.
+ *
+ * The pool is process-wide and never shrinks on its own. recycle() bounds
+ * it: it keeps at most MAX_POOLED_BUFFERS buffers and frees any other
+ * released buffer, so the pool holds at most MAX_POOLED_BUFFERS times the
+ * largest buffer a queue asked for. Hits and misses are reported to Java
+ * by WCRenderQueue.getBufferPoolCounts().
+ */
+class ByteBufferPool {
+public:
+    static const size_t MAX_POOLED_BUFFERS = 2 * RenderingQueue::MAX_BUFFER_COUNT;
+
+    RefPtr<ByteBuffer> take(int capacity)
+    {
+        for (size_t i = m_buffers.size(); i > 0; --i) {
+            if (m_buffers[i - 1]->capacity() == capacity) {
+                ++m_hits;
+                RefPtr<ByteBuffer> buffer = WTFMove(m_buffers[i - 1]);
+                m_buffers.remove(i - 1);
+                return buffer;
+            }
+        }
+        ++m_misses;
+        return ByteBuffer::create(capacity);
+    }
+
+    void recycle(RefPtr<ByteBuffer>&& buffer)
+    {
+        // Drop the buffer if it is shared with somebody else.
+        if (!buffer || !buffer->hasOneRef() || m_buffers.size() >= MAX_POOLED_BUFFERS) {
+            return;
+        }
+        buffer->reset();
+        m_buffers.append(WTFMove(buffer));
+    }
+
+    unsigned hits() const { return m_hits; }
+    unsigned misses() const { return m_misses; }
+
+private:
+    Vector<RefPtr<ByteBuffer>> m_buffers;
+    unsigned m_hits { 0 };
+    unsigned m_misses { 0 };
+};
+
+static ByteBufferPool& getByteBufferPool()
+{
+    static NeverDestroyed<ByteBufferPool> pool;
+    return pool.get();
+}
+
 /*static*/
 RefPtr<RenderingQueue> RenderingQueue::create(
     const JLObject &jRQ,
@@ -65,7 +121,7 @@ RenderingQueue& RenderingQueue::freeSpace(int size) {
         }
     }
     if (!m_buffer) {
-        m_buffer = RefPtr<ByteBuffer>(ByteBuffer::create(std::max(m_capacity, size)));
+        m_buffer = getByteBufferPool().take(std::max(m_capacity, size));
     }
     return *this;
 }
@@ -106,7 +162,7 @@ RenderingQueue& RenderingQueue::flushBuffer() {
     JNIEnv* env = WTF::GetJavaEnv();
 
     static jmethodID midFwkAddBuffer = env->GetMethodID(PG_GetRenderQueueClass(env),
-        "fwkAddBuffer", "(Ljava/nio/ByteBuffer;)V");
+        "fwkAddBuffer", "(Ljava/nio/ByteBuffer;I)V");
     ASSERT(midFwkAddBuffer);
 
     Addr2ByteBuffer &a2bb = getAddr2ByteBuffer();
@@ -114,7 +170,8 @@ RenderingQueue& RenderingQueue::flushBuffer() {
     env->CallVoidMethod(
         getWCRenderingQueue(),
         midFwkAddBuffer,
-        (jobject)(m_buffer->createDirectByteBuffer(env)));
+        (jobject)(m_buffer->createDirectByteBuffer(env)),
+        (jint)m_buffer->position());
     WTF::CheckAndClearException(env);
 
     m_buffer = nullptr;
@@ -135,11 +192,30 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_graphics_WCRenderQueue_twkRelease
      * it should be thread safe.
      */
     Addr2ByteBuffer& a2bb = getAddr2ByteBuffer();
+    ByteBufferPool& pool = getByteBufferPool();
     for (int i = 0; i < env->GetArrayLength(bufs); ++i) {
         char *key = (char *)env->GetDirectBufferAddress(
             JLObject(env->GetObjectArrayElement(bufs, i)));
         if (key != 0) {
-            a2bb.remove(key);
+            pool.recycle(a2bb.take(key));
         }
     }
 }
+
+JNIEXPORT jlongArray JNICALL Java_com_sun_webkit_graphics_WCRenderQueue_twkGetBufferPoolCounts
+    (JNIEnv* env, jclass)
+{
+    using namespace WebCore;
+    ByteBufferPool& pool = getByteBufferPool();
+    jlong counts[] = {
+        static_cast<jlong>(pool.hits()),
+        static_cast<jlong>(pool.misses())
+    };
+
+    jlongArray result = env->NewLongArray(2);
+    if (WTF::CheckAndClearException(env) || !result) {
+        return nullptr;
+    }
+    env->SetLongArrayRegion(result, 0, 2, counts);
+    return result;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2017, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -44,15 +44,31 @@ public:
         return adoptRef(new ByteBuffer(capacity));
     }
 
+    // The java.nio wrapper spans the whole native block and is kept for
+    // the lifetime of the ByteBuffer, so a recycled buffer is handed to
+    // Java again without a new NewDirectByteBuffer call. The number of
+    // valid bytes is passed to Java separately, see RenderingQueue::flushBuffer.
     JLObject createDirectByteBuffer(JNIEnv* env) {
         ASSERT(!isEmpty());
-        JLObject ret(env->NewDirectByteBuffer(m_buffer, m_position));
-        m_nio_holder = ret;
-        return ret;
+        if (!static_cast<jobject>(m_nio_holder)) {
+            m_nio_holder = JLObject(env->NewDirectByteBuffer(m_buffer, m_capacity));
+        }
+        return JLObject(m_nio_holder);
     }
 
     char* bufferAddress() { return m_buffer; }
 
+    int capacity() const { return m_capacity; }
+
+    int position() const { return m_position; }
+
+    // Makes the buffer ready for reuse. Drops the resources referenced
+    // by the previous content, so it has to be called on the Event thread.
+    void reset() {
+        m_position = 0;
+        m_refList.clear();
+    }
+
     void putRef(RefPtr<RQRef> ref) {
         ASSERT(m_position + sizeof(jint) <= m_capacity);
         RefPtr<RQRef> repeatable_use_holder(ref);
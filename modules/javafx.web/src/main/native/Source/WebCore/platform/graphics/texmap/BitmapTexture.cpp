@@ -23,7 +23,9 @@
 #include "BitmapTexture.h"
 
 #if USE(TEXTURE_MAPPER)
-#if !PLATFORM(JAVA)
+#if PLATFORM(JAVA)
+#include "BitmapTextureJava.h"
+#else
 #include "GLContext.h"
 #endif
 #include "GraphicsContext.h"
@@ -83,6 +85,18 @@ GLenum depthBufferFormat()
     return GL_DEPTH_COMPONENT16;
 }
 
+#if PLATFORM(JAVA)
+static BitmapTextureJava::Flags javaTextureFlags(OptionSet<BitmapTexture::Flags> flags)
+{
+    BitmapTextureJava::Flags javaFlags = BitmapTextureJava::NoFlag;
+    if (flags.contains(BitmapTexture::Flags::SupportsAlpha))
+        javaFlags |= BitmapTextureJava::SupportsAlpha;
+    if (flags.contains(BitmapTexture::Flags::DepthBuffer))
+        javaFlags |= BitmapTextureJava::DepthBuffer;
+    return javaFlags;
+}
+#endif
+
 BitmapTexture::BitmapTexture(const IntSize& size, OptionSet<Flags> flags)
     : m_flags(flags)
     , m_size(size)
@@ -124,6 +138,9 @@ BitmapTexture::BitmapTexture(const IntSize& size, OptionSet<Flags> flags)
     allocateTexture();
 
     glBindTexture(GL_TEXTURE_2D, boundTexture);
+    #else
+    m_javaTexture = BitmapTextureJava::create();
+    m_javaTexture->reset(m_size, javaTextureFlags(m_flags));
     #endif
 }
 
@@ -208,6 +225,9 @@ void BitmapTexture::swapTexture(BitmapTexture& other)
 #endif
     std::swap(m_flags, other.m_flags);
     std::swap(m_id, other.m_id);
+#if PLATFORM(JAVA)
+    std::swap(m_javaTexture, other.m_javaTexture);
+#endif
 
     // Take the pixel format from the source texture. The source texture
     // (going back to the pool) is reset to the default pixel format.
@@ -253,6 +273,14 @@ void BitmapTexture::reset(const IntSize& size, OptionSet<Flags> flags)
 
     GLint boundTexture = 0;
     glGetIntegerv(GL_TEXTURE_BINDING_2D, &boundTexture);
+#else
+    m_flags = flags;
+    m_pixelFormat = PixelFormat::RGBA8;
+    m_filterOperation = nullptr;
+    m_size = size;
+    // A texture taken back from the pool keeps its image buffer when the
+    // size is unchanged, BitmapTextureJava only clears it.
+    m_javaTexture->reset(size, javaTextureFlags(flags));
 #endif
 
 #if USE(GBM)
@@ -350,6 +378,11 @@ void BitmapTexture::updateContents(const void* srcData, const IntRect& targetRec
         glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
         glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
     }
+#else
+    // The Java texture takes premultiplied BGRA rows, which is what the
+    // NativeImage and GraphicsLayer uploads hand over.
+    ASSERT(pixelFormat == PixelFormat::BGRA8);
+    m_javaTexture->updateContents(srcData, targetRect, sourceOffset, bytesPerLine);
 #endif
 }
 
@@ -369,6 +402,8 @@ void BitmapTexture::updateContents(NativeImage* frameImage, const IntRect& targe
     SkPixmap pixmap;
     if (surface->peekPixels(&pixmap))
         updateContents(pixmap.addr(), targetRect, offset, pixmap.rowBytes(), PixelFormat::BGRA8);
+#elif PLATFORM(JAVA)
+    m_javaTexture->updateContents(frameImage, targetRect, offset);
 #else
     UNUSED_PARAM(targetRect);
     UNUSED_PARAM(offset);
@@ -45,6 +45,9 @@ typedef void *EGLImage;
 
 namespace WebCore {
 
+#if PLATFORM(JAVA)
+class BitmapTextureJava;
+#endif
 class GraphicsLayer;
 class NativeImage;
 class TextureMapper;
@@ -102,6 +105,11 @@ public:
 
     OptionSet<TextureMapperFlags> colorConvertFlags() const;
 
+#if PLATFORM(JAVA)
+    // The image buffer that holds the texture contents on the Java port.
+    BitmapTextureJava& javaTexture() const { return *m_javaTexture; }
+#endif
+
 #if USE(GBM)
     MemoryMappedGPUBuffer* memoryMappedGPUBuffer() const { return m_memoryMappedGPUBuffer.get(); }
     IntSize allocatedSize() const;
@@ -135,6 +143,9 @@ private:
     ClipStack m_clipStack;
     RefPtr<const FilterOperation> m_filterOperation;
     PixelFormat m_pixelFormat { PixelFormat::RGBA8 };
+#if PLATFORM(JAVA)
+    RefPtr<BitmapTextureJava> m_javaTexture;
+#endif
 
 #if USE(GBM)
     std::unique_ptr<MemoryMappedGPUBuffer> m_memoryMappedGPUBuffer;
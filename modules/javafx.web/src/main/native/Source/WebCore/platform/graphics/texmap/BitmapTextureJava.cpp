@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -28,19 +28,39 @@
 #include "BitmapTextureJava.h"
 #include "GraphicsLayer.h"
 #include "NotImplemented.h"
+#include "PixelBuffer.h"
 #include "PlatformContextJava.h"
 #include "TextureMapperJava.h"
 #include <stdio.h>
 namespace WebCore {
 
 
-void BitmapTextureJava::updateContents(const void*, const IntRect& target, const IntPoint& sourceOffset, int bytesPerLine)
+void BitmapTextureJava::updateContents(const void* data, const IntRect& targetRect, const IntPoint& sourceOffset, int bytesPerLine)
 {
-    notImplemented();
+    if (!m_image || !data || targetRect.isEmpty())
+        return;
+
+    // The source rows are bytesPerLine apart, so they are viewed as an
+    // image that is as wide as a row and the update is taken out of it.
+    IntSize sourceSize(bytesPerLine / 4, sourceOffset.y() + targetRect.height());
+    std::span<const uint8_t> bytes(static_cast<const uint8_t*>(data), static_cast<size_t>(bytesPerLine) * sourceSize.height());
+    PixelBufferFormat format { AlphaPremultiplication::Premultiplied, PixelFormat::BGRA8, DestinationColorSpace::SRGB() };
+    auto source = PixelBufferSourceView::create(format, sourceSize, bytes);
+    if (!source)
+        return;
+
+    m_image->putPixelBuffer(*source, IntRect(sourceOffset, targetRect.size()), targetRect.location());
 }
 
 void BitmapTextureJava::didReset()
 {
+    // The render target is kept while the texture keeps its size, so that
+    // a reused layer texture does not allocate a new one on every frame.
+    if (m_image && m_image->backendSize() == contentSize()) {
+        m_image->context().clearRect(FloatRect(FloatPoint(), contentSize()));
+        return;
+    }
+
     float devicePixelRatio = 1.0;
     m_image = ImageBuffer::create(contentSize(), RenderingMode::Unaccelerated, RenderingPurpose::Unspecified, devicePixelRatio,
                          DestinationColorSpace::SRGB(), PixelFormat::BGRA8);
@@ -48,7 +68,12 @@ void BitmapTextureJava::didReset()
 
 void BitmapTextureJava::updateContents(NativeImage* image, const IntRect& targetRect, const IntPoint& offset)
 {
-    //m_image->context().drawImage(*image, targetRect, IntRect(offset, targetRect.size()));
+    if (!m_image || !image || targetRect.isEmpty())
+        return;
+
+    // The contents are drawn once into the texture, later frames only
+    // composite it with the layer transform and opacity.
+    m_image->context().drawNativeImage(*image, targetRect, IntRect(offset, targetRect.size()), { CompositeOperator::Copy });
 }
 
 } // namespace WebCore
@@ -44,6 +44,9 @@ public:
     unsigned bufferID() const { return m_bufferID; }
     const void* bufferDataOffsetAsPtr() const;
     unsigned numberOfVertices() const { return m_vertices.size(); }
+#if PLATFORM(JAVA)
+    const Vector<FloatPoint>& vertices() const { return m_vertices; }
+#endif
 
     const FloatRect& bounds() const { return m_bounds; }
 
@@ -40,6 +40,14 @@
 
 typedef void *EGLImage;
 
+// The Java port paints composited layers through TextureMapperJavaAdapter,
+// which overrides the drawing, clipping and surface entry points below.
+#if PLATFORM(JAVA)
+#define TEXTURE_MAPPER_JAVA_VIRTUAL virtual
+#else
+#define TEXTURE_MAPPER_JAVA_VIRTUAL
+#endif
+
 namespace WebCore {
 class BitmapTexture;
 class ClipPath;
@@ -66,15 +74,15 @@ public:
     WEBCORE_EXPORT static std::unique_ptr<TextureMapper> create();
 
     TextureMapper();
-    WEBCORE_EXPORT ~TextureMapper();
+    WEBCORE_EXPORT TEXTURE_MAPPER_JAVA_VIRTUAL ~TextureMapper();
 
     enum class AllEdgesExposed : bool { No, Yes };
     enum class FlipY : bool { No, Yes };
 
-    WEBCORE_EXPORT void drawBorder(const Color&, float borderWidth, const FloatRect&, const TransformationMatrix&);
-    void drawNumber(int number, const Color&, const FloatPoint&, const TransformationMatrix&);
+    WEBCORE_EXPORT TEXTURE_MAPPER_JAVA_VIRTUAL void drawBorder(const Color&, float borderWidth, const FloatRect&, const TransformationMatrix&);
+    TEXTURE_MAPPER_JAVA_VIRTUAL void drawNumber(int number, const Color&, const FloatPoint&, const TransformationMatrix&);
 
-    WEBCORE_EXPORT void drawTexture(const BitmapTexture&, const FloatRect& target, const TransformationMatrix& modelViewMatrix = TransformationMatrix(), float opacity = 1.0f, AllEdgesExposed = AllEdgesExposed::Yes);
+    WEBCORE_EXPORT TEXTURE_MAPPER_JAVA_VIRTUAL void drawTexture(const BitmapTexture&, const FloatRect& target, const TransformationMatrix& modelViewMatrix = TransformationMatrix(), float opacity = 1.0f, AllEdgesExposed = AllEdgesExposed::Yes);
     void drawTextureWithPhysicalSize(const BitmapTexture&, const FloatRect& target, const TransformationMatrix& modelViewMatrix = TransformationMatrix(), float opacity = 1.0f, AllEdgesExposed = AllEdgesExposed::Yes);
 
 #if ENABLE(DAMAGE_TRACKING)
@@ -85,23 +93,23 @@ public:
     void drawTextureSemiPlanarYUV(const std::array<GLuint, 2>& textures, bool uvReversed, const std::array<GLfloat, 16>& yuvToRgbMatrix, OptionSet<TextureMapperFlags>, const FloatRect& targetRect, const TransformationMatrix& modelViewMatrix, float opacity, TransferFunction, AllEdgesExposed = AllEdgesExposed::Yes);
     void drawTexturePackedYUV(GLuint texture, const std::array<GLfloat, 16>& yuvToRgbMatrix, OptionSet<TextureMapperFlags>, const FloatRect& targetRect, const TransformationMatrix& modelViewMatrix, float opacity, TransferFunction, AllEdgesExposed = AllEdgesExposed::Yes);
     void drawTextureExternalOES(GLuint texture, OptionSet<TextureMapperFlags>, const FloatRect&, const TransformationMatrix& modelViewMatrix, float opacity);
-    void drawSolidColor(const FloatRect&, const TransformationMatrix&, const Color&, bool);
-    void clearColor(const Color&);
+    TEXTURE_MAPPER_JAVA_VIRTUAL void drawSolidColor(const FloatRect&, const TransformationMatrix&, const Color&, bool);
+    TEXTURE_MAPPER_JAVA_VIRTUAL void clearColor(const Color&);
 
     // makes a surface the target for the following drawTexture calls.
-    void bindSurface(BitmapTexture* surface);
-    BitmapTexture* currentSurface();
-    void beginClip(const TransformationMatrix&, const FloatRoundedRect&);
-    void beginClip(const TransformationMatrix&, const ClipPath&);
+    TEXTURE_MAPPER_JAVA_VIRTUAL void bindSurface(BitmapTexture* surface);
+    TEXTURE_MAPPER_JAVA_VIRTUAL BitmapTexture* currentSurface();
+    TEXTURE_MAPPER_JAVA_VIRTUAL void beginClip(const TransformationMatrix&, const FloatRoundedRect&);
+    TEXTURE_MAPPER_JAVA_VIRTUAL void beginClip(const TransformationMatrix&, const ClipPath&);
     void beginClipWithoutApplying(const TransformationMatrix&, const FloatRect&);
     WEBCORE_EXPORT void beginPainting(FlipY = FlipY::No, BitmapTexture* = nullptr);
     WEBCORE_EXPORT void endPainting();
-    void endClip();
+    TEXTURE_MAPPER_JAVA_VIRTUAL void endClip();
     void endClipWithoutApplying();
-    IntRect clipBounds();
-    IntSize maxTextureSize() const;
-    void setDepthRange(double zNear, double zFar);
-    std::pair<double, double> depthRange() const;
+    TEXTURE_MAPPER_JAVA_VIRTUAL IntRect clipBounds();
+    TEXTURE_MAPPER_JAVA_VIRTUAL IntSize maxTextureSize() const;
+    TEXTURE_MAPPER_JAVA_VIRTUAL void setDepthRange(double zNear, double zFar);
+    TEXTURE_MAPPER_JAVA_VIRTUAL std::pair<double, double> depthRange() const;
     void setMaskMode(bool m) { m_isMaskMode = m; }
     void setWrapMode(WrapMode m) { m_wrapMode = m; }
     void setPatternTransform(const TransformationMatrix& p) { m_patternTransform = p; }
@@ -151,7 +159,7 @@ private:
     WrapMode m_wrapMode { WrapMode::Stretch };
     std::optional<FloatSize> m_uvClampMax;
     std::optional<FloatSize> m_uvClampTexelSize;
-    TextureMapperGLData* m_data;
+    TextureMapperGLData* m_data { nullptr };
     ClipStack m_clipStack;
 #if ENABLE(DAMAGE_TRACKING)
     std::optional<Damage> m_damage;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -28,8 +28,12 @@
 
 #include "PlatformContextJava.h"
 #include "BitmapTexturePool.h"
+#include "ClipPath.h"
+#include "FontCascade.h"
 #include "GraphicsLayer.h"
 #include "NotImplemented.h"
+#include "TextRun.h"
+#include <wtf/NeverDestroyed.h>
 
 #include "com_sun_webkit_graphics_GraphicsDecoder.h"
 
@@ -49,6 +53,16 @@ IntSize TextureMapperJava::maxTextureSize() const
     return IntSize(s_maximumAllowedImageBufferDimension, s_maximumAllowedImageBufferDimension);
 }
 
+static void setPerspectiveTransform(GraphicsContext& context, const TransformationMatrix& transform)
+{
+    context.platformContext()->rq().freeSpace(68)
+        << (jint)com_sun_webkit_graphics_GraphicsDecoder_SET_PERSPECTIVE_TRANSFORM
+        << (float)transform.m11() << (float)transform.m12() << (float)transform.m13() << (float)transform.m14()
+        << (float)transform.m21() << (float)transform.m22() << (float)transform.m23() << (float)transform.m24()
+        << (float)transform.m31() << (float)transform.m32() << (float)transform.m33() << (float)transform.m34()
+        << (float)transform.m41() << (float)transform.m42() << (float)transform.m43() << (float)transform.m44();
+}
+
 void TextureMapperJava::beginClip(const TransformationMatrix& matrix, const FloatRoundedRect& rect)
 {
     GraphicsContext* context = currentContext();
@@ -61,6 +75,28 @@ void TextureMapperJava::beginClip(const TransformationMatrix& matrix, const Floa
     context->setCTM(previousTransform);
 }
 
+// Clips to a layer fragment split by the 3D rendering context. Like the
+// rounded rect clip, it is balanced by endClip().
+void TextureMapperJava::beginClip(const TransformationMatrix& matrix, const ClipPath& clipPath)
+{
+    GraphicsContext* context = currentContext();
+    if (!context)
+        return;
+    Path path;
+    const auto& vertices = clipPath.vertices();
+    if (!vertices.isEmpty()) {
+        path.moveTo(vertices[0]);
+        for (size_t i = 1; i < vertices.size(); i++)
+            path.addLineTo(vertices[i]);
+        path.closeSubpath();
+    }
+    auto previousTransform = context->getCTM();
+    context->save();
+    context->concatCTM(matrix.toAffineTransform());
+    context->clipPath(path, WindRule::NonZero);
+    context->setCTM(previousTransform);
+}
+
 void TextureMapperJava::drawTexture(const BitmapTextureJava& texture, const FloatRect& targetRect, const TransformationMatrix& transform, float opacity, unsigned /* exposedEdges */)
 {
     GraphicsContext* context = currentContext();
@@ -69,14 +105,12 @@ void TextureMapperJava::drawTexture(const BitmapTextureJava& texture, const Floa
 
     const BitmapTextureJava& textureImageBuffer = texture;
     ImageBuffer* image = textureImageBuffer.image();
+    if (!image)
+        return;
+
     context->save();
     context->setAlpha(opacity);
-    context->platformContext()->rq().freeSpace(68)
-        << (jint)com_sun_webkit_graphics_GraphicsDecoder_SET_PERSPECTIVE_TRANSFORM
-        << (float)transform.m11() << (float)transform.m12() << (float)transform.m13() << (float)transform.m14()
-        << (float)transform.m21() << (float)transform.m22() << (float)transform.m23() << (float)transform.m24()
-        << (float)transform.m31() << (float)transform.m32() << (float)transform.m33() << (float)transform.m34()
-        << (float)transform.m41() << (float)transform.m42() << (float)transform.m43() << (float)transform.m44();
+    setPerspectiveTransform(*context, transform);
     context->drawImageBuffer(*image, targetRect);
     context->restore();
 }
@@ -88,30 +122,72 @@ void TextureMapperJava::drawSolidColor(const FloatRect& rect, const Transformati
         return;
 
     context->save();
-    context->platformContext()->rq().freeSpace(68)
-        << (jint)com_sun_webkit_graphics_GraphicsDecoder_SET_PERSPECTIVE_TRANSFORM
-        << (float)transform.m11() << (float)transform.m12() << (float)transform.m13() << (float)transform.m14()
-        << (float)transform.m21() << (float)transform.m22() << (float)transform.m23() << (float)transform.m24()
-        << (float)transform.m31() << (float)transform.m32() << (float)transform.m33() << (float)transform.m34()
-        << (float)transform.m41() << (float)transform.m42() << (float)transform.m43() << (float)transform.m44();
+    setPerspectiveTransform(*context, transform);
 
     context->fillRect(rect, color);
     context->restore();
 }
 
-void TextureMapperJava::drawBorder(const Color&, float /* borderWidth */, const FloatRect&, const TransformationMatrix&)
+void TextureMapperJava::drawBorder(const Color& color, float borderWidth, const FloatRect& rect, const TransformationMatrix& transform)
 {
-    notImplemented();
+    GraphicsContext* context = currentContext();
+    if (!context)
+        return;
+
+    context->save();
+    setPerspectiveTransform(*context, transform);
+    context->setStrokeColor(color);
+    context->setStrokeThickness(borderWidth);
+    context->strokeRect(rect, borderWidth);
+    context->restore();
 }
 
-void TextureMapperJava::drawNumber(int /* number */, const Color&, const FloatPoint&, const TransformationMatrix&)
+static const FontCascade& numberFont()
 {
-    notImplemented();
+    static NeverDestroyed<FontCascade> font = [] {
+        FontCascadeDescription fontDescription;
+        fontDescription.setOneFamily("Monospace"_s);
+        fontDescription.setSpecifiedSize(8);
+        fontDescription.setComputedSize(8);
+        fontDescription.setWeight(boldWeightValue());
+        FontCascade font(WTF::move(fontDescription));
+        font.update(nullptr);
+        return font;
+    }();
+    return font;
 }
 
-void TextureMapperJava::clearColor(const Color&)
+void TextureMapperJava::drawNumber(int number, const Color& color, const FloatPoint& targetPoint, const TransformationMatrix& transform)
 {
-    notImplemented();
+    GraphicsContext* context = currentContext();
+    if (!context)
+        return;
+
+    // Same layout as the label drawn by the Cairo TextureMapper, a white
+    // number on a box of the given color.
+    const FontCascade& font = numberFont();
+    TextRun textRun(String::number(number));
+    float pointSize = font.size();
+    FloatRect labelRect(targetPoint, FloatSize(font.width(textRun) + 4, pointSize * 1.5));
+
+    context->save();
+    setPerspectiveTransform(*context, transform);
+    context->fillRect(labelRect, color);
+    context->setFillColor(Color::white);
+    context->drawText(font, textRun, targetPoint + FloatSize(2, pointSize));
+    context->restore();
+}
+
+void TextureMapperJava::clearColor(const Color& color)
+{
+    GraphicsContext* context = currentContext();
+    if (!context)
+        return;
+
+    context->save();
+    context->setCompositeOperation(CompositeOperator::Copy);
+    context->fillRect(context->clipBounds(), color);
+    context->restore();
 }
 
 void TextureMapperJava::setDepthRange(double, double)
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -43,12 +43,16 @@ public:
     void drawTexture(const BitmapTextureJava&, const FloatRect& targetRect, const TransformationMatrix&, float opacity, unsigned exposedEdges);
     void drawSolidColor(const FloatRect&, const TransformationMatrix&, const Color&, bool);
     void beginClip(const TransformationMatrix&, const FloatRoundedRect&);
+    void beginClip(const TransformationMatrix&, const ClipPath&);
     void bindSurface(BitmapTextureJava* surface) { m_currentSurface = surface;}
-    void endClip() { graphicsContext()->restore(); }
+    void endClip()
+    {
+        if (GraphicsContext* context = currentContext())
+            context->restore();
+    }
     IntRect clipBounds() { return currentContext()->clipBounds(); }
     IntSize maxTextureSize() const;
     Ref<BitmapTextureJava> createTexture() { return BitmapTextureJava::create(); }
-    BitmapTextureJava* currentSurface() { return m_currentSurface ? m_currentSurface.get() : nullptr; }
     Ref<BitmapTextureJava> createTexture(GCGLint) { return createTexture(); }
     void setDepthRange(double zNear, double zFar);
     void clearColor(const Color&);
@@ -11,17 +11,83 @@ public:
 
     TextureMapperJava& javaMapper() { return m_javaMapper.get(); }
 
+    // TextureMapperLayer paints through these overrides, the GL
+    // implementations in TextureMapper are compiled out on Java.
     void drawBorder(const Color& color, float borderWidth,
-                    const FloatRect& rect, const TransformationMatrix& transform)
+                    const FloatRect& rect, const TransformationMatrix& transform) override
     {
         m_javaMapper->drawBorder(color, borderWidth, rect, transform);
     }
 
-    void clearColor(const Color& color)
+    void drawNumber(int number, const Color& color,
+                    const FloatPoint& targetPoint, const TransformationMatrix& transform) override
+    {
+        m_javaMapper->drawNumber(number, color, targetPoint, transform);
+    }
+
+    void clearColor(const Color& color) override
     {
         m_javaMapper->clearColor(color);
     }
 
+    void drawTexture(const BitmapTexture& texture, const FloatRect& targetRect,
+                     const TransformationMatrix& transform, float opacity, AllEdgesExposed) override
+    {
+        m_javaMapper->drawTexture(texture.javaTexture(), targetRect, transform, opacity, 0);
+    }
+
+    void drawSolidColor(const FloatRect& rect, const TransformationMatrix& transform,
+                        const Color& color, bool isBlendingAllowed) override
+    {
+        m_javaMapper->drawSolidColor(rect, transform, color, isBlendingAllowed);
+    }
+
+    void bindSurface(BitmapTexture* surface) override
+    {
+        m_currentSurface = surface;
+        m_javaMapper->bindSurface(surface ? &surface->javaTexture() : nullptr);
+    }
+
+    BitmapTexture* currentSurface() override
+    {
+        return m_currentSurface.get();
+    }
+
+    void beginClip(const TransformationMatrix& transform, const FloatRoundedRect& rect) override
+    {
+        m_javaMapper->beginClip(transform, rect);
+    }
+
+    void beginClip(const TransformationMatrix& transform, const ClipPath& clipPath) override
+    {
+        m_javaMapper->beginClip(transform, clipPath);
+    }
+
+    void endClip() override
+    {
+        m_javaMapper->endClip();
+    }
+
+    IntRect clipBounds() override
+    {
+        return m_javaMapper->clipBounds();
+    }
+
+    IntSize maxTextureSize() const override
+    {
+        return m_javaMapper->maxTextureSize();
+    }
+
+    void setDepthRange(double zNear, double zFar) override
+    {
+        m_depthRange = { zNear, zFar };
+    }
+
+    std::pair<double, double> depthRange() const override
+    {
+        return m_depthRange;
+    }
+
     GraphicsContext* graphicsContext()
     {
         return m_javaMapper->graphicsContext();
@@ -34,6 +100,8 @@ public:
 
 private:
     Ref<TextureMapperJava> m_javaMapper;
+    RefPtr<BitmapTexture> m_currentSurface;
+    std::pair<double, double> m_depthRange { 0, 0 };
 };
 
 } // namespace WebCore
@@ -132,7 +132,6 @@ static bool matchesJPEGXLSignature(std::span<const uint8_t> contents)
 
 RefPtr<ScalableImageDecoder> ScalableImageDecoder::create(FragmentedSharedBuffer& data, AlphaOption alphaOption, GammaAndColorProfileOption gammaAndColorProfileOption)
 {
-    constexpr size_t lengthOfLongestSignature = 14; // To wit: "RIFF????WEBPVP"
     if (data.size() < lengthOfLongestSignature)
         return nullptr;
 
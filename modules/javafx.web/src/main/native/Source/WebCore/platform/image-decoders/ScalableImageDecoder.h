@@ -60,6 +60,8 @@ public:
 
     static bool supportsMediaType(MediaType type) { return type == MediaType::Image; }
 
+    static constexpr size_t lengthOfLongestSignature = 14; // To wit: "RIFF????WEBPVP"
+
     // Returns nullptr if we can't sniff a supported type from the provided data (possibly
     // because there isn't enough data yet).
     static RefPtr<ScalableImageDecoder> create(FragmentedSharedBuffer& data, AlphaOption, GammaAndColorProfileOption);
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "config.h"
+#include "ImageBackingStore.h"
+
+#include "ImageJava.h"
+#include "PlatformJavaClasses.h"
+#include "RQRef.h"
+
+namespace WebCore {
+
+// The decoded pixels are handed to Prism once, as IntArgbPre data of a
+// WCImageFrame, the same way frames of the Java decoder are wrapped.
+PlatformImagePtr ImageBackingStore::image() const
+{
+    JNIEnv* env = WTF::GetJavaEnv();
+    if (!env || m_size.isEmpty()) {
+        return nullptr;
+    }
+
+    static jmethodID midCreateFrame = env->GetMethodID(
+        PG_GetGraphicsManagerClass(env),
+        "createFrame",
+        "(IILjava/nio/ByteBuffer;)Lcom/sun/webkit/graphics/WCImageFrame;");
+    ASSERT(midCreateFrame);
+
+    auto pixels = m_pixelsSpan.first(m_size.area());
+    Vector<uint32_t> premultipliedPixels;
+    if (!m_premultiplyAlpha) {
+        premultipliedPixels = WTF::map(pixels, [](uint32_t pixel) {
+            auto color = premultipliedFlooring(asSRGBA(PackedColor::ARGB { pixel }).resolved()).resolved();
+            return PackedColor::ARGB { color }.value;
+        });
+        pixels = premultipliedPixels.mutableSpan();
+    }
+
+    JLObject data(env->NewDirectByteBuffer(pixels.data(), pixels.size_bytes()));
+    if (WTF::CheckAndClearException(env) || !data) {
+        return nullptr;
+    }
+
+    JLObject frame(env->CallObjectMethod(
+        PL_GetGraphicsManager(env),
+        midCreateFrame,
+        m_size.width(),
+        m_size.height(),
+        (jobject)data));
+    if (WTF::CheckAndClearException(env) || !frame) {
+        return nullptr;
+    }
+
+    return ImageJava::create(RQRef::create(frame), nullptr, m_size.width(), m_size.height());
+}
+
+} // namespace WebCore
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "config.h"
+#include "ScriptBytecodeCacheJava.h"
+
+#include "Logging.h"
+#include <JavaScriptCore/BytecodeCacheError.h>
+#include <JavaScriptCore/CachedTypes.h>
+#include <JavaScriptCore/UnlinkedFunctionExecutable.h>
+#include <wtf/FileHandle.h>
+#include <wtf/FileMetadata.h>
+#include <wtf/FileSystem.h>
+#include <wtf/MainThread.h>
+#include <wtf/MappedFileData.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/SHA1.h>
+#include <wtf/text/MakeString.h>
+
+namespace WebCore {
+
+// Smaller scripts are compiled about as fast as their cache entry is read.
+static constexpr unsigned minimumCachedSourceLength = 16 * 1024;
+
+static constexpr auto bytecodeCacheFileExtension = ".jsbytecode"_s;
+
+// All the state below is only accessed on the main thread, scripts of
+// workers do not use a CachedScriptSourceProvider.
+static uint64_t maximumBytecodeCacheSize;
+static std::optional<uint64_t> currentBytecodeCacheSize;
+
+static String& bytecodeCacheDirectory()
+{
+    static NeverDestroyed<String> directory;
+    return directory;
+}
+
+void ScriptBytecodeCacheJava::configure(const String& directory, uint64_t maximumSize)
+{
+    ASSERT(isMainThread());
+#if OS(UNIX)
+    if (directory.isEmpty() || !maximumSize || !FileSystem::makeAllDirectories(directory)) {
+        bytecodeCacheDirectory() = String();
+        return;
+    }
+    bytecodeCacheDirectory() = directory;
+    maximumBytecodeCacheSize = maximumSize;
+    currentBytecodeCacheSize = std::nullopt;
+#else
+    // Entries are read through FileHandle::map(), which needs POSIX file handles.
+    UNUSED_PARAM(directory);
+    UNUSED_PARAM(maximumSize);
+#endif
+}
+
+// Deletes the least recently written entries once the cache is full. The
+// directory is only scanned when the running total says the cache is full,
+// and is trimmed to 3/4 of its maximum size so that it is not scanned again
+// on the next write.
+static void evictBytecodeCacheEntriesIfNeeded(uint64_t addedSize)
+{
+    if (currentBytecodeCacheSize) {
+        *currentBytecodeCacheSize += addedSize;
+        if (*currentBytecodeCacheSize <= maximumBytecodeCacheSize)
+            return;
+    }
+
+    struct CacheEntry {
+        String path;
+        WallTime modificationTime;
+        uint64_t size;
+    };
+    Vector<CacheEntry> entries;
+    uint64_t totalSize = 0;
+    for (auto& fileName : FileSystem::listDirectory(bytecodeCacheDirectory())) {
+        if (!fileName.endsWith(bytecodeCacheFileExtension))
+            continue;
+        auto path = FileSystem::pathByAppendingComponent(bytecodeCacheDirectory(), fileName);
+        auto metadata = FileSystem::fileMetadata(path);
+        if (!metadata)
+            continue;
+        entries.append({ WTF::move(path), metadata->modificationTime, static_cast<uint64_t>(metadata->length) });
+        totalSize += metadata->length;
+    }
+
+    if (totalSize > maximumBytecodeCacheSize) {
+        std::sort(entries.begin(), entries.end(), [](auto& a, auto& b) {
+            return a.modificationTime < b.modificationTime;
+        });
+        uint64_t targetSize = maximumBytecodeCacheSize / 4 * 3;
+        unsigned evictedCount = 0;
+        for (auto& entry : entries) {
+            if (totalSize <= targetSize)
+                break;
+            if (FileSystem::deleteFile(entry.path)) {
+                totalSize -= entry.size;
+                ++evictedCount;
+            }
+        }
+        LOG(Loading, "Evicted %u bytecode cache entries, %" PRIu64 " bytes left", evictedCount, totalSize);
+        UNUSED_VARIABLE(evictedCount);
+    }
+    currentBytecodeCacheSize = totalSize;
+}
+
+ScriptBytecodeCacheJava::ScriptBytecodeCacheJava(const URL& url)
+    : m_url(url)
+{
+}
+
+ScriptBytecodeCacheJava::~ScriptBytecodeCacheJava()
+{
+    commitCachedBytecode();
+}
+
+bool ScriptBytecodeCacheJava::isEnabled(StringView source)
+{
+    if (!m_cachePath.isNull())
+        return true;
+
+    if (bytecodeCacheDirectory().isNull() || source.length() < minimumCachedSourceLength)
+        return false;
+    if (!m_url.protocolIsInHTTPFamily() && !m_url.protocolIsFile())
+        return false;
+
+    SHA1 sha1;
+    sha1.addUTF8Bytes(m_url.string());
+    if (source.is8Bit())
+        sha1.addBytes(source.span8());
+    else
+        sha1.addBytes(std::as_bytes(source.span16()));
+    SHA1::Digest digest;
+    sha1.computeHash(digest);
+
+    m_cachePath = FileSystem::pathByAppendingComponent(bytecodeCacheDirectory(),
+        makeString(String::fromLatin1(SHA1::hexDigest(digest).data()), bytecodeCacheFileExtension));
+    return true;
+}
+
+void ScriptBytecodeCacheJava::loadBytecode()
+{
+    m_didLoadBytecode = true;
+
+    auto mappedFileData = FileSystem::mapFile(m_cachePath, FileSystem::MappedFileMode::Private);
+    if (!mappedFileData || !mappedFileData->size())
+        return;
+
+    m_cachedBytecode = JSC::CachedBytecode::create(WTF::move(*mappedFileData));
+}
+
+RefPtr<JSC::CachedBytecode> ScriptBytecodeCacheJava::cachedBytecode(StringView source)
+{
+    if (!m_didLoadBytecode && isEnabled(source))
+        loadBytecode();
+    return m_cachedBytecode;
+}
+
+void ScriptBytecodeCacheJava::cacheBytecode(StringView source, const JSC::BytecodeCacheGenerator& generator)
+{
+    if (!isEnabled(source))
+        return;
+
+    // JavaScriptCore only generates the global code block when the entry
+    // it was given, if any, did not validate. Start over from a new one.
+    m_cachedBytecode = JSC::CachedBytecode::create();
+    if (auto update = generator())
+        m_cachedBytecode->addGlobalUpdate(*update);
+}
+
+void ScriptBytecodeCacheJava::updateCache(const JSC::UnlinkedFunctionExecutable* executable, JSC::CodeSpecializationKind kind, const JSC::UnlinkedFunctionCodeBlock* codeBlock)
+{
+    if (!m_cachedBytecode)
+        return;
+
+    JSC::BytecodeCacheError error;
+    auto cachedBytecode = JSC::encodeFunctionCodeBlock(executable->vm(), codeBlock, error);
+    if (cachedBytecode && !error.isValid())
+        m_cachedBytecode->addFunctionUpdate(executable, kind, *cachedBytecode);
+}
+
+void ScriptBytecodeCacheJava::commitCachedBytecode()
+{
+    if (!m_cachedBytecode || !m_cachedBytecode->hasUpdates())
+        return;
+
+    // The committed entry is mapped again on the next use.
+    auto cachedBytecode = std::exchange(m_cachedBytecode, nullptr);
+    m_didLoadBytecode = false;
+    if (bytecodeCacheDirectory().isNull())
+        return;
+
+    // The updated entry is written to a new file that is renamed over the
+    // old one, which may still be mapped by this or another WebView.
+    auto [temporaryPath, handle] = FileSystem::openTemporaryFile("bytecode"_s, { }, bytecodeCacheDirectory());
+    if (!handle)
+        return;
+
+    auto previousData = cachedBytecode->span();
+    bool succeeded = handle.write(previousData) == previousData.size()
+        && handle.truncate(cachedBytecode->sizeForUpdate());
+    cachedBytecode->commitUpdates([&, &handle = handle] (off_t offset, std::span<const uint8_t> data) {
+        succeeded = succeeded
+            && handle.seek(offset, FileSystem::FileSeekOrigin::Beginning)
+            && handle.write(data) == data.size();
+    });
+    handle = { };
+
+    if (!succeeded || !FileSystem::moveFile(temporaryPath, m_cachePath)) {
+        FileSystem::deleteFile(temporaryPath);
+        return;
+    }
+    evictBytecodeCacheEntriesIfNeeded(cachedBytecode->sizeForUpdate());
+}
+
+} // namespace WebCore
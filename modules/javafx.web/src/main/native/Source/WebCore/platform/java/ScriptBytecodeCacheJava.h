@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#pragma once
+
+#include <JavaScriptCore/SourceProvider.h>
+#include <wtf/URL.h>
+
+namespace WebCore {
+
+// On-disk bytecode cache of the scripts loaded by a WebView.
+//
+// The cache is disabled unless a directory is configured with the
+// com.sun.webkit.bytecodeCacheDirectory system property. Entries are keyed
+// by the script URL and the SHA-1 of its source, JavaScriptCore rejects
+// entries written by another version of the engine. The least recently
+// written entries are evicted once the cache grows past its maximum size.
+class ScriptBytecodeCacheJava {
+    WTF_MAKE_NONCOPYABLE(ScriptBytecodeCacheJava);
+public:
+    WEBCORE_EXPORT static void configure(const String& directory, uint64_t maximumSize);
+
+    explicit ScriptBytecodeCacheJava(const URL&);
+    ~ScriptBytecodeCacheJava();
+
+    RefPtr<JSC::CachedBytecode> cachedBytecode(StringView source);
+    void cacheBytecode(StringView source, const JSC::BytecodeCacheGenerator&);
+    void updateCache(const JSC::UnlinkedFunctionExecutable*, JSC::CodeSpecializationKind, const JSC::UnlinkedFunctionCodeBlock*);
+    void commitCachedBytecode();
+
+private:
+    bool isEnabled(StringView source);
+    void loadBytecode();
+
+    URL m_url;
+    String m_cachePath;
+    RefPtr<JSC::CachedBytecode> m_cachedBytecode;
+    bool m_didLoadBytecode { false };
+};
+
+} // namespace WebCore
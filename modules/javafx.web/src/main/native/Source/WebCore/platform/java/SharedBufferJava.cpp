@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -28,14 +28,30 @@
 #include "SharedBuffer.h"
 #include "NotImplemented.h"
 #include "com_sun_webkit_SharedBuffer.h"
+#include <wtf/FileSystem.h>
 
 namespace WebCore {
 
-// JDK-8146959
-RefPtr<SharedBuffer> SharedBuffer::createFromReadingFile(const String&)
+RefPtr<SharedBuffer> SharedBuffer::createFromReadingFile(const String& filePath)
 {
-  notImplemented();
-  return {};
+#if OS(UNIX)
+    if (filePath.isEmpty())
+        return nullptr;
+
+    // Map the file so that large local resources are not copied into the heap.
+    if (auto mappedFileData = FileSystem::mapFile(filePath, FileSystem::MappedFileMode::Private))
+        return SharedBuffer::create(WTF::move(*mappedFileData));
+
+    auto contents = FileSystem::readEntireFile(filePath);
+    if (!contents)
+        return nullptr;
+    return SharedBuffer::create(WTF::move(*contents));
+#else
+    // JDK-8146959
+    UNUSED_PARAM(filePath);
+    notImplemented();
+    return {};
+#endif
 }
 
 extern "C" {
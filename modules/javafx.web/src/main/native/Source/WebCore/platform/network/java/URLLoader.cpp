@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -47,6 +47,7 @@
 #include "com_sun_webkit_LoadListenerClient.h"
 #include "com_sun_webkit_network_URLLoaderBase.h"
 #include <wtf/CompletionHandler.h>
+#include <wtf/TZoneMallocInlines.h>
 
 namespace WebCore {
 class Page;
@@ -110,6 +111,44 @@ static void initRefs(JNIEnv* env)
     }
 }
 
+// Keeps a direct buffer handed over by the Java loader alive while WebCore
+// references its data, then runs the release callback of the loader. The
+// last reference may go away on any thread, e.g. an image decoding thread.
+class JavaBufferOwner {
+    WTF_MAKE_TZONE_ALLOCATED_INLINE(JavaBufferOwner);
+    WTF_MAKE_NONCOPYABLE(JavaBufferOwner);
+public:
+    JavaBufferOwner(JNIEnv* env, jobject byteBuffer, jobject release)
+        : m_byteBuffer(env->NewGlobalRef(byteBuffer))
+        , m_release(env->NewGlobalRef(release))
+    {
+    }
+
+    ~JavaBufferOwner()
+    {
+        WTF::AttachThreadAsDaemonToJavaEnv autoAttach;
+        JNIEnv* env = autoAttach.env();
+        if (!env) {
+            return;
+        }
+
+        static jmethodID runMethod = env->GetMethodID(
+                JLClass(env->FindClass("java/lang/Runnable")),
+                "run",
+                "()V");
+        ASSERT(runMethod);
+
+        env->CallVoidMethod(m_release, runMethod);
+        WTF::CheckAndClearException(env);
+        env->DeleteGlobalRef(m_release);
+        env->DeleteGlobalRef(m_byteBuffer);
+    }
+
+private:
+    jobject m_byteBuffer;
+    jobject m_release;
+};
+
 }
 
 URLLoader::URLLoader()
@@ -500,7 +539,7 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidReceiveRe
 
 JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidReceiveData
   (JNIEnv* env, jclass, jobject byteBuffer, jint position, jint remaining,
-   jlong data)
+   jobject release, jlong data)
 {
     using namespace WebCore;
     URLLoader::Target* target =
@@ -508,9 +547,22 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidReceiveDa
     ASSERT(target);
     const uint8_t* address =
             static_cast<const uint8_t*>(env->GetDirectBufferAddress(byteBuffer));
-    Ref<SharedBuffer> tmp_buf = SharedBuffer::create(std::span<const uint8_t>(address, remaining));
-    target->didReceiveData(tmp_buf->makeContiguous().ptr() + position, remaining);
-    //target->didReceiveData((SharedBuffer*)(address) + position, remaining);
+    auto span = std::span<const uint8_t>(address + position, remaining);
+    if (!release) {
+        Ref<SharedBuffer> buffer = SharedBuffer::create(span);
+        target->didReceiveData(buffer.ptr(), remaining);
+        return;
+    }
+
+    // The loader hands the buffer over: wrap it without copying, and let
+    // the loader recycle it once the last reference to the data is gone.
+    auto owner = makeUnique<URLLoaderJavaInternal::JavaBufferOwner>(env, byteBuffer, release);
+    Ref<SharedBuffer> buffer = SharedBuffer::create(DataSegment::Provider {
+        [owner = WTF::move(owner), span] {
+            return span;
+        }
+    });
+    target->didReceiveData(buffer.ptr(), remaining);
 }
 
 JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidFinishLoading
@@ -127,6 +127,7 @@ list(APPEND WebKitLegacy_SOURCES
     java/WebCoreSupport/VisitedLinkStoreJava.cpp
     java/WebCoreSupport/InspectorClientJava.cpp
     java/WebCoreSupport/WebPage.cpp
+    java/WebCoreSupport/TileCacheJava.cpp
     java/WebCoreSupport/PlatformStrategiesJava.cpp
     java/WebCoreSupport/ChromeClientJava.cpp
     java/WebCoreSupport/BackForwardList.cpp
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "TileCacheJava.h"
+
+#include <WebCore/GraphicsContext.h>
+#include <WebCore/GraphicsContextStateSaver.h>
+#include <WebCore/LocalFrameView.h>
+#include <WebCore/NativeImage.h>
+#include <WebCore/PlatformContextJava.h>
+#include <WebCore/Region.h>
+
+#include "com_sun_webkit_graphics_GraphicsDecoder.h"
+
+namespace WebCore {
+
+static bool s_tileCacheEnabled;
+
+void TileCacheJava::setEnabled(bool enabled)
+{
+    s_tileCacheEnabled = enabled;
+}
+
+bool TileCacheJava::isEnabled()
+{
+    return s_tileCacheEnabled;
+}
+
+TileCacheJava::~TileCacheJava()
+{
+    clear();
+}
+
+static int tileIndex(int coordinate)
+{
+    // Contents coordinates are negative in right-to-left documents.
+    return coordinate >= 0
+        ? coordinate / TileCacheJava::tileSize
+        : -((-coordinate + TileCacheJava::tileSize - 1) / TileCacheJava::tileSize);
+}
+
+IntRect TileCacheJava::tileRect(const IntPoint& index)
+{
+    return IntRect(index.x() * tileSize, index.y() * tileSize, tileSize, tileSize);
+}
+
+void TileCacheJava::attach(LocalFrameView& frameView)
+{
+    // A new frame view is created for every loaded document.
+    m_tiles.clear();
+    m_frameView = frameView;
+    m_scrollPosition = frameView.scrollPosition();
+    frameView.setPaintsEntireContents(true);
+}
+
+void TileCacheJava::clear()
+{
+    m_tiles.clear();
+    if (RefPtr frameView = m_frameView.get())
+        frameView->setPaintsEntireContents(false);
+    m_frameView = nullptr;
+}
+
+IntRect TileCacheJava::invalidate(const IntRect& windowRect)
+{
+    RefPtr frameView = m_frameView.get();
+    if (!frameView)
+        return windowRect;
+
+    IntRect contentsRect = frameView->windowToContents(windowRect);
+    for (auto& [index, tile] : m_tiles) {
+        IntRect dirtyRect = intersection(contentsRect, tileRect(index));
+        if (!dirtyRect.isEmpty())
+            tile.dirtyRect.unite(dirtyRect);
+    }
+    return intersection(windowRect, IntRect(IntPoint(), frameView->size()));
+}
+
+void TileCacheJava::paint(LocalFrameView& frameView, GraphicsContext& context, const IntRect& dirtyRect)
+{
+    if (m_frameView.get() != &frameView)
+        attach(frameView);
+
+    // Fixed positioned content moves over the document as it scrolls, and
+    // only its new position on screen is invalidated. The tiles it was
+    // painted into before are not valid anymore.
+    if (m_scrollPosition != frameView.scrollPosition()) {
+        m_scrollPosition = frameView.scrollPosition();
+        if (frameView.hasViewportConstrainedObjects())
+            m_tiles.clear();
+    }
+
+    IntRect visibleContentsRect = frameView.visibleContentRect();
+    IntRect contentsBox = intersection(dirtyRect, frameView.contentsToWindow(visibleContentsRect));
+
+    // The scroll bars, the scroll corner and the overhang areas are not
+    // cached. The frame view does not paint its contents outside of its
+    // visible rect unless it paints its entire contents.
+    if (contentsBox != dirtyRect) {
+        Region borderRegion(dirtyRect);
+        borderRegion.subtract(contentsBox);
+        frameView.setPaintsEntireContents(false);
+        for (auto& rect : borderRegion.rects())
+            frameView.paint(context, rect);
+        frameView.setPaintsEntireContents(true);
+    }
+
+    IntRect contentsRect = frameView.windowToContents(contentsBox);
+    if (!contentsRect.isEmpty()) {
+        GraphicsContextStateSaver stateSaver(context);
+        context.clip(contentsBox);
+        for (int y = tileIndex(contentsRect.y()); y <= tileIndex(contentsRect.maxY() - 1); ++y) {
+            for (int x = tileIndex(contentsRect.x()); x <= tileIndex(contentsRect.maxX() - 1); ++x) {
+                IntPoint index(x, y);
+                auto& tile = m_tiles.ensure(index, [&] {
+                    return Tile { nullptr, tileRect(index) };
+                }).iterator->value;
+                paintTile(frameView, context, index, tile, contentsRect);
+            }
+        }
+    }
+
+    evictTiles(visibleContentsRect);
+}
+
+void TileCacheJava::paintTile(LocalFrameView& frameView, GraphicsContext& context, const IntPoint& index, Tile& tile, const IntRect& contentsRect)
+{
+    IntRect rect = tileRect(index);
+    if (!tile.buffer) {
+        tile.buffer = ImageBuffer::create(rect.size(), RenderingMode::Unaccelerated, RenderingPurpose::Unspecified, 1,
+            DestinationColorSpace::SRGB(), { PixelFormat::BGRA8, UseLosslessCompression::No });
+        tile.dirtyRect = rect;
+    }
+
+    if (!tile.buffer) {
+        // Paint the contents uncached if there is no texture for the tile.
+        IntRect paintRect = intersection(rect, contentsRect);
+        GraphicsContextStateSaver stateSaver(context);
+        context.translate(toIntSize(frameView.contentsToWindow(IntPoint())));
+        context.clip(paintRect);
+        frameView.paintContents(context, paintRect);
+        return;
+    }
+
+    GraphicsContext& tileContext = tile.buffer->context();
+    if (!tile.dirtyRect.isEmpty()) {
+        GraphicsContextStateSaver stateSaver(tileContext);
+        tileContext.translate(-rect.x(), -rect.y());
+        tileContext.clip(tile.dirtyRect);
+        tileContext.clearRect(tile.dirtyRect);
+        frameView.paintContents(tileContext, tile.dirtyRect);
+        tile.dirtyRect = { };
+    }
+
+    // The texture is updated when the page queue is decoded. The tile queue
+    // is decoded on every use as Java may drop a page queue before it is
+    // rendered, and with it the commands recorded for the tile in that frame.
+    RenderingQueue& tileQueue = tileContext.platformContext()->rq();
+    tileQueue.flushBuffer();
+    context.platformContext()->rq().freeSpace(8)
+        << (jint)com_sun_webkit_graphics_GraphicsDecoder_DECODERQ
+        << tileQueue.getRQRenderingQueue();
+
+    if (auto image = tile.buffer->createNativeImageReference())
+        context.drawNativeImage(*image, frameView.contentsToWindow(rect), FloatRect(FloatPoint(), rect.size()));
+}
+
+void TileCacheJava::evictTiles(const IntRect& visibleContentsRect)
+{
+    // Keep the tiles within a viewport of the visible contents, so that
+    // short scrolls back and forth are painted from the cache.
+    IntRect retainedRect = visibleContentsRect;
+    retainedRect.inflateX(visibleContentsRect.width());
+    retainedRect.inflateY(visibleContentsRect.height());
+    m_tiles.removeIf([&](auto& entry) {
+        return !retainedRect.intersects(tileRect(entry.key));
+    });
+}
+
+} // namespace WebCore
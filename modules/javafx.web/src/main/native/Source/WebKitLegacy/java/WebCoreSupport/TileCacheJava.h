@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#pragma once
+
+#include <WebCore/ImageBuffer.h>
+#include <WebCore/IntPointHash.h>
+#include <WebCore/IntRect.h>
+#include <wtf/HashMap.h>
+#include <wtf/TZoneMallocInlines.h>
+#include <wtf/WeakPtr.h>
+
+namespace WebCore {
+
+class GraphicsContext;
+class LocalFrameView;
+
+// Retained backing store of the main frame for the non-composited painting
+// path, enabled with the com.sun.webkit.useTileCache system property.
+//
+// The document is split into fixed-size tiles, each rendered into its own
+// texture. A tile is only repainted where it was invalidated, so scrolling
+// back over already painted content or blinking the caret does not walk
+// the render tree for the rest of the tile again. The frame view paints its
+// entire contents while the cache is in use, so that tiles which are not
+// on screen are invalidated too.
+class TileCacheJava {
+    WTF_MAKE_TZONE_ALLOCATED_INLINE(TileCacheJava);
+    WTF_MAKE_NONCOPYABLE(TileCacheJava);
+public:
+    static constexpr int tileSize = 512;
+
+    static void setEnabled(bool);
+    static bool isEnabled();
+
+    TileCacheJava() = default;
+    ~TileCacheJava();
+
+    // Paints dirtyRect, in window coordinates, of the frame view.
+    void paint(LocalFrameView&, GraphicsContext&, const IntRect& dirtyRect);
+
+    // Marks the tiles under windowRect for repainting and returns the part
+    // of windowRect that is on screen.
+    IntRect invalidate(const IntRect& windowRect);
+
+    // Drops all the tiles and lets the frame view go back to painting only
+    // its visible contents.
+    void clear();
+
+private:
+    struct Tile {
+        RefPtr<ImageBuffer> buffer;
+        IntRect dirtyRect;
+    };
+
+    static IntRect tileRect(const IntPoint& index);
+    void attach(LocalFrameView&);
+    void paintTile(LocalFrameView&, GraphicsContext&, const IntPoint& index, Tile&, const IntRect& contentsRect);
+    void evictTiles(const IntRect& visibleContentsRect);
+
+    HashMap<IntPoint, Tile> m_tiles;
+    SingleThreadWeakPtr<LocalFrameView> m_frameView;
+    IntPoint m_scrollPosition;
+};
+
+} // namespace WebCore
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -97,6 +97,7 @@
 #include <WebCore/RenderTreeAsText.h>
 #include <WebCore/RenderView.h>
 #include <WebCore/ResourceRequest.h>
+#include <WebCore/ScriptBytecodeCacheJava.h>
 #include <WebCore/ScriptController.h>
 #include <WebCore/ScrollingCoordinatorTypes.h>
 #include <WebCore/SecurityPolicy.h>
@@ -107,6 +108,8 @@
 #include <WebCore/TextureMapperLayer.h>
 #include <WebCore/WorkerThread.h>
 #include <WebCore/platform/graphics/java/GraphicsContextJava.h>
+#include <wtf/FastMalloc.h>
+#include <wtf/MemoryFootprint.h>
 #include <wtf/Ref.h>
 #include <wtf/RunLoop.h>
 #include <wtf/java/JavaRef.h>
@@ -144,12 +147,16 @@ namespace WebCore {
 WebPage::WebPage(RefPtr<Page> page)
     : m_page(WTF::move(page))
     , m_printContext(PrintContext::create(m_page->localMainFrame()))
+    , m_repaintTimer([this] { flushPendingRepaints(); })
 {
 #if ENABLE(NOTIFICATIONS) || ENABLE(LEGACY_NOTIFICATIONS)
     if(!NotificationController::from(m_page.get())) {
         provideNotification(m_page.get(), NotificationClientJava::instance());
     }
 #endif
+    if (TileCacheJava::isEnabled()) {
+        m_tileCache = makeUnique<TileCacheJava>();
+    }
 }
 
 WebPage::~WebPage()
@@ -280,7 +287,11 @@ void WebPage::paint(jobject rq, jint x, jint y, jint w, jint h)
     JSGlobalContextRef globalContext = toGlobalRef(localFrame->script().globalObject(mainThreadNormalWorldSingleton()));
     JSC::JSLockHolder sw(toJS(globalContext)); // TODO-java: was JSC::APIEntryShim sw( toJS(globalContext) );
 
-    frameView->paint(gc, IntRect(x, y, w, h));
+    if (m_tileCache) {
+        m_tileCache->paint(*frameView, gc, IntRect(x, y, w, h));
+    } else {
+        frameView->paint(gc, IntRect(x, y, w, h));
+    }
     if (m_page->settings().showDebugBorders()) {
         drawDebugLed(gc, IntRect(x, y, w, h), SRGBA<uint8_t> { 0, 0, 255, 128 });
     }
@@ -330,6 +341,10 @@ void WebPage::scroll(const IntSize& scrollDelta,
         return;
     }
 
+    // Java moves its dirty rects along with the scrolled contents, the
+    // repaints requested before the scroll have to reach it first.
+    flushPendingRepaints();
+
     JNIEnv* env = WTF::GetJavaEnv();
 
     static jmethodID mid = env->GetMethodID(
@@ -355,11 +370,49 @@ void WebPage::repaint(const IntRect& rect)
     if (m_rootLayer) {
         m_rootLayer->setNeedsDisplayInRect(rect);
     }
+    if (m_tileCache) {
+        // The invalidations of the whole document are reported to keep the
+        // tiles up to date, only the visible part needs to be painted.
+        IntRect visibleRect = m_tileCache->invalidate(rect);
+        if (!visibleRect.isEmpty()) {
+            requestJavaRepaint(visibleRect);
+        }
+        return;
+    }
     requestJavaRepaint(rect);
 }
 
 void WebPage::requestJavaRepaint(const IntRect& rect)
 {
+    if (rect.isEmpty()) {
+        return;
+    }
+    ++m_requestedRepaintRectCount;
+    m_pendingRepaintRegion.unite(rect);
+    if (!m_repaintTimer.isActive()) {
+        m_repaintTimer.startOneShot(0_s);
+    }
+}
+
+void WebPage::flushPendingRepaints()
+{
+    // A region made of many rects, or one that covers most of its bounds,
+    // is sent as its bounds. One larger rect is cheaper for Java to paint
+    // than many separate ones.
+    static constexpr size_t maximumRepaintRectCount = 16;
+
+    m_repaintTimer.stop();
+    if (m_pendingRepaintRegion.isEmpty()) {
+        return;
+    }
+    Region region = std::exchange(m_pendingRepaintRegion, Region());
+    IntRect bounds = region.bounds();
+    Vector<IntRect, 1> rects = region.rects();
+    if (rects.size() > maximumRepaintRectCount
+            || region.totalArea() * 4 >= static_cast<uint64_t>(bounds.width()) * bounds.height() * 3) {
+        rects = { bounds };
+    }
+
     JNIEnv* env = WTF::GetJavaEnv();
 
     static jmethodID mid = env->GetMethodID(
@@ -368,14 +421,18 @@ void WebPage::requestJavaRepaint(const IntRect& rect)
             "(IIII)V");
     ASSERT(mid);
 
-    env->CallVoidMethod(
-            jobjectFromPage(m_page.get()),
-            mid,
-            rect.x(),
-            rect.y(),
-            rect.width(),
-            rect.height());
-    WTF::CheckAndClearException(env);
+    JLObject jlself = jobjectFromPage(m_page.get());
+    for (auto& rect : rects) {
+        ++m_submittedRepaintRectCount;
+        env->CallVoidMethod(
+                jlself,
+                mid,
+                rect.x(),
+                rect.y(),
+                rect.width(),
+                rect.height());
+        WTF::CheckAndClearException(env);
+    }
 }
 
 void WebPage::setRootChildLayer(GraphicsLayer* layer)
@@ -389,6 +446,11 @@ void WebPage::setRootChildLayer(GraphicsLayer* layer)
         m_rootLayer->addChild(*layer);
 
         m_textureMapper = std::make_unique<TextureMapperJavaAdapter>();
+
+        // The composited layers have their own backing store.
+        if (m_tileCache) {
+            m_tileCache->clear();
+        }
     } else {
         m_rootLayer = nullptr;
         m_textureMapper.reset();
@@ -404,10 +466,17 @@ void WebPage::scheduleRenderingUpdate()
     markForSync();
 }
 
+void WebPage::updateRendering()
+{
+    // The rects invalidated by the update reach Java as one batch.
+    m_page->isolatedUpdateRendering();
+    flushPendingRepaints();
+}
+
 void WebPage::markForSync()
 {
     if (!m_rootLayer) {
-        m_page->isolatedUpdateRendering();
+        updateRendering();
         return;
     }
     m_syncLayers = true;
@@ -879,16 +948,30 @@ namespace {
 bool s_useJIT;
 bool s_useDFGJIT;
 bool s_useCSS3D;
+bool s_useTileCache;
+uint64_t s_bytecodeCacheSize;
+
+String& bytecodeCacheDirectory()
+{
+    static NeverDestroyed<String> directory;
+    return directory;
+}
 
 }  // namespace
 
 extern "C" {
 
 JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkInitWebCore
-    (JNIEnv* env, jclass self, jboolean useJIT, jboolean useDFGJIT, jboolean useCSS3D) {
+    (JNIEnv* env, jclass self, jboolean useJIT, jboolean useDFGJIT, jboolean useCSS3D,
+     jboolean useTileCache, jstring bytecodeCacheDirectoryPath, jlong bytecodeCacheSize) {
     s_useJIT = useJIT;
     s_useDFGJIT = useDFGJIT;
     s_useCSS3D = useCSS3D;
+    s_useTileCache = useTileCache;
+    if (bytecodeCacheDirectoryPath) {
+        bytecodeCacheDirectory() = String(env, bytecodeCacheDirectoryPath);
+        s_bytecodeCacheSize = std::max<jlong>(bytecodeCacheSize, 0);
+    }
 }
 
 JNIEXPORT jlong JNICALL Java_com_sun_webkit_WebPage_twkCreatePage
@@ -917,6 +1000,8 @@ JNIEXPORT jlong JNICALL Java_com_sun_webkit_WebPage_twkCreatePage
         JSC::Options::useJIT() = s_useJIT;
         // Enable DFG only if JIT is enabled.
         JSC::Options::useDFGJIT() = s_useJIT && s_useDFGJIT;
+        ScriptBytecodeCacheJava::configure(bytecodeCacheDirectory(), s_bytecodeCacheSize);
+        TileCacheJava::setEnabled(s_useTileCache);
     });
 
     JLObject jlself(self, true);
@@ -1764,7 +1849,7 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkUpdateContent
 JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkUpdateRendering
     (JNIEnv*, jobject, jlong pPage)
 {
-    WebPage::pageFromJLong(pPage)->isolatedUpdateRendering();
+    WebPage::webPageFromJLong(pPage)->updateRendering();
 }
 
 JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkPostPaint
@@ -2616,10 +2701,44 @@ JNIEXPORT jint JNICALL Java_com_sun_webkit_WebPage_twkWorkerThreadCount
     return WorkerThread::workerThreadCount();
 }
 
+JNIEXPORT jlongArray JNICALL Java_com_sun_webkit_WebPage_twkGetRepaintRectCounts
+  (JNIEnv* env, jobject, jlong pPage)
+{
+    WebPage* webPage = WebPage::webPageFromJLong(pPage);
+    jlong counts[] = {
+        static_cast<jlong>(webPage->requestedRepaintRectCount()),
+        static_cast<jlong>(webPage->submittedRepaintRectCount())
+    };
+
+    jlongArray result = env->NewLongArray(2);
+    if (WTF::CheckAndClearException(env) || !result) {
+        return nullptr;
+    }
+    env->SetLongArrayRegion(result, 0, 2, counts);
+    return result;
+}
+
+JNIEXPORT jlong JNICALL Java_com_sun_webkit_WebPage_twkGetMemoryFootprint
+  (JNIEnv*, jclass)
+{
+    return static_cast<jlong>(WTF::memoryFootprint());
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkReleaseFreeMemory
+  (JNIEnv*, jclass)
+{
+    WTF::releaseFastMallocFreeMemory();
+}
+
 JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkDoJSCGarbageCollection
   (JNIEnv*, jclass)
 {
    GarbageCollectionController::singleton().garbageCollectNow();
+   // The event thread is created by the JVM and enters WebKit through JNI.
+   // On Linux the bmalloc scavenger cannot stop the allocators cached by
+   // another thread, so the pages they hold are only given back when the
+   // thread itself asks for it. No-op with the system allocator.
+   WTF::releaseFastMallocFreeMemoryForThisThread();
 }
 
 }
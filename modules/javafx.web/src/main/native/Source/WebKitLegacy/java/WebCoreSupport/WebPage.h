@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -30,11 +30,14 @@
 #include <WebCore/GraphicsLayerClient.h>
 #include <WebCore/IntRect.h>
 #include <WebCore/PrintContext.h>
+#include <WebCore/Region.h>
 #include <WebCore/ScrollTypes.h>
 #include <WebCore/HandleUserInputEventResult.h>
+#include <WebCore/Timer.h>
 
 #include "MediaPlayerPrivateJava.h"
 #include "TextureMapperJavaAdapter.h"
+#include "TileCacheJava.h"
 
 #include <jni.h> // todo tav remove when building w/ pch
 
@@ -98,6 +101,7 @@ public:
     void setRootChildLayer(GraphicsLayer*);
     void setNeedsOneShotDrawingSynchronization();
     void scheduleRenderingUpdate();
+    void updateRendering();
     void debugStarted();
     void debugEnded();
     void enableWatchdog();
@@ -105,8 +109,14 @@ public:
 
     RefPtr<RQRef> jRenderTheme();
 
+    // Number of rects requested for repainting and number of rects passed
+    // to Java after they were coalesced.
+    uint64_t requestedRepaintRectCount() const { return m_requestedRepaintRectCount; }
+    uint64_t submittedRepaintRectCount() const { return m_submittedRepaintRectCount; }
+
 private:
     void requestJavaRepaint(const IntRect&);
+    void flushPendingRepaints();
     void markForSync();
     void syncLayers();
     IntRect pageRect();
@@ -137,6 +147,16 @@ private:
     std::unique_ptr<TextureMapper> m_textureMapper;
     bool m_syncLayers { false };
 
+    std::unique_ptr<TileCacheJava> m_tileCache;
+
+    // Repaint requests are collected here and passed to Java at the end of
+    // the rendering update, or from a zero-delay timer when they are made
+    // outside of one.
+    Region m_pendingRepaintRegion;
+    Timer m_repaintTimer;
+    uint64_t m_requestedRepaintRectCount { 0 };
+    uint64_t m_submittedRepaintRectCount { 0 };
+
     // Webkit expects keyPress events to be suppressed if the associated keyDown
     // event was handled. Safari implements this behavior by peeking out the
     // associated WM_CHAR event if the keydown was handled. We emulate
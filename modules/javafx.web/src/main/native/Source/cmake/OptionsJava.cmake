@@ -78,6 +78,7 @@ else()
 endif()
 
 WEBKIT_OPTION_BEGIN()
+WEBKIT_OPTION_DEFINE(USE_WEBCORE_IMAGE_DECODERS "Whether to decode JPEG, PNG, GIF, WebP, BMP and ICO images with the WebCore image decoders instead of the Java decoder." PRIVATE OFF)
 WEBKIT_OPTION_DEFAULT_PORT_VALUE(ENABLE_DRAG_SUPPORT PUBLIC ON)
 WEBKIT_OPTION_DEFAULT_PORT_VALUE(ENABLE_TOUCH_EVENTS PUBLIC OFF)
 WEBKIT_OPTION_DEFAULT_PORT_VALUE(ENABLE_VIDEO PUBLIC ON)
@@ -111,6 +112,11 @@ WEBKIT_OPTION_DEFAULT_PORT_VALUE(ENABLE_MEDIA_SESSION PRIVATE ON)
 
 if (APPLE)
 WEBKIT_OPTION_DEFAULT_PORT_VALUE(USE_SYSTEM_MALLOC PRIVATE OFF)
+elseif (WTF_OS_LINUX AND (WTF_CPU_X86_64 OR WTF_CPU_ARM64) AND NOT USE_64KB_PAGE_BLOCK)
+# bmalloc and libpas keep fragmentation of long running pages in check and
+# provide the gigacage to JSC. Build with -DUSE_SYSTEM_MALLOC=ON, or
+# -PWEBKIT_SYSTEM_MALLOC=true with gradle, to compare with glibc malloc.
+WEBKIT_OPTION_DEFAULT_PORT_VALUE(USE_SYSTEM_MALLOC PRIVATE OFF)
 else()
 WEBKIT_OPTION_DEFAULT_PORT_VALUE(USE_SYSTEM_MALLOC PRIVATE ON)
 endif()
@@ -137,6 +143,11 @@ endif ()
 # this point, and do not attempt to change any option after this point.
 WEBKIT_OPTION_END()
 
+if (USE_WEBCORE_IMAGE_DECODERS)
+    find_package(JPEG REQUIRED)
+    find_package(PNG REQUIRED)
+    find_package(WebP REQUIRED COMPONENTS demux)
+endif ()
 
 set(ENABLE_WEBKIT_LEGACY ON)
 set(ENABLE_WEBKIT OFF)
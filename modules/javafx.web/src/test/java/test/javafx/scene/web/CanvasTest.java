@@ -245,6 +245,79 @@ public class CanvasTest extends TestBase {
         assertTrue("Color should be transparent black:" + pixelAt75x25, isColorsSimilar(Color.BLACK, pixelAt75x25, 1));
     }
 
+    @Test public void testCanvasPathHitTestAndFill() {
+        final String htmlCanvasPath =
+                "<canvas id='canvas' width='200' height='200'></canvas> <script>" +
+                        "var ctx = document.getElementById('canvas').getContext('2d');" +
+                        "ctx.beginPath();" +
+                        "ctx.moveTo(10, 10);" +
+                        "ctx.lineTo(190, 10);" +
+                        "ctx.lineTo(190, 190);" +
+                        "ctx.lineTo(10, 190);" +
+                        "ctx.closePath();" +
+                        "ctx.moveTo(50, 100);" +
+                        "ctx.quadraticCurveTo(100, 20, 150, 100);" +
+                        "ctx.bezierCurveTo(150, 160, 50, 160, 50, 100);" +
+                        "ctx.closePath();" +
+                        "window.nonZeroInner = ctx.isPointInPath(100, 100, 'nonzero');" +
+                        "window.evenOddInner = ctx.isPointInPath(100, 100, 'evenodd');" +
+                        "window.evenOddOuter = ctx.isPointInPath(20, 20, 'evenodd');" +
+                        "window.outside = ctx.isPointInPath(195, 195);" +
+                        "ctx.fillStyle = 'red';" +
+                        "ctx.fill('evenodd');" +
+                        "</script>";
+
+        loadContent(htmlCanvasPath);
+        submit(() -> {
+            assertTrue("Point inside both subpaths, nonzero rule",
+                    (Boolean) getEngine().executeScript("window.nonZeroInner"));
+            assertFalse("Point inside both subpaths, evenodd rule",
+                    (Boolean) getEngine().executeScript("window.evenOddInner"));
+            assertTrue("Point inside outer subpath only, evenodd rule",
+                    (Boolean) getEngine().executeScript("window.evenOddOuter"));
+            assertFalse("Point outside the path",
+                    (Boolean) getEngine().executeScript("window.outside"));
+            assertEquals("Filled pixel in the outer subpath", 255,
+                    (int) getEngine().executeScript("document.getElementById('canvas').getContext('2d').getImageData(20,20,1,1).data[0]"));
+            assertEquals("Unfilled pixel in the inner subpath", 0,
+                    (int) getEngine().executeScript("document.getElementById('canvas').getContext('2d').getImageData(100,100,1,1).data[3]"));
+        });
+    }
+
+    @Test public void testCanvasPathHitTestNearCurves() {
+        // (120, 32) lies on the quad and (86.4, 11) on the cubic. Both are
+        // between two points of a 64 segment flattening of the curve, where
+        // the chord is about 0.03 away from it.
+        final String htmlCanvasPath =
+                "<canvas id='canvas' width='400' height='200'></canvas> <script>" +
+                        "var ctx = document.getElementById('canvas').getContext('2d');" +
+                        "ctx.beginPath();" +
+                        "ctx.moveTo(0, 200);" +
+                        "ctx.quadraticCurveTo(200, -200, 400, 200);" +
+                        "ctx.closePath();" +
+                        "window.quadInside = ctx.isPointInPath(120, 32.01);" +
+                        "window.quadOutside = ctx.isPointInPath(120, 31.99);" +
+                        "ctx.beginPath();" +
+                        "ctx.moveTo(0, 200);" +
+                        "ctx.bezierCurveTo(0, -100, 400, -100, 400, 200);" +
+                        "ctx.closePath();" +
+                        "window.cubicInside = ctx.isPointInPath(86.4, 11.01);" +
+                        "window.cubicOutside = ctx.isPointInPath(86.4, 10.99);" +
+                        "</script>";
+
+        loadContent(htmlCanvasPath);
+        submit(() -> {
+            assertTrue("Point just inside the quad",
+                    (Boolean) getEngine().executeScript("window.quadInside"));
+            assertFalse("Point just outside the quad",
+                    (Boolean) getEngine().executeScript("window.quadOutside"));
+            assertTrue("Point just inside the cubic",
+                    (Boolean) getEngine().executeScript("window.cubicInside"));
+            assertFalse("Point just outside the cubic",
+                    (Boolean) getEngine().executeScript("window.cubicOutside"));
+        });
+    }
+
     @After
     public void resetSystemErr() {
         System.setErr(ERR);
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web;
+
+import com.sun.webkit.WebPage;
+import com.sun.webkit.WebPageShim;
+import java.awt.Color;
+import java.awt.image.BufferedImage;
+import javafx.application.ConditionalFeature;
+import javafx.application.Platform;
+import javafx.scene.web.WebEngineShim;
+import org.junit.Test;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assume.assumeTrue;
+
+public class CompositedLayerTest extends TestBase {
+    static {
+        // Read once when WebPage is initialized, every test class runs in
+        // its own VM.
+        System.setProperty("com.sun.webkit.useCSS3D", "true");
+    }
+
+    /**
+     * Loads an element that gets its own composited layer and checks that
+     * its contents are uploaded into the layer texture and drawn by the
+     * Java texture mapper.
+     */
+    @Test public void testCompositedLayerIsPainted() {
+        assumeTrue(Platform.isSupported(ConditionalFeature.SCENE3D));
+
+        loadContent("<html>\n" +
+                    "<body style='margin: 0px; background-color: #fff;'>\n" +
+                    "<div style='will-change: transform; transform: translateZ(0px); width: 100px; height: 100px; background-color: #00f;'></div>\n" +
+                    "<div style='will-change: transform; transform: translate3d(100px, 0px, 0px); opacity: 0.5; width: 100px; height: 100px; background-color: #000;'></div>\n" +
+                    "</body>\n" +
+                    "</html>");
+        submit(() -> {
+            final WebPage webPage = WebEngineShim.getPage(getEngine());
+            assertNotNull(webPage);
+            final BufferedImage img = WebPageShim.paint(webPage, 0, 0, 800, 600);
+            assertNotNull(img);
+
+            final Color pixelAt50x50 = new Color(img.getRGB(50, 50), true);
+            assertTrue("Color should be blue:" + pixelAt50x50, isColorsSimilar(Color.BLUE, pixelAt50x50, 1));
+            final Color pixelAt150x150 = new Color(img.getRGB(150, 150), true);
+            assertTrue("Color should be gray:" + pixelAt150x150, isColorsSimilar(Color.GRAY, pixelAt150x150, 1));
+            final Color pixelAt400x50 = new Color(img.getRGB(400, 50), true);
+            assertTrue("Color should be white:" + pixelAt400x50, isColorsSimilar(Color.WHITE, pixelAt400x50, 1));
+        });
+    }
+
+    /**
+     * Two planes of a preserve-3d context that cross each other are split
+     * by the 3D rendering context and each fragment is painted under its
+     * own polygon clip, so the front plane wins on either side of the
+     * intersection. Content painted after them must not be affected by
+     * those clips.
+     */
+    @Test public void testIntersectingPlanesArePaintedWithClips() {
+        assumeTrue(Platform.isSupported(ConditionalFeature.SCENE3D));
+
+        loadContent("<html>\n" +
+                    "<body style='margin: 0px; background-color: #fff;'>\n" +
+                    "<div style='position: absolute; left: 0px; top: 0px; width: 200px; height: 200px; perspective: 500px;'>\n" +
+                    "  <div style='position: absolute; width: 200px; height: 200px; transform-style: preserve-3d; transform: translateZ(0px);'>\n" +
+                    "    <div style='position: absolute; width: 200px; height: 200px; background-color: #f00; transform: rotateY(45deg);'></div>\n" +
+                    "    <div style='position: absolute; width: 200px; height: 200px; background-color: #0f0; transform: rotateY(-45deg);'></div>\n" +
+                    "  </div>\n" +
+                    "</div>\n" +
+                    "<div style='position: absolute; left: 300px; top: 0px; will-change: transform; transform: translateZ(0px); width: 100px; height: 100px; background-color: #00f;'></div>\n" +
+                    "</body>\n" +
+                    "</html>");
+        submit(() -> {
+            final WebPage webPage = WebEngineShim.getPage(getEngine());
+            assertNotNull(webPage);
+            final BufferedImage img = WebPageShim.paint(webPage, 0, 0, 800, 600);
+            assertNotNull(img);
+
+            // The red plane is in front left of the intersection, the green one right of it
+            final Color pixelAt60x100 = new Color(img.getRGB(60, 100), true);
+            assertTrue("Color should be red:" + pixelAt60x100, isColorsSimilar(Color.RED, pixelAt60x100, 1));
+            final Color pixelAt140x100 = new Color(img.getRGB(140, 100), true);
+            assertTrue("Color should be green:" + pixelAt140x100, isColorsSimilar(Color.GREEN, pixelAt140x100, 1));
+            final Color pixelAt350x50 = new Color(img.getRGB(350, 50), true);
+            assertTrue("Color should be blue:" + pixelAt350x50, isColorsSimilar(Color.BLUE, pixelAt350x50, 1));
+        });
+    }
+}
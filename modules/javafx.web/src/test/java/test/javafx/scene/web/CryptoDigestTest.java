@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertNotNull;
+
+import com.sun.webkit.CryptoDigest;
+import java.nio.charset.StandardCharsets;
+import java.util.Arrays;
+import java.util.HexFormat;
+import org.junit.Test;
+
+/**
+ * Known answer tests from FIPS 180 for the digests behind WebCrypto. The
+ * messages are added whole and in chunks that do and do not line up with
+ * the block size, each digest is computed twice to check that the digest is
+ * reset, and SHA-1 and SHA-256 run with both the block functions selected
+ * for this CPU and the portable ones. TestBase loads the native library.
+ */
+public class CryptoDigestTest extends TestBase {
+
+    private static final String TWO_BLOCKS =
+            "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    private static final String TWO_LONG_BLOCKS =
+            "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+            + "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+
+    private static final int[] CHUNK_SIZES = { 1, 3, 63, 64, 65, 127, 128, 1000, Integer.MAX_VALUE };
+
+    private static void check(int algorithm, byte[] message, String expected) {
+        byte[] hash = HexFormat.of().parseHex(expected);
+        for (boolean portable : new boolean[] { false, true }) {
+            for (int chunkSize : CHUNK_SIZES) {
+                byte[] hashes = CryptoDigest.digest(algorithm, message, chunkSize, 2, portable);
+                String what = "algorithm " + algorithm + ", " + message.length + " bytes in chunks of "
+                        + chunkSize + (portable ? ", portable" : "");
+                assertArrayEquals(what, hash, Arrays.copyOfRange(hashes, 0, hash.length));
+                assertArrayEquals(what + ", reused", hash, Arrays.copyOfRange(hashes, hash.length, 2 * hash.length));
+            }
+        }
+    }
+
+    private static void check(int algorithm, String message, String expected) {
+        check(algorithm, message.getBytes(StandardCharsets.US_ASCII), expected);
+    }
+
+    private static byte[] millionA() {
+        byte[] message = new byte[1_000_000];
+        Arrays.fill(message, (byte) 'a');
+        return message;
+    }
+
+    @Test public void testAcceleration() {
+        assertNotNull(CryptoDigest.getAcceleration());
+    }
+
+    @Test public void testSHA1() {
+        check(CryptoDigest.SHA_1, "", "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+        check(CryptoDigest.SHA_1, "abc", "a9993e364706816aba3e25717850c26c9cd0d89d");
+        check(CryptoDigest.SHA_1, TWO_BLOCKS, "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+        check(CryptoDigest.SHA_1, millionA(), "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+    }
+
+    @Test public void testSHA224() {
+        check(CryptoDigest.SHA_224, "", "d14a028c2a3a2bc9476102bb288234c415a2b01f828ea62ac5b3e42f");
+        check(CryptoDigest.SHA_224, "abc", "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7");
+        check(CryptoDigest.SHA_224, TWO_BLOCKS, "75388b16512776cc5dba5da1fd890150b0c6455cb4f58b1952522525");
+        check(CryptoDigest.SHA_224, millionA(), "20794655980c91d8bbb4c1ea97618a4bf03f42581948b2ee4ee7ad67");
+    }
+
+    @Test public void testSHA256() {
+        check(CryptoDigest.SHA_256, "", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+        check(CryptoDigest.SHA_256, "abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+        check(CryptoDigest.SHA_256, TWO_BLOCKS, "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+        check(CryptoDigest.SHA_256, millionA(), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+    }
+
+    @Test public void testSHA384() {
+        check(CryptoDigest.SHA_384, "",
+                "38b060a751ac96384cd9327eb1b1e36a21fdb71114be07434c0cc7bf63f6e1da274edebfe76f65fbd51ad2f14898b95b");
+        check(CryptoDigest.SHA_384, "abc",
+                "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed8086072ba1e7cc2358baeca134c825a7");
+        check(CryptoDigest.SHA_384, TWO_LONG_BLOCKS,
+                "09330c33f71147e83d192fc782cd1b4753111b173b3b05d22fa08086e3b0f712fcc7c71a557e2db966c3e9fa91746039");
+        check(CryptoDigest.SHA_384, millionA(),
+                "9d0e1809716474cb086e834e310a4a1ced149e9c00f248527972cec5704c2a5b07b8b3dc38ecc4ebae97ddd87f3d8985");
+    }
+
+    @Test public void testSHA512() {
+        check(CryptoDigest.SHA_512, "",
+                "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce"
+                + "47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e");
+        check(CryptoDigest.SHA_512, "abc",
+                "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+                + "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+        check(CryptoDigest.SHA_512, TWO_LONG_BLOCKS,
+                "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018"
+                + "501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909");
+        check(CryptoDigest.SHA_512, millionA(),
+                "e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973eb"
+                + "de0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b");
+    }
+}
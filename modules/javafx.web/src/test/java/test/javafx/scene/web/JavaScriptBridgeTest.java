@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -651,6 +651,38 @@ public class JavaScriptBridgeTest extends TestBase {
         }
     }
 
+    // This package is not exported, so these calls take the reflective
+    // path; the direct one is covered by the system JavaScriptBridgeDirectCallTest.
+    public static class PrimitiveBridge {
+        public Object lastObject;
+        public int addInt(int a, int b) { return a + b; }
+        public double scaleDouble(double d, float f) { return d * f; }
+        public long negateLong(long l) { return -l; }
+        public boolean not(boolean b) { return !b; }
+        public char firstChar(String s) { return s.charAt(0); }
+        public String concat(String s, int i) { return s + i; }
+        public void keep(Object o) { lastObject = o; }
+    }
+
+    public @Test void testMethodCallWithPrimitives() {
+        final WebEngine web = getEngine();
+
+        submit(() -> {
+            PrimitiveBridge test = new PrimitiveBridge();
+            bind("test", test);
+            assertEquals(42, web.executeScript("test.addInt(40, 2)"));
+            assertEquals(7.5, web.executeScript("test.scaleDouble(2.5, 3)"));
+            assertEquals(-7, web.executeScript("test.negateLong(7)"));
+            assertEquals(Boolean.FALSE, web.executeScript("test.not(true)"));
+            assertEquals("J", web.executeScript("String(test.firstChar('JavaFX'))"));
+            assertEquals("abc3", web.executeScript("test.concat('abc', 3)"));
+            web.executeScript("test.keep('str')");
+            assertEquals("str", test.lastObject);
+            web.executeScript("test.keep(test)");
+            assertSame(test, test.lastObject);
+        });
+    }
+
 
     public @Test void testBridgeArray1() {
         final WebEngine web = getEngine();
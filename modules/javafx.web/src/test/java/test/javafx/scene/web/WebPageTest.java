@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -27,10 +27,12 @@ package test.javafx.scene.web;
 
 import com.sun.webkit.WebPage;
 import com.sun.webkit.WebPageShim;
+import com.sun.webkit.graphics.WCRenderQueue;
 import javafx.scene.web.WebEngineShim;
 
 import static org.junit.Assert.assertEquals;
 import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
 import org.junit.Test;
 
 public class WebPageTest extends TestBase {
@@ -89,6 +91,60 @@ public class WebPageTest extends TestBase {
                 "test/html/icutagparse.html").toExternalForm());
     }
 
+    @Test public void testRepaintRectsAreCoalesced() {
+        final WebPage page = WebEngineShim.getPage(getEngine());
+
+        StringBuilder content = new StringBuilder();
+        for (int i = 0; i < 50; i++) {
+            content.append("<span id='s").append(i).append("'>").append(i).append("</span> ");
+        }
+        loadContent(content.toString());
+        submit(() -> {
+            // Send the repaints still pending from the load first
+            page.updateRendering();
+            long[] before = page.getRepaintRectCounts();
+            getEngine().executeScript(
+                "for (var i = 0; i < 50; i++) {" +
+                "    document.getElementById('s' + i).style.color = 'red';" +
+                "}");
+            // The rendering update repaints the spans and flushes the
+            // coalesced rects to Java
+            page.updateRendering();
+            long[] after = page.getRepaintRectCounts();
+            long requested = after[0] - before[0];
+            long submitted = after[1] - before[1];
+            assertTrue("Several repaints should be requested, requested: " + requested,
+                    requested > 1);
+            assertTrue("Repaints should be submitted", submitted > 0);
+            assertTrue("Fewer rects should be submitted than requested, submitted: "
+                    + submitted + ", requested: " + requested,
+                    submitted < requested);
+        });
+    }
+
+    @Test public void testRenderQueueBuffersAreReused() {
+        final WebPage page = WebEngineShim.getPage(getEngine());
+
+        loadContent(HTML);
+        // The buffers of the first paint are released to the pool once
+        // they have been decoded on the render thread
+        submit(() -> {
+            WebPageShim.paint(page, 0, 0, 800, 600);
+        });
+        final long[] before = submit(() -> WCRenderQueue.getBufferPoolCounts());
+        for (int i = 0; i < 5; i++) {
+            submit(() -> {
+                WebPageShim.paint(page, 0, 0, 800, 600);
+            });
+        }
+        final long[] after = submit(() -> WCRenderQueue.getBufferPoolCounts());
+        long hits = after[0] - before[0];
+        long misses = after[1] - before[1];
+        assertTrue("Repaints should reuse released buffers, hits: " + hits, hits > 0);
+        assertTrue("Repaints should mostly reuse buffers, hits: " + hits
+                + ", misses: " + misses, misses < hits);
+    }
+
     @Test(expected = IllegalStateException.class)
     public void testGetClientTextLocationFromNonEventThread() {
         WebPage page = WebEngineShim.getPage(getEngine());
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Measures the decoding throughput of libavcodec for the video stream of a
+ * file with the settings of the media av plugin, once on a single thread and
+ * once with the frame and slice threads the plugin picks by default.
+ *
+ * Build and run from the repository root, for example on Linux:
+ *
+ *   gcc -O2 tests/performance/avDecoder/AVDecoderBenchmark.c \
+ *       $(pkg-config --cflags --libs libavformat libavcodec libavutil) \
+ *       -o avDecoder && ./avDecoder file.mp4 [threads [iterations]]
+ *
+ * The threads argument works like the thread-count property of the plugin,
+ * 0 picks the number of threads from the number of processors.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <libavformat/avformat.h>
+#include <libavcodec/avcodec.h>
+
+#define MAX_AUTO_THREAD_COUNT 16
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int receiveFrames(AVCodecContext *context, AVFrame *frame) {
+    int frames = 0;
+    while (avcodec_receive_frame(context, frame) == 0) {
+        frames++;
+    }
+    return frames;
+}
+
+/*
+ * Decodes the whole stream, returns the number of frames or -1 on error.
+ */
+static int decode(const char *path, int threads, double *seconds) {
+    AVFormatContext *format = NULL;
+    AVCodecContext *context = NULL;
+    const AVCodec *codec = NULL;
+    AVPacket *packet = av_packet_alloc();
+    AVFrame *frame = av_frame_alloc();
+    int stream, frames = -1;
+    double start;
+
+    if (avformat_open_input(&format, path, NULL, NULL) < 0
+            || avformat_find_stream_info(format, NULL) < 0) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        goto done;
+    }
+
+    stream = av_find_best_stream(format, AVMEDIA_TYPE_VIDEO, -1, -1, &codec, 0);
+    if (stream < 0) {
+        fprintf(stderr, "No video stream in %s\n", path);
+        goto done;
+    }
+
+    context = avcodec_alloc_context3(codec);
+    avcodec_parameters_to_context(context, format->streams[stream]->codecpar);
+    if (threads > 0) {
+        context->thread_count = threads;
+    } else {
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        context->thread_count = processors < MAX_AUTO_THREAD_COUNT ? (int)processors : MAX_AUTO_THREAD_COUNT;
+    }
+    context->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+    if (avcodec_open2(context, codec, NULL) < 0) {
+        fprintf(stderr, "Cannot open the %s decoder\n", codec->name);
+        goto done;
+    }
+
+    frames = 0;
+    start = now();
+    while (av_read_frame(format, packet) >= 0) {
+        if (packet->stream_index == stream && avcodec_send_packet(context, packet) == 0) {
+            frames += receiveFrames(context, frame);
+        }
+        av_packet_unref(packet);
+    }
+    // Drain the frames the decoding threads still hold.
+    if (avcodec_send_packet(context, NULL) == 0) {
+        frames += receiveFrames(context, frame);
+    }
+    *seconds = now() - start;
+
+    printf("%s %dx%d, %d threads: %d frames\n", codec->name,
+           context->width, context->height, context->thread_count, frames);
+
+done:
+    avcodec_free_context(&context);
+    avformat_close_input(&format);
+    av_frame_free(&frame);
+    av_packet_free(&packet);
+    return frames;
+}
+
+static void run(const char *path, int threads, int iterations) {
+    double seconds, best = 0;
+    int i, frames = 0;
+
+    for (i = 0; i < iterations; i++) {
+        frames = decode(path, threads, &seconds);
+        if (frames <= 0) {
+            exit(1);
+        }
+        if (i == 0 || seconds < best) {
+            best = seconds;
+        }
+    }
+    printf("  %.1f fps, %.2f ms per frame\n", frames / best, best * 1000 / frames);
+}
+
+int main(int argc, char *argv[]) {
+    int threads = 0, iterations = 3;
+
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s file [threads [iterations]]\n", argv[0]);
+        return 1;
+    }
+    if (argc > 2) {
+        threads = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        iterations = atoi(argv[3]);
+    }
+
+    run(argv[1], 1, iterations);
+    run(argv[1], threads, iterations);
+    return 0;
+}
@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Checks that the SIMD variants of the jfxmedia color converters produce
+ * the same pixels as the scalar ones and reports their throughput.
+ *
+ * Build and run from the repository root, for example on Linux:
+ *
+ *   gcc -O2 -DTARGET_OS_LINUX=1 \
+ *       -Imodules/javafx.media/src/main/native/jfxmedia \
+ *       -Imodules/javafx.media/src/main/native/jfxmedia/Utils \
+ *       modules/javafx.media/src/main/native/jfxmedia/Utils/ColorConverter.c \
+ *       tests/performance/colorConverter/ColorConverterBenchmark.c \
+ *       -o colorConverter && ./colorConverter [width height [iterations]]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ColorConverter.h"
+
+static const char *levelNames[] = { "scalar", "sse2", "avx2", "neon" };
+
+enum { FMT_420P, FMT_422, FMT_NV12, FMT_P010, FMT_420P10, FMT_422P, FMT_422P10, FMT_COUNT };
+static const char *formatNames[] = { "420p", "422 (UYVY)", "NV12", "P010", "420p10", "422p", "422p10" };
+
+static int width, height;
+static uint8_t *yPlane, *uPlane, *vPlane, *uvPlane, *packed;
+static uint16_t *y16Plane, *uv16Plane;
+static uint16_t *y10Plane, *u10Plane, *v10Plane;
+static uint8_t *y422Plane, *u422Plane, *v422Plane;
+static uint16_t *y422p10Plane, *u422p10Plane, *v422p10Plane;
+static uint8_t *dst, *ref;
+static int dstStride;
+
+static unsigned int seed = 12345;
+
+static unsigned int nextRandom() {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) & 0xffffff;
+}
+
+static void initPlanes() {
+    int cw = (width + 1) / 2, ch = (height + 1) / 2;
+    int i, j;
+
+    yPlane = malloc((size_t)width * height);
+    uPlane = malloc((size_t)cw * ch);
+    vPlane = malloc((size_t)cw * ch);
+    uvPlane = malloc((size_t)cw * 2 * ch);
+    packed = malloc((size_t)cw * 4 * height);
+    y16Plane = malloc((size_t)width * height * 2);
+    uv16Plane = malloc((size_t)cw * 4 * ch);
+    y10Plane = malloc((size_t)width * height * 2);
+    u10Plane = malloc((size_t)cw * ch * 2);
+    v10Plane = malloc((size_t)cw * ch * 2);
+    y422Plane = malloc((size_t)cw * 2 * height);
+    u422Plane = malloc((size_t)cw * height);
+    v422Plane = malloc((size_t)cw * height);
+    y422p10Plane = malloc((size_t)cw * 4 * height);
+    u422p10Plane = malloc((size_t)cw * 2 * height);
+    v422p10Plane = malloc((size_t)cw * 2 * height);
+    // The SSE2 4:2:0 code stores whole 16 byte aligned vectors
+    dstStride = (width * 4 + 15) & ~15;
+    dst = aligned_alloc(16, (size_t)dstStride * height);
+    ref = aligned_alloc(16, (size_t)dstStride * height);
+
+    for (i = 0; i < width * height; i++) {
+        yPlane[i] = (uint8_t)nextRandom();
+        // 10 bit sample in the low bits, and in the high bits for P010
+        y10Plane[i] = (uint16_t)(nextRandom() & 0x3ff);
+        y16Plane[i] = (uint16_t)(y10Plane[i] << 6);
+    }
+    for (i = 0; i < cw * ch; i++) {
+        uPlane[i] = (uint8_t)nextRandom();
+        vPlane[i] = (uint8_t)nextRandom();
+        // NV12 holds the same chroma as the planar source
+        uvPlane[2 * i] = uPlane[i];
+        uvPlane[2 * i + 1] = vPlane[i];
+        u10Plane[i] = (uint16_t)(nextRandom() & 0x3ff);
+        v10Plane[i] = (uint16_t)(nextRandom() & 0x3ff);
+        uv16Plane[2 * i] = (uint16_t)(u10Plane[i] << 6);
+        uv16Plane[2 * i + 1] = (uint16_t)(v10Plane[i] << 6);
+    }
+    for (j = 0; j < height; j++) {
+        for (i = 0; i < cw; i++) {
+            uint8_t *p = packed + (size_t)j * cw * 4 + i * 4;
+            p[0] = (uint8_t)nextRandom();
+            p[1] = (uint8_t)nextRandom();
+            p[2] = (uint8_t)nextRandom();
+            p[3] = (uint8_t)nextRandom();
+        }
+    }
+    // Planar 4:2:2 holds the samples of the packed source, one pixel pair
+    // after the other, so both line up for any stride of cw pairs.
+    for (i = 0; i < cw * height; i++) {
+        u422Plane[i] = packed[4 * i];
+        y422Plane[2 * i] = packed[4 * i + 1];
+        v422Plane[i] = packed[4 * i + 2];
+        y422Plane[2 * i + 1] = packed[4 * i + 3];
+        u422p10Plane[i] = (uint16_t)(u422Plane[i] << 2);
+        v422p10Plane[i] = (uint16_t)(v422Plane[i] << 2);
+        y422p10Plane[2 * i] = (uint16_t)(y422Plane[2 * i] << 2);
+        y422p10Plane[2 * i + 1] = (uint16_t)(y422Plane[2 * i + 1] << 2);
+    }
+}
+
+static int convert(int format, int bgra) {
+    int cw = (width + 1) / 2;
+    switch (format) {
+        case FMT_420P:
+            return bgra
+                ? ColorConvert_YCbCr420p_to_BGRA32_no_alpha(dst, dstStride, width, height,
+                        yPlane, vPlane, uPlane, width, cw, cw)
+                : ColorConvert_YCbCr420p_to_ARGB32_no_alpha(dst, dstStride, width, height,
+                        yPlane, vPlane, uPlane, width, cw, cw);
+        case FMT_422:
+            return bgra
+                ? ColorConvert_YCbCr422p_to_BGRA32_no_alpha(dst, dstStride, width, height,
+                        packed + 1, packed + 2, packed, cw * 4, cw * 4)
+                : ColorConvert_YCbCr422p_to_ARGB32_no_alpha(dst, dstStride, width, height,
+                        packed + 1, packed + 2, packed, cw * 4, cw * 4);
+        case FMT_NV12:
+            return bgra
+                ? ColorConvert_NV12_to_BGRA32_no_alpha(dst, dstStride, width, height,
+                        yPlane, uvPlane, width, cw * 2)
+                : ColorConvert_NV12_to_ARGB32_no_alpha(dst, dstStride, width, height,
+                        yPlane, uvPlane, width, cw * 2);
+        case FMT_P010:
+            return bgra
+                ? ColorConvert_P010_to_BGRA32_no_alpha(dst, dstStride, width, height,
+                        y16Plane, uv16Plane, width * 2, cw * 4)
+                : ColorConvert_P010_to_ARGB32_no_alpha(dst, dstStride, width, height,
+                        y16Plane, uv16Plane, width * 2, cw * 4);
+        case FMT_420P10:
+            return bgra
+                ? ColorConvert_YCbCr420p10_to_BGRA32_no_alpha(dst, dstStride, width, height,
+                        y10Plane, v10Plane, u10Plane, width * 2, cw * 2, cw * 2)
+                : ColorConvert_YCbCr420p10_to_ARGB32_no_alpha(dst, dstStride, width, height,
+                        y10Plane, v10Plane, u10Plane, width * 2, cw * 2, cw * 2);
+        case FMT_422P:
+            return bgra
+                ? ColorConvert_YCbCr422planar_to_BGRA32_no_alpha(dst, dstStride, width, height,
+                        y422Plane, v422Plane, u422Plane, cw * 2, cw, cw)
+                : ColorConvert_YCbCr422planar_to_ARGB32_no_alpha(dst, dstStride, width, height,
+                        y422Plane, v422Plane, u422Plane, cw * 2, cw, cw);
+        case FMT_422P10:
+            return bgra
+                ? ColorConvert_YCbCr422planar10_to_BGRA32_no_alpha(dst, dstStride, width, height,
+                        y422p10Plane, v422p10Plane, u422p10Plane, cw * 4, cw * 2, cw * 2)
+                : ColorConvert_YCbCr422planar10_to_ARGB32_no_alpha(dst, dstStride, width, height,
+                        y422p10Plane, v422p10Plane, u422p10Plane, cw * 4, cw * 2, cw * 2);
+    }
+    return 1;
+}
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ * The reference of each format is its scalar conversion, except for 4:2:0:
+ * below the AVX2 level it runs the SSE2 code which predates the scalar
+ * rows, so it is checked at every level against the scalar NV12
+ * conversion of the same samples. 10 bit 4:2:0 is checked against the
+ * scalar P010 conversion of the same samples, and planar 4:2:2 against the
+ * scalar UYVY conversion of the same samples.
+ */
+static int check(int format, int bgra, int level) {
+    int refFormat = (format == FMT_420P) ? FMT_NV12 : (format == FMT_420P10) ? FMT_P010
+            : (format == FMT_422P || format == FMT_422P10) ? FMT_422 : format;
+    size_t size = (size_t)dstStride * height;
+    size_t i;
+
+    ColorConvert_SetSIMDLevel(0);
+    memset(dst, 0, size);
+    if (convert(refFormat, bgra) != 0) {
+        printf("  %s %s: scalar conversion failed\n", formatNames[refFormat], bgra ? "BGRA" : "ARGB");
+        return 0;
+    }
+    memcpy(ref, dst, size);
+
+    ColorConvert_SetSIMDLevel(level);
+    memset(dst, 0, size);
+    if (convert(format, bgra) != 0) {
+        printf("  %s %s %s: conversion failed\n", formatNames[format], bgra ? "BGRA" : "ARGB",
+               levelNames[level]);
+        return 0;
+    }
+    for (i = 0; i < size; i++) {
+        if (dst[i] != ref[i]) {
+            printf("  %s %s %s: mismatch at pixel (%d, %d) byte %d: %d != %d\n",
+                   formatNames[format], bgra ? "BGRA" : "ARGB", levelNames[level],
+                   (int)((i % dstStride) / 4), (int)(i / dstStride), (int)(i % 4),
+                   dst[i], ref[i]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    int iterations = 50;
+    int levels[4];
+    int levelCount = 0;
+    int level, format, bgra, it;
+    int failures = 0;
+
+    width = argc > 1 ? atoi(argv[1]) : 1920;
+    height = argc > 2 ? atoi(argv[2]) : 1080;
+    iterations = argc > 3 ? atoi(argv[3]) : iterations;
+    if (width <= 0 || height <= 0 || ((width | height) & 1) || iterations <= 0) {
+        fprintf(stderr, "usage: %s [width height [iterations]] (even sizes)\n", argv[0]);
+        return 2;
+    }
+    initPlanes();
+
+    for (level = 0; level <= 3; level++) {
+        if (ColorConvert_SetSIMDLevel(level) == level) {
+            levels[levelCount++] = level;
+        }
+    }
+
+    printf("Correctness (%dx%d and %dx%d):\n", width, height, width - 3, height);
+    for (format = 0; format < FMT_COUNT; format++) {
+        for (bgra = 0; bgra <= 1; bgra++) {
+            for (level = 0; level < levelCount; level++) {
+                failures += !check(format, bgra, levels[level]);
+            }
+        }
+    }
+    // Odd widths leave a tail for the scalar code, except in 4:2:0
+    width -= 3;
+    for (format = FMT_422; format < FMT_COUNT; format++) {
+        for (level = 0; level < levelCount; level++) {
+            failures += !check(format, 1, levels[level]);
+        }
+    }
+    width += 3;
+    printf("  %s\n", failures ? "FAILED" : "all variants match");
+
+    printf("Throughput (BGRA, %d frames):\n", iterations);
+    for (format = 0; format < FMT_COUNT; format++) {
+        for (level = 0; level < levelCount; level++) {
+            double start, elapsed;
+            ColorConvert_SetSIMDLevel(levels[level]);
+            convert(format, 1);
+            start = now();
+            for (it = 0; it < iterations; it++) {
+                convert(format, 1);
+            }
+            elapsed = now() - start;
+            printf("  %-12s %-11s %8.1f Mpixel/s %7.2f ms/frame\n",
+                   formatNames[format], levelNames[levels[level]],
+                   (double)width * height * iterations / elapsed / 1e6,
+                   elapsed * 1000 / iterations);
+        }
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Checks that CGstVideoFrame parses the caps the av video decoder puts on
+ * its native-only frames (NV12, P010_10LE, I420_10LE, Y42B and I422_10LE,
+ * with FFmpeg style padded line sizes) and that converting them to
+ * BGRA_PRE, as CGstAVPlaybackPipeline::ToDisplayFormat() does, gives the
+ * same pixels as the color converter run directly on the planes.
+ *
+ * Build and run from the repository root after the media module has been
+ * built once (for the JNI headers), for example on Linux:
+ *
+ *   M=modules/javafx.media
+ *   J=$M/src/main/native/jfxmedia
+ *   g++ -O2 -DTARGET_OS_LINUX=1 -I$J -I$J/Utils \
+ *       -I$M/build/gensrc/headers/javafx.media \
+ *       -I$JAVA_HOME/include -I$JAVA_HOME/include/linux \
+ *       $(pkg-config --cflags gstreamer-1.0) \
+ *       -x c $J/Utils/ColorConverter.c -x c++ \
+ *       $J/PipelineManagement/VideoFrame.cpp \
+ *       $J/platform/gstreamer/GstVideoFrame.cpp \
+ *       tests/performance/colorConverter/GstVideoFrameCheck.cpp \
+ *       $(pkg-config --libs gstreamer-1.0) \
+ *       -o gstVideoFrameCheck && ./gstVideoFrameCheck [width height]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gst/gst.h>
+#include <jni/Logger.h>
+#include <platform/gstreamer/GstVideoFrame.h>
+#include "ColorConverter.h"
+
+// GstVideoFrame only logs through the Java logger, which is not there.
+CLogger::LSingleton CLogger::s_Singleton;
+
+uint32_t CLogger::CreateInstance(CLogger **ppLogger)
+{
+    return ERROR_MEMORY_ALLOCATION;
+}
+
+void CLogger::logMsg(int level, const char *msg) {}
+void CLogger::logMsg(int level, const char *sourceClass, const char *sourceMethod, const char *msg) {}
+
+struct Format {
+    const char *name;
+    int planeCount;     // 2 for interleaved chroma
+    int sampleSize;     // bytes per sample
+    int chromaShift;    // vertical chroma subsampling
+    int shift;          // where the 8 bit test sample goes in a 16 bit sample
+};
+
+static const Format formats[] = {
+    { "NV12",      2, 1, 1, 0 },
+    { "P010_10LE", 2, 2, 1, 8 },
+    { "I420_10LE", 3, 2, 1, 2 },
+    { "Y42B",      3, 1, 0, 0 },
+    { "I422_10LE", 3, 2, 0, 2 },
+};
+
+static unsigned int seed = 12345;
+
+static unsigned int nextRandom()
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) & 0xffffff;
+}
+
+// FFmpeg pads its line sizes, the decoder passes them on as strides
+static int lineSize(int samples, int sampleSize)
+{
+    return (samples * sampleSize + 63) & ~63;
+}
+
+static void putSample(uint8_t *p, const Format &f, uint8_t v)
+{
+    if (f.sampleSize == 1) {
+        *p = v;
+    } else {
+        *(uint16_t*)p = (uint16_t)(v << f.shift);
+    }
+}
+
+/*
+ * Lays the planes out in one buffer the way videodecoder_configure_sourcepad()
+ * describes it, and builds the reference image from tightly packed copies.
+ */
+static int checkFormat(const Format &f, int width, int height)
+{
+    int cw = width / 2;
+    int ch = height >> f.chromaShift;
+    int ls0 = lineSize(width, f.sampleSize);
+    int ls1 = lineSize(f.planeCount == 2 ? cw * 2 : cw, f.sampleSize);
+    int uOffset = ls0 * height;
+    int uvBlockSize = ls1 * ch;
+    int vOffset = uOffset + uvBlockSize;
+    int frameSize = uOffset + uvBlockSize * (f.planeCount - 1);
+    int stride = (width * 4 + 15) & ~15;
+    int i, j, failures = 0;
+
+    uint8_t *frame = (uint8_t*)g_malloc0(frameSize);
+    uint16_t *y = (uint16_t*)malloc((size_t)width * height * 2);
+    uint16_t *u = (uint16_t*)malloc((size_t)cw * ch * 2);
+    uint16_t *v = (uint16_t*)malloc((size_t)cw * ch * 2);
+    uint16_t *uv = (uint16_t*)malloc((size_t)cw * ch * 4);
+    uint8_t *ref = (uint8_t*)calloc((size_t)stride, height);
+
+    for (j = 0; j < height; j++) {
+        for (i = 0; i < width; i++) {
+            uint8_t s = (uint8_t)nextRandom();
+            putSample(frame + j * ls0 + i * f.sampleSize, f, s);
+            y[j * width + i] = (uint16_t)(s << f.shift);
+        }
+    }
+    for (j = 0; j < ch; j++) {
+        for (i = 0; i < cw; i++) {
+            uint8_t cb = (uint8_t)nextRandom();
+            uint8_t cr = (uint8_t)nextRandom();
+            if (f.planeCount == 2) {
+                putSample(frame + uOffset + j * ls1 + 2 * i * f.sampleSize, f, cb);
+                putSample(frame + uOffset + j * ls1 + (2 * i + 1) * f.sampleSize, f, cr);
+            } else {
+                putSample(frame + uOffset + j * ls1 + i * f.sampleSize, f, cb);
+                putSample(frame + vOffset + j * ls1 + i * f.sampleSize, f, cr);
+            }
+            u[j * cw + i] = (uint16_t)(cb << f.shift);
+            v[j * cw + i] = (uint16_t)(cr << f.shift);
+            uv[2 * (j * cw + i)] = u[j * cw + i];
+            uv[2 * (j * cw + i) + 1] = v[j * cw + i];
+        }
+    }
+
+    if (f.sampleSize == 1) {
+        // The 8 bit planes are needed as bytes
+        uint8_t *y8 = (uint8_t*)y, *u8 = (uint8_t*)u, *v8 = (uint8_t*)v, *uv8 = (uint8_t*)uv;
+        for (i = 0; i < width * height; i++) y8[i] = (uint8_t)y[i];
+        for (i = 0; i < cw * ch; i++) { u8[i] = (uint8_t)u[i]; v8[i] = (uint8_t)v[i]; }
+        for (i = 0; i < cw * ch * 2; i++) uv8[i] = (uint8_t)uv[i];
+        if (f.planeCount == 2) {
+            ColorConvert_NV12_to_BGRA32_no_alpha(ref, stride, width, height, y8, uv8, width, cw * 2);
+        } else {
+            ColorConvert_YCbCr422planar_to_BGRA32_no_alpha(ref, stride, width, height,
+                    y8, v8, u8, width, cw, cw);
+        }
+    } else if (f.planeCount == 2) {
+        ColorConvert_P010_to_BGRA32_no_alpha(ref, stride, width, height, y, uv, width * 2, cw * 4);
+    } else if (f.chromaShift) {
+        ColorConvert_YCbCr420p10_to_BGRA32_no_alpha(ref, stride, width, height,
+                y, v, u, width * 2, cw * 2, cw * 2);
+    } else {
+        ColorConvert_YCbCr422planar10_to_BGRA32_no_alpha(ref, stride, width, height,
+                y, v, u, width * 2, cw * 2, cw * 2);
+    }
+
+    GstBuffer *buffer = gst_buffer_new_wrapped(frame, frameSize);
+    GST_BUFFER_TIMESTAMP(buffer) = GST_SECOND;
+    GST_BUFFER_DURATION(buffer) = GST_SECOND / 30;
+
+    GstCaps *caps;
+    if (f.planeCount == 2) {
+        caps = gst_caps_new_simple("video/x-raw-yuv",
+                                   "format", G_TYPE_STRING, f.name,
+                                   "width", G_TYPE_INT, width,
+                                   "height", G_TYPE_INT, height,
+                                   "stride-y", G_TYPE_INT, ls0,
+                                   "stride-uv", G_TYPE_INT, ls1,
+                                   "offset-y", G_TYPE_INT, 0,
+                                   "offset-uv", G_TYPE_INT, uOffset,
+                                   "framerate", GST_TYPE_FRACTION, 2997, 100,
+                                   NULL);
+    } else {
+        caps = gst_caps_new_simple("video/x-raw-yuv",
+                                   "format", G_TYPE_STRING, f.name,
+                                   "width", G_TYPE_INT, width,
+                                   "height", G_TYPE_INT, height,
+                                   "stride-y", G_TYPE_INT, ls0,
+                                   "stride-u", G_TYPE_INT, ls1,
+                                   "stride-v", G_TYPE_INT, ls1,
+                                   "offset-y", G_TYPE_INT, 0,
+                                   "offset-u", G_TYPE_INT, uOffset,
+                                   "offset-v", G_TYPE_INT, vOffset,
+                                   "framerate", GST_TYPE_FRACTION, 2997, 100,
+                                   NULL);
+    }
+
+    GstSample *sample = gst_sample_new(buffer, caps, NULL, NULL);
+    gst_caps_unref(caps);
+    gst_buffer_unref(buffer);
+
+    CGstVideoFrame *videoFrame = new CGstVideoFrame();
+    CVideoFrame *converted = NULL;
+    if (!videoFrame->Init(sample) || !videoFrame->IsValid()) {
+        printf("%-10s frame not valid\n", f.name);
+        failures++;
+    } else if (!videoFrame->IsNativeOnly()) {
+        printf("%-10s frame not native-only\n", f.name);
+        failures++;
+    } else if ((converted = videoFrame->ConvertToFormat(CVideoFrame::BGRA_PRE)) == NULL) {
+        printf("%-10s conversion failed\n", f.name);
+        failures++;
+    } else if (converted->GetType() != CVideoFrame::BGRA_PRE
+               || converted->GetWidth() != (unsigned int)width
+               || converted->GetHeight() != (unsigned int)height
+               || converted->GetStrideForPlane(0) != (unsigned int)stride) {
+        printf("%-10s converted frame has the wrong type or size\n", f.name);
+        failures++;
+    } else {
+        const uint8_t *out = (const uint8_t*)converted->GetDataForPlane(0);
+        for (j = 0; j < height; j++) {
+            if (memcmp(out + j * stride, ref + j * stride, width * 4) != 0) {
+                printf("%-10s row %d differs\n", f.name, j);
+                failures++;
+                break;
+            }
+        }
+        if (!failures) {
+            printf("%-10s ok\n", f.name);
+        }
+    }
+
+    if (converted) {
+        converted->Dispose();
+        delete converted;
+    }
+    videoFrame->Dispose();
+    delete videoFrame;
+    gst_sample_unref(sample);
+    free(y);
+    free(u);
+    free(v);
+    free(uv);
+    free(ref);
+    return failures;
+}
+
+int main(int argc, char **argv)
+{
+    int width = 318, height = 180;
+    int failures = 0;
+    size_t i;
+
+    if (argc >= 3) {
+        width = atoi(argv[1]);
+        height = atoi(argv[2]);
+    }
+    // The decoder only produces even sizes
+    width &= ~1;
+    height &= ~1;
+    if (width <= 0 || height <= 0) {
+        fprintf(stderr, "usage: %s [width height]\n", argv[0]);
+        return 2;
+    }
+
+    gst_init(&argc, &argv);
+    for (i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+        failures += checkFormat(formats[i], width, height);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Checks that the SIMD and multithreaded variants of the Decora SSE peer
+ * kernels produce the same pixels as the scalar ones and reports their
+ * throughput. Each kernel is measured over a range of kernel sizes, from
+ * the small ones where the setup of the vector loops dominates to the
+ * largest the peers accept, so the size at which each variant starts to
+ * pay off shows in the speedup column.
+ *
+ * Build and run from the repository root, for example on Linux:
+ *
+ *   g++ -O2 -ffast-math -I$JAVA_HOME/include -I$JAVA_HOME/include/linux \
+ *       -Imodules/javafx.graphics/src/main/native-decora \
+ *       modules/javafx.graphics/src/main/native-decora/SSEKernels.cc \
+ *       modules/javafx.graphics/src/main/native-decora/SSEThreadPool.cc \
+ *       tests/performance/decoraKernels/DecoraKernelsBenchmark.cc \
+ *       -lpthread -o decoraKernels && ./decoraKernels [width height [threads]]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include "SSEKernels.h"
+#include "SSEThreadPool.h"
+
+static const char *levelNames[] = { "scalar", "sse2", "avx2" };
+
+struct Image {
+    std::vector<jint> pixels;
+    jint w, h, scan;
+};
+
+static Image randomImage(jint w, jint h, jint scan, unsigned seed)
+{
+    Image img;
+    img.w = w;
+    img.h = h;
+    img.scan = scan;
+    img.pixels.resize((size_t) scan * h);
+    srand(seed);
+    for (size_t i = 0; i < img.pixels.size(); i++) {
+        // Premultiplied, with some fully transparent and opaque areas.
+        jint a = rand() % 320 - 32;
+        a = (a < 0) ? 0 : ((a > 255) ? 255 : a);
+        jint r = (rand() % 256) * a / 255;
+        jint g = (rand() % 256) * a / 255;
+        jint b = (rand() % 256) * a / 255;
+        img.pixels[i] = (a << 24) | (r << 16) | (g << 8) | b;
+    }
+    return img;
+}
+
+struct Case {
+    const char *name;
+    void (*run)(jint *dst, const Image &src, jint ksize);
+    bool hv;
+    bool convolve;
+    jint dstw(const Image &src, jint ksize) const { return hv ? src.w + ksize - 1 : src.w; }
+    jint dsth(const Image &src, jint ksize) const { return hv ? src.h : src.h + ksize - 1; }
+};
+
+// Box kernels take any size up to 255. The convolve peers get kernels
+// padded to a multiple of 4 below 32 and of 32 above, up to 128 (see
+// LinearConvolveRenderState.getPeerSize).
+static const jint boxSizes[] = { 3, 5, 9, 17, 33, 65, 129, 255 };
+static const jint convolveSizes[] = { 4, 8, 16, 32, 64, 128 };
+
+static const jfloat shadowColor[4] = { 0.25f, 0.5f, 0.75f, 0.8f };
+
+static void gaussianKernel(jfloat *kvals, jint ksize)
+{
+    // The peers get the weights twice so any window start can be read
+    // without wrapping.
+    jfloat total = 0.0f;
+    jint r = ksize / 2;
+    for (jint i = 0; i < ksize; i++) {
+        jfloat d = (jfloat) (i - r) / (r + 1);
+        kvals[i] = 1.0f - d * d;
+        total += kvals[i];
+    }
+    for (jint i = 0; i < ksize; i++) {
+        kvals[i] /= total;
+        kvals[i + ksize] = kvals[i];
+    }
+}
+
+static void runBlurH(jint *dst, const Image &s, jint k)
+{
+    boxBlurHorizontal(dst, s.w + k - 1, s.h, s.w + k - 1, s.pixels.data(), s.w, s.h, s.scan);
+}
+
+static void runBlurV(jint *dst, const Image &s, jint k)
+{
+    boxBlurVertical(dst, s.w, s.h + k - 1, s.w, s.pixels.data(), s.w, s.h, s.scan);
+}
+
+static void runShadowH(jint *dst, const Image &s, jint k)
+{
+    boxShadowHorizontalBlack(dst, s.w + k - 1, s.h, s.w + k - 1, s.pixels.data(), s.w, s.h, s.scan, 0.3f);
+}
+
+static void runShadowVBlack(jint *dst, const Image &s, jint k)
+{
+    boxShadowVerticalBlack(dst, s.w, s.h + k - 1, s.w, s.pixels.data(), s.w, s.h, s.scan, 0.3f);
+}
+
+static void runShadowV(jint *dst, const Image &s, jint k)
+{
+    boxShadowVertical(dst, s.w, s.h + k - 1, s.w, s.pixels.data(), s.w, s.h, s.scan, 0.3f, shadowColor);
+}
+
+static void runConvolveH(jint *dst, const Image &s, jint k)
+{
+    jfloat kvals[256];
+    gaussianKernel(kvals, k);
+    jint dstw = s.w + k - 1;
+    linearConvolveHV(dst, dstw, s.h, 1, dstw, s.pixels.data(), s.w, 1, s.scan, kvals, k);
+}
+
+static void runConvolveV(jint *dst, const Image &s, jint k)
+{
+    jfloat kvals[256];
+    gaussianKernel(kvals, k);
+    linearConvolveHV(dst, s.h + k - 1, s.w, s.w, 1, s.pixels.data(), s.h, s.scan, 1, kvals, k);
+}
+
+static void runConvolveShadowH(jint *dst, const Image &s, jint k)
+{
+    jfloat kvals[256];
+    gaussianKernel(kvals, k);
+    jint shadowRGBs[256];
+    for (jint i = 0; i < 256; i++) {
+        shadowRGBs[i] = ((int) (shadowColor[0] * i) << 16) |
+                        ((int) (shadowColor[1] * i) <<  8) |
+                        ((int) (shadowColor[2] * i) <<  0) |
+                        ((int) (shadowColor[3] * i) << 24);
+    }
+    jint dstw = s.w + k - 1;
+    linearConvolveShadowHV(dst, dstw, s.h, 1, dstw, s.pixels.data(), s.w, 1, s.scan,
+                           kvals, k, shadowRGBs);
+}
+
+// Runs the case up to 20 times, stopping early after 250 ms so the large
+// scalar kernels do not dominate the run time.
+static double timeRun(const Case &tc, jint ksize, std::vector<jint> &dst, const Image &src)
+{
+    int iterations = 0;
+    std::chrono::duration<double, std::milli> elapsed(0);
+    auto start = std::chrono::steady_clock::now();
+    do {
+        tc.run(dst.data(), src, ksize);
+        iterations++;
+        elapsed = std::chrono::steady_clock::now() - start;
+    } while (iterations < 20 && elapsed.count() < 250.0);
+    return elapsed.count() / iterations;
+}
+
+int main(int argc, char **argv)
+{
+    jint w = (argc > 2) ? atoi(argv[1]) : 1021;
+    jint h = (argc > 2) ? atoi(argv[2]) : 767;
+    jint threads = (argc > 3) ? atoi(argv[3]) : 4;
+    Image src = randomImage(w, h, w + 3, 42);
+
+    Case cases[] = {
+        { "boxBlurHorizontal",        runBlurH,           true,  false },
+        { "boxBlurVertical",          runBlurV,           false, false },
+        { "boxShadowHorizontalBlack", runShadowH,         true,  false },
+        { "boxShadowVerticalBlack",   runShadowVBlack,    false, false },
+        { "boxShadowVertical",        runShadowV,         false, false },
+        { "linearConvolveH",          runConvolveH,       true,  true  },
+        { "linearConvolveV",          runConvolveV,       false, true  },
+        { "linearConvolveShadowH",    runConvolveShadowH, true,  true  },
+    };
+
+    // Every SIMD level on one thread, then the best level on all threads.
+    int maxLevel = setDecoraSIMDLevel(DECORA_SIMD_AVX2);
+    int runs = maxLevel + 1 + (threads > 1 ? 1 : 0);
+    int failures = 0;
+    printf("%dx%d pixels, best SIMD level: %s, %d threads\n",
+           w, h, levelNames[maxLevel], threads);
+    printf("%-26s %5s %-10s %11s  %6s\n", "kernel", "size", "variant", "time", "speedup");
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        const Case &tc = cases[c];
+        const jint *sizes = tc.convolve ? convolveSizes : boxSizes;
+        size_t sizeCount = tc.convolve
+            ? sizeof(convolveSizes) / sizeof(convolveSizes[0])
+            : sizeof(boxSizes) / sizeof(boxSizes[0]);
+        for (size_t k = 0; k < sizeCount; k++) {
+            jint ksize = sizes[k];
+            size_t n = (size_t) tc.dstw(src, ksize) * tc.dsth(src, ksize);
+            std::vector<jint> expected(n);
+            double scalarTime = 0.0;
+            for (int run = 0; run < runs; run++) {
+                int level = (run > maxLevel) ? maxLevel : run;
+                jint runThreads = (run > maxLevel) ? threads : 1;
+                setDecoraSIMDLevel(level);
+                setDecoraThreading(runThreads, 128 * 128);
+                char label[32];
+                snprintf(label, sizeof(label), "%s x%d", levelNames[level], runThreads);
+
+                std::vector<jint> dst(n, 0x12345678);
+                tc.run(dst.data(), src, ksize);
+                if (run == 0) {
+                    expected = dst;
+                } else if (memcmp(dst.data(), expected.data(), n * sizeof(jint)) != 0) {
+                    printf("%-26s %5d %-10s MISMATCH\n", tc.name, ksize, label);
+                    failures++;
+                    continue;
+                }
+                double ms = timeRun(tc, ksize, dst, src);
+                if (run == 0) {
+                    scalarTime = ms;
+                }
+                printf("%-26s %5d %-10s %8.3f ms  %5.2fx\n",
+                       tc.name, ksize, label, ms, scalarTime / ms);
+            }
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Measures banded (multithreaded) rasterization of large fills in the
+ * Pisces renderer over fill sizes and paint types, and checks that it
+ * produces the same pixels as rendering on one thread.
+ *
+ * Build and run from the repository root, for example on Linux:
+ *
+ *   SW=modules/javafx.graphics/src/main/native-prism-sw
+ *   gcc -O2 -DINLINE=inline -I$JAVA_HOME/include -I$JAVA_HOME/include/linux \
+ *       -I<dir with the generated com_sun_pisces_RendererBase.h> -I$SW \
+ *       $SW/PiscesBlit.c $SW/PiscesBlitSpans.c $SW/PiscesPaint.c \
+ *       $SW/PiscesThreads.c $SW/PiscesTransform.c $SW/PiscesMath.c \
+ *       $SW/PiscesSysutils.c $SW/PiscesUtil.c \
+ *       tests/performance/piscesBands/PiscesBandsBenchmark.c \
+ *       -lm -lpthread -o piscesBands && ./piscesBands [threads [iterations]]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <PiscesRenderer.inl>
+#include <PiscesThreads.h>
+
+#define PAINT_TYPES 5
+
+static const char *paintNames[PAINT_TYPES] = {
+    "color", "linear", "radial", "texture", "mask+linear"
+};
+
+static const jint sizes[][2] = { { 256, 256 }, { 1024, 1024 }, { 3840, 2160 } };
+
+static jint gradientColors[GRADIENT_MAP_SIZE];
+static jint *texture;
+static jbyte *mask;
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void setPaint(Renderer *rdr, int type, jint w, jint h) {
+    Transform6 identity = { 1 << 16, 0, 0, 1 << 16, 0, 0 };
+    Transform6 scale = { (64 << 16) / w, 0, 0, (64 << 16) / h, 0, 0 };
+
+    renderer_setCompositeRule(rdr, COMPOSITE_SRC_OVER);
+    renderer_setColor(rdr, 40, 120, 200, 200);
+    switch (type) {
+    case 1:
+    case 4:
+        renderer_setLinearGradient(rdr, 0, 0, w << 16, h << 16,
+                                   gradientColors, &identity);
+        break;
+    case 2:
+        renderer_setRadialGradient(rdr, (w / 2) << 16, (h / 2) << 16,
+                                   (w / 3) << 16, (h / 3) << 16, (w / 2) << 16,
+                                   gradientColors, &identity);
+        break;
+    case 3:
+        renderer_setTexture(rdr, IMAGE_MODE_NORMAL, texture, 64, 64, 64,
+                            XNI_FALSE, XNI_TRUE, &scale, XNI_FALSE, XNI_TRUE,
+                            0, 0, 63, 63);
+        break;
+    }
+}
+
+/* Does what JPiscesRenderer's fillRect and fillAlphaMask do for the rows. */
+static void fill(Renderer *rdr, Surface *surface, int type, jint w, jint h) {
+    if (type == 4) {
+        renderer_setMask(rdr, ALPHA_MASK, mask, w, h, XNI_FALSE);
+    }
+    INVALIDATE_RENDERER_SURFACE(rdr);
+    VALIDATE_BLITTING(rdr);
+
+    rdr->_minTouched = 0;
+    rdr->_maxTouched = w - 1;
+    rdr->_currX = 0;
+    rdr->_currY = 0;
+    rdr->_alphaWidth = w;
+    rdr->_currImageOffset = 0;
+    rdr->_imageScanlineStride = surface->width;
+    rdr->_imagePixelStride = 1;
+    rdr->_rowNum = 0;
+    rdr->_el_lfrac = 0;
+    rdr->_el_rfrac = 0;
+
+    if (type == 4) {
+        rdr->_maskOffset = 0;
+        emitMaskRows(rdr, h, w, 0);
+        renderer_removeMask(rdr);
+    } else {
+        emitRectRows(rdr, h);
+    }
+}
+
+int main(int argc, char **argv) {
+    jint threads = argc > 1 ? atoi(argv[1]) : 4;
+    jint iterations = argc > 2 ? atoi(argv[2]) : 10;
+    jint maxW = 3840, maxH = 2160;
+    jint *expected = malloc(maxW * maxH * sizeof(jint));
+    Surface surface;
+    Renderer *rdr;
+    int failures = 0;
+    jint i, s, type, it;
+
+    texture = malloc(64 * 64 * sizeof(jint));
+    mask = malloc(maxW * maxH);
+    for (i = 0; i < 64 * 64; i++) {
+        texture[i] = ((i & 8) ^ ((i >> 6) & 8)) ? 0xff2060a0 : 0x80401000;
+    }
+    for (i = 0; i < maxW * maxH; i++) {
+        mask[i] = (jbyte)((i * 7) ^ (i / maxW));
+    }
+    for (i = 0; i < GRADIENT_MAP_SIZE; i++) {
+        gradientColors[i] = 0xff000000 | (i << 16) | ((255 - i) << 8) | (i / 2);
+    }
+
+    surface.width = maxW;
+    surface.height = maxH;
+    surface.offset = 0;
+    surface.scanlineStride = maxW;
+    surface.pixelStride = 1;
+    surface.imageType = TYPE_INT_ARGB_PRE;
+    surface.data = malloc(maxW * maxH * sizeof(jint));
+    surface.alphaData = NULL;
+
+    rdr = renderer_create(&surface);
+    renderer_setClip(rdr, 0, 0, maxW, maxH);
+
+    printf("%-12s %11s %10s %10s %8s\n", "paint", "size", "1 thread", "threads", "speedup");
+    for (type = 0; type < PAINT_TYPES; type++) {
+        for (s = 0; s < (jint)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+            jint w = sizes[s][0], h = sizes[s][1];
+            double t1, tn, start;
+
+            setPaint(rdr, type, w, h);
+
+            piscesSetThreading(1, 128 * 128);
+            memset(surface.data, 0x40, maxW * maxH * sizeof(jint));
+            start = now();
+            for (it = 0; it < iterations; it++) {
+                fill(rdr, &surface, type, w, h);
+            }
+            t1 = (now() - start) / iterations;
+            memcpy(expected, surface.data, maxW * maxH * sizeof(jint));
+
+            piscesSetThreading(threads, 128 * 128);
+            memset(surface.data, 0x40, maxW * maxH * sizeof(jint));
+            start = now();
+            for (it = 0; it < iterations; it++) {
+                fill(rdr, &surface, type, w, h);
+            }
+            tn = (now() - start) / iterations;
+
+            if (memcmp(expected, surface.data, maxW * maxH * sizeof(jint)) != 0) {
+                printf("%s %dx%d: banded result differs\n", paintNames[type], w, h);
+                failures++;
+            }
+            printf("%-12s %5dx%-5d %8.2fms %8.2fms %7.2fx\n", paintNames[type], w, h,
+                   t1 * 1e3, tn * 1e3, t1 / tn);
+        }
+    }
+    renderer_dispose(rdr);
+    printf(failures ? "FAILED\n" : "PASSED\n");
+    return failures ? 1 : 0;
+}
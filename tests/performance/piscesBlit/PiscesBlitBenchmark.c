@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Checks that the SIMD span loops used by the Pisces blitters produce the
+ * same pixels as the scalar ones and reports their throughput.
+ *
+ * Build and run from the repository root, for example on Linux:
+ *
+ *   gcc -O2 -DINLINE=inline -I$JAVA_HOME/include -I$JAVA_HOME/include/linux \
+ *       -Imodules/javafx.graphics/src/main/native-prism-sw \
+ *       modules/javafx.graphics/src/main/native-prism-sw/PiscesBlitSpans.c \
+ *       tests/performance/piscesBlit/PiscesBlitBenchmark.c \
+ *       -lm -o piscesBlit && ./piscesBlit [width [iterations]]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "PiscesBlitSpans.h"
+
+static const char *levelNames[] = { "scalar", "sse2", "avx2", "neon" };
+
+static jint gammaTable[256];
+static jint invGammaTable[256];
+
+static jint *dst;
+static jint *ref;
+static jint *orig;
+static jint *paint;
+static jint *aval;
+static jint *frac;
+static jint *coverage;
+static jbyte *lcdMask;
+
+static unsigned int seed = 12345;
+
+static jint nextRandom() {
+    seed = seed * 1103515245 + 12345;
+    return (jint)((seed >> 8) & 0xffffff) ^ (jint)(seed << 24);
+}
+
+/* Mostly empty or full coverage, like the inside and outside of a shape. */
+static jint randomCoverage() {
+    jint r = nextRandom() & 0xff;
+    if (r < 64) {
+        return 0;
+    } else if (r < 128) {
+        return 255;
+    }
+    return nextRandom() & 0xff;
+}
+
+static jint randomPremultiplied() {
+    jint a = nextRandom() & 0xff;
+    jint r = (nextRandom() & 0xff) * a / 255;
+    jint g = (nextRandom() & 0xff) * a / 255;
+    jint b = (nextRandom() & 0xff) * a / 255;
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+static void fill(jint width) {
+    jint i;
+    for (i = 0; i < width; i++) {
+        /* Destination pixels are arbitrary, to also compare overflows. */
+        orig[i] = nextRandom();
+        paint[i] = randomPremultiplied();
+        coverage[i] = randomCoverage();
+        aval[i] = (coverage[i] * 200) / 255;
+        frac[i] = coverage[i] ? coverage[i] + 1 : 0;
+        lcdMask[3 * i] = (jbyte) randomCoverage();
+        lcdMask[3 * i + 1] = (jbyte) randomCoverage();
+        lcdMask[3 * i + 2] = (jbyte) randomCoverage();
+    }
+}
+
+static void runSpan(int kind, jint *data, jint count) {
+    switch (kind) {
+    case 0:
+        blendSpanSrcOver8888_pre(data, 1, aval, count, 10, 200, 90);
+        break;
+    case 1:
+        blendSpanSrc8888_pre(data, 1, coverage, count, 180, 10, 200, 90);
+        break;
+    case 2:
+        blendSpanPTSrcOver8888_pre(data, 1, paint, frac, count);
+        break;
+    case 3:
+        blendSpanPTSrc8888_pre(data, 1, paint, coverage, count);
+        break;
+    case 4:
+        blendSpanLCDSrcOver8888_pre(data, 1, lcdMask, count, 200, 10, 200, 90,
+                                    gammaTable, invGammaTable);
+        break;
+    }
+}
+
+static const char *spanNames[] = {
+    "SrcOver", "Src", "PTSrcOver", "PTSrc", "LCDSrcOver"
+};
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    jint width = argc > 1 ? atoi(argv[1]) : 4093;
+    jint iterations = argc > 2 ? atoi(argv[2]) : 2000;
+    jint best = piscesGetSIMDLevel();
+    int failures = 0;
+    jint kind, level, count, i, it;
+
+    dst = malloc(width * sizeof(jint));
+    ref = malloc(width * sizeof(jint));
+    orig = malloc(width * sizeof(jint));
+    paint = malloc(width * sizeof(jint));
+    aval = malloc(width * sizeof(jint));
+    frac = malloc(width * sizeof(jint));
+    coverage = malloc(width * sizeof(jint));
+    lcdMask = malloc(3 * width);
+    for (i = 0; i < 256; i++) {
+        gammaTable[i] = (jint)(255 * pow(i / 255.0, 1.4));
+        invGammaTable[i] = (jint)(255 * pow(i / 255.0, 1 / 1.4));
+    }
+    printf("best SIMD level: %s\n", levelNames[best]);
+
+    for (kind = 0; kind < 5; kind++) {
+        for (level = PISCES_SIMD_NONE; level <= PISCES_SIMD_NEON; level++) {
+            double start, elapsed;
+            if (level != PISCES_SIMD_NONE && piscesSetSIMDLevel(level) != level) {
+                continue;
+            }
+            /* Exactness, for every span length up to 67 and the full width. */
+            for (count = 1; count <= 68; count++) {
+                jint n = (count == 68) ? width : count;
+                fill(width);
+                piscesSetSIMDLevel(PISCES_SIMD_NONE);
+                memcpy(ref, orig, width * sizeof(jint));
+                runSpan(kind, ref, n);
+                piscesSetSIMDLevel(level);
+                memcpy(dst, orig, width * sizeof(jint));
+                runSpan(kind, dst, n);
+                if (memcmp(ref, dst, width * sizeof(jint)) != 0) {
+                    for (i = 0; i < width && ref[i] == dst[i]; i++) {
+                    }
+                    printf("%s/%s: mismatch at %d of %d: %08x != %08x\n",
+                           spanNames[kind], levelNames[level], i, n, dst[i], ref[i]);
+                    failures++;
+                    break;
+                }
+            }
+            piscesSetSIMDLevel(level);
+            fill(width);
+            start = now();
+            for (it = 0; it < iterations; it++) {
+                memcpy(dst, orig, width * sizeof(jint));
+                runSpan(kind, dst, width);
+            }
+            elapsed = now() - start;
+            printf("%-10s %-6s %8.1f Mpixel/s\n", spanNames[kind], levelNames[level],
+                   (double) width * iterations / elapsed / 1e6);
+        }
+    }
+    piscesSetSIMDLevel(best);
+    printf(failures ? "FAILED\n" : "PASSED\n");
+    return failures ? 1 : 0;
+}
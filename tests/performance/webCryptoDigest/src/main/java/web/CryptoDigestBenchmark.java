@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package web;
+
+import com.sun.webkit.CryptoDigest;
+import java.nio.ByteBuffer;
+import java.security.MessageDigest;
+import java.util.ArrayDeque;
+import java.util.Queue;
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.concurrent.Worker;
+import javafx.scene.web.WebEngine;
+import javafx.stage.Stage;
+import netscape.javascript.JSObject;
+
+/**
+ * Compares the native digests behind WebCrypto with the former digest path
+ * of the web module, for small and large inputs.
+ *
+ * <ul>
+ * <li>native: SHADigestJava through com.sun.webkit.CryptoDigest, one
+ *     addBytes and computeHash per digest, with a single JNI call for all
+ *     digests of a round.
+ * <li>JNI path: what CryptoDigest used to do through WCMessageDigest per
+ *     digest: a new java.security.MessageDigest, the input wrapped in a
+ *     direct ByteBuffer, and the hash returned as a byte[]. The three JNI
+ *     transitions of the former path are not included, so it is measured
+ *     in its favor.
+ * <li>WebView: crypto.subtle.digest end to end, which has no SHA-224.
+ * </ul>
+ *
+ * Usage: java --add-exports javafx.web/com.sun.webkit=ALL-UNNAMED
+ *            web.CryptoDigestBenchmark [total bytes per round]
+ */
+public class CryptoDigestBenchmark extends Application {
+
+    private static final int WARMUP_ROUNDS = 3;
+    private static final int ROUNDS = 5;
+
+    private record Algorithm(String name, int id, boolean inWebCrypto) { }
+
+    private static final Algorithm[] ALGORITHMS = {
+        new Algorithm("SHA-1", CryptoDigest.SHA_1, true),
+        new Algorithm("SHA-224", CryptoDigest.SHA_224, false),
+        new Algorithm("SHA-256", CryptoDigest.SHA_256, true),
+        new Algorithm("SHA-384", CryptoDigest.SHA_384, true),
+        new Algorithm("SHA-512", CryptoDigest.SHA_512, true)
+    };
+    private static final int[] SIZES = { 64, 1024, 1024 * 1024 };
+
+    private static final String SCRIPT =
+            "async function runDigest(algorithm, size, iterations, rounds) {"
+            + "  var data = new Uint8Array(size);"
+            + "  for (var i = 0; i < size; i++) data[i] = i * 31;"
+            + "  var total = 0;"
+            + "  for (var r = 0; r < rounds; r++) {"
+            + "    var t0 = performance.now();"
+            + "    for (var i = 0; i < iterations; i++) await crypto.subtle.digest(algorithm, data);"
+            + "    total += performance.now() - t0;"
+            + "  }"
+            + "  return total;"
+            + "}";
+
+    public class Callback {
+        public void done(double ms) {
+            Platform.runLater(() -> finishCase(ms));
+        }
+
+        public void failed(String message) {
+            System.out.println("crypto.subtle.digest failed: " + message);
+            Platform.exit();
+        }
+    }
+
+    private record Case(Algorithm algorithm, int size) { }
+
+    private final Queue<Case> cases = new ArrayDeque<>();
+    private long bytesPerRound = 16L * 1024 * 1024;
+    private WebEngine engine;
+    private Case current;
+
+    @Override
+    public void start(Stage stage) {
+        var args = getParameters().getRaw();
+        if (!args.isEmpty()) {
+            bytesPerRound = Long.parseLong(args.get(0));
+        }
+
+        for (Algorithm algorithm : ALGORITHMS) {
+            for (int size : SIZES) {
+                cases.add(new Case(algorithm, size));
+            }
+        }
+
+        // Creating the engine also loads the native library
+        engine = new WebEngine();
+        engine.getLoadWorker().stateProperty().addListener((ov, o, n) -> {
+            if (n == Worker.State.SUCCEEDED) {
+                JSObject window = (JSObject) engine.executeScript("window");
+                window.setMember("callback", new Callback());
+                engine.executeScript(SCRIPT);
+                System.out.println("Bytes per round: " + bytesPerRound
+                        + ", SHA-1/SHA-256 block functions: " + CryptoDigest.getAcceleration());
+                System.out.printf("%-8s %8s %14s %14s %14s%n", "", "size", "native", "JNI path", "WebView");
+                nextCase();
+            }
+        });
+        engine.loadContent("<html><body></body></html>");
+    }
+
+    private int iterations(int size) {
+        return (int) Math.max(1, bytesPerRound / size);
+    }
+
+    private void nextCase() {
+        current = cases.poll();
+        if (current == null) {
+            Platform.exit();
+            return;
+        }
+        if (!current.algorithm().inWebCrypto()) {
+            finishCase(Double.NaN);
+            return;
+        }
+        // The digests resolve asynchronously, the script reports back when
+        // the warmup and measured rounds are done.
+        String name = current.algorithm().name();
+        int iterations = iterations(current.size());
+        engine.executeScript("runDigest('" + name + "', " + current.size() + ", "
+                + iterations + ", " + WARMUP_ROUNDS + ")"
+                + ".then(() => runDigest('" + name + "', " + current.size() + ", "
+                + iterations + ", " + ROUNDS + "))"
+                + ".then(ms => callback.done(ms), e => callback.failed(String(e)))");
+    }
+
+    private void finishCase(double webViewMs) {
+        double nativeMs = measureNative(current.algorithm(), current.size());
+        double jniMs = measureMessageDigest(current.algorithm(), current.size());
+        System.out.printf("%-8s %8d %9.1f MB/s %9.1f MB/s %14s%n",
+                current.algorithm().name(), current.size(),
+                throughput(nativeMs), throughput(jniMs),
+                Double.isNaN(webViewMs) ? "-" : String.format("%9.1f MB/s", throughput(webViewMs)));
+        nextCase();
+    }
+
+    private double throughput(double ms) {
+        return (double) bytesPerRound * ROUNDS / (1024 * 1024) / (ms / 1000);
+    }
+
+    private static byte[] input(int size) {
+        byte[] data = new byte[size];
+        for (int i = 0; i < size; i++) {
+            data[i] = (byte) (i * 31);
+        }
+        return data;
+    }
+
+    private double measureNative(Algorithm algorithm, int size) {
+        byte[] data = input(size);
+        int iterations = iterations(size);
+        long sink = 0;
+        for (int i = 0; i < WARMUP_ROUNDS; i++) {
+            sink += CryptoDigest.digest(algorithm.id(), data, size, iterations, false)[0];
+        }
+        long t0 = System.nanoTime();
+        for (int i = 0; i < ROUNDS; i++) {
+            sink += CryptoDigest.digest(algorithm.id(), data, size, iterations, false)[0];
+        }
+        double ms = (System.nanoTime() - t0) / 1_000_000.0;
+        // keep the digests from being optimized away
+        return sink == 42 ? ms + Double.MIN_VALUE : ms;
+    }
+
+    private double measureMessageDigest(Algorithm algorithm, int size) {
+        try {
+            ByteBuffer data = ByteBuffer.allocateDirect(size);
+            data.put(input(size)).flip();
+            int iterations = iterations(size);
+            long sink = 0;
+            for (int i = 0; i < WARMUP_ROUNDS; i++) {
+                sink += digestRound(algorithm.name(), data, iterations);
+            }
+            long t0 = System.nanoTime();
+            for (int i = 0; i < ROUNDS; i++) {
+                sink += digestRound(algorithm.name(), data, iterations);
+            }
+            double ms = (System.nanoTime() - t0) / 1_000_000.0;
+            return sink == 42 ? ms + Double.MIN_VALUE : ms;
+        } catch (Exception e) {
+            throw new RuntimeException(e);
+        }
+    }
+
+    private static long digestRound(String algorithm, ByteBuffer data, int iterations) throws Exception {
+        long sink = 0;
+        for (int i = 0; i < iterations; i++) {
+            // CryptoDigest::create, addBytes and computeHash of the JNI path
+            MessageDigest digest = MessageDigest.getInstance(algorithm);
+            digest.update(data.duplicate());
+            sink += digest.digest()[0];
+        }
+        return sink;
+    }
+
+    public static void main(String[] args) {
+        Application.launch(args);
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package web;
+
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.concurrent.Worker;
+import javafx.scene.web.WebEngine;
+import javafx.stage.Stage;
+import netscape.javascript.JSObject;
+
+/**
+ * Measures the cost of calling Java methods from JavaScript through the
+ * WebView bridge for a few common argument shapes.
+ *
+ * Usage: JavaBridgeBenchmark [iterations]
+ */
+public class JavaBridgeBenchmark extends Application {
+
+    private static final int WARMUP_ROUNDS = 3;
+    private static final int ROUNDS = 5;
+
+    public static class Bridge {
+        private long sink;
+
+        public void noArgs() { sink++; }
+        public int intArgs(int a, int b) { return a + b; }
+        public double doubleArgs(double a, double b) { return a * b; }
+        public int stringArg(String s) { return s.length(); }
+        public void objectArg(Object o) { sink += o.hashCode(); }
+
+        public long getSink() { return sink; }
+    }
+
+    private static final String[][] CASES = {
+        { "no arguments", "bridge.noArgs();" },
+        { "int, int", "bridge.intArgs(i, 1);" },
+        { "double, double", "bridge.doubleArgs(i, 0.5);" },
+        { "String", "bridge.stringArg('abc');" },
+        { "Object", "bridge.objectArg(bridge);" },
+    };
+
+    private int iterations = 100_000;
+
+    @Override
+    public void start(Stage stage) {
+        var args = getParameters().getRaw();
+        if (!args.isEmpty()) {
+            iterations = Integer.parseInt(args.get(0));
+        }
+
+        WebEngine engine = new WebEngine();
+        engine.getLoadWorker().stateProperty().addListener((ov, o, n) -> {
+            if (n == Worker.State.SUCCEEDED) {
+                run(engine);
+                Platform.exit();
+            }
+        });
+        engine.loadContent("<html><body></body></html>");
+    }
+
+    private void run(WebEngine engine) {
+        Bridge bridge = new Bridge();
+        JSObject window = (JSObject) engine.executeScript("window");
+        window.setMember("bridge", bridge);
+
+        System.out.println("Iterations per round: " + iterations);
+        for (String[] c : CASES) {
+            String script = "(function() {"
+                    + "  var t0 = performance.now();"
+                    + "  for (var i = 0; i < " + iterations + "; i++) { " + c[1] + " }"
+                    + "  return performance.now() - t0;"
+                    + "})()";
+            for (int i = 0; i < WARMUP_ROUNDS; i++) {
+                engine.executeScript(script);
+            }
+            double total = 0;
+            for (int i = 0; i < ROUNDS; i++) {
+                total += ((Number) engine.executeScript(script)).doubleValue();
+            }
+            double nsPerCall = total * 1_000_000.0 / ((double) ROUNDS * iterations);
+            System.out.printf("%-16s %10.1f ns/call%n", c[0], nsPerCall);
+        }
+        // keep the calls from being optimized away
+        System.out.println("(sink " + bridge.getSink() + ")");
+    }
+
+    public static void main(String[] args) {
+        Application.launch(args);
+    }
+}
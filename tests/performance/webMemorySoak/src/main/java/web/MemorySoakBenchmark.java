@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package web;
+
+import com.sun.webkit.WebPage;
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.concurrent.Worker;
+import javafx.scene.web.WebEngine;
+import javafx.stage.Stage;
+
+/**
+ * Soak test for the WebKit allocator. Reloads a page that churns DOM nodes,
+ * strings, objects and typed arrays of mixed sizes, and keeps part of them
+ * alive across rounds so that the heap fragments like a long running page.
+ * Prints the allocation throughput and the resident set size as it goes.
+ *
+ * Build the web module with and without -PWEBKIT_SYSTEM_MALLOC=true to
+ * compare bmalloc with the system allocator. The memory footprint is the one
+ * WebKit measures (WebPage.getMemoryFootprint), the resident set size on
+ * Linux. At the end the free memory the allocator still caches is returned
+ * to the system (WebPage.releaseFreeMemory) and the footprint measured again.
+ *
+ * Usage: java --add-exports javafx.web/com.sun.webkit=ALL-UNNAMED
+ *            web.MemorySoakBenchmark [rounds]
+ */
+public class MemorySoakBenchmark extends Application {
+
+    private static final int WARMUP_ROUNDS = 10;
+    private static final int REPORT_INTERVAL = 20;
+    private static final int RELOAD_INTERVAL = 10;
+
+    private static final String PAGE =
+            "<html><body><div id='root'></div><script>"
+            + "var retained = [];"
+            + "function churn(operations) {"
+            + "  var root = document.getElementById('root');"
+            + "  var t0 = performance.now();"
+            + "  for (var i = 0; i < operations; i++) {"
+            + "    var size = 16 << (i % 9);"
+            + "    var node = document.createElement(i % 3 ? 'span' : 'div');"
+            + "    node.textContent = 'x'.repeat(size >> 4) + i;"
+            + "    root.appendChild(node);"
+            + "    var object = { index: i, name: 'item' + i, values: new Array(size >> 6).fill(i) };"
+            + "    var buffer = new Uint8Array(size);"
+            + "    var json = JSON.stringify(object);"
+            + "    if (i % 97 == 0) retained.push([node.cloneNode(true), JSON.parse(json), buffer]);"
+            + "  }"
+            + "  root.textContent = '';"
+            + "  if (retained.length > 2000) retained.splice(0, retained.length - 1000);"
+            + "  return performance.now() - t0;"
+            + "}"
+            + "</script></body></html>";
+
+    private WebEngine engine;
+    private int rounds = 500;
+    private int operations = 20_000;
+    private int round;
+    private double totalMs;
+    private long baselineRss;
+    private long peakRss;
+
+    @Override
+    public void start(Stage stage) {
+        var args = getParameters().getRaw();
+        if (!args.isEmpty()) {
+            rounds = Integer.parseInt(args.get(0));
+        }
+
+        engine = new WebEngine();
+        engine.getLoadWorker().stateProperty().addListener((ov, o, n) -> {
+            if (n == Worker.State.SUCCEEDED) {
+                Platform.runLater(this::runRound);
+            }
+        });
+        System.out.println("Rounds: " + rounds + ", operations per round: " + operations);
+        System.out.printf("%8s %14s %12s%n", "round", "throughput", "RSS");
+        engine.loadContent(PAGE);
+    }
+
+    private void runRound() {
+        double ms = ((Number) engine.executeScript("churn(" + operations + ")")).doubleValue();
+        round++;
+        if (round == WARMUP_ROUNDS) {
+            baselineRss = residentSetSize();
+        } else if (round > WARMUP_ROUNDS) {
+            totalMs += ms;
+        }
+        long rss = residentSetSize();
+        peakRss = Math.max(peakRss, rss);
+
+        if (round % REPORT_INTERVAL == 0) {
+            System.out.printf("%8d %9.0f op/s %9.1f MB%n", round, operations * 1000.0 / ms, rss / 1e6);
+            // Lets the JVM collect the objects that keep JavaScriptCore
+            // garbage collections coming.
+            System.gc();
+        }
+
+        if (round >= rounds) {
+            report(rss);
+            WebPage.releaseFreeMemory();
+            System.out.printf("RSS after releasing free memory %.1f MB%n", residentSetSize() / 1e6);
+            Platform.exit();
+        } else if (round % RELOAD_INTERVAL == 0) {
+            // A new document drops whatever the previous one retained.
+            engine.loadContent(PAGE);
+        } else {
+            Platform.runLater(this::runRound);
+        }
+    }
+
+    private void report(long rss) {
+        int measured = rounds - WARMUP_ROUNDS;
+        if (measured > 0) {
+            System.out.printf("Throughput: %.0f op/s%n", (double) measured * operations * 1000.0 / totalMs);
+        }
+        if (baselineRss > 0) {
+            System.out.printf("RSS after warmup %.1f MB, peak %.1f MB, final %.1f MB, growth %.1f MB%n",
+                    baselineRss / 1e6, peakRss / 1e6, rss / 1e6, (rss - baselineRss) / 1e6);
+        }
+    }
+
+    private static long residentSetSize() {
+        return WebPage.getMemoryFootprint();
+    }
+
+    public static void main(String[] args) {
+        Application.launch(args);
+    }
+}
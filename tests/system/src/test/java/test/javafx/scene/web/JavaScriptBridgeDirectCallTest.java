@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.fail;
+
+import java.util.concurrent.CountDownLatch;
+
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.scene.web.WebEngine;
+import javafx.stage.Stage;
+
+import netscape.javascript.JSException;
+import netscape.javascript.JSObject;
+
+import org.junit.AfterClass;
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+import test.util.Util;
+
+/*
+ * System tests run in the unnamed module, so unlike the javafx.web unit
+ * tests the bridge object below is a public class in an exported package,
+ * whose methods JavaScript calls with plain JNI calls.
+ */
+public class JavaScriptBridgeDirectCallTest {
+    private static final CountDownLatch launchLatch = new CountDownLatch(1);
+
+    public static class TestApp extends Application {
+        @Override
+        public void start(Stage primaryStage) throws Exception {
+            Platform.setImplicitExit(false);
+            launchLatch.countDown();
+        }
+    }
+
+    public static class DirectBridge {
+        public Object lastObject;
+        // Set when a call went through reflection or Utilities.fwkInvokeWithContext
+        public boolean reflectiveCall;
+
+        private void checkCaller() {
+            for (StackTraceElement frame : Thread.currentThread().getStackTrace()) {
+                if (frame.getClassName().equals("com.sun.webkit.Utilities")
+                        || frame.getClassName().startsWith("java.lang.reflect.")
+                        || frame.getClassName().startsWith("jdk.internal.reflect.")) {
+                    reflectiveCall = true;
+                }
+            }
+        }
+
+        public int addInt(int a, int b) { checkCaller(); return a + b; }
+        public double scaleDouble(double d, float f) { checkCaller(); return d * f; }
+        public long negateLong(long l) { checkCaller(); return -l; }
+        public boolean not(boolean b) { checkCaller(); return !b; }
+        public char firstChar(String s) { checkCaller(); return s.charAt(0); }
+        public String concat(String s, int i) { checkCaller(); return s + i; }
+        public void keep(Object o) { checkCaller(); lastObject = o; }
+        public void keepBridge(DirectBridge b) { checkCaller(); lastObject = b; }
+    }
+
+    @BeforeClass
+    public static void setupOnce() {
+        Util.launch(launchLatch, TestApp.class);
+    }
+
+    @AfterClass
+    public static void tearDownOnce() {
+        Util.shutdown();
+    }
+
+    @Test
+    public void testDirectMethodCalls() {
+        Util.runAndWait(() -> {
+            final WebEngine web = new WebEngine();
+            final DirectBridge test = new DirectBridge();
+            JSObject window = (JSObject) web.executeScript("window");
+            window.setMember("test", test);
+
+            assertEquals(42, web.executeScript("test.addInt(40, 2)"));
+            assertEquals(7.5, web.executeScript("test.scaleDouble(2.5, 3)"));
+            assertEquals(-7, web.executeScript("test.negateLong(7)"));
+            assertEquals(Boolean.FALSE, web.executeScript("test.not(true)"));
+            assertEquals("J", web.executeScript("String(test.firstChar('JavaFX'))"));
+            assertEquals("abc3", web.executeScript("test.concat('abc', 3)"));
+            web.executeScript("test.keep('str')");
+            assertEquals("str", test.lastObject);
+            web.executeScript("test.keep(test)");
+            assertSame(test, test.lastObject);
+
+            assertFalse("Method was invoked through reflection", test.reflectiveCall);
+        });
+    }
+
+    private static void assertRejected(WebEngine web, String script) {
+        try {
+            web.executeScript(script);
+            fail("Argument of the wrong type was accepted: " + script);
+        } catch (JSException ex) {
+            // expected, as thrown by Method.invoke
+        }
+    }
+
+    @Test
+    public void testArgumentTypeMismatch() {
+        Util.runAndWait(() -> {
+            final WebEngine web = new WebEngine();
+            final DirectBridge test = new DirectBridge();
+            JSObject window = (JSObject) web.executeScript("window");
+            window.setMember("test", test);
+            window.setMember("other", new StringBuilder("other"));
+
+            web.executeScript("test.keepBridge(test)");
+            assertSame(test, test.lastObject);
+            web.executeScript("test.keepBridge(null)");
+            assertNull(test.lastObject);
+
+            test.lastObject = test;
+            assertRejected(web, "test.keepBridge(undefined)");
+            assertRejected(web, "test.keepBridge('str')");
+            assertRejected(web, "test.keepBridge(other)");
+            assertSame(test, test.lastObject);
+        });
+    }
+}